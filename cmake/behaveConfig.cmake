@@ -0,0 +1,6 @@
+# Package configuration for find_package(behave)
+
+INCLUDE(CMakeFindDependencyMacro)
+FIND_DEPENDENCY(Threads)
+
+INCLUDE("${CMAKE_CURRENT_LIST_DIR}/behaveTargets.cmake")
@@ -0,0 +1,44 @@
+# Installs a built behave into WORK_DIR/prefix, then configures, builds and
+# runs the find_package(behave) consumer in CONSUMER_SOURCE_DIR against it.
+# Run by ctest, see TEST_INSTALL in the top level CMakeLists.txt.
+
+FILE(REMOVE_RECURSE ${WORK_DIR})
+FILE(MAKE_DIRECTORY ${WORK_DIR}/build)
+
+EXECUTE_PROCESS(
+    COMMAND ${CMAKE_COMMAND}
+        -DCMAKE_INSTALL_PREFIX=${WORK_DIR}/prefix
+        -DCMAKE_INSTALL_CONFIG_NAME=${BEHAVE_CONFIG}
+        -P ${BEHAVE_BINARY_DIR}/cmake_install.cmake
+    RESULT_VARIABLE result)
+IF(NOT result EQUAL 0)
+    MESSAGE(FATAL_ERROR "Installing behave failed")
+ENDIF()
+
+EXECUTE_PROCESS(
+    COMMAND ${CMAKE_COMMAND} ${CONSUMER_SOURCE_DIR}
+        -DCMAKE_PREFIX_PATH=${WORK_DIR}/prefix
+        -DCMAKE_CXX_COMPILER=${CMAKE_CXX_COMPILER}
+        -DCMAKE_BUILD_TYPE=${BEHAVE_CONFIG}
+    WORKING_DIRECTORY ${WORK_DIR}/build
+    RESULT_VARIABLE result)
+IF(NOT result EQUAL 0)
+    MESSAGE(FATAL_ERROR "Configuring the find_package(behave) consumer failed")
+ENDIF()
+
+IF(BEHAVE_CONFIG)
+    SET(configArguments --config ${BEHAVE_CONFIG})
+ENDIF()
+EXECUTE_PROCESS(
+    COMMAND ${CMAKE_COMMAND} --build . ${configArguments}
+    WORKING_DIRECTORY ${WORK_DIR}/build
+    RESULT_VARIABLE result)
+IF(NOT result EQUAL 0)
+    MESSAGE(FATAL_ERROR "Building the find_package(behave) consumer against the installed headers failed")
+ENDIF()
+
+FILE(GLOB_RECURSE consumer ${WORK_DIR}/build/behaveConsumer ${WORK_DIR}/build/behaveConsumer.exe)
+EXECUTE_PROCESS(COMMAND ${consumer} RESULT_VARIABLE result)
+IF(NOT result EQUAL 0)
+    MESSAGE(FATAL_ERROR "The find_package(behave) consumer failed")
+ENDIF()
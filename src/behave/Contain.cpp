@@ -90,6 +90,7 @@
 //==============================================================================
 
 // Local include files
+#include "behaveInstrumentation.h"
 #include "Contain.h"
 #include "ContainForce.h"
 
@@ -218,6 +219,7 @@ Sem::Contain::~Contain( void )
 
 void Sem::Contain::calcU( void )
 {
+    BEHAVE_INSTRUMENT_SCOPE(ContainCalcU);
     // Store the current u and h as the old u and h.
     m_u0 = m_u;
     m_h0 = m_h;
@@ -246,6 +248,7 @@ void Sem::Contain::calcU( void )
 	     m_rkpr[2] = productionRatio( m_h0 + m_distStep );
 	     if(m_timeIncrement>1.0)        // mins, m_timeIncrement calc'd & set in productionRatio()
 	     {	m_distStep/=2.0;
+               BEHAVE_INSTRUMENT_EVENT(ContainStepHalved);
 
                continue;
           }
@@ -1225,6 +1228,7 @@ double Sem::Contain::spreadRate( double /* minutesSinceReport */ ) const
 
 Sem::Contain::ContainStatus Sem::Contain::step( void )
 {
+    BEHAVE_INSTRUMENT_SCOPE(ContainStep);
     // Determine next angle and fire head position.
     calcU();
 
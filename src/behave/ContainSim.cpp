@@ -24,6 +24,7 @@
 // Local include files
 #include <iostream>
 #include "ContainSim.h"
+#include "behaveInstrumentation.h"
 //include "Logger.h"
 
 // Standard include files
@@ -620,10 +621,14 @@ void Sem::ContainSim::run( void )
     bool rerun = true;
     bool MAXSTEPS_EXCEEDED=false;
     m_pass = 0;
-    
+    int passesRun = 0;
     
     while ( rerun )
     {
+        if ( passesRun++ > 0 )
+        {
+            BEHAVE_INSTRUMENT_EVENT(ContainRerun);
+        }
         m_left->containLog( ( logLevel >= 1 ), "\nPass %d Begins:\n", m_pass );
         // Simulate until forces overrun, fire contained, or maxSteps reached
         int iLeft = 0;              // First index of left half values
@@ -0,0 +1,431 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  C interface to the Behave batch calculations for foreign callers
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "behaveCApi.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "crown.h"
+#include "fuelModels.h"
+#include "mortality.h"
+#include "species_master_table.h"
+#include "spot.h"
+#include "surface.h"
+
+struct BehaveFuelModels
+{
+    FuelModels fuelModels;
+};
+
+struct BehaveSpeciesTable
+{
+    SpeciesMasterTable speciesMasterTable;
+};
+
+// The integer columns are read in place as the enums they hold
+static_assert(sizeof(SpotFireLocation::SpotFireLocationEnum) == sizeof(int), "SpotFireLocationEnum must be int sized");
+static_assert(sizeof(SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum) == sizeof(int), "SpotDownWindCanopyModeEnum must be int sized");
+static_assert(sizeof(SpotTreeSpecies::SpotTreeSpeciesEnum) == sizeof(int), "SpotTreeSpeciesEnum must be int sized");
+static_assert(sizeof(BeetleDamage) == sizeof(int), "BeetleDamage must be int sized");
+
+namespace
+{
+// Copies the part of the caller's struct it knows about, newer fields read as zero
+template<typename Columns>
+bool readStruct(const Columns* callerStruct, Columns& localStruct)
+{
+    std::memset(&localStruct, 0, sizeof(Columns));
+    if (callerStruct == nullptr || callerStruct->structSize < sizeof(std::size_t))
+    {
+        return false;
+    }
+    std::memcpy(&localStruct, callerStruct, std::min(callerStruct->structSize, sizeof(Columns)));
+    return true;
+}
+
+double columnValue(const double* column, std::size_t row, double defaultValue)
+{
+    return (column != nullptr) ? column[row] : defaultValue;
+}
+
+bool hasSurfaceColumns(const BehaveSurfaceColumns& columns)
+{
+    return columns.fuelModelNumber && columns.moistureOneHour && columns.moistureTenHour && columns.moistureHundredHour
+        && columns.moistureLiveHerbaceous && columns.moistureLiveWoody && columns.windSpeed;
+}
+
+void writeSpotColumns(const BehaveSpotColumns& columns, SpotBatchInputs& inputs)
+{
+    inputs.numberOfScenarios = columns.numberOfRows;
+    inputs.windSpeedAtTwentyFeet = columns.windSpeed;
+    inputs.downwindCoverHeight = columns.downwindCoverHeight;
+    inputs.ridgeToValleyDistance = columns.ridgeToValleyDistance;
+    inputs.ridgeToValleyElevation = columns.ridgeToValleyElevation;
+    inputs.location = reinterpret_cast<const SpotFireLocation::SpotFireLocationEnum*>(columns.location);
+    inputs.downwindCanopyMode = reinterpret_cast<const SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum*>(columns.downwindCanopyMode);
+    inputs.burningPileFlameHeight = columns.burningPileFlameHeight;
+    inputs.flameLength = columns.flameLength;
+    inputs.torchingTrees = columns.torchingTrees;
+    inputs.DBH = columns.DBH;
+    inputs.treeHeight = columns.treeHeight;
+    inputs.treeSpecies = reinterpret_cast<const SpotTreeSpecies::SpotTreeSpeciesEnum*>(columns.treeSpecies);
+    inputs.windSpeedUnits = SpeedUnits::MilesPerHour;
+    inputs.heightUnits = LengthUnits::Feet;
+    inputs.DBHUnits = LengthUnits::Inches;
+    inputs.ridgeToValleyDistanceUnits = LengthUnits::Miles;
+}
+}
+
+int behave_get_api_version(void)
+{
+    return BEHAVE_C_API_VERSION;
+}
+
+BehaveFuelModels* behave_fuel_models_create(void)
+{
+    try
+    {
+        return new BehaveFuelModels();
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void behave_fuel_models_destroy(BehaveFuelModels* fuelModels)
+{
+    delete fuelModels;
+}
+
+int behave_fuel_models_is_defined(const BehaveFuelModels* fuelModels, int fuelModelNumber)
+{
+    return (fuelModels != nullptr && fuelModels->fuelModels.isFuelModelDefined(fuelModelNumber)) ? 1 : 0;
+}
+
+int behave_fuel_models_load_custom(BehaveFuelModels* fuelModels, const char* fileName)
+{
+    if (fuelModels == nullptr || fileName == nullptr)
+    {
+        return BEHAVE_ERROR_INVALID_ARGUMENT;
+    }
+    try
+    {
+        return fuelModels->fuelModels.loadCustomFuelModels(fileName) ? BEHAVE_OK : BEHAVE_ERROR_INVALID_ARGUMENT;
+    }
+    catch (...)
+    {
+        return BEHAVE_ERROR_INTERNAL;
+    }
+}
+
+BehaveSpeciesTable* behave_species_table_create(void)
+{
+    try
+    {
+        return new BehaveSpeciesTable();
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void behave_species_table_destroy(BehaveSpeciesTable* speciesTable)
+{
+    delete speciesTable;
+}
+
+int behave_species_table_find(const BehaveSpeciesTable* speciesTable, const char* speciesCode, int equationType)
+{
+    if (speciesTable == nullptr || speciesCode == nullptr)
+    {
+        return -1;
+    }
+    try
+    {
+        return speciesTable->speciesMasterTable.getSpeciesTableIndexFromSpeciesCodeAndEquationType(speciesCode,
+            static_cast<EquationType>(equationType));
+    }
+    catch (...)
+    {
+        return -1;
+    }
+}
+
+int behave_surface_run_batch(const BehaveFuelModels* fuelModels, const BehaveSurfaceColumns* callerColumns,
+    const BehaveSurfaceOutputs* callerOutputs)
+{
+    BehaveSurfaceColumns columns;
+    BehaveSurfaceOutputs outputs;
+    if (fuelModels == nullptr || !readStruct(callerColumns, columns) || !readStruct(callerOutputs, outputs))
+    {
+        return BEHAVE_ERROR_INVALID_ARGUMENT;
+    }
+    if (!hasSurfaceColumns(columns))
+    {
+        return BEHAVE_ERROR_MISSING_COLUMN;
+    }
+
+    try
+    {
+        Surface surface(fuelModels->fuelModels);
+        for (std::size_t row = 0; row < columns.numberOfRows; row++)
+        {
+            surface.updateSurfaceInputs(columns.fuelModelNumber[row], columns.moistureOneHour[row], columns.moistureTenHour[row],
+                columns.moistureHundredHour[row], columns.moistureLiveHerbaceous[row], columns.moistureLiveWoody[row],
+                FractionUnits::Percent, columns.windSpeed[row], SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot,
+                columnValue(columns.windDirection, row, 0.0), WindAndSpreadOrientationMode::RelativeToNorth,
+                columnValue(columns.slope, row, 0.0), SlopeUnits::Percent, columnValue(columns.aspect, row, 0.0),
+                columnValue(columns.canopyCover, row, 0.0), FractionUnits::Percent, columnValue(columns.canopyHeight, row, 0.0),
+                LengthUnits::Feet, columnValue(columns.crownRatio, row, 0.0));
+            surface.doSurfaceRunInDirectionOfMaxSpread();
+
+            if (outputs.spreadRate)
+            {
+                outputs.spreadRate[row] = surface.getSpreadRate(SpeedUnits::FeetPerMinute);
+            }
+            if (outputs.flameLength)
+            {
+                outputs.flameLength[row] = surface.getFlameLength(LengthUnits::Feet);
+            }
+            if (outputs.firelineIntensity)
+            {
+                outputs.firelineIntensity[row] = surface.getFirelineIntensity(FirelineIntensityUnits::BtusPerFootPerSecond);
+            }
+            if (outputs.directionOfMaxSpread)
+            {
+                outputs.directionOfMaxSpread[row] = surface.getDirectionOfMaxSpread();
+            }
+        }
+    }
+    catch (...)
+    {
+        return BEHAVE_ERROR_INTERNAL;
+    }
+    return BEHAVE_OK;
+}
+
+int behave_crown_run_batch(const BehaveFuelModels* fuelModels, int crownMethod, const BehaveCrownColumns* callerColumns,
+    const BehaveCrownOutputs* callerOutputs)
+{
+    BehaveCrownColumns columns;
+    BehaveSurfaceColumns surfaceColumns;
+    BehaveCrownOutputs outputs;
+    if (fuelModels == nullptr || !readStruct(callerColumns, columns) || !readStruct(callerOutputs, outputs)
+        || (crownMethod != BEHAVE_CROWN_ROTHERMEL && crownMethod != BEHAVE_CROWN_SCOTT_AND_REINHARDT))
+    {
+        return BEHAVE_ERROR_INVALID_ARGUMENT;
+    }
+    if (!readStruct(columns.surface, surfaceColumns) || !hasSurfaceColumns(surfaceColumns) || !surfaceColumns.canopyHeight || !columns.canopyBaseHeight
+        || !columns.canopyBulkDensity || !columns.moistureFoliar)
+    {
+        return BEHAVE_ERROR_MISSING_COLUMN;
+    }
+
+    try
+    {
+        // Crown only reads the fuel models
+        Crown crown(const_cast<FuelModels&>(fuelModels->fuelModels));
+        for (std::size_t row = 0; row < surfaceColumns.numberOfRows; row++)
+        {
+            crown.updateCrownInputs(surfaceColumns.fuelModelNumber[row], surfaceColumns.moistureOneHour[row],
+                surfaceColumns.moistureTenHour[row], surfaceColumns.moistureHundredHour[row],
+                surfaceColumns.moistureLiveHerbaceous[row], surfaceColumns.moistureLiveWoody[row], columns.moistureFoliar[row],
+                FractionUnits::Percent, surfaceColumns.windSpeed[row], SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot,
+                columnValue(surfaceColumns.windDirection, row, 0.0), WindAndSpreadOrientationMode::RelativeToNorth,
+                columnValue(surfaceColumns.slope, row, 0.0), SlopeUnits::Percent, columnValue(surfaceColumns.aspect, row, 0.0),
+                columnValue(surfaceColumns.canopyCover, row, 0.0), FractionUnits::Percent, surfaceColumns.canopyHeight[row],
+                columns.canopyBaseHeight[row], LengthUnits::Feet, columnValue(surfaceColumns.crownRatio, row, 0.0),
+                columns.canopyBulkDensity[row], DensityUnits::PoundsPerCubicFoot);
+            if (crownMethod == BEHAVE_CROWN_ROTHERMEL)
+            {
+                crown.doCrownRunRothermel();
+            }
+            else
+            {
+                crown.doCrownRunScottAndReinhardt();
+            }
+
+            if (outputs.spreadRate)
+            {
+                outputs.spreadRate[row] = crown.getFinalSpreadRate(SpeedUnits::FeetPerMinute);
+            }
+            if (outputs.flameLength)
+            {
+                outputs.flameLength[row] = crown.getFinalFlameLength(LengthUnits::Feet);
+            }
+            if (outputs.firelineIntensity)
+            {
+                outputs.firelineIntensity[row] = crown.getFinalFirelineIntesity(FirelineIntensityUnits::BtusPerFootPerSecond);
+            }
+            if (outputs.fireType)
+            {
+                outputs.fireType[row] = (int)crown.getFireType();
+            }
+        }
+    }
+    catch (...)
+    {
+        return BEHAVE_ERROR_INTERNAL;
+    }
+    return BEHAVE_OK;
+}
+
+int behave_spot_burning_pile_batch(const BehaveSpotColumns* callerColumns, double* flatDistance, double* mountainDistance)
+{
+    BehaveSpotColumns columns;
+    if (!readStruct(callerColumns, columns) || flatDistance == nullptr || mountainDistance == nullptr)
+    {
+        return BEHAVE_ERROR_INVALID_ARGUMENT;
+    }
+    if (!columns.windSpeed || !columns.downwindCoverHeight || !columns.burningPileFlameHeight)
+    {
+        return BEHAVE_ERROR_MISSING_COLUMN;
+    }
+    SpotBatchInputs inputs;
+    writeSpotColumns(columns, inputs);
+    try
+    {
+        Spot spot;
+        spot.calculateSpottingDistanceFromBurningPileForBatch(inputs, flatDistance, mountainDistance, LengthUnits::Miles);
+    }
+    catch (...)
+    {
+        return BEHAVE_ERROR_INTERNAL;
+    }
+    return BEHAVE_OK;
+}
+
+int behave_spot_surface_fire_batch(const BehaveSpotColumns* callerColumns, double* flatDistance, double* mountainDistance)
+{
+    BehaveSpotColumns columns;
+    if (!readStruct(callerColumns, columns) || flatDistance == nullptr || mountainDistance == nullptr)
+    {
+        return BEHAVE_ERROR_INVALID_ARGUMENT;
+    }
+    if (!columns.windSpeed || !columns.downwindCoverHeight || !columns.flameLength)
+    {
+        return BEHAVE_ERROR_MISSING_COLUMN;
+    }
+    SpotBatchInputs inputs;
+    writeSpotColumns(columns, inputs);
+    try
+    {
+        Spot spot;
+        spot.calculateSpottingDistanceFromSurfaceFireForBatch(inputs, flatDistance, mountainDistance, LengthUnits::Miles);
+    }
+    catch (...)
+    {
+        return BEHAVE_ERROR_INTERNAL;
+    }
+    return BEHAVE_OK;
+}
+
+int behave_spot_torching_trees_batch(const BehaveSpotColumns* callerColumns, double* flatDistance, double* mountainDistance)
+{
+    BehaveSpotColumns columns;
+    if (!readStruct(callerColumns, columns) || flatDistance == nullptr || mountainDistance == nullptr)
+    {
+        return BEHAVE_ERROR_INVALID_ARGUMENT;
+    }
+    if (!columns.windSpeed || !columns.downwindCoverHeight || !columns.torchingTrees || !columns.DBH || !columns.treeHeight)
+    {
+        return BEHAVE_ERROR_MISSING_COLUMN;
+    }
+    SpotBatchInputs inputs;
+    writeSpotColumns(columns, inputs);
+    try
+    {
+        Spot spot;
+        spot.calculateSpottingDistanceFromTorchingTreesForBatch(inputs, flatDistance, mountainDistance, LengthUnits::Miles);
+    }
+    catch (...)
+    {
+        return BEHAVE_ERROR_INTERNAL;
+    }
+    return BEHAVE_OK;
+}
+
+int behave_mortality_batch(const BehaveSpeciesTable* speciesTable, const BehaveMortalityColumns* callerColumns,
+    double flameLengthOrScorchHeight, int isScorchHeight, int fireSeverity, int numberOfThreads,
+    double* probabilityOfMortality, BehaveMortalitySummary* summary)
+{
+    BehaveMortalityColumns columns;
+    if (speciesTable == nullptr || !readStruct(callerColumns, columns) || probabilityOfMortality == nullptr
+        || fireSeverity < BEHAVE_FIRE_SEVERITY_NOT_SET || fireSeverity > BEHAVE_FIRE_SEVERITY_LOW)
+    {
+        return BEHAVE_ERROR_INVALID_ARGUMENT;
+    }
+    if (!columns.speciesTableIndex)
+    {
+        return BEHAVE_ERROR_MISSING_COLUMN;
+    }
+
+    MortalityTreeList treeList;
+    treeList.numberOfTrees = columns.numberOfRows;
+    treeList.speciesTableIndex = columns.speciesTableIndex;
+    treeList.dbh = columns.DBH;
+    treeList.treeHeight = columns.treeHeight;
+    treeList.crownRatio = columns.crownRatio;
+    treeList.expansionFactor = columns.expansionFactor;
+    treeList.crownDamage = columns.crownDamage;
+    treeList.cambiumKillRating = columns.cambiumKillRating;
+    treeList.beetleDamage = reinterpret_cast<const BeetleDamage*>(columns.beetleDamage);
+    treeList.boleCharHeight = columns.boleCharHeight;
+    treeList.dbhUnits = LengthUnits::Inches;
+    treeList.heightUnits = LengthUnits::Feet;
+    treeList.expansionFactorAreaUnits = AreaUnits::Acres;
+
+    try
+    {
+        // Mortality only reads the species table
+        Mortality mortality(const_cast<SpeciesMasterTable&>(speciesTable->speciesMasterTable));
+        mortality.setFlameLengthOrScorchHeightSwitch(isScorchHeight ? FlameLengthOrScorchHeightSwitch::scorch_height
+            : FlameLengthOrScorchHeightSwitch::flame_length);
+        mortality.setFlameLengthOrScorchHeightValue(flameLengthOrScorchHeight, LengthUnits::Feet);
+        mortality.setFireSeverity(static_cast<FireSeverity>(fireSeverity));
+        MortalityStandSummary standSummary = mortality.calculateMortalityForTreeList(treeList, probabilityOfMortality,
+            FractionUnits::Fraction, numberOfThreads);
+        if (summary)
+        {
+            summary->numberOfTrees = standSummary.numberOfTrees;
+            summary->numberOfInvalidTrees = standSummary.numberOfInvalidTrees;
+            summary->treesPrefire = standSummary.treesPrefire;
+            summary->treesKilled = standSummary.treesKilled;
+            summary->basalAreaPrefire = standSummary.basalAreaPrefire;
+            summary->basalAreaKilled = standSummary.basalAreaKilled;
+            summary->prefireCanopyCover = standSummary.prefireCanopyCover;
+            summary->postfireCanopyCover = standSummary.postfireCanopyCover;
+        }
+    }
+    catch (...)
+    {
+        return BEHAVE_ERROR_INTERNAL;
+    }
+    return BEHAVE_OK;
+}
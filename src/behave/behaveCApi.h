@@ -0,0 +1,221 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  C interface to the Behave batch calculations for foreign callers
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef BEHAVECAPI_H
+#define BEHAVECAPI_H
+
+/*
+ * Plain C functions over the batch calculations, for callers in other
+ * languages. Each batch call reads caller owned input columns and writes
+ * caller owned output columns, one element per row, without copying or
+ * allocating per row. Columns marked optional may be NULL.
+ *
+ * Units are fixed: moistures and canopy cover in percent, wind speeds in
+ * miles per hour at twenty feet, slope in percent, directions in degrees
+ * clockwise from north, lengths and heights in feet, spread rates in feet per
+ * minute, fireline intensity in Btu/ft/s, canopy bulk density in lb/ft^3 and
+ * spotting distances in miles.
+ *
+ * Column structs only ever grow at the end. Callers set structSize to
+ * sizeof() the struct they were compiled with, and fields past it read as
+ * NULL or zero.
+ *
+ * Handles are read only during batch calls, so concurrent calls may share
+ * them. Functions return BEHAVE_OK or a negative BEHAVE_ERROR_ code.
+ */
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#  if defined(BEHAVE_C_API_EXPORTS)
+#    define BEHAVE_C_API __declspec(dllexport)
+#  else
+#    define BEHAVE_C_API
+#  endif
+#elif defined(__GNUC__)
+#  define BEHAVE_C_API __attribute__((visibility("default")))
+#else
+#  define BEHAVE_C_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BEHAVE_C_API_VERSION 1
+
+#define BEHAVE_OK 0
+#define BEHAVE_ERROR_INVALID_ARGUMENT -1
+#define BEHAVE_ERROR_MISSING_COLUMN -2
+#define BEHAVE_ERROR_INTERNAL -3
+
+/* Crown fire methods */
+#define BEHAVE_CROWN_ROTHERMEL 0
+#define BEHAVE_CROWN_SCOTT_AND_REINHARDT 1
+
+/* Crown fire types, as FireType */
+#define BEHAVE_FIRE_TYPE_SURFACE 0
+#define BEHAVE_FIRE_TYPE_TORCHING 1
+#define BEHAVE_FIRE_TYPE_CONDITIONAL_CROWN_FIRE 2
+#define BEHAVE_FIRE_TYPE_CROWNING 3
+
+/* Mortality equation types and fire severities, as EquationType and FireSeverity */
+#define BEHAVE_EQUATION_CROWN_SCORCH 0
+#define BEHAVE_EQUATION_BOLE_CHAR 1
+#define BEHAVE_EQUATION_CROWN_DAMAGE 2
+#define BEHAVE_FIRE_SEVERITY_NOT_SET -1
+#define BEHAVE_FIRE_SEVERITY_EMPTY 0
+#define BEHAVE_FIRE_SEVERITY_LOW 1
+
+typedef struct BehaveFuelModels BehaveFuelModels;
+typedef struct BehaveSpeciesTable BehaveSpeciesTable;
+
+typedef struct BehaveSurfaceColumns
+{
+    size_t structSize;
+    size_t numberOfRows;
+    const int* fuelModelNumber;
+    const double* moistureOneHour;
+    const double* moistureTenHour;
+    const double* moistureHundredHour;
+    const double* moistureLiveHerbaceous;
+    const double* moistureLiveWoody;
+    const double* windSpeed;
+    const double* windDirection;            /* optional, the direction the wind blows from */
+    const double* slope;                    /* optional */
+    const double* aspect;                   /* optional */
+    const double* canopyCover;              /* optional */
+    const double* canopyHeight;             /* optional */
+    const double* crownRatio;               /* optional, fraction */
+} BehaveSurfaceColumns;
+
+typedef struct BehaveSurfaceOutputs
+{
+    size_t structSize;
+    double* spreadRate;                     /* optional, in the direction of max spread */
+    double* flameLength;                    /* optional */
+    double* firelineIntensity;              /* optional */
+    double* directionOfMaxSpread;           /* optional */
+} BehaveSurfaceOutputs;
+
+/* The surface columns plus the canopy */
+typedef struct BehaveCrownColumns
+{
+    size_t structSize;
+    const BehaveSurfaceColumns* surface;    /* read with its own structSize */
+    const double* canopyBaseHeight;
+    const double* canopyBulkDensity;
+    const double* moistureFoliar;
+} BehaveCrownColumns;
+
+typedef struct BehaveCrownOutputs
+{
+    size_t structSize;
+    double* spreadRate;                     /* optional, final spread rate by fire type */
+    double* flameLength;                    /* optional, final flame length by fire type */
+    double* firelineIntensity;              /* optional, final fireline intensity by fire type */
+    int* fireType;                          /* optional, BEHAVE_FIRE_TYPE_ */
+} BehaveCrownOutputs;
+
+/* Only the firebrand source columns of the calculated source are read */
+typedef struct BehaveSpotColumns
+{
+    size_t structSize;
+    size_t numberOfRows;
+    const double* windSpeed;
+    const double* downwindCoverHeight;
+    const double* ridgeToValleyDistance;    /* optional, flat terrain if NULL */
+    const double* ridgeToValleyElevation;   /* optional, flat terrain if NULL */
+    const int* location;                    /* optional, SpotFireLocation, midslope windward if NULL */
+    const int* downwindCanopyMode;          /* optional, SpotDownWindCanopyMode, closed if NULL */
+    const double* burningPileFlameHeight;
+    const double* flameLength;
+    const int* torchingTrees;
+    const double* DBH;                      /* inches */
+    const double* treeHeight;
+    const int* treeSpecies;                 /* optional, SpotTreeSpecies, Engelmann spruce if NULL */
+} BehaveSpotColumns;
+
+typedef struct BehaveMortalityColumns
+{
+    size_t structSize;
+    size_t numberOfRows;
+    const int* speciesTableIndex;           /* from behave_species_table_find() */
+    const double* DBH;                      /* optional, inches, not set if NULL */
+    const double* treeHeight;               /* optional, not set if NULL */
+    const double* crownRatio;               /* optional, fraction, not set if NULL */
+    const double* expansionFactor;          /* optional, trees per acre */
+    const double* crownDamage;              /* optional */
+    const double* cambiumKillRating;        /* optional */
+    const int* beetleDamage;                /* optional, -1 not set, 0 no, 1 yes */
+    const double* boleCharHeight;           /* optional */
+} BehaveMortalityColumns;
+
+/* Stand totals per acre, as MortalityStandSummary */
+typedef struct BehaveMortalitySummary
+{
+    size_t numberOfTrees;
+    size_t numberOfInvalidTrees;
+    double treesPrefire;
+    double treesKilled;
+    double basalAreaPrefire;                /* square feet */
+    double basalAreaKilled;                 /* square feet */
+    double prefireCanopyCover;              /* percent */
+    double postfireCanopyCover;             /* percent */
+} BehaveMortalitySummary;
+
+BEHAVE_C_API int behave_get_api_version(void);
+
+BEHAVE_C_API BehaveFuelModels* behave_fuel_models_create(void);
+BEHAVE_C_API void behave_fuel_models_destroy(BehaveFuelModels* fuelModels);
+BEHAVE_C_API int behave_fuel_models_is_defined(const BehaveFuelModels* fuelModels, int fuelModelNumber);
+BEHAVE_C_API int behave_fuel_models_load_custom(BehaveFuelModels* fuelModels, const char* fileName);
+
+BEHAVE_C_API BehaveSpeciesTable* behave_species_table_create(void);
+BEHAVE_C_API void behave_species_table_destroy(BehaveSpeciesTable* speciesTable);
+/* Species table index of the species code and BEHAVE_EQUATION_ type, -1 if not found */
+BEHAVE_C_API int behave_species_table_find(const BehaveSpeciesTable* speciesTable, const char* speciesCode, int equationType);
+
+BEHAVE_C_API int behave_surface_run_batch(const BehaveFuelModels* fuelModels, const BehaveSurfaceColumns* columns,
+    const BehaveSurfaceOutputs* outputs);
+BEHAVE_C_API int behave_crown_run_batch(const BehaveFuelModels* fuelModels, int crownMethod, const BehaveCrownColumns* columns,
+    const BehaveCrownOutputs* outputs);
+
+/* Max flat and mountainous terrain spotting distance of each row, 0 where there is no spotting */
+BEHAVE_C_API int behave_spot_burning_pile_batch(const BehaveSpotColumns* columns, double* flatDistance, double* mountainDistance);
+BEHAVE_C_API int behave_spot_surface_fire_batch(const BehaveSpotColumns* columns, double* flatDistance, double* mountainDistance);
+BEHAVE_C_API int behave_spot_torching_trees_batch(const BehaveSpotColumns* columns, double* flatDistance, double* mountainDistance);
+
+/* Probability of mortality (fraction, -1 for invalid trees) of each tree for one fire, summary may be NULL */
+BEHAVE_C_API int behave_mortality_batch(const BehaveSpeciesTable* speciesTable, const BehaveMortalityColumns* columns,
+    double flameLengthOrScorchHeight, int isScorchHeight, int fireSeverity, int numberOfThreads,
+    double* probabilityOfMortality, BehaveMortalitySummary* summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BEHAVECAPI_H */
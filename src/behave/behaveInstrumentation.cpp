@@ -0,0 +1,252 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Optional stage timing and event counters of the core calculations
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "behaveInstrumentation.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BEHAVE_INSTRUMENTATION_RDTSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define BEHAVE_INSTRUMENTATION_RDTSC
+#endif
+
+namespace
+{
+
+const char* stageNames[InstrumentationStage::NumberOfStages] =
+{
+    "surfaceFuelbedIntermediates",
+    "surfaceReactionIntensity",
+    "surfaceWindAndSlopeFactors",
+    "surfaceEllipse",
+    "surfaceFlameAndIntensity",
+    "randFuelComputeSpread",
+    "randFuelRecomputeSpread",
+    "randFuelSampleSpread",
+    "randThreadSpreadPaths",
+    "containStep",
+    "containCalcU",
+    "mortalityCrownScorch",
+    "mortalityBoleChar",
+    "mortalityCrownDamage"
+};
+
+const char* eventNames[InstrumentationEvent::NumberOfEvents] =
+{
+    "windSpeedLimitApplied",
+    "zeroLoadSkipped",
+    "containRerun",
+    "containStepHalved"
+};
+
+// Written only by the owning thread, atomic so other threads can read them
+struct ThreadCounters
+{
+    ThreadCounters();
+    ~ThreadCounters();
+
+    void add(InstrumentationSnapshot& total) const;
+    void reset();
+
+    std::atomic<std::uint64_t> stageTicks[InstrumentationStage::NumberOfStages];
+    std::atomic<std::uint64_t> stageCalls[InstrumentationStage::NumberOfStages];
+    std::atomic<std::uint64_t> eventCounts[InstrumentationEvent::NumberOfEvents];
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::set<ThreadCounters*> threads;
+    InstrumentationSnapshot exitedThreads;     // totals of threads that have exited
+};
+
+Registry& getRegistry()
+{
+    // Never destroyed, threads may exit after static destruction starts
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+void increment(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+{
+    // Only the owning thread writes, so no read-modify-write is needed
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+ThreadCounters::ThreadCounters()
+{
+    reset();
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.insert(this);
+}
+
+ThreadCounters::~ThreadCounters()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    add(registry.exitedThreads);
+    registry.threads.erase(this);
+}
+
+void ThreadCounters::add(InstrumentationSnapshot& total) const
+{
+    for (int i = 0; i < InstrumentationStage::NumberOfStages; i++)
+    {
+        total.stageTicks[i] += stageTicks[i].load(std::memory_order_relaxed);
+        total.stageCalls[i] += stageCalls[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < InstrumentationEvent::NumberOfEvents; i++)
+    {
+        total.eventCounts[i] += eventCounts[i].load(std::memory_order_relaxed);
+    }
+}
+
+void ThreadCounters::reset()
+{
+    for (int i = 0; i < InstrumentationStage::NumberOfStages; i++)
+    {
+        stageTicks[i].store(0, std::memory_order_relaxed);
+        stageCalls[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < InstrumentationEvent::NumberOfEvents; i++)
+    {
+        eventCounts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+ThreadCounters& getThreadCounters()
+{
+    thread_local ThreadCounters threadCounters;
+    return threadCounters;
+}
+
+}
+
+bool Instrumentation::isEnabled()
+{
+#ifdef BEHAVE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+InstrumentationSnapshot Instrumentation::snapshot()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    InstrumentationSnapshot total = registry.exitedThreads;
+    for (std::set<ThreadCounters*>::const_iterator it = registry.threads.begin(); it != registry.threads.end(); ++it)
+    {
+        (*it)->add(total);
+    }
+    return total;
+}
+
+InstrumentationSnapshot Instrumentation::snapshotCurrentThread()
+{
+    InstrumentationSnapshot total;
+    getThreadCounters().add(total);
+    return total;
+}
+
+void Instrumentation::reset()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.exitedThreads = InstrumentationSnapshot();
+    for (std::set<ThreadCounters*>::const_iterator it = registry.threads.begin(); it != registry.threads.end(); ++it)
+    {
+        (*it)->reset();
+    }
+}
+
+std::string Instrumentation::toJson(const InstrumentationSnapshot& snapshot)
+{
+    std::ostringstream json;
+    json << "{\"tickUnit\": \"" << getTickUnit() << "\", \"stages\": {";
+    for (int i = 0; i < InstrumentationStage::NumberOfStages; i++)
+    {
+        json << ((i > 0) ? ", " : "") << "\"" << stageNames[i] << "\": {\"calls\": " << snapshot.stageCalls[i]
+            << ", \"ticks\": " << snapshot.stageTicks[i] << "}";
+    }
+    json << "}, \"events\": {";
+    for (int i = 0; i < InstrumentationEvent::NumberOfEvents; i++)
+    {
+        json << ((i > 0) ? ", " : "") << "\"" << eventNames[i] << "\": " << snapshot.eventCounts[i];
+    }
+    json << "}}";
+    return json.str();
+}
+
+const char* Instrumentation::getStageName(InstrumentationStage::InstrumentationStageEnum stage)
+{
+    return stageNames[stage];
+}
+
+const char* Instrumentation::getEventName(InstrumentationEvent::InstrumentationEventEnum event)
+{
+    return eventNames[event];
+}
+
+const char* Instrumentation::getTickUnit()
+{
+#ifdef BEHAVE_INSTRUMENTATION_RDTSC
+    return "cycles";
+#else
+    return "nanoseconds";
+#endif
+}
+
+std::uint64_t Instrumentation::readTicks()
+{
+#ifdef BEHAVE_INSTRUMENTATION_RDTSC
+    return __rdtsc();
+#else
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void Instrumentation::addStage(InstrumentationStage::InstrumentationStageEnum stage, std::uint64_t ticks)
+{
+    ThreadCounters& threadCounters = getThreadCounters();
+    increment(threadCounters.stageTicks[stage], ticks);
+    increment(threadCounters.stageCalls[stage], 1);
+}
+
+void Instrumentation::addEvent(InstrumentationEvent::InstrumentationEventEnum event)
+{
+    increment(getThreadCounters().eventCounts[event], 1);
+}
@@ -0,0 +1,164 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Optional stage timing and event counters of the core calculations
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef BEHAVEINSTRUMENTATION_H
+#define BEHAVEINSTRUMENTATION_H
+
+#include <cstdint>
+#include <string>
+
+// Stage timing and event counting of the hot paths, compiled in only when
+// BEHAVE_INSTRUMENTATION is defined. Without it the BEHAVE_INSTRUMENT_
+// macros expand to nothing, and the snapshots are all zero.
+//
+// Every thread records into its own counters. snapshot() totals the
+// counters of all threads, including threads that have exited. Stage times
+// are inclusive, so a stage that runs inside another is counted in both.
+
+struct InstrumentationStage
+{
+    enum InstrumentationStageEnum
+    {
+        SurfaceFuelbedIntermediates,    // SurfaceFire::calculateForwardSpreadRate() stages
+        SurfaceReactionIntensity,
+        SurfaceWindAndSlopeFactors,
+        SurfaceEllipse,
+        SurfaceFlameAndIntensity,
+        RandFuelComputeSpread,          // RandFuel::computeSpread2()
+        RandFuelRecomputeSpread,        // RandFuel::recomputeSpread()
+        RandFuelSampleSpread,           // RandFuel::sampleSpread2()
+        RandThreadSpreadPaths,          // RandThread::calcSpreadPaths2(), on the RandFuel threads
+        ContainStep,                    // Sem::Contain::step()
+        ContainCalcU,                   // Sem::Contain::calcU()
+        MortalityCrownScorch,           // Mortality equations by type
+        MortalityBoleChar,
+        MortalityCrownDamage,
+        NumberOfStages
+    };
+};
+
+struct InstrumentationEvent
+{
+    enum InstrumentationEventEnum
+    {
+        WindSpeedLimitApplied,          // SurfaceFire::applyWindSpeedLimit()
+        ZeroLoadSkipped,                // SurfaceFire::skipCalculationForZeroLoad()
+        ContainRerun,                   // Sem::ContainSim::run() starts another pass
+        ContainStepHalved,              // Sem::Contain::calcU() halves its distance step
+        NumberOfEvents
+    };
+};
+
+struct InstrumentationSnapshot
+{
+    std::uint64_t stageTicks[InstrumentationStage::NumberOfStages] = {};
+    std::uint64_t stageCalls[InstrumentationStage::NumberOfStages] = {};
+    std::uint64_t eventCounts[InstrumentationEvent::NumberOfEvents] = {};
+};
+
+class Instrumentation
+{
+public:
+    // True if BEHAVE_INSTRUMENTATION was defined when the core was built
+    static bool isEnabled();
+
+    static InstrumentationSnapshot snapshot();
+    static InstrumentationSnapshot snapshotCurrentThread();
+    // Zeroes the counters of every thread, counts recorded by other threads
+    // while resetting may survive it
+    static void reset();
+
+    // {"tickUnit": ..., "stages": {name: {"calls": n, "ticks": n}, ...}, "events": {name: n, ...}}
+    static std::string toJson(const InstrumentationSnapshot& snapshot);
+    static const char* getStageName(InstrumentationStage::InstrumentationStageEnum stage);
+    static const char* getEventName(InstrumentationEvent::InstrumentationEventEnum event);
+    // "cycles" where the time stamp counter is read, otherwise "nanoseconds"
+    static const char* getTickUnit();
+
+    static std::uint64_t readTicks();
+    static void addStage(InstrumentationStage::InstrumentationStageEnum stage, std::uint64_t ticks);
+    static void addEvent(InstrumentationEvent::InstrumentationEventEnum event);
+};
+
+// Times the rest of the enclosing scope
+class InstrumentationScope
+{
+public:
+    explicit InstrumentationScope(InstrumentationStage::InstrumentationStageEnum stage)
+        : stage_(stage),
+        start_(Instrumentation::readTicks())
+    {
+
+    }
+
+    ~InstrumentationScope()
+    {
+        Instrumentation::addStage(stage_, Instrumentation::readTicks() - start_);
+    }
+
+private:
+    InstrumentationScope(const InstrumentationScope&) = delete;
+    InstrumentationScope& operator=(const InstrumentationScope&) = delete;
+
+    InstrumentationStage::InstrumentationStageEnum stage_;
+    std::uint64_t start_;
+};
+
+// Times consecutive stages of one function, each finish() ends a stage
+// started by the previous finish() or the constructor
+class InstrumentationSequence
+{
+public:
+    InstrumentationSequence()
+        : last_(Instrumentation::readTicks())
+    {
+
+    }
+
+    void finish(InstrumentationStage::InstrumentationStageEnum stage)
+    {
+        std::uint64_t now = Instrumentation::readTicks();
+        Instrumentation::addStage(stage, now - last_);
+        last_ = now;
+    }
+
+private:
+    std::uint64_t last_;
+};
+
+#ifdef BEHAVE_INSTRUMENTATION
+#define BEHAVE_INSTRUMENT_SCOPE(stage) InstrumentationScope behaveInstrumentationScope(InstrumentationStage::stage)
+#define BEHAVE_INSTRUMENT_SEQUENCE(name) InstrumentationSequence name
+#define BEHAVE_INSTRUMENT_SEQUENCE_FINISH(name, stage) name.finish(InstrumentationStage::stage)
+#define BEHAVE_INSTRUMENT_EVENT(event) Instrumentation::addEvent(InstrumentationEvent::event)
+#else
+#define BEHAVE_INSTRUMENT_SCOPE(stage)
+#define BEHAVE_INSTRUMENT_SEQUENCE(name)
+#define BEHAVE_INSTRUMENT_SEQUENCE_FINISH(name, stage)
+#define BEHAVE_INSTRUMENT_EVENT(event)
+#endif
+
+#endif // BEHAVEINSTRUMENTATION_H
@@ -54,6 +54,7 @@ public:
 
     void reinitialize();
 
+    // Keeps a pointer, see FuelModels for changing custom fuel models during runs
     void setFuelModels(FuelModels& fuelModels);
     void setMoistureScenarios(MoistureScenarios& moistureScenarios);
 
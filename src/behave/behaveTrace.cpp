@@ -0,0 +1,350 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Chrome trace event timeline of batch tool stages across threads
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "behaveTrace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace
+{
+
+struct TraceEvent
+{
+    const char* category;       // null for counters
+    const char* name;
+    std::uint64_t startTime;
+    std::uint64_t duration;
+    double value;               // counters only
+};
+
+struct ThreadTrack
+{
+    int threadId;
+    std::string threadName;
+    std::vector<TraceEvent> events;     // ring buffer, written % size is the next slot
+    std::uint64_t written;
+};
+
+// Locked by its owning thread for every event, so only contended while a
+// trace is started or written
+struct ThreadBuffer
+{
+    ThreadBuffer();
+    ~ThreadBuffer();
+
+    void add(const TraceEvent& event);
+
+    std::mutex mutex;
+    ThreadTrack track;
+};
+
+struct Registry
+{
+    Registry()
+        : isRecording(false),
+        eventsPerThread(0),
+        startTime(0),
+        nextThreadId(1),
+        numberOfExitedEvents(0),
+        numberOfExitedEventsRecorded(0)
+    {
+
+    }
+
+    std::mutex mutex;
+    std::atomic<bool> isRecording;
+    std::size_t eventsPerThread;
+    std::uint64_t startTime;
+    int nextThreadId;
+    std::set<ThreadBuffer*> threads;
+    // Exited threads keep at most one ring buffer's worth of events between
+    // them, the oldest tracks are dropped first
+    std::deque<ThreadTrack> exitedThreads;
+    std::size_t numberOfExitedEvents;               // kept in exitedThreads
+    std::uint64_t numberOfExitedEventsRecorded;     // including dropped ones
+};
+
+Registry& getRegistry()
+{
+    // Never destroyed, threads may exit after static destruction starts
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+ThreadBuffer::ThreadBuffer()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    track.threadId = registry.nextThreadId++;
+    track.events.resize(registry.eventsPerThread);
+    track.written = 0;
+    registry.threads.insert(this);
+}
+
+ThreadBuffer::~ThreadBuffer()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.erase(this);
+    if (track.written == 0)
+    {
+        return;
+    }
+    registry.numberOfExitedEventsRecorded += track.written;
+
+    // Only the written slots, a ring buffer that never wrapped keeps its
+    // events at the same indexes
+    ThreadTrack exitedTrack;
+    exitedTrack.threadId = track.threadId;
+    exitedTrack.threadName = track.threadName;
+    exitedTrack.written = track.written;
+    std::size_t numberOfEvents = (track.written < track.events.size()) ? (std::size_t)track.written : track.events.size();
+    exitedTrack.events.assign(track.events.begin(), track.events.begin() + numberOfEvents);
+    registry.exitedThreads.push_back(exitedTrack);
+    registry.numberOfExitedEvents += numberOfEvents;
+
+    while (registry.numberOfExitedEvents > registry.eventsPerThread && !registry.exitedThreads.empty())
+    {
+        registry.numberOfExitedEvents -= registry.exitedThreads.front().events.size();
+        registry.exitedThreads.pop_front();
+    }
+}
+
+void ThreadBuffer::add(const TraceEvent& event)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (track.events.empty())
+    {
+        return;
+    }
+    track.events[track.written % track.events.size()] = event;
+    track.written++;
+}
+
+ThreadBuffer& getThreadBuffer()
+{
+    thread_local ThreadBuffer threadBuffer;
+    return threadBuffer;
+}
+
+void writeJsonString(std::ostream& out, const std::string& text)
+{
+    out << '"';
+    for (std::string::const_iterator it = text.begin(); it != text.end(); ++it)
+    {
+        if (*it == '"' || *it == '\\')
+        {
+            out << '\\' << *it;
+        }
+        else if ((unsigned char)*it < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned)(unsigned char)*it);
+            out << escaped;
+        }
+        else
+        {
+            out << *it;
+        }
+    }
+    out << '"';
+}
+
+// Chrome trace times are microseconds
+void writeMicroseconds(std::ostream& out, std::uint64_t nanoseconds)
+{
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", nanoseconds / 1000.0);
+    out << text;
+}
+
+void writeTrack(std::ostream& out, const ThreadTrack& track, std::uint64_t startTime, bool& isFirst)
+{
+    if (track.written == 0)
+    {
+        return;
+    }
+    out << (isFirst ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << track.threadId
+        << ", \"args\": {\"name\": ";
+    writeJsonString(out, track.threadName.empty() ? "thread " + std::to_string(track.threadId) : track.threadName);
+    out << "}}";
+    isFirst = false;
+
+    // Oldest first, a full ring buffer starts at its next slot
+    std::uint64_t size = track.events.size();
+    std::uint64_t first = (track.written > size) ? track.written - size : 0;
+    for (std::uint64_t i = first; i < track.written; i++)
+    {
+        const TraceEvent& event = track.events[i % size];
+        // A span that began before start() is clipped to it
+        std::uint64_t eventStart = (event.startTime > startTime) ? event.startTime : startTime;
+        std::uint64_t eventEnd = event.startTime + event.duration;
+        out << ",\n{\"name\": ";
+        writeJsonString(out, event.name);
+        if (event.category)
+        {
+            out << ", \"cat\": ";
+            writeJsonString(out, event.category);
+            out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << track.threadId << ", \"ts\": ";
+            writeMicroseconds(out, eventStart - startTime);
+            out << ", \"dur\": ";
+            writeMicroseconds(out, (eventEnd > eventStart) ? eventEnd - eventStart : 0);
+            out << "}";
+        }
+        else
+        {
+            char value[32];
+            std::snprintf(value, sizeof(value), "%.15g", event.value);
+            out << ", \"ph\": \"C\", \"pid\": 1, \"tid\": " << track.threadId << ", \"ts\": ";
+            writeMicroseconds(out, eventStart - startTime);
+            out << ", \"args\": {\"value\": " << value << "}}";
+        }
+    }
+}
+
+}
+
+void Trace::start(std::size_t eventsPerThread)
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.isRecording = false;
+    registry.eventsPerThread = eventsPerThread;
+    registry.exitedThreads.clear();
+    registry.numberOfExitedEvents = 0;
+    registry.numberOfExitedEventsRecorded = 0;
+    for (std::set<ThreadBuffer*>::const_iterator it = registry.threads.begin(); it != registry.threads.end(); ++it)
+    {
+        std::lock_guard<std::mutex> threadLock((*it)->mutex);
+        (*it)->track.events.assign(eventsPerThread, TraceEvent());
+        (*it)->track.written = 0;
+    }
+    registry.startTime = now();
+    registry.isRecording = (eventsPerThread > 0);
+}
+
+void Trace::stop()
+{
+    getRegistry().isRecording = false;
+}
+
+bool Trace::isRecording()
+{
+    return getRegistry().isRecording.load(std::memory_order_relaxed);
+}
+
+void Trace::setThreadName(const std::string& name)
+{
+    ThreadBuffer& threadBuffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(threadBuffer.mutex);
+    threadBuffer.track.threadName = name;
+}
+
+std::uint64_t Trace::now()
+{
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::addSpan(const char* category, const char* name, std::uint64_t startTime, std::uint64_t endTime)
+{
+    if (!isRecording())
+    {
+        return;
+    }
+    TraceEvent event;
+    event.category = category;
+    event.name = name;
+    event.startTime = startTime;
+    event.duration = (endTime > startTime) ? endTime - startTime : 0;
+    event.value = 0.0;
+    getThreadBuffer().add(event);
+}
+
+void Trace::addCounter(const char* name, double value)
+{
+    if (!isRecording())
+    {
+        return;
+    }
+    TraceEvent event;
+    event.category = nullptr;
+    event.name = name;
+    event.startTime = now();
+    event.duration = 0;
+    event.value = value;
+    getThreadBuffer().add(event);
+}
+
+void Trace::writeChromeTrace(std::ostream& out)
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    bool isFirst = true;
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (std::deque<ThreadTrack>::const_iterator it = registry.exitedThreads.begin(); it != registry.exitedThreads.end(); ++it)
+    {
+        writeTrack(out, *it, registry.startTime, isFirst);
+    }
+    for (std::set<ThreadBuffer*>::const_iterator it = registry.threads.begin(); it != registry.threads.end(); ++it)
+    {
+        std::lock_guard<std::mutex> threadLock((*it)->mutex);
+        writeTrack(out, (*it)->track, registry.startTime, isFirst);
+    }
+    out << "\n]}\n";
+}
+
+bool Trace::writeChromeTrace(const std::string& fileName)
+{
+    std::ofstream out(fileName.c_str(), std::ios::out | std::ios::trunc);
+    if (!out)
+    {
+        return false;
+    }
+    writeChromeTrace(out);
+    out.close();
+    return !out.fail();
+}
+
+std::uint64_t Trace::getNumberOfEventsRecorded()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::uint64_t total = registry.numberOfExitedEventsRecorded;
+    for (std::set<ThreadBuffer*>::const_iterator it = registry.threads.begin(); it != registry.threads.end(); ++it)
+    {
+        std::lock_guard<std::mutex> threadLock((*it)->mutex);
+        total += (*it)->track.written;
+    }
+    return total;
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Chrome trace event timeline of batch tool stages across threads
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef BEHAVETRACE_H
+#define BEHAVETRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Timeline of the stages of the batch tools, written as Chrome trace event
+// JSON that chrome://tracing and Perfetto open. Recording is off until
+// start(), while it is off a span or counter costs one atomic load.
+//
+// Every thread records into its own ring buffer, which keeps the newest
+// events once full. The tracks of exited threads keep one ring buffer's worth
+// of events between them, dropping the oldest tracks. Spans are meant for chunks, batches, queue waits and
+// flushes, not single rows. Categories and names are not copied, so they
+// must be string literals or otherwise outlive the trace.
+
+class Trace
+{
+public:
+    // Clears any earlier trace and starts recording, each thread keeps its
+    // newest eventsPerThread events
+    static void start(std::size_t eventsPerThread = 65536);
+    static void stop();
+    static bool isRecording();
+
+    // Names the calling thread's track
+    static void setThreadName(const std::string& name);
+
+    // Nanoseconds of a steady clock
+    static std::uint64_t now();
+    static void addSpan(const char* category, const char* name, std::uint64_t startTime, std::uint64_t endTime);
+    // One sample of a counter track, such as a queue depth or rows per second
+    static void addCounter(const char* name, double value);
+
+    // {"traceEvents": [...], "displayTimeUnit": "ms"}, times relative to start()
+    static void writeChromeTrace(std::ostream& out);
+    // False if the file could not be written
+    static bool writeChromeTrace(const std::string& fileName);
+    // Events recorded since start(), including ones the ring buffers dropped
+    static std::uint64_t getNumberOfEventsRecorded();
+};
+
+// Records the rest of the enclosing scope as a span if tracing was recording
+// when it began
+class TraceSpan
+{
+public:
+    TraceSpan(const char* category, const char* name)
+        : category_(category),
+        name_(name),
+        startTime_(Trace::isRecording() ? Trace::now() : 0)
+    {
+
+    }
+
+    ~TraceSpan()
+    {
+        if (startTime_ != 0)
+        {
+            Trace::addSpan(category_, name_, startTime_, Trace::now());
+        }
+    }
+
+private:
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    const char* category_;
+    const char* name_;
+    std::uint64_t startTime_;
+};
+
+#endif // BEHAVETRACE_H
@@ -1182,3 +1182,33 @@ double HeatSinkUnits::fromBaseUnits(double value, HeatSinkUnitsEnum units)
     }
     return value;
 }
+
+UnitSystem UnitSystem::english()
+{
+    UnitSystem unitSystem;
+    unitSystem.spreadRateUnits = SpeedUnits::ChainsPerHour;
+    unitSystem.windSpeedUnits = SpeedUnits::MilesPerHour;
+    unitSystem.flameLengthUnits = LengthUnits::Feet;
+    unitSystem.lengthUnits = LengthUnits::Chains;
+    unitSystem.areaUnits = AreaUnits::Acres;
+    unitSystem.firelineIntensityUnits = FirelineIntensityUnits::BtusPerFootPerSecond;
+    unitSystem.heatPerUnitAreaUnits = HeatPerUnitAreaUnits::BtusPerSquareFoot;
+    unitSystem.reactionIntensityUnits = HeatSourceAndReactionIntensityUnits::BtusPerSquareFootPerMinute;
+    unitSystem.timeUnits = TimeUnits::Minutes;
+    return unitSystem;
+}
+
+UnitSystem UnitSystem::metric()
+{
+    UnitSystem unitSystem;
+    unitSystem.spreadRateUnits = SpeedUnits::MetersPerMinute;
+    unitSystem.windSpeedUnits = SpeedUnits::KilometersPerHour;
+    unitSystem.flameLengthUnits = LengthUnits::Meters;
+    unitSystem.lengthUnits = LengthUnits::Meters;
+    unitSystem.areaUnits = AreaUnits::Hectares;
+    unitSystem.firelineIntensityUnits = FirelineIntensityUnits::KilowattsPerMeter;
+    unitSystem.heatPerUnitAreaUnits = HeatPerUnitAreaUnits::KilojoulesPerSquareMeter;
+    unitSystem.reactionIntensityUnits = HeatSourceAndReactionIntensityUnits::KilowattsPerSquareMeter;
+    unitSystem.timeUnits = TimeUnits::Minutes;
+    return unitSystem;
+}
@@ -268,4 +268,25 @@ struct TimeUnits
     static double fromBaseUnits(double value, TimeUnitsEnum units);
 };
 
+// Output units of a results snapshot such as Surface::getResults(), base units
+// unless set
+struct UnitSystem
+{
+    SpeedUnits::SpeedUnitsEnum spreadRateUnits = SpeedUnits::FeetPerMinute;
+    SpeedUnits::SpeedUnitsEnum windSpeedUnits = SpeedUnits::FeetPerMinute;
+    LengthUnits::LengthUnitsEnum flameLengthUnits = LengthUnits::Feet;
+    LengthUnits::LengthUnitsEnum lengthUnits = LengthUnits::Feet;   // spread distances and fire dimensions
+    AreaUnits::AreaUnitsEnum areaUnits = AreaUnits::SquareFeet;
+    FirelineIntensityUnits::FirelineIntensityUnitsEnum firelineIntensityUnits = FirelineIntensityUnits::BtusPerFootPerSecond;
+    HeatPerUnitAreaUnits::HeatPerUnitAreaUnitsEnum heatPerUnitAreaUnits = HeatPerUnitAreaUnits::BtusPerSquareFoot;
+    HeatSourceAndReactionIntensityUnits::HeatSourceAndReactionIntensityUnitsEnum reactionIntensityUnits =
+        HeatSourceAndReactionIntensityUnits::BtusPerSquareFootPerMinute;
+    TimeUnits::TimeUnitsEnum timeUnits = TimeUnits::Minutes;        // residence time
+
+    // ch/h, mi/h, ft, ch, ac, Btu/ft/s, Btu/ft^2, Btu/ft^2/min and min
+    static UnitSystem english();
+    // m/min, km/h, m, m, ha, kW/m, kJ/m^2, kW/m^2 and min
+    static UnitSystem metric();
+};
+
 #endif // BEHAVEUNITS_H
@@ -4,13 +4,14 @@
 #include <stdio.h>
 #include <string.h>
 
-CanopyCoefficientTable::CanopyCoefficientTable():record_
+// Indexed by crown coefficient code, fixed at compile time and shared by every table
+static constexpr CanopyCoefficientTableRecord canopyCoefficientRecords[] =
 /*.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.- */
 /*   Sp   FVS      Trees hgt > 4.5 ft.  | Hgts. <= 4.5 ft.                         */
 /*        alpha                         |                                          */
 /* Idx No code    "a" coeff. "b" coeff. | "ratio" coeff.                           */
 
-     {
+{
         { -1,    "",          0,         0,           0 },  /* Dummy record to make index same as equation code */
         {  1,  "SF",     3.9723,    0.5177,       0.473 },
         {  2,  "WF",     3.8166,    0.5229,       0.452 },
@@ -52,7 +53,26 @@ CanopyCoefficientTable::CanopyCoefficientTable():record_
         { -1,    "",          0,         0,           0 },  /* Dummy record, currently unused equation code */
         { 39,    "",      4.4215,    0.5329,      0.517 },  /* Other */
         { -1,    "",          0,         0,           0 }
-}
+};
+
+static constexpr int numberOfCanopyCoefficientRecords = (int)(sizeof(canopyCoefficientRecords) / sizeof(canopyCoefficientRecords[0]));
+
+CanopyCoefficientTable::CanopyCoefficientTable()
 {
  
 }
+
+int CanopyCoefficientTable::getNumberOfRecords() const
+{
+    return numberOfCanopyCoefficientRecords;
+}
+
+const CanopyCoefficientTableRecord& CanopyCoefficientTable::getRecord(int index) const
+{
+    if((index < 0) || (index >= numberOfCanopyCoefficientRecords))
+    {
+        // Same as the dummy records, no canopy coefficients
+        return canopyCoefficientRecords[numberOfCanopyCoefficientRecords - 1];
+    }
+    return canopyCoefficientRecords[index];
+}
@@ -32,14 +32,10 @@
 #ifndef CANOPY_COEFFICIENT_TABLE_H
 #define CANOPY_COEFFICIENT_TABLE_H
 
-#include <vector>
-
-using std::vector;
-
 struct CanopyCoefficientTableRecord
 {
     int   indexNumber_;                                 /* Spe FVS Index No.            */
-    char crownCode_[10];                             /* Crown Code,                  */
+    const char* crownCode_;                            /* Crown Code,                  */
     double coefficientA_;                                  /* Large tree coefficients      */
     double coefficientB_;
     double coefficientR_;                                  /* Small tree coefficients      */
@@ -49,7 +45,9 @@ class CanopyCoefficientTable
 {
 public:
     CanopyCoefficientTable();
-    vector<CanopyCoefficientTableRecord> record_;
+
+    int getNumberOfRecords() const;
+    const CanopyCoefficientTableRecord& getRecord(int index) const;
 };
 
 #endif // CANOPY_COEFFICIENT_TABLE_H
@@ -333,6 +333,34 @@ void Crown::calculateCrownFireActiveWindSpeed()
     crownFireActiveWindSpeed_ = uMid / 0.4;         // 20-ft wind speed (ft/min) for waf=0.4
 }
 
+CrownResults Crown::getResults(const UnitSystem& unitSystem) const
+{
+    CrownResults results;
+    const double elapsedTime = surfaceFuel_.getElapsedTime(TimeUnits::Minutes);
+    const double surfaceFireSpreadRate = surfaceFuel_.getSpreadRate(SpeedUnits::FeetPerMinute);
+
+    results.fireType = fireType_;
+    results.finalSpreadRate = SpeedUnits::fromBaseUnits(finalSpreadRate_, unitSystem.spreadRateUnits);
+    results.finalFlameLength = LengthUnits::fromBaseUnits(finalFlameLength_, unitSystem.flameLengthUnits);
+    results.finalFirelineIntensity = FirelineIntensityUnits::fromBaseUnits(finalFirelineIntesity_, unitSystem.firelineIntensityUnits);
+    results.finalHeatPerUnitArea = HeatPerUnitAreaUnits::fromBaseUnits(finalHeatPerUnitArea_, unitSystem.heatPerUnitAreaUnits);
+    results.crownFireSpreadRate = SpeedUnits::fromBaseUnits(crownFireSpreadRate_, unitSystem.spreadRateUnits);
+    results.crownFlameLength = LengthUnits::fromBaseUnits(crownFlameLength_, unitSystem.flameLengthUnits);
+    results.crownFirelineIntensity = FirelineIntensityUnits::fromBaseUnits(crownFirelineIntensity_, unitSystem.firelineIntensityUnits);
+    results.surfaceFireSpreadRate = SpeedUnits::fromBaseUnits(surfaceFireSpreadRate, unitSystem.spreadRateUnits);
+    results.surfaceFireDirectionOfMaxSpread = surfaceFuel_.getDirectionOfMaxSpread();
+    results.surfaceFireEccentricity = surfaceFuel_.getFireEccentricity();
+    results.crownFireLengthToWidthRatio = crownFireLengthToWidthRatio_;
+    results.crownFireEccentricity = crownFireSize_.getEccentricity();
+    results.criticalOpenWindSpeed = SpeedUnits::fromBaseUnits(crownFireActiveWindSpeed_, unitSystem.windSpeedUnits);
+    results.crownFractionBurned = crownFractionBurned_;
+    results.crownFireSpreadDistance = LengthUnits::fromBaseUnits(crownFireSpreadRate_ * elapsedTime, unitSystem.lengthUnits);
+    results.surfaceFireSpreadDistance = LengthUnits::fromBaseUnits(surfaceFireSpreadRate * elapsedTime, unitSystem.lengthUnits);
+    results.crownFirePerimeter = crownFireSize_.getFirePerimeter(true, unitSystem.lengthUnits, elapsedTime, TimeUnits::Minutes);
+    results.crownFireArea = crownFireSize_.getFireArea(true, unitSystem.areaUnits, elapsedTime, TimeUnits::Minutes);
+    return results;
+}
+
 double Crown::getCrownFireSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
 {
     return SpeedUnits::fromBaseUnits(crownFireSpreadRate_, spreadRateUnits);
@@ -351,6 +379,16 @@ double Crown::getSurfaceFireSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnit
     return surfaceFuel_.getSpreadRate(spreadRateUnits);
 }
 
+double Crown::getSurfaceFireDirectionOfMaxSpread() const
+{
+    return surfaceFuel_.getDirectionOfMaxSpread();
+}
+
+double Crown::getSurfaceFireEccentricity() const
+{
+    return surfaceFuel_.getFireEccentricity();
+}
+
 double Crown::getSurfaceFireSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const
 {
     return surfaceFuel_.getSpreadDistance(lengthUnits, elapsedTime, timeUnits);
@@ -396,6 +434,11 @@ double Crown::getCrownFireLengthToWidthRatio() const
     return crownFireLengthToWidthRatio_;
 }
 
+double Crown::getCrownFireEccentricity() const
+{
+    return crownFireSize_.getEccentricity();
+}
+
 double Crown::getCrownFireArea(AreaUnits::AreaUnitsEnum areaUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const
 {
     return crownFireSize_.getFireArea(true, areaUnits, elapsedTime, timeUnits);
@@ -885,6 +928,11 @@ void Crown::setWindAdjustmentFactorCalculationMethod(WindAdjustmentFactorCalcula
     surfaceFuel_.setWindAdjustmentFactorCalculationMethod(windAdjustmentFactorCalculationMethod);
 }
 
+const SurfaceInputs& Crown::getSurfaceInputs() const
+{
+    return surfaceFuel_.getSurfaceInputs();
+}
+
 int Crown::getFuelModelNumber() const
 {
     return surfaceFuel_.getFuelModelNumber();
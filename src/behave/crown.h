@@ -52,6 +52,31 @@ struct FireType
     };
 };
 
+// Outputs of the last crown run in the units of a UnitSystem. Spread distances
+// and fire size are those at the elapsed time input
+struct CrownResults
+{
+    FireType::FireTypeEnum fireType;
+    double finalSpreadRate;
+    double finalFlameLength;
+    double finalFirelineIntensity;
+    double finalHeatPerUnitArea;
+    double crownFireSpreadRate;
+    double crownFlameLength;
+    double crownFirelineIntensity;
+    double surfaceFireSpreadRate;
+    double surfaceFireDirectionOfMaxSpread;     // degrees
+    double surfaceFireEccentricity;
+    double crownFireLengthToWidthRatio;
+    double crownFireEccentricity;
+    double criticalOpenWindSpeed;
+    double crownFractionBurned;
+    double crownFireSpreadDistance;
+    double surfaceFireSpreadDistance;
+    double crownFirePerimeter;
+    double crownFireArea;
+};
+
 class Crown
 {
 public:
@@ -81,6 +106,9 @@ public:
     void setCanopyBulkDensity(double canopyBulkDensity, DensityUnits::DensityUnitsEnum densityUnits);
     void setMoistureFoliar(double foliarMoisture, FractionUnits::FractionUnitsEnum moistureUnits);
 
+    // Every output of CrownResults in one call, instead of one getter per output
+    CrownResults getResults(const UnitSystem& unitSystem) const;
+
     // Crown Module Getters
     double getCanopyBaseHeight(LengthUnits::LengthUnitsEnum canopyHeightUnits) const;
     double getCanopyBulkDensity(DensityUnits::DensityUnitsEnum canopyBulkDensityUnits) const;
@@ -88,6 +116,8 @@ public:
     double getCrownFireSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
     double getCrownFireSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const;
     double getSurfaceFireSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
+    double getSurfaceFireDirectionOfMaxSpread() const;
+    double getSurfaceFireEccentricity() const;
     double getSurfaceFireSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const;
     double getCrownFirelineIntensity(FirelineIntensityUnits::FirelineIntensityUnitsEnum firelineIntensityUnits) const;
     double getCrownFlameLength(LengthUnits::LengthUnitsEnum flameLengthUnits) const;
@@ -99,6 +129,7 @@ public:
     double getFinalFlameLength(LengthUnits::LengthUnitsEnum flameLengthUnits) const;
 
     double getCrownFireLengthToWidthRatio() const;
+    double getCrownFireEccentricity() const;
     double getCrownFireArea(AreaUnits::AreaUnitsEnum areaUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const;
     double getCrownFirePerimeter(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const;
     double getCriticalOpenWindSpeed(SpeedUnits::SpeedUnitsEnum speedUnits) const;
@@ -156,6 +187,7 @@ public:
     void setWindAdjustmentFactorCalculationMethod(WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum windAdjustmentFactorCalculationMethod);
 
     // SurfaceInputs getters
+    const SurfaceInputs& getSurfaceInputs() const;
     int getFuelModelNumber() const;
     double getMoistureOneHour(FractionUnits::FractionUnitsEnum moistureUnits) const;
     double getMoistureTenHour(FractionUnits::FractionUnitsEnum moistureUnits) const;
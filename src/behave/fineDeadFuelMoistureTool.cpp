@@ -1,5 +1,8 @@
 #include "fineDeadFuelMoistureTool.h"
 
+#include <algorithm>
+#include <cmath>
+
 FineDeadFuelMoistureTool::FineDeadFuelMoistureTool()
 {
     referenceMoisture_ = -1;
@@ -250,6 +253,151 @@ void FineDeadFuelMoistureTool::calculateByIndex(const int aspectIndex, const int
     }
 }
 
+void FineDeadFuelMoistureTool::calculateForWeatherSeries(const FDFMToolWeatherSeries& series, double* moistureOneHour,
+    FractionUnits::FractionUnitsEnum moistureUnits, int* referenceMoisture, int* correctionMoisture) const
+{
+    const int numDryBulbValues = static_cast<int>(dryBulbTemperatures_.size());
+    const int numRelativeHumidityValues = static_cast<int>(relativeHumidities_.size());
+    const int numCorrectionColumns = static_cast<int>(correctionMoistures_[0].size());
+
+    // Flattened copies of both tables for the lookups below
+    std::vector<int> referenceTable(numDryBulbValues * numRelativeHumidityValues);
+    for (int i = 0; i < numDryBulbValues; i++)
+    {
+        std::copy(referenceMostures_[i].begin(), referenceMostures_[i].end(), referenceTable.begin() + i * numRelativeHumidityValues);
+    }
+    std::vector<int> correctionTable(correctionMoistures_.size() * numCorrectionColumns);
+    for (std::size_t i = 0; i < correctionMoistures_.size(); i++)
+    {
+        std::copy(correctionMoistures_[i].begin(), correctionMoistures_[i].end(), correctionTable.begin() + i * numCorrectionColumns);
+    }
+
+    // The part of the correction table row and column fixed by each site, -1 for an invalid site
+    const std::size_t numberOfSites = std::max<std::size_t>(series.numberOfSites, 1);
+    std::vector<int> siteCorrectionRow(numberOfSites);
+    std::vector<int> siteCorrectionColumn(numberOfSites);
+    for (std::size_t site = 0; site < numberOfSites; site++)
+    {
+        int aspectIndex = (series.aspectIndex != nullptr) ? series.aspectIndex[site] : series.batchAspectIndex;
+        int elevationIndex = (series.elevationIndex != nullptr) ? series.elevationIndex[site] : series.batchElevationIndex;
+        int shadingIndex = (series.shadingIndex != nullptr) ? series.shadingIndex[site] : series.batchShadingIndex;
+        int slopeIndex = (series.slopeIndex != nullptr) ? series.slopeIndex[site] : series.batchSlopeIndex;
+        bool isValidSite = aspectIndex >= 0 && aspectIndex < static_cast<int>(aspects_.size()) &&
+            elevationIndex >= 0 && elevationIndex < static_cast<int>(elevations_.size()) &&
+            shadingIndex >= 0 && shadingIndex < static_cast<int>(shadings_.size()) &&
+            slopeIndex >= 0 && slopeIndex < static_cast<int>(slopes_.size());
+        siteCorrectionRow[site] = -1;
+        siteCorrectionColumn[site] = -1;
+        if (isValidSite)
+        {
+            siteCorrectionRow[site] = (shadingIndex == 0)
+                ? (slopeIndex + 2 * aspectIndex)
+                : (8 + aspectIndex);
+            siteCorrectionColumn[site] = elevationIndex;
+        }
+    }
+
+    const double percentToMoistureUnits = FractionUnits::fromBaseUnits(0.01, moistureUnits);
+
+    // Rows are binned and looked up a block at a time, each step one pass over the block
+    const std::size_t blockSize = 512;
+    int referenceIndex[blockSize];
+    int correctionIndex[blockSize];
+    for (std::size_t begin = 0; begin < series.numberOfRows; begin += blockSize)
+    {
+        const std::size_t size = std::min(blockSize, series.numberOfRows - begin);
+
+        // Reference table index from dry bulb temperature and relative humidity
+        for (std::size_t i = 0; i < size; i++)
+        {
+            int dryBulbIndex = getDryBulbTemperatureIndexForValue(series.dryBulbTemperature[begin + i], series.temperatureUnits);
+            int relativeHumidityIndex = getRelativeHumidityIndexForValue(series.relativeHumidity[begin + i]);
+            referenceIndex[i] = dryBulbIndex * numRelativeHumidityValues + relativeHumidityIndex;
+        }
+
+        // Correction table index from site, month and time of day
+        for (std::size_t i = 0; i < size; i++)
+        {
+            int site = (series.site != nullptr) ? series.site[begin + i] : 0;
+            int monthIndex = getMonthIndexForMonth(series.month[begin + i]);
+            int timeOfDayIndex = getTimeOfDayIndexForHour(series.hourOfDay[begin + i]);
+            bool isValidRow = site >= 0 && site < static_cast<int>(numberOfSites) &&
+                siteCorrectionRow[site] >= 0 && monthIndex >= 0 && timeOfDayIndex >= 0;
+            correctionIndex[i] = isValidRow
+                ? (siteCorrectionRow[site] + 12 * monthIndex) * numCorrectionColumns
+                    + siteCorrectionColumn[site] + 3 * timeOfDayIndex
+                : -1;
+        }
+
+        // Corrected fuel moisture
+        for (std::size_t i = 0; i < size; i++)
+        {
+            int reference = referenceTable[referenceIndex[i]];
+            int correction = (correctionIndex[i] >= 0) ? correctionTable[correctionIndex[i]] : -1;
+            moistureOneHour[begin + i] = (correctionIndex[i] >= 0)
+                ? (reference + correction) * percentToMoistureUnits
+                : -1.0;
+            if (referenceMoisture != nullptr)
+            {
+                referenceMoisture[begin + i] = (correctionIndex[i] >= 0) ? reference : -1;
+            }
+            if (correctionMoisture != nullptr)
+            {
+                correctionMoisture[begin + i] = correction;
+            }
+        }
+    }
+}
+
+int FineDeadFuelMoistureTool::getDryBulbTemperatureIndexForValue(double dryBulbTemperature,
+    TemperatureUnits::TemperatureUnitsEnum temperatureUnits)
+{
+    double temperatureInFahrenheit = (temperatureUnits == TemperatureUnits::Fahrenheit)
+        ? dryBulbTemperature
+        : TemperatureUnits::toBaseUnits(dryBulbTemperature, temperatureUnits);
+    // 20 oF ranges starting at 10 oF
+    int index = static_cast<int>(std::floor((temperatureInFahrenheit - 10.0) / 20.0));
+    return std::min(std::max(index, 0), static_cast<int>(FDFMToolDryBulbIndex::GREATER_THAN_ONE_HUNDRED_NINE_DEGREES_F));
+}
+
+int FineDeadFuelMoistureTool::getRelativeHumidityIndexForValue(double relativeHumidity)
+{
+    // 5 percent ranges
+    int index = static_cast<int>(std::floor(relativeHumidity / 5.0));
+    return std::min(std::max(index, 0), static_cast<int>(FDFMToolRHIndex::ONE_HUNDRED_PERCENT));
+}
+
+int FineDeadFuelMoistureTool::getMonthIndexForMonth(int month)
+{
+    static const int monthIndices[12] =
+    {
+        FDFMToolMonthIndex::NOV_DEC_JAN,                // Jan
+        FDFMToolMonthIndex::FEB_MAR_APR_AUG_SEP_OCT,    // Feb
+        FDFMToolMonthIndex::FEB_MAR_APR_AUG_SEP_OCT,    // Mar
+        FDFMToolMonthIndex::FEB_MAR_APR_AUG_SEP_OCT,    // Apr
+        FDFMToolMonthIndex::MAY_JUNE_JULY,              // May
+        FDFMToolMonthIndex::MAY_JUNE_JULY,              // Jun
+        FDFMToolMonthIndex::MAY_JUNE_JULY,              // Jul
+        FDFMToolMonthIndex::FEB_MAR_APR_AUG_SEP_OCT,    // Aug
+        FDFMToolMonthIndex::FEB_MAR_APR_AUG_SEP_OCT,    // Sep
+        FDFMToolMonthIndex::FEB_MAR_APR_AUG_SEP_OCT,    // Oct
+        FDFMToolMonthIndex::NOV_DEC_JAN,                // Nov
+        FDFMToolMonthIndex::NOV_DEC_JAN                 // Dec
+    };
+    return (month >= 1 && month <= 12) ? monthIndices[month - 1] : -1;
+}
+
+int FineDeadFuelMoistureTool::getTimeOfDayIndexForHour(int hourOfDay)
+{
+    if (hourOfDay < 0 || hourOfDay > 23)
+    {
+        return -1;
+    }
+    // 2 hour ranges from 08:00, the table has no night time values
+    int index = (hourOfDay - 8) / 2;
+    return std::min(std::max(index, 0), static_cast<int>(FDFMToolTimeOfDayIndex::EIGHTTEEN_HUNDRED_HOURS_TO_SUNSET));
+}
+
 int FineDeadFuelMoistureTool::getReferenceMoisture() const
 {
     return referenceMoisture_;
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
+#include "behaveUnits.h"
+
 struct FDFMToolAspectIndex
 {
     enum AspectIndexEnum
@@ -106,6 +109,32 @@ struct FDFMToolTimeOfDayIndex
     };
 };
 
+// Hourly weather for many sites, one row per site and hour. The columns are
+// read in place, never copied. Site columns are indexed by each row's site and
+// left as nullptr to use the batch wide value for every site
+struct FDFMToolWeatherSeries
+{
+    std::size_t numberOfRows = 0;
+    const double* dryBulbTemperature = nullptr;
+    const double* relativeHumidity = nullptr;   // percent
+    const int* hourOfDay = nullptr;             // local time, 0 - 23
+    const int* month = nullptr;                 // 1 - 12
+    const int* site = nullptr;                  // optional, every row is site 0 if nullptr
+
+    std::size_t numberOfSites = 1;
+    const int* aspectIndex = nullptr;           // FDFMToolAspectIndex values
+    const int* elevationIndex = nullptr;        // FDFMToolElevationIndex values
+    const int* shadingIndex = nullptr;          // FDFMToolShadingIndex values
+    const int* slopeIndex = nullptr;            // FDFMToolSlopeIndex values
+
+    FDFMToolAspectIndex::AspectIndexEnum batchAspectIndex = FDFMToolAspectIndex::NORTH;
+    FDFMToolElevationIndex::ElevationIndexEnum batchElevationIndex = FDFMToolElevationIndex::LEVEL_WITHIN_1000_FT;
+    FDFMToolShadingIndex::ShadingIndexEnum batchShadingIndex = FDFMToolShadingIndex::EXPOSED;
+    FDFMToolSlopeIndex::SlopeIndexEnum batchSlopeIndex = FDFMToolSlopeIndex::ZERO_TO_THIRTY_PERCENT;
+
+    TemperatureUnits::TemperatureUnitsEnum temperatureUnits = TemperatureUnits::Fahrenheit;
+};
+
 class FineDeadFuelMoistureTool
 {
 public:
@@ -128,6 +157,23 @@ public:
         const int relativeHumidityIndex, const int shadingIndex,
         const int slopeIndex, const int timeOfDayIndex);
 
+    // Fine dead fuel moisture for every row of an hourly weather series, written
+    // to moistureOneHour in moistureUnits, ready for a surface run. The weather
+    // is binned into the indices above a column at a time, then both tables are
+    // looked up for all rows. Rows with a month, hour or site index out of range
+    // get -1. Reference and correction moistures are also written if given
+    void calculateForWeatherSeries(const FDFMToolWeatherSeries& series, double* moistureOneHour,
+        FractionUnits::FractionUnitsEnum moistureUnits, int* referenceMoisture = nullptr,
+        int* correctionMoisture = nullptr) const;
+
+    // Index of a measured value. Temperature and humidity are clamped to the table,
+    // hours before 10:00 use the first time of day and hours from 18:00 the last,
+    // a month or hour out of range gives -1
+    static int getDryBulbTemperatureIndexForValue(double dryBulbTemperature, TemperatureUnits::TemperatureUnitsEnum temperatureUnits);
+    static int getRelativeHumidityIndexForValue(double relativeHumidity);
+    static int getMonthIndexForMonth(int month);
+    static int getTimeOfDayIndexForHour(int hourOfDay);
+
     // Getters for the maximum valid values for various indices, applies to enums and string vectors 
     int getAspectIndexSize() const;
     int getDryBulbTemperatureIndexSize() const;
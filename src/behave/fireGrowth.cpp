@@ -0,0 +1,453 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Minimum travel time fire growth over a raster landscape
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "fireGrowth.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <utility>
+
+#include "surface.h"
+
+namespace
+{
+// Adjacent neighbors first, clockwise from north, then the knight's moves
+const int neighborRowOffsets[FireGrowth::NumberOfNeighbors] = { -1, -1, 0, 1, 1, 1, 0, -1, -2, -1, 1, 2, 2, 1, -1, -2 };
+const int neighborColumnOffsets[FireGrowth::NumberOfNeighbors] = { 0, 1, 1, 1, 0, -1, -1, -1, 1, 2, 2, 1, -1, -2, -2, -1 };
+
+template<typename Run>
+void applyCellInputs(const FireGrowthLandscape& landscape, std::size_t cell, Run& run)
+{
+    if (landscape.fuelModelNumber)
+    {
+        run.setFuelModelNumber(landscape.fuelModelNumber[cell]);
+    }
+    if (landscape.slope)
+    {
+        run.setSlope(landscape.slope[cell], landscape.slopeUnits);
+    }
+    if (landscape.aspect)
+    {
+        run.setAspect(landscape.aspect[cell]);
+    }
+    if (landscape.windSpeed)
+    {
+        run.setWindSpeed(landscape.windSpeed[cell], landscape.windSpeedUnits, landscape.windHeightInputMode);
+    }
+    if (landscape.windDirection)
+    {
+        run.setWindDirection(landscape.windDirection[cell]);
+    }
+    if (landscape.canopyCover)
+    {
+        run.setCanopyCover(landscape.canopyCover[cell], landscape.coverUnits);
+    }
+    if (landscape.canopyHeight)
+    {
+        run.setCanopyHeight(landscape.canopyHeight[cell], landscape.canopyHeightUnits);
+    }
+    if (landscape.crownRatio)
+    {
+        run.setCrownRatio(landscape.crownRatio[cell]);
+    }
+}
+}
+
+FireGrowth::FireGrowth()
+    : numberOfThreads_(1),
+    numberOfBurnedCells_(0)
+{
+
+}
+
+void FireGrowth::setLandscape(const FireGrowthLandscape& landscape)
+{
+    landscape_ = landscape;
+    if (landscape_.numberOfRows < 0)
+    {
+        landscape_.numberOfRows = 0;
+    }
+    if (landscape_.numberOfColumns < 0)
+    {
+        landscape_.numberOfColumns = 0;
+    }
+    clearSpreadRates();
+    ignitionTimes_.assign((std::size_t)landscape_.numberOfRows * landscape_.numberOfColumns, -1.0);
+    arrivalTimes_.assign(ignitionTimes_.size(), -1.0);
+    numberOfBurnedCells_ = 0;
+}
+
+void FireGrowth::setNumberOfThreads(int numberOfThreads)
+{
+    numberOfThreads_ = (numberOfThreads > 1) ? numberOfThreads : 1;
+}
+
+void FireGrowth::calculateSpreadRates(const Surface& surface)
+{
+    const FireGrowthLandscape& landscape = landscape_;
+    calculateCellFires(surface, [&landscape](std::size_t cell, Surface& run, CellFire& cellFire)
+    {
+        applyCellInputs(landscape, cell, run);
+        if (!run.isFuelModelDefined(run.getFuelModelNumber()))
+        {
+            return;
+        }
+        run.doSurfaceRunInDirectionOfMaxSpread();
+        cellFire.spreadRate = run.getSpreadRate(SpeedUnits::FeetPerMinute);
+        cellFire.eccentricity = run.getFireEccentricity();
+        cellFire.directionOfMaxSpread = run.getDirectionOfMaxSpread();
+    });
+}
+
+void FireGrowth::calculateSpreadRates(const Crown& crown, FireGrowthCrownMethod::FireGrowthCrownMethodEnum crownMethod)
+{
+    const FireGrowthLandscape& landscape = landscape_;
+    calculateCellFires(crown, [&landscape, crownMethod](std::size_t cell, Crown& run, CellFire& cellFire)
+    {
+        applyCellInputs(landscape, cell, run);
+        if (landscape.canopyBaseHeight)
+        {
+            run.setCanopyBaseHeight(landscape.canopyBaseHeight[cell], landscape.canopyHeightUnits);
+        }
+        if (landscape.canopyBulkDensity)
+        {
+            run.setCanopyBulkDensity(landscape.canopyBulkDensity[cell], landscape.densityUnits);
+        }
+        if (!run.isFuelModelDefined(run.getFuelModelNumber()))
+        {
+            return;
+        }
+
+        if (crownMethod == FireGrowthCrownMethod::Rothermel)
+        {
+            run.doCrownRunRothermel();
+        }
+        else if (crownMethod == FireGrowthCrownMethod::ScottAndReinhardt)
+        {
+            run.doCrownRunScottAndReinhardt();
+        }
+        else
+        {
+            // Crown always runs its surface fire first, so its crown fire is
+            // computed and ignored
+            run.doCrownRunRothermel();
+            cellFire.spreadRate = run.getSurfaceFireSpreadRate(SpeedUnits::FeetPerMinute);
+            cellFire.eccentricity = run.getSurfaceFireEccentricity();
+            cellFire.directionOfMaxSpread = run.getSurfaceFireDirectionOfMaxSpread();
+            return;
+        }
+
+        // An active crown fire spreads with the crown fire's ellipse, in the
+        // surface fire's direction of max spread
+        cellFire.fireType = run.getFireType();
+        cellFire.spreadRate = run.getFinalSpreadRate(SpeedUnits::FeetPerMinute);
+        cellFire.eccentricity = (cellFire.fireType == FireType::Crowning)
+            ? run.getCrownFireEccentricity()
+            : run.getSurfaceFireEccentricity();
+        cellFire.directionOfMaxSpread = run.getSurfaceFireDirectionOfMaxSpread();
+    });
+}
+
+template<typename Run, typename RunCell>
+void FireGrowth::calculateCellFires(const Run& run, RunCell runCell)
+{
+    std::size_t numberOfCells = ignitionTimes_.size();
+    CellFire noFire;
+    noFire.spreadRate = 0.0;
+    noFire.eccentricity = 0.0;
+    noFire.directionOfMaxSpread = 0.0;
+    noFire.fireType = FireType::Surface;
+    cellFires_.assign(numberOfCells, noFire);
+    neighborSpreadRates_.assign(numberOfCells * NumberOfNeighbors, 0.0f);
+    arrivalTimes_.assign(numberOfCells, -1.0);
+    numberOfBurnedCells_ = 0;
+
+    // Each thread runs its own copy over a contiguous block of cells, so the
+    // spread rates do not depend on the number of threads
+    int numberOfThreads = numberOfThreads_;
+    if ((std::size_t)numberOfThreads > numberOfCells)
+    {
+        numberOfThreads = (numberOfCells > 0) ? (int)numberOfCells : 1;
+    }
+    auto runCells = [this, &run, &runCell, numberOfCells, numberOfThreads](int thread)
+    {
+        Run threadRun(run);
+        threadRun.setWindAndSpreadOrientationMode(WindAndSpreadOrientationMode::RelativeToNorth);
+        std::size_t firstCell = numberOfCells * thread / numberOfThreads;
+        std::size_t lastCell = numberOfCells * (thread + 1) / numberOfThreads;
+        for (std::size_t cell = firstCell; cell < lastCell; cell++)
+        {
+            runCell(cell, threadRun, cellFires_[cell]);
+            fillSpreadRates(cell, cellFires_[cell]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int thread = 1; thread < numberOfThreads; thread++)
+    {
+        threads.push_back(std::thread(runCells, thread));
+    }
+    runCells(0);
+    for (std::size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+}
+
+void FireGrowth::fillSpreadRates(std::size_t cell, const CellFire& cellFire)
+{
+    // Spread rate from the ignition point at the rear focus of the fire ellipse
+    const double pi = 3.14159265358979323846;
+    float* spreadRates = &neighborSpreadRates_[cell * NumberOfNeighbors];
+    for (int neighbor = 0; neighbor < NumberOfNeighbors; neighbor++)
+    {
+        double spreadRate = 0.0;
+        if (cellFire.spreadRate > 0.0)
+        {
+            double direction = atan2((double)neighborColumnOffsets[neighbor], (double)-neighborRowOffsets[neighbor]) * 180.0 / pi;
+            double beta = fabs(direction - cellFire.directionOfMaxSpread);
+            beta = fmod(beta, 360.0);
+            if (beta > 180.0)
+            {
+                beta = 360.0 - beta;
+            }
+            double eccentricity = cellFire.eccentricity;
+            spreadRate = cellFire.spreadRate * (1.0 - eccentricity) / (1.0 - eccentricity * cos(beta * pi / 180.0));
+        }
+        spreadRates[neighbor] = (float)spreadRate;
+    }
+}
+
+void FireGrowth::clearSpreadRates()
+{
+    cellFires_.clear();
+    neighborSpreadRates_.clear();
+}
+
+void FireGrowth::clearIgnitions()
+{
+    ignitionTimes_.assign(ignitionTimes_.size(), -1.0);
+}
+
+void FireGrowth::addIgnitionPoint(int row, int column, double ignitionTime, TimeUnits::TimeUnitsEnum timeUnits)
+{
+    if (row < 0 || row >= landscape_.numberOfRows || column < 0 || column >= landscape_.numberOfColumns)
+    {
+        return;
+    }
+    ignitionTime = TimeUnits::toBaseUnits(ignitionTime, timeUnits);
+    if (ignitionTime < 0.0)
+    {
+        ignitionTime = 0.0;
+    }
+    double& cellIgnitionTime = ignitionTimes_[getCellIndex(row, column)];
+    if (cellIgnitionTime < 0.0 || ignitionTime < cellIgnitionTime)
+    {
+        cellIgnitionTime = ignitionTime;
+    }
+}
+
+void FireGrowth::addIgnitionPerimeter(std::size_t numberOfVertices, const double* rows, const double* columns,
+    double ignitionTime, TimeUnits::TimeUnitsEnum timeUnits)
+{
+    for (std::size_t vertex = 0; vertex < numberOfVertices; vertex++)
+    {
+        std::size_t nextVertex = (vertex + 1) % numberOfVertices;
+        double rowChange = rows[nextVertex] - rows[vertex];
+        double columnChange = columns[nextVertex] - columns[vertex];
+        // Two samples per cell crossed never skip a cell along the edge
+        int numberOfSteps = (int)ceil(2.0 * std::max(fabs(rowChange), fabs(columnChange))) + 1;
+        for (int step = 0; step <= numberOfSteps; step++)
+        {
+            double fraction = (double)step / numberOfSteps;
+            int row = (int)floor(rows[vertex] + fraction * rowChange + 0.5);
+            int column = (int)floor(columns[vertex] + fraction * columnChange + 0.5);
+            addIgnitionPoint(row, column, ignitionTime, timeUnits);
+        }
+    }
+}
+
+void FireGrowth::calculateArrivalTimes()
+{
+    calculateArrivalTimes(std::numeric_limits<double>::infinity(), TimeUnits::Minutes);
+}
+
+void FireGrowth::calculateArrivalTimes(double maximumTime, TimeUnits::TimeUnitsEnum timeUnits)
+{
+    maximumTime = TimeUnits::toBaseUnits(maximumTime, timeUnits);
+    std::size_t numberOfCells = ignitionTimes_.size();
+    arrivalTimes_.assign(numberOfCells, -1.0);
+    numberOfBurnedCells_ = 0;
+    if (!hasSpreadRates())
+    {
+        return;
+    }
+
+    // Half of the distance to each neighbor is burned at the cell's spread rate
+    // and half at the neighbor's
+    double cellSize = LengthUnits::toBaseUnits(landscape_.cellSize, landscape_.cellSizeUnits);
+    double halfDistances[NumberOfNeighbors];
+    for (int neighbor = 0; neighbor < NumberOfNeighbors; neighbor++)
+    {
+        double rowOffset = neighborRowOffsets[neighbor];
+        double columnOffset = neighborColumnOffsets[neighbor];
+        halfDistances[neighbor] = 0.5 * cellSize * sqrt(rowOffset * rowOffset + columnOffset * columnOffset);
+    }
+
+    // Dijkstra's search with a binary heap, a cell may be queued more than once
+    // and only its earliest entry is used
+    typedef std::pair<double, std::size_t> FrontCell;
+    std::priority_queue<FrontCell, std::vector<FrontCell>, std::greater<FrontCell> > front;
+    std::vector<double> tentativeTimes(numberOfCells, std::numeric_limits<double>::infinity());
+    for (std::size_t cell = 0; cell < numberOfCells; cell++)
+    {
+        if (ignitionTimes_[cell] >= 0.0)
+        {
+            tentativeTimes[cell] = ignitionTimes_[cell];
+            front.push(FrontCell(ignitionTimes_[cell], cell));
+        }
+    }
+
+    int numberOfRows = landscape_.numberOfRows;
+    int numberOfColumns = landscape_.numberOfColumns;
+    while (!front.empty())
+    {
+        FrontCell frontCell = front.top();
+        front.pop();
+        double time = frontCell.first;
+        std::size_t cell = frontCell.second;
+        if (time > maximumTime)
+        {
+            break;
+        }
+        if (arrivalTimes_[cell] >= 0.0)
+        {
+            continue;
+        }
+        arrivalTimes_[cell] = time;
+        numberOfBurnedCells_++;
+
+        int row = (int)(cell / numberOfColumns);
+        int column = (int)(cell % numberOfColumns);
+        const float* spreadRates = &neighborSpreadRates_[cell * NumberOfNeighbors];
+        for (int neighbor = 0; neighbor < NumberOfNeighbors; neighbor++)
+        {
+            int neighborRow = row + neighborRowOffsets[neighbor];
+            int neighborColumn = column + neighborColumnOffsets[neighbor];
+            if (neighborRow < 0 || neighborRow >= numberOfRows || neighborColumn < 0 || neighborColumn >= numberOfColumns)
+            {
+                continue;
+            }
+            std::size_t neighborCell = getCellIndex(neighborRow, neighborColumn);
+            double spreadRateOut = spreadRates[neighbor];
+            double spreadRateIn = neighborSpreadRates_[neighborCell * NumberOfNeighbors + neighbor];
+            if (arrivalTimes_[neighborCell] >= 0.0 || spreadRateOut <= 0.0 || spreadRateIn <= 0.0)
+            {
+                continue;
+            }
+            double neighborTime = time + halfDistances[neighbor] / spreadRateOut + halfDistances[neighbor] / spreadRateIn;
+            if (neighborTime < tentativeTimes[neighborCell])
+            {
+                tentativeTimes[neighborCell] = neighborTime;
+                front.push(FrontCell(neighborTime, neighborCell));
+            }
+        }
+    }
+}
+
+const FireGrowthLandscape& FireGrowth::getLandscape() const
+{
+    return landscape_;
+}
+
+int FireGrowth::getNumberOfThreads() const
+{
+    return numberOfThreads_;
+}
+
+bool FireGrowth::hasSpreadRates() const
+{
+    return !cellFires_.empty();
+}
+
+double FireGrowth::getArrivalTime(int row, int column, TimeUnits::TimeUnitsEnum timeUnits) const
+{
+    double arrivalTime = arrivalTimes_[getCellIndex(row, column)];
+    return (arrivalTime < 0.0) ? -1.0 : TimeUnits::fromBaseUnits(arrivalTime, timeUnits);
+}
+
+void FireGrowth::getArrivalTimes(double* arrivalTimes, TimeUnits::TimeUnitsEnum timeUnits) const
+{
+    for (std::size_t cell = 0; cell < arrivalTimes_.size(); cell++)
+    {
+        arrivalTimes[cell] = (arrivalTimes_[cell] < 0.0) ? -1.0 : TimeUnits::fromBaseUnits(arrivalTimes_[cell], timeUnits);
+    }
+}
+
+std::size_t FireGrowth::getNumberOfBurnedCells() const
+{
+    return numberOfBurnedCells_;
+}
+
+double FireGrowth::getSpreadRate(int row, int column, SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
+{
+    return SpeedUnits::fromBaseUnits(cellFires_[getCellIndex(row, column)].spreadRate, spreadRateUnits);
+}
+
+double FireGrowth::getSpreadRateToNeighbor(int row, int column, int neighbor, SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
+{
+    return SpeedUnits::fromBaseUnits(neighborSpreadRates_[getCellIndex(row, column) * NumberOfNeighbors + neighbor], spreadRateUnits);
+}
+
+double FireGrowth::getEccentricity(int row, int column) const
+{
+    return cellFires_[getCellIndex(row, column)].eccentricity;
+}
+
+double FireGrowth::getDirectionOfMaxSpread(int row, int column) const
+{
+    return cellFires_[getCellIndex(row, column)].directionOfMaxSpread;
+}
+
+FireType::FireTypeEnum FireGrowth::getFireType(int row, int column) const
+{
+    return cellFires_[getCellIndex(row, column)].fireType;
+}
+
+void FireGrowth::getNeighborOffset(int neighbor, int& rowOffset, int& columnOffset)
+{
+    rowOffset = neighborRowOffsets[neighbor];
+    columnOffset = neighborColumnOffsets[neighbor];
+}
+
+std::size_t FireGrowth::getCellIndex(int row, int column) const
+{
+    return (std::size_t)row * landscape_.numberOfColumns + column;
+}
@@ -0,0 +1,152 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Minimum travel time fire growth over a raster landscape
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef FIREGROWTH_H
+#define FIREGROWTH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "behaveUnits.h"
+#include "crown.h"
+
+class Surface;
+
+// Per cell inputs of a raster landscape stored row major from its north west
+// corner, so rows run south and columns run east. Each column holds
+// numberOfRows * numberOfColumns values, a null column uses the value already
+// set on the Surface or Crown the spread rates are calculated from.
+struct FireGrowthLandscape
+{
+    int numberOfRows = 0;
+    int numberOfColumns = 0;
+    double cellSize = 30.0;
+    LengthUnits::LengthUnitsEnum cellSizeUnits = LengthUnits::Meters;
+
+    const int* fuelModelNumber = nullptr;       // cells of undefined fuel models never burn
+    const double* slope = nullptr;
+    SlopeUnits::SlopeUnitsEnum slopeUnits = SlopeUnits::Degrees;
+    const double* aspect = nullptr;
+    const double* windSpeed = nullptr;
+    SpeedUnits::SpeedUnitsEnum windSpeedUnits = SpeedUnits::MilesPerHour;
+    WindHeightInputMode::WindHeightInputModeEnum windHeightInputMode = WindHeightInputMode::TwentyFoot;
+    const double* windDirection = nullptr;      // relative to north
+    const double* canopyCover = nullptr;
+    FractionUnits::FractionUnitsEnum coverUnits = FractionUnits::Percent;
+    const double* canopyHeight = nullptr;
+    const double* canopyBaseHeight = nullptr;   // crown growth only
+    LengthUnits::LengthUnitsEnum canopyHeightUnits = LengthUnits::Feet;
+    const double* crownRatio = nullptr;
+    const double* canopyBulkDensity = nullptr;  // crown growth only
+    DensityUnits::DensityUnitsEnum densityUnits = DensityUnits::KilogramsPerCubicMeter;
+};
+
+struct FireGrowthCrownMethod
+{
+    enum FireGrowthCrownMethodEnum
+    {
+        None,               // surface fire only
+        Rothermel,
+        ScottAndReinhardt
+    };
+};
+
+// Arrival times of a fire spreading from ignition cells with the minimum travel
+// time method: every cell is a node linked to its 16 neighbors (the 8 adjacent
+// cells and the 8 a knight's move away) and the fire reaches each cell along
+// the fastest path. The spread rate out of a cell toward a neighbor is read off
+// the cell's fire ellipse, so each cell is run through Surface (and Crown) only
+// once. The spread rates are kept until the landscape changes, so any number of
+// ignitions can be grown from them.
+class FireGrowth
+{
+public:
+    static const int NumberOfNeighbors = 16;
+
+    FireGrowth();
+
+    // Clears the spread rates, ignitions and arrival times, the landscape's
+    // columns must outlive the next calculateSpreadRates()
+    void setLandscape(const FireGrowthLandscape& landscape);
+    void setNumberOfThreads(int numberOfThreads);
+
+    // Runs every cell with a copy of surface or crown in the direction of max
+    // spread, wind and spread directions are always taken relative to north
+    void calculateSpreadRates(const Surface& surface);
+    void calculateSpreadRates(const Crown& crown, FireGrowthCrownMethod::FireGrowthCrownMethodEnum crownMethod);
+
+    void clearIgnitions();
+    void addIgnitionPoint(int row, int column, double ignitionTime = 0.0, TimeUnits::TimeUnitsEnum timeUnits = TimeUnits::Minutes);
+    // Ignites every cell on the closed polygon through the vertices, in cells
+    void addIgnitionPerimeter(std::size_t numberOfVertices, const double* rows, const double* columns,
+        double ignitionTime = 0.0, TimeUnits::TimeUnitsEnum timeUnits = TimeUnits::Minutes);
+
+    // Grows the fire from the ignitions, cells not reached by maximumTime keep
+    // no arrival time
+    void calculateArrivalTimes(double maximumTime, TimeUnits::TimeUnitsEnum timeUnits);
+    void calculateArrivalTimes();
+
+    const FireGrowthLandscape& getLandscape() const;
+    int getNumberOfThreads() const;
+    bool hasSpreadRates() const;
+    // Negative for cells the fire has not reached
+    double getArrivalTime(int row, int column, TimeUnits::TimeUnitsEnum timeUnits) const;
+    // Fills numberOfRows * numberOfColumns arrival times, negative for cells not reached
+    void getArrivalTimes(double* arrivalTimes, TimeUnits::TimeUnitsEnum timeUnits) const;
+    std::size_t getNumberOfBurnedCells() const;
+    double getSpreadRate(int row, int column, SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
+    double getSpreadRateToNeighbor(int row, int column, int neighbor, SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
+    double getEccentricity(int row, int column) const;
+    double getDirectionOfMaxSpread(int row, int column) const;
+    FireType::FireTypeEnum getFireType(int row, int column) const;
+    static void getNeighborOffset(int neighbor, int& rowOffset, int& columnOffset);
+
+private:
+    struct CellFire
+    {
+        double spreadRate;          // ft/min, in the direction of max spread
+        double eccentricity;
+        double directionOfMaxSpread;
+        FireType::FireTypeEnum fireType;
+    };
+
+    // Runs runCell(cell, run, cellFire) on every cell with a copy of run per thread
+    template<typename Run, typename RunCell>
+    void calculateCellFires(const Run& run, RunCell runCell);
+    void clearSpreadRates();
+    void fillSpreadRates(std::size_t cell, const CellFire& cellFire);
+    std::size_t getCellIndex(int row, int column) const;
+
+    FireGrowthLandscape landscape_;
+    int numberOfThreads_;
+    std::vector<float> neighborSpreadRates_;    // ft/min, cells x neighbors, neighbors fastest
+    std::vector<CellFire> cellFires_;
+    std::vector<double> ignitionTimes_;         // minutes, negative for cells not ignited
+    std::vector<double> arrivalTimes_;          // minutes, negative for cells not reached
+    std::size_t numberOfBurnedCells_;
+};
+
+#endif // FIREGROWTH_H
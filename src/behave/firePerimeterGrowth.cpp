@@ -0,0 +1,466 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Elliptical wavelet propagation of a vector fire perimeter
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "firePerimeterGrowth.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "fireGrowth.h"
+#include "fireSize.h"
+#include "surface.h"
+
+FirePerimeterGrowth::FirePerimeterGrowth()
+    : numberOfRows_(0),
+    numberOfColumns_(0),
+    cellSize_(0.0),
+    numberOfThreads_(1),
+    minimumSpacing_(LengthUnits::toBaseUnits(5.0, LengthUnits::Meters)),
+    maximumSpacing_(LengthUnits::toBaseUnits(15.0, LengthUnits::Meters)),
+    elapsedTime_(0.0)
+{
+
+}
+
+void FirePerimeterGrowth::setUniformFire(const Surface& surface)
+{
+    numberOfRows_ = 0;
+    numberOfColumns_ = 0;
+    cellSize_ = 0.0;
+    wavelets_.resize(1);
+    setWavelet(wavelets_[0], surface.getSpreadRate(SpeedUnits::FeetPerMinute), surface.getFireLengthToWidthRatio(),
+        surface.getDirectionOfMaxSpread());
+}
+
+void FirePerimeterGrowth::setLandscapeFire(const FireGrowth& fireGrowth)
+{
+    const FireGrowthLandscape& landscape = fireGrowth.getLandscape();
+    numberOfRows_ = landscape.numberOfRows;
+    numberOfColumns_ = landscape.numberOfColumns;
+    cellSize_ = LengthUnits::toBaseUnits(landscape.cellSize, landscape.cellSizeUnits);
+    wavelets_.resize((std::size_t)numberOfRows_ * numberOfColumns_);
+    if (!fireGrowth.hasSpreadRates())
+    {
+        Wavelet noFire = { 0.0, 0.0, 0.0, 0.0, 1.0 };
+        std::fill(wavelets_.begin(), wavelets_.end(), noFire);
+        return;
+    }
+    for (int row = 0; row < numberOfRows_; row++)
+    {
+        for (int column = 0; column < numberOfColumns_; column++)
+        {
+            double eccentricity = fireGrowth.getEccentricity(row, column);
+            double fireLengthToWidthRatio = (eccentricity < 1.0) ? 1.0 / sqrt(1.0 - eccentricity * eccentricity) : 1.0;
+            setWavelet(wavelets_[(std::size_t)row * numberOfColumns_ + column], fireGrowth.getSpreadRate(row, column, SpeedUnits::FeetPerMinute),
+                fireLengthToWidthRatio, fireGrowth.getDirectionOfMaxSpread(row, column));
+        }
+    }
+}
+
+void FirePerimeterGrowth::setNumberOfThreads(int numberOfThreads)
+{
+    numberOfThreads_ = (numberOfThreads > 1) ? numberOfThreads : 1;
+}
+
+void FirePerimeterGrowth::setVertexSpacing(double minimumSpacing, double maximumSpacing, LengthUnits::LengthUnitsEnum lengthUnits)
+{
+    maximumSpacing_ = LengthUnits::toBaseUnits(maximumSpacing, lengthUnits);
+    minimumSpacing_ = LengthUnits::toBaseUnits(minimumSpacing, lengthUnits);
+    if (maximumSpacing_ <= 0.0)
+    {
+        maximumSpacing_ = LengthUnits::toBaseUnits(15.0, LengthUnits::Meters);
+    }
+    // Splitting a segment longer than the maximum must not leave pieces shorter than the minimum
+    minimumSpacing_ = std::max(0.0, std::min(minimumSpacing_, 0.5 * maximumSpacing_));
+}
+
+void FirePerimeterGrowth::setPerimeter(std::size_t numberOfVertices, const double* x, const double* y, LengthUnits::LengthUnitsEnum lengthUnits)
+{
+    vertices_.resize(numberOfVertices);
+    for (std::size_t i = 0; i < numberOfVertices; i++)
+    {
+        vertices_[i].x = LengthUnits::toBaseUnits(x[i], lengthUnits);
+        vertices_[i].y = LengthUnits::toBaseUnits(y[i], lengthUnits);
+    }
+    if (calculateSignedArea(vertices_) < 0.0)
+    {
+        std::reverse(vertices_.begin(), vertices_.end());
+    }
+    elapsedTime_ = 0.0;
+    redistributeVertices();
+}
+
+void FirePerimeterGrowth::setIgnitionPoint(double x, double y, LengthUnits::LengthUnitsEnum lengthUnits)
+{
+    const double pi = 3.14159265358979323846;
+    const int numberOfVertices = 16;
+    // Vertices of a 16 sided polygon are 0.39 radii apart
+    double radius = std::max(minimumSpacing_ / 0.39, 0.5 * maximumSpacing_);
+    x = LengthUnits::toBaseUnits(x, lengthUnits);
+    y = LengthUnits::toBaseUnits(y, lengthUnits);
+    vertices_.resize(numberOfVertices);
+    for (int i = 0; i < numberOfVertices; i++)
+    {
+        double angle = 2.0 * pi * i / numberOfVertices;
+        vertices_[i].x = x + radius * cos(angle);
+        vertices_[i].y = y + radius * sin(angle);
+    }
+    elapsedTime_ = 0.0;
+    redistributeVertices();
+}
+
+void FirePerimeterGrowth::advance(double timeStep, TimeUnits::TimeUnitsEnum timeUnits)
+{
+    timeStep = TimeUnits::toBaseUnits(timeStep, timeUnits);
+    if (timeStep <= 0.0 || vertices_.size() < 3 || wavelets_.empty())
+    {
+        return;
+    }
+
+    std::vector<Vertex> movedVertices(vertices_.size());
+    moveVertices(timeStep, movedVertices);
+    vertices_.swap(movedVertices);
+    elapsedTime_ += timeStep;
+
+    redistributeVertices();
+    clipLoops();
+}
+
+void FirePerimeterGrowth::setWavelet(Wavelet& wavelet, double spreadRate, double fireLengthToWidthRatio, double directionOfMaxSpread)
+{
+    const double pi = 3.14159265358979323846;
+    FireSize size;
+    size.calculateFireBasicDimensionsFromLengthToWidthRatio(fireLengthToWidthRatio, spreadRate, SpeedUnits::FeetPerMinute);
+    wavelet.ellipticalA = size.getEllipticalA(LengthUnits::Feet, 1.0, TimeUnits::Minutes);
+    wavelet.ellipticalB = size.getEllipticalB(LengthUnits::Feet, 1.0, TimeUnits::Minutes);
+    wavelet.ellipticalC = size.getEllipticalC(LengthUnits::Feet, 1.0, TimeUnits::Minutes);
+    wavelet.sinDirection = sin(directionOfMaxSpread * pi / 180.0);
+    wavelet.cosDirection = cos(directionOfMaxSpread * pi / 180.0);
+}
+
+const FirePerimeterGrowth::Wavelet* FirePerimeterGrowth::getWavelet(const Vertex& vertex) const
+{
+    if (numberOfRows_ == 0)
+    {
+        return &wavelets_[0];
+    }
+    double column = floor(vertex.x / cellSize_);
+    double row = numberOfRows_ - 1 - floor(vertex.y / cellSize_);
+    if (column < 0.0 || column >= numberOfColumns_ || row < 0.0 || row >= numberOfRows_)
+    {
+        return nullptr;
+    }
+    return &wavelets_[(std::size_t)row * numberOfColumns_ + (std::size_t)column];
+}
+
+void FirePerimeterGrowth::moveVertices(double timeStep, std::vector<Vertex>& movedVertices) const
+{
+    std::size_t numberOfVertices = vertices_.size();
+    auto moveBlock = [this, timeStep, numberOfVertices, &movedVertices](std::size_t firstVertex, std::size_t lastVertex)
+    {
+        for (std::size_t i = firstVertex; i < lastVertex; i++)
+        {
+            const Vertex& vertex = vertices_[i];
+            movedVertices[i] = vertex;
+            const Wavelet* wavelet = getWavelet(vertex);
+            if (wavelet == nullptr || wavelet->ellipticalB <= 0.0)
+            {
+                continue;
+            }
+
+            // Outward normal of the counterclockwise perimeter, from its
+            // tangent across the neighboring vertices
+            const Vertex& previous = vertices_[(i + numberOfVertices - 1) % numberOfVertices];
+            const Vertex& next = vertices_[(i + 1) % numberOfVertices];
+            double normalX = next.y - previous.y;
+            double normalY = previous.x - next.x;
+
+            // Normal in the ellipse's frame, along the direction of max spread
+            // (heading) and to its right (flank)
+            double headingNormal = normalX * wavelet->sinDirection + normalY * wavelet->cosDirection;
+            double flankNormal = normalX * wavelet->cosDirection - normalY * wavelet->sinDirection;
+            double a = wavelet->ellipticalA;
+            double b = wavelet->ellipticalB;
+            double denominator = sqrt(b * b * headingNormal * headingNormal + a * a * flankNormal * flankNormal);
+            if (denominator <= 0.0)
+            {
+                continue;
+            }
+            double heading = wavelet->ellipticalC + b * b * headingNormal / denominator;
+            double flank = a * a * flankNormal / denominator;
+            movedVertices[i].x += timeStep * (heading * wavelet->sinDirection + flank * wavelet->cosDirection);
+            movedVertices[i].y += timeStep * (heading * wavelet->cosDirection - flank * wavelet->sinDirection);
+        }
+    };
+
+    // Thread start up outweighs moving only a few vertices
+    const std::size_t minimumVerticesPerThread = 1024;
+    std::size_t numberOfThreads = std::min((std::size_t)numberOfThreads_, numberOfVertices / minimumVerticesPerThread + 1);
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 1; thread < numberOfThreads; thread++)
+    {
+        threads.push_back(std::thread(moveBlock, numberOfVertices * thread / numberOfThreads,
+            numberOfVertices * (thread + 1) / numberOfThreads));
+    }
+    moveBlock(0, numberOfVertices / numberOfThreads);
+    for (std::size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+}
+
+void FirePerimeterGrowth::redistributeVertices()
+{
+    std::size_t numberOfVertices = vertices_.size();
+    if (numberOfVertices < 3)
+    {
+        return;
+    }
+
+    // Split segments longer than the maximum spacing into equal pieces
+    std::vector<Vertex> vertices;
+    vertices.reserve(numberOfVertices + numberOfVertices / 4);
+    for (std::size_t i = 0; i < numberOfVertices; i++)
+    {
+        const Vertex& vertex = vertices_[i];
+        const Vertex& next = vertices_[(i + 1) % numberOfVertices];
+        vertices.push_back(vertex);
+        double length = hypot(next.x - vertex.x, next.y - vertex.y);
+        if (length > maximumSpacing_)
+        {
+            int numberOfPieces = (int)ceil(length / maximumSpacing_);
+            for (int piece = 1; piece < numberOfPieces; piece++)
+            {
+                double fraction = (double)piece / numberOfPieces;
+                Vertex inserted = { vertex.x + fraction * (next.x - vertex.x), vertex.y + fraction * (next.y - vertex.y) };
+                vertices.push_back(inserted);
+            }
+        }
+    }
+
+    // Drop vertices closer than the minimum spacing to the last one kept
+    vertices_.clear();
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        if (!vertices_.empty() && hypot(vertices[i].x - vertices_.back().x, vertices[i].y - vertices_.back().y) < minimumSpacing_)
+        {
+            continue;
+        }
+        vertices_.push_back(vertices[i]);
+    }
+    while (vertices_.size() > 3 && hypot(vertices_.back().x - vertices_[0].x, vertices_.back().y - vertices_[0].y) < minimumSpacing_)
+    {
+        vertices_.pop_back();
+    }
+}
+
+void FirePerimeterGrowth::clipLoops()
+{
+    // Cut the perimeter at each crossing and keep the loop with the larger
+    // counterclockwise area, the other is either burned over or inside out
+    std::size_t firstSegment = 0;
+    std::size_t secondSegment = 0;
+    Vertex crossing;
+    while (vertices_.size() > 3 && findFirstCrossing(firstSegment, secondSegment, crossing))
+    {
+        std::vector<Vertex> innerLoop;
+        innerLoop.push_back(crossing);
+        innerLoop.insert(innerLoop.end(), vertices_.begin() + firstSegment + 1, vertices_.begin() + secondSegment + 1);
+
+        std::vector<Vertex> outerLoop;
+        outerLoop.push_back(crossing);
+        outerLoop.insert(outerLoop.end(), vertices_.begin() + secondSegment + 1, vertices_.end());
+        outerLoop.insert(outerLoop.end(), vertices_.begin(), vertices_.begin() + firstSegment + 1);
+
+        if (calculateSignedArea(innerLoop) > calculateSignedArea(outerLoop))
+        {
+            vertices_.swap(innerLoop);
+        }
+        else
+        {
+            vertices_.swap(outerLoop);
+        }
+    }
+}
+
+bool FirePerimeterGrowth::findFirstCrossing(std::size_t& firstSegment, std::size_t& secondSegment, Vertex& crossing) const
+{
+    // Spatial hash of the segments, sorted by grid cell so that segments
+    // sharing a cell are adjacent. Segments are at most about the maximum
+    // spacing long, so each covers only a few cells.
+    std::size_t numberOfVertices = vertices_.size();
+    double gridSize = maximumSpacing_;
+    for (std::size_t i = 0; i < numberOfVertices; i++)
+    {
+        const Vertex& vertex = vertices_[i];
+        const Vertex& next = vertices_[(i + 1) % numberOfVertices];
+        gridSize = std::max(gridSize, std::max(fabs(next.x - vertex.x), fabs(next.y - vertex.y)));
+    }
+
+    typedef std::pair<std::uint64_t, std::uint32_t> CellSegment;
+    std::vector<CellSegment> cellSegments;
+    cellSegments.reserve(2 * numberOfVertices);
+    for (std::size_t i = 0; i < numberOfVertices; i++)
+    {
+        const Vertex& vertex = vertices_[i];
+        const Vertex& next = vertices_[(i + 1) % numberOfVertices];
+        std::int64_t firstColumn = (std::int64_t)floor(std::min(vertex.x, next.x) / gridSize);
+        std::int64_t lastColumn = (std::int64_t)floor(std::max(vertex.x, next.x) / gridSize);
+        std::int64_t firstRow = (std::int64_t)floor(std::min(vertex.y, next.y) / gridSize);
+        std::int64_t lastRow = (std::int64_t)floor(std::max(vertex.y, next.y) / gridSize);
+        for (std::int64_t column = firstColumn; column <= lastColumn; column++)
+        {
+            for (std::int64_t row = firstRow; row <= lastRow; row++)
+            {
+                std::uint64_t cell = ((std::uint64_t)column << 32) ^ (std::uint32_t)row;
+                cellSegments.push_back(CellSegment(cell, (std::uint32_t)i));
+            }
+        }
+    }
+    std::sort(cellSegments.begin(), cellSegments.end());
+
+    bool isFound = false;
+    std::size_t groupStart = 0;
+    while (groupStart < cellSegments.size())
+    {
+        std::size_t groupEnd = groupStart + 1;
+        while (groupEnd < cellSegments.size() && cellSegments[groupEnd].first == cellSegments[groupStart].first)
+        {
+            groupEnd++;
+        }
+        for (std::size_t m = groupStart; m < groupEnd; m++)
+        {
+            std::size_t i = cellSegments[m].second;
+            for (std::size_t n = m + 1; n < groupEnd; n++)
+            {
+                // Within a cell the segments are sorted, so i < j
+                std::size_t j = cellSegments[n].second;
+                if (j == i + 1 || (i == 0 && j == numberOfVertices - 1))
+                {
+                    continue; // neighboring segments share a vertex
+                }
+                if (isFound && (i > firstSegment || (i == firstSegment && j >= secondSegment)))
+                {
+                    continue;
+                }
+                const Vertex& p = vertices_[i];
+                const Vertex& pNext = vertices_[(i + 1) % numberOfVertices];
+                const Vertex& q = vertices_[j];
+                const Vertex& qNext = vertices_[(j + 1) % numberOfVertices];
+                double rX = pNext.x - p.x;
+                double rY = pNext.y - p.y;
+                double sX = qNext.x - q.x;
+                double sY = qNext.y - q.y;
+                double denominator = rX * sY - rY * sX;
+                if (denominator == 0.0)
+                {
+                    continue; // parallel
+                }
+                double t = ((q.x - p.x) * sY - (q.y - p.y) * sX) / denominator;
+                double u = ((q.x - p.x) * rY - (q.y - p.y) * rX) / denominator;
+                if (t > 0.0 && t < 1.0 && u > 0.0 && u < 1.0)
+                {
+                    isFound = true;
+                    firstSegment = i;
+                    secondSegment = j;
+                    crossing.x = p.x + t * rX;
+                    crossing.y = p.y + t * rY;
+                }
+            }
+        }
+        groupStart = groupEnd;
+    }
+    return isFound;
+}
+
+double FirePerimeterGrowth::calculateSignedArea(const std::vector<Vertex>& vertices) const
+{
+    // Shoelace formula, positive for counterclockwise vertices
+    double twiceArea = 0.0;
+    std::size_t numberOfVertices = vertices.size();
+    for (std::size_t i = 0; i < numberOfVertices; i++)
+    {
+        const Vertex& vertex = vertices[i];
+        const Vertex& next = vertices[(i + 1) % numberOfVertices];
+        twiceArea += vertex.x * next.y - next.x * vertex.y;
+    }
+    return 0.5 * twiceArea;
+}
+
+int FirePerimeterGrowth::getNumberOfThreads() const
+{
+    return numberOfThreads_;
+}
+
+double FirePerimeterGrowth::getMinimumVertexSpacing(LengthUnits::LengthUnitsEnum lengthUnits) const
+{
+    return LengthUnits::fromBaseUnits(minimumSpacing_, lengthUnits);
+}
+
+double FirePerimeterGrowth::getMaximumVertexSpacing(LengthUnits::LengthUnitsEnum lengthUnits) const
+{
+    return LengthUnits::fromBaseUnits(maximumSpacing_, lengthUnits);
+}
+
+double FirePerimeterGrowth::getElapsedTime(TimeUnits::TimeUnitsEnum timeUnits) const
+{
+    return TimeUnits::fromBaseUnits(elapsedTime_, timeUnits);
+}
+
+std::size_t FirePerimeterGrowth::getNumberOfVertices() const
+{
+    return vertices_.size();
+}
+
+void FirePerimeterGrowth::getPerimeter(double* x, double* y, LengthUnits::LengthUnitsEnum lengthUnits) const
+{
+    for (std::size_t i = 0; i < vertices_.size(); i++)
+    {
+        x[i] = LengthUnits::fromBaseUnits(vertices_[i].x, lengthUnits);
+        y[i] = LengthUnits::fromBaseUnits(vertices_[i].y, lengthUnits);
+    }
+}
+
+double FirePerimeterGrowth::getFireArea(AreaUnits::AreaUnitsEnum areaUnits) const
+{
+    return AreaUnits::fromBaseUnits(calculateSignedArea(vertices_), areaUnits);
+}
+
+double FirePerimeterGrowth::getFirePerimeter(LengthUnits::LengthUnitsEnum lengthUnits) const
+{
+    double perimeter = 0.0;
+    std::size_t numberOfVertices = vertices_.size();
+    for (std::size_t i = 0; i < numberOfVertices; i++)
+    {
+        const Vertex& vertex = vertices_[i];
+        const Vertex& next = vertices_[(i + 1) % numberOfVertices];
+        perimeter += hypot(next.x - vertex.x, next.y - vertex.y);
+    }
+    return LengthUnits::fromBaseUnits(perimeter, lengthUnits);
+}
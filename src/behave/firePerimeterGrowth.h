@@ -0,0 +1,118 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Elliptical wavelet propagation of a vector fire perimeter
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef FIREPERIMETERGROWTH_H
+#define FIREPERIMETERGROWTH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "behaveUnits.h"
+
+class FireGrowth;
+class Surface;
+
+// Propagates a fire perimeter, a closed polygon of vertices, with Richards'
+// (1990) elliptical wavelets: over each time step every vertex moves to the
+// point of its local fire ellipse (from FireSize) whose normal matches the
+// perimeter's outward normal at the vertex. After each step vertices are
+// inserted and removed to keep their spacing, and the loops left where the
+// perimeter crosses itself are clipped off. Only the outer perimeter is kept,
+// unburned islands and fires that split apart keep their largest part.
+//
+// Coordinates run east (x) and north (y) from the south west corner of the
+// landscape, if any.
+class FirePerimeterGrowth
+{
+public:
+    FirePerimeterGrowth();
+
+    // Every vertex spreads with the fire ellipse of surface's last run, whose
+    // direction of max spread must be relative to north
+    void setUniformFire(const Surface& surface);
+    // Each vertex spreads with the fire ellipse of the landscape cell it is in,
+    // call after fireGrowth.calculateSpreadRates(). Vertices off the landscape
+    // or in cells that do not burn stay put.
+    void setLandscapeFire(const FireGrowth& fireGrowth);
+    void setNumberOfThreads(int numberOfThreads);
+    void setVertexSpacing(double minimumSpacing, double maximumSpacing, LengthUnits::LengthUnitsEnum lengthUnits);
+
+    // Resets the elapsed time, vertices may be given in either direction
+    void setPerimeter(std::size_t numberOfVertices, const double* x, const double* y, LengthUnits::LengthUnitsEnum lengthUnits);
+    // Starts the perimeter as a small circle around the point
+    void setIgnitionPoint(double x, double y, LengthUnits::LengthUnitsEnum lengthUnits);
+
+    // Large steps let the perimeter cross itself more, they are clipped but
+    // the perimeter loses detail
+    void advance(double timeStep, TimeUnits::TimeUnitsEnum timeUnits);
+
+    int getNumberOfThreads() const;
+    double getMinimumVertexSpacing(LengthUnits::LengthUnitsEnum lengthUnits) const;
+    double getMaximumVertexSpacing(LengthUnits::LengthUnitsEnum lengthUnits) const;
+    double getElapsedTime(TimeUnits::TimeUnitsEnum timeUnits) const;
+    std::size_t getNumberOfVertices() const;
+    // Fills getNumberOfVertices() coordinates, counterclockwise
+    void getPerimeter(double* x, double* y, LengthUnits::LengthUnitsEnum lengthUnits) const;
+    double getFireArea(AreaUnits::AreaUnitsEnum areaUnits) const;
+    double getFirePerimeter(LengthUnits::LengthUnitsEnum lengthUnits) const;
+
+private:
+    struct Vertex
+    {
+        double x;   // ft
+        double y;   // ft
+    };
+
+    // Fire ellipse grown in one minute
+    struct Wavelet
+    {
+        double ellipticalA;     // semi-minor axis (ft)
+        double ellipticalB;     // semi-major axis (ft)
+        double ellipticalC;     // distance from the ignition point to the center (ft)
+        double sinDirection;    // of the direction of max spread
+        double cosDirection;
+    };
+
+    void setWavelet(Wavelet& wavelet, double spreadRate, double fireLengthToWidthRatio, double directionOfMaxSpread);
+    const Wavelet* getWavelet(const Vertex& vertex) const;
+    void moveVertices(double timeStep, std::vector<Vertex>& movedVertices) const;
+    void redistributeVertices();
+    void clipLoops();
+    bool findFirstCrossing(std::size_t& firstSegment, std::size_t& secondSegment, Vertex& crossing) const;
+    double calculateSignedArea(const std::vector<Vertex>& vertices) const;
+
+    std::vector<Vertex> vertices_;      // counterclockwise
+    std::vector<Wavelet> wavelets_;     // one per landscape cell, rows from the north
+    int numberOfRows_;                  // landscape rows, 0 for a uniform fire
+    int numberOfColumns_;
+    double cellSize_;                   // ft
+    int numberOfThreads_;
+    double minimumSpacing_;             // ft
+    double maximumSpacing_;             // ft
+    double elapsedTime_;                // minutes
+};
+
+#endif // FIREPERIMETERGROWTH_H
@@ -40,6 +40,18 @@ void FireSize::calculateFireBasicDimensions(bool isCrown, double effectiveWindSp
     calculateEllipticalDimensions();
 }
 
+void FireSize::calculateFireBasicDimensionsFromLengthToWidthRatio(double fireLengthToWidthRatio, double forwardSpreadRate, SpeedUnits::SpeedUnitsEnum spreadRateUnits)
+{
+    forwardSpreadRate_ = SpeedUnits::toBaseUnits(forwardSpreadRate, spreadRateUnits); // spread rate is now feet per minute
+    effectiveWindSpeed_ = 0.0; // not known
+    fireLengthToWidthRatio_ = (fireLengthToWidthRatio > 1.0) ? fireLengthToWidthRatio : 1.0;
+
+    calculateFireEccentricity();
+    calculateBackingSpreadRate();
+    calculateFlankingSpreadRate();
+    calculateEllipticalDimensions();
+}
+
 double FireSize::getFireLengthToWidthRatio() const
 {
     return fireLengthToWidthRatio_;
@@ -36,6 +36,8 @@ public:
     FireSize();
     ~FireSize();
     void calculateFireBasicDimensions(bool isCrown, double effectiveWindSpeed, SpeedUnits::SpeedUnitsEnum windSpeedRateUnits, double forwardSpreadRate, SpeedUnits::SpeedUnitsEnum spreadRateUnits);
+    // Fire shape from an already known length-to-width ratio instead of the effective wind speed
+    void calculateFireBasicDimensionsFromLengthToWidthRatio(double fireLengthToWidthRatio, double forwardSpreadRate, SpeedUnits::SpeedUnitsEnum spreadRateUnits);
 
     double getFireLengthToWidthRatio() const;
     double getEccentricity() const;
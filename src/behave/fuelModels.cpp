@@ -31,545 +31,814 @@
 
 #include "fuelModels.h"
 
-#include "surfaceInputs.h"
-
-FuelModels::FuelModels()
-{
-    FuelModelVector_.resize(FuelConstants::MaxFuelModels);
-    initializeAllFuelModelRecords();
-    populateFuelModels();
-}
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 
-FuelModels::FuelModels(const FuelModels& rhs)
-{
-    memberwiseCopyAssignment(rhs);
-}
+#include "mappedFile.h"
+#include "surfaceInputs.h"
 
-FuelModels& FuelModels::operator=(const FuelModels& rhs)
-{
-    if (this != &rhs)
-    {
-        memberwiseCopyAssignment(rhs);
-    }
-    return *this;
-}
+// Binary custom fuel model catalog, written in native byte order and laid out
+// so it can be read straight from a read-only mapping shared between processes:
+//  FuelModelCatalogFileHeader
+//  numberOfRecords FuelModelCatalogFileRecord, sorted by fuel model number
+//  string table of NUL terminated codes and names, in base units like FuelModelRecord
+static const char fuelModelCatalogMagic[8] = { 'B', 'H', 'V', 'F', 'M', 'C', 'A', 'T' };
+static const uint32_t fuelModelCatalogByteOrderMark = 0x01020304;
+static const uint32_t fuelModelCatalogVersion = 1;
+static const uint32_t fuelModelCatalogDynamicFlag = 0x1;
 
-void FuelModels::memberwiseCopyAssignment(const FuelModels& rhs)
+struct FuelModelCatalogFileHeader
 {
-    FuelModelVector_.resize(rhs.FuelModelVector_.size());
-    for (unsigned int i = 0; i < rhs.FuelModelVector_.size(); i++)
-    {
-        FuelModelVector_[i].fuelModelNumber_ = rhs.FuelModelVector_[i].fuelModelNumber_;
-        FuelModelVector_[i].code_ = rhs.FuelModelVector_[i].code_;
-        FuelModelVector_[i].name_ = rhs.FuelModelVector_[i].name_;
-        FuelModelVector_[i].fuelbedDepth_ = rhs.FuelModelVector_[i].fuelbedDepth_;
-        FuelModelVector_[i].moistureOfExtinctionDead_ = rhs.FuelModelVector_[i].moistureOfExtinctionDead_;
-        FuelModelVector_[i].heatOfCombustionDead_ = rhs.FuelModelVector_[i].heatOfCombustionDead_;
-        FuelModelVector_[i].heatOfCombustionLive_ = rhs.FuelModelVector_[i].heatOfCombustionLive_;
-        FuelModelVector_[i].fuelLoadOneHour_ = rhs.FuelModelVector_[i].fuelLoadOneHour_;
-        FuelModelVector_[i].fuelLoadTenHour_ = rhs.FuelModelVector_[i].fuelLoadTenHour_;
-        FuelModelVector_[i].fuelLoadHundredHour_ = rhs.FuelModelVector_[i].fuelLoadHundredHour_;
-        FuelModelVector_[i].fuelLoadLiveHerbaceous_ = rhs.FuelModelVector_[i].fuelLoadLiveHerbaceous_;
-        FuelModelVector_[i].fuelLoadLiveWoody_ = rhs.FuelModelVector_[i].fuelLoadLiveWoody_;
-        FuelModelVector_[i].savrOneHour_ = rhs.FuelModelVector_[i].savrOneHour_;
-        FuelModelVector_[i].savrLiveHerbaceous_ = rhs.FuelModelVector_[i].savrLiveHerbaceous_;
-        FuelModelVector_[i].savrLiveWoody_ = rhs.FuelModelVector_[i].savrLiveWoody_;
-        FuelModelVector_[i].isReserved_ = rhs.FuelModelVector_[i].isReserved_;
-        FuelModelVector_[i].isDefined_ = rhs.FuelModelVector_[i].isDefined_;
-    }
-}
+    char magic[8];
+    uint32_t byteOrderMark;             // reads back differently on a machine of the other byte order
+    uint32_t version;
+    uint32_t numberOfRecords;
+    uint32_t recordSize;                // sizeof(FuelModelCatalogFileRecord)
+    uint64_t stringTableOffset;         // from the start of the file
+    uint64_t stringTableSize;
+};
 
-FuelModels::~FuelModels()
+struct FuelModelCatalogFileRecord
 {
+    int32_t fuelModelNumber;
+    uint32_t codeOffset;                // into the string table
+    uint32_t nameOffset;                // into the string table
+    uint32_t flags;                     // fuelModelCatalogDynamicFlag
+    double fuelbedDepth;
+    double moistureOfExtinctionDead;
+    double heatOfCombustionDead;
+    double heatOfCombustionLive;
+    double fuelLoadOneHour;
+    double fuelLoadTenHour;
+    double fuelLoadHundredHour;
+    double fuelLoadLiveHerbaceous;
+    double fuelLoadLiveWoody;
+    double savrOneHour;
+    double savrLiveHerbaceous;
+    double savrLiveWoody;
+};
 
-}
-
-void FuelModels::initializeSingleFuelModelRecord(int fuelModelNumber)
-{
-    FuelModelVector_[fuelModelNumber].fuelModelNumber_ = 0;
-    FuelModelVector_[fuelModelNumber].code_ = "NO_CODE";
-    FuelModelVector_[fuelModelNumber].name_ = "NO_NAME";
-    FuelModelVector_[fuelModelNumber].fuelbedDepth_ = 0;
-    FuelModelVector_[fuelModelNumber].moistureOfExtinctionDead_ = 0;
-    FuelModelVector_[fuelModelNumber].heatOfCombustionDead_ = 0;
-    FuelModelVector_[fuelModelNumber].heatOfCombustionLive_ = 0;
-    FuelModelVector_[fuelModelNumber].fuelLoadOneHour_ = 0;
-    FuelModelVector_[fuelModelNumber].fuelLoadTenHour_ = 0;
-    FuelModelVector_[fuelModelNumber].fuelLoadHundredHour_ = 0;
-    FuelModelVector_[fuelModelNumber].fuelLoadLiveHerbaceous_ = 0;
-    FuelModelVector_[fuelModelNumber].fuelLoadLiveWoody_ = 0;
-    FuelModelVector_[fuelModelNumber].savrOneHour_ = 0;
-    FuelModelVector_[fuelModelNumber].savrLiveHerbaceous_ = 0;
-    FuelModelVector_[fuelModelNumber].savrLiveWoody_ = 0;
-    FuelModelVector_[fuelModelNumber].isReserved_ = false;
-    FuelModelVector_[fuelModelNumber].isDefined_ = false;
-}
+static_assert(sizeof(FuelModelCatalogFileHeader) == 40, "catalog header layout changed");
+static_assert(sizeof(FuelModelCatalogFileRecord) == 112, "catalog record layout changed");
 
-void FuelModels::initializeAllFuelModelRecords()
-{
-    for (int i = 0; i < FuelConstants::MaxFuelModels; i++)
-    {
-        initializeSingleFuelModelRecord(i);
-    }
-}
+// Standard fuel models, shared read-only by every FuelModels object. Fields are
+// in FuelModelRecord order:
+//  fuelModelNumber, code, name,
+//  fuelBedDepth, moistureOfExtinctionDeadFuel, heatOfCombustionDeadFuel, heatOfCombustionLiveFuel,
+//  fuelLoad1Hour, fuelLoad10Hour, fuelLoad100Hour, fuelLoadLiveHerb, fuelLoadLiveWood,
+//  savr1HourFuel, savrLiveHerb, savrLiveWood,
+//  isDynamic, isReserved, isDefined
+// Reserved numbers with no standard model yet are listed as reserved but not defined.
+static constexpr double tonsPerAcre = 2000.0 / 43560.0; // tons per acre in pounds per square foot
 
-void FuelModels::setFuelModelRecord(int fuelModelNumber, std::string code, std::string name,
-    double fuelBedDepth, double moistureOfExtinctionDead, double heatOfCombustionDead, double heatOfCombustionLive,
-    double fuelLoadOneHour, double fuelLoadTenHour, double fuelLoadHundredHour, double fuelLoadliveHerbaceous,
-    double fuelLoadliveWoody, double savrOneHour, double savrLiveHerbaceous, double savrLiveWoody,
-    bool isDynamic, bool isReserved)
-{
-    FuelModelVector_[fuelModelNumber].fuelModelNumber_ = fuelModelNumber;
-    FuelModelVector_[fuelModelNumber].code_ = code;
-    FuelModelVector_[fuelModelNumber].name_ = name;
-    FuelModelVector_[fuelModelNumber].fuelbedDepth_ = fuelBedDepth;
-    FuelModelVector_[fuelModelNumber].moistureOfExtinctionDead_ = moistureOfExtinctionDead;
-    FuelModelVector_[fuelModelNumber].heatOfCombustionDead_ = heatOfCombustionDead;
-    FuelModelVector_[fuelModelNumber].heatOfCombustionLive_ = heatOfCombustionLive;
-    FuelModelVector_[fuelModelNumber].fuelLoadOneHour_ = fuelLoadOneHour;
-    FuelModelVector_[fuelModelNumber].fuelLoadTenHour_ = fuelLoadTenHour;
-    FuelModelVector_[fuelModelNumber].fuelLoadHundredHour_ = fuelLoadHundredHour;
-    FuelModelVector_[fuelModelNumber].fuelLoadLiveHerbaceous_ = fuelLoadliveHerbaceous;
-    FuelModelVector_[fuelModelNumber].fuelLoadLiveWoody_ = fuelLoadliveWoody;
-    FuelModelVector_[fuelModelNumber].savrOneHour_ = savrOneHour;
-    FuelModelVector_[fuelModelNumber].savrLiveHerbaceous_ = savrLiveHerbaceous;
-    FuelModelVector_[fuelModelNumber].savrLiveWoody_ = savrLiveWoody;
-    FuelModelVector_[fuelModelNumber].isDynamic_ = isDynamic;
-    FuelModelVector_[fuelModelNumber].isReserved_ = isReserved;
-    FuelModelVector_[fuelModelNumber].isDefined_ = true;
-}
-
-// PopulateFuelModels() fills FuelModelArray[] with the standard fuel model parameters
-// as well as earmarking which models are available for use as custom models
-void FuelModels::populateFuelModels()
+static constexpr FuelModels::FuelModelRecord standardFuelModels[] =
 {
     // See Standard Fire Behavior Fuel Models: A Comprehensive Set for Use with Rothermels
     // Surface Fire Spread Model by Joe H.Scott and Robert E.Burgan, 2005
     // https://www.fs.fed.us/rm/pubs/rmrs_gtr153.pdf
 
     // Index 0 is not used
-    setFuelModelRecord(0, "NO_CODE", "NO_NAME", 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, false, false);
-    FuelModelVector_[0].isDefined_ = false;
-    /*
-    fuelModelNumber, code, name
-    fuelBedDepth, moistureOfExtinctionDeadFuel, heatOfCombustionDeadFuel, heatOfCombustionLiveFuel,
-    fuelLoad1Hour, fuelLoad10Hour, fuelLoad100Hour, fuelLoadLiveHerb, fuelLoadLiveWood,
-    savr1HourFuel, savrLiveHerb, savrLiveWood,
-    isDynamic, isReserved
-    - WMC 10/2015
-    */
+    { 0, "NO_CODE", "NO_NAME", 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, false, false, false },
 
     // Code FMx: Original 13 Fuel Models
-    setFuelModelRecord(1, "FM1", "Short grass [1]",
+    { 1, "FM1", "Short grass [1]",
         1.0, 0.12, 8000, 8000,
         0.034, 0, 0, 0, 0,
         3500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(2, "FM2", "Timber grass and understory [2]",
+        false, true, true },
+    { 2, "FM2", "Timber grass and understory [2]",
         1.0, 0.15, 8000, 8000,
         0.092, 0.046, 0.023, 0.023, 0,
         3000, 1500, 1500,
-        false, true);
-    setFuelModelRecord(3, "FM3", "Tall grass [3]",
+        false, true, true },
+    { 3, "FM3", "Tall grass [3]",
         2.5, 0.25, 8000, 8000,
         0.138, 0, 0, 0, 0,
         1500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(4, "FM4", "Chaparral [4]",
+        false, true, true },
+    { 4, "FM4", "Chaparral [4]",
         6.0, 0.2, 8000, 8000,
         0.230, 0.184, 0.092, 0, 0.230,
         2000, 1500, 1500,
-        false, true);
-    setFuelModelRecord(5, "FM5", "Brush [5]",
+        false, true, true },
+    { 5, "FM5", "Brush [5]",
         2.0, 0.20, 8000, 8000,
         0.046, 0.023, 0, 0, 0.092,
         2000, 1500, 1500,
-        false, true);
-    setFuelModelRecord(6, "FM6", "Dormant brush, hardwood slash [6]",
+        false, true, true },
+    { 6, "FM6", "Dormant brush, hardwood slash [6]",
         2.5, 0.25, 8000, 8000,
         0.069, 0.115, 0.092, 0, 0,
         1750, 1500, 1500,
-        false, true);
-    setFuelModelRecord(7, "FM7", "Southern rough [7]",
+        false, true, true },
+    { 7, "FM7", "Southern rough [7]",
         2.5, 0.40, 8000, 8000,
         0.052, 0.086, 0.069, 0, 0.017,
         1750, 1500, 1500,
-        false, true);
-    setFuelModelRecord(8, "FM8", "Short needle litter [8]",
+        false, true, true },
+    { 8, "FM8", "Short needle litter [8]",
         0.2, 0.3, 8000, 8000,
         0.069, 0.046, 0.115, 0, 0,
         2000, 1500, 1500,
-        false, true);
-    setFuelModelRecord(9, "FM9", "Long needle or hardwood litter [9]",
+        false, true, true },
+    { 9, "FM9", "Long needle or hardwood litter [9]",
         0.2, 0.25, 8000, 8000,
         0.134, 0.019, 0.007, 0, 0,
         2500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(10, "FM10", "Timber litter & understory [10]",
+        false, true, true },
+    { 10, "FM10", "Timber litter & understory [10]",
         1.0, 0.25, 8000, 8000,
         0.138, 0.092, 0.230, 0, 0.092,
         2000, 1500, 1500,
-        false, true);
-    setFuelModelRecord(11, "FM11", "Light logging slash [11]",
+        false, true, true },
+    { 11, "FM11", "Light logging slash [11]",
         1.0, 0.15, 8000, 8000,
         0.069, 0.207, 0.253, 0, 0,
         1500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(12, "FM12", "Medium logging slash [12]",
+        false, true, true },
+    { 12, "FM12", "Medium logging slash [12]",
         2.3, 0.20, 8000, 8000,
         0.184, 0.644, 0.759, 0, 0,
         1500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(13, "FM13", "Heavy logging slash [13]",
+        false, true, true },
+    { 13, "FM13", "Heavy logging slash [13]",
         3.0, 0.25, 8000, 8000,
         0.322, 1.058, 1.288, 0, 0,
         1500, 1500, 1500,
-        false, true);
+        false, true, true },
 
     // 14-89 Available for custom models
 
     // Code NBx: Non-burnable
     // 90 Available for custom NB model  
-    setFuelModelRecord(91, "NB1", "Urban, developed [91]",
+    { 91, "NB1", "Urban, developed [91]",
         1.0, 0.10, 8000, 8000,
         0, 0, 0, 0, 0,
         1500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(92, "NB2", "Snow, ice [92]",
+        false, true, true },
+    { 92, "NB2", "Snow, ice [92]",
         1.0, 0.10, 8000, 8000,
         0, 0, 0, 0, 0,
         1500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(93, "NB3", "Agricultural [93]",
+        false, true, true },
+    { 93, "NB3", "Agricultural [93]",
         1.0, 0.10, 8000, 8000,
         0, 0, 0, 0, 0,
         1500, 1500, 1500,
-        false, true);
+        false, true, true },
 
     // Indices 94-95 Reserved for future standard non-burnable models
-    for (int i = 94; i <= 95; i++)
-    {
-        markAsReservedModel(i);
-    }
-
-    setFuelModelRecord(94, "NB4", "Future standard non-burnable [94]",
+    { 94, "NB4", "Future standard non-burnable [94]",
         1.0, 0.10, 8000, 8000,
         0, 0, 0, 0, 0,
         1500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(95, "NB5", "Future standard non-burnable [95]",
+        false, true, true },
+    { 95, "NB5", "Future standard non-burnable [95]",
         1.0, 0.10, 8000, 8000,
         0, 0, 0, 0, 0,
         1500, 1500, 1500,
-        false, true);
+        false, true, true },
 
     // Indices 96-97 Available for custom NB model
 
-    setFuelModelRecord(98, "NB8", "Open water [98]",
+    { 98, "NB8", "Open water [98]",
         1.0, 0.10, 8000, 8000,
         0, 0, 0, 0, 0,
         1500, 1500, 1500,
-        false, true);
-    setFuelModelRecord(99, "NB9", "Bare ground [99]",
+        false, true, true },
+    { 99, "NB9", "Bare ground [99]",
         1.0, 0.10, 8000, 8000,
         0, 0, 0, 0, 0,
         1500, 1500, 1500,
-        false, true);
+        false, true, true },
 
     // Code GRx: Grass
     // Index 100 Available for custom GR model
-    double f = 2000.0 / 43560.0;
-    setFuelModelRecord(101, "GR1", "Short, sparse, dry climate grass (D)",
+    { 101, "GR1", "Short, sparse, dry climate grass (D)",
         0.4, 0.15, 8000, 8000,
-        0.10*f, 0, 0, 0.30*f, 0,
+        0.10*tonsPerAcre, 0, 0, 0.30*tonsPerAcre, 0,
         2200, 2000, 1500,
-        true, true);
-    setFuelModelRecord(102, "GR2", "Low load, dry climate grass (D)",
+        true, true, true },
+    { 102, "GR2", "Low load, dry climate grass (D)",
         1.0, 0.15, 8000, 8000,
-        0.10*f, 0, 0, 1.0*f, 0,
+        0.10*tonsPerAcre, 0, 0, 1.0*tonsPerAcre, 0,
         2000, 1800, 1500,
-        true, true);
-    setFuelModelRecord(103, "GR3",
+        true, true, true },
+    { 103, "GR3",
         "Low load, very coarse, humid climate grass (D)",
         2.0, 0.30, 8000, 8000,
-        0.10*f, 0.40*f, 0, 1.50*f, 0,
+        0.10*tonsPerAcre, 0.40*tonsPerAcre, 0, 1.50*tonsPerAcre, 0,
         1500, 1300, 1500,
-        true, true);
-    setFuelModelRecord(104, "GR4", "Moderate load, dry climate grass (D)",
+        true, true, true },
+    { 104, "GR4", "Moderate load, dry climate grass (D)",
         2.0, 0.15, 8000, 8000,
-        0.25*f, 0, 0, 1.9*f, 0,
+        0.25*tonsPerAcre, 0, 0, 1.9*tonsPerAcre, 0,
         2000, 1800, 1500,
-        true, true);
-    setFuelModelRecord(105, "GR5", "Low load, humid climate grass (D)",
+        true, true, true },
+    { 105, "GR5", "Low load, humid climate grass (D)",
         1.5, 0.40, 8000, 8000,
-        0.40*f, 0.0, 0.0, 2.50*f, 0.0,
+        0.40*tonsPerAcre, 0.0, 0.0, 2.50*tonsPerAcre, 0.0,
         1800, 1600, 1500,
-        true, true);
-    setFuelModelRecord(106, "GR6",
+        true, true, true },
+    { 106, "GR6",
         "Moderate load, humid climate grass (D)",
         1.5, 0.40, 9000, 9000,
-        0.10*f, 0, 0, 3.4*f, 0,
+        0.10*tonsPerAcre, 0, 0, 3.4*tonsPerAcre, 0,
         2200, 2000, 1500,
-        true, true);
-    setFuelModelRecord(107, "GR7",
+        true, true, true },
+    { 107, "GR7",
         "High load, dry climate grass (D)",
         3.0, 0.15, 8000, 8000,
-        1.0*f, 0, 0, 5.4*f, 0,
+        1.0*tonsPerAcre, 0, 0, 5.4*tonsPerAcre, 0,
         2000, 1800, 1500,
-        true, true);
-    setFuelModelRecord(108, "GR8",
+        true, true, true },
+    { 108, "GR8",
         "High load, very coarse, humid climate grass (D)",
         4.0, 0.30, 8000, 8000,
-        0.5*f, 1.0*f, 0, 7.3*f, 0,
+        0.5*tonsPerAcre, 1.0*tonsPerAcre, 0, 7.3*tonsPerAcre, 0,
         1500, 1300, 1500,
-        true, true);
-    setFuelModelRecord(109, "GR9",
+        true, true, true },
+    { 109, "GR9",
         "Very high load, humid climate grass (D)",
         5.0, 0.40, 8000, 8000,
-        1.0*f, 1.0*f, 0, 9.0*f, 0,
+        1.0*tonsPerAcre, 1.0*tonsPerAcre, 0, 9.0*tonsPerAcre, 0,
         1800, 1600, 1500,
-        true, true);
+        true, true, true },
     // 110-112 are reserved for future standard grass models
-    for (int i = 110; i <= 112; i++)
-    {
-        markAsReservedModel(i);
-    }
+    { 110, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 111, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 112, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
     // 113-119 are available for custom grass models
 
     // Code GSx: Grass and shrub
     // 120 available for custom grass and shrub model
-    setFuelModelRecord(121, "GS1",
+    { 121, "GS1",
         "Low load, dry climate grass-shrub (D)",
         0.9, 0.15, 8000, 8000,
-        0.2*f, 0, 0, 0.5*f, 0.65*f,
+        0.2*tonsPerAcre, 0, 0, 0.5*tonsPerAcre, 0.65*tonsPerAcre,
         2000, 1800, 1800,
-        true, true);
-    setFuelModelRecord(122, "GS2",
+        true, true, true },
+    { 122, "GS2",
         "Moderate load, dry climate grass-shrub (D)",
         1.5, 0.15, 8000, 8000,
-        0.5*f, 0.5*f, 0, 0.6*f, 1.0*f,
+        0.5*tonsPerAcre, 0.5*tonsPerAcre, 0, 0.6*tonsPerAcre, 1.0*tonsPerAcre,
         2000, 1800, 1800,
-        true, true);
-    setFuelModelRecord(123, "GS3",
+        true, true, true },
+    { 123, "GS3",
         "Moderate load, humid climate grass-shrub (D)",
         1.8, 0.40, 8000, 8000,
-        0.3*f, 0.25*f, 0, 1.45*f, 1.25*f,
+        0.3*tonsPerAcre, 0.25*tonsPerAcre, 0, 1.45*tonsPerAcre, 1.25*tonsPerAcre,
         1800, 1600, 1600,
-        true, true);
-    setFuelModelRecord(124, "GS4",
+        true, true, true },
+    { 124, "GS4",
         "High load, humid climate grass-shrub (D)",
         2.1, 0.40, 8000, 8000,
-        1.9*f, 0.3*f, 0.1*f, 3.4*f, 7.1*f,
+        1.9*tonsPerAcre, 0.3*tonsPerAcre, 0.1*tonsPerAcre, 3.4*tonsPerAcre, 7.1*tonsPerAcre,
         1800, 1600, 1600,
-        true, true);
+        true, true, true },
     // 125-130 reserved for future standard grass and shrub models
-    for (int i = 125; i <= 130; i++)
-    {
-        markAsReservedModel(i);
-    }
+    { 125, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 126, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 127, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 128, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 129, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 130, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
     // 131-139 available for custom grass and shrub models
 
     // Shrub
     // 140 available for custom shrub model
-    setFuelModelRecord(141, "SH1",
+    { 141, "SH1",
         "Low load, dry climate shrub (D)",
         1.0, 0.15, 8000, 8000,
-        0.25*f, 0.25*f, 0, 0.15*f, 1.3*f,
+        0.25*tonsPerAcre, 0.25*tonsPerAcre, 0, 0.15*tonsPerAcre, 1.3*tonsPerAcre,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(142, "SH2",
+        true, true, true },
+    { 142, "SH2",
         "Moderate load, dry climate shrub (S)",
         1.0, 0.15, 8000, 8000,
-        1.35*f, 2.4*f, 0.75*f, 0, 3.85*f,
+        1.35*tonsPerAcre, 2.4*tonsPerAcre, 0.75*tonsPerAcre, 0, 3.85*tonsPerAcre,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(143, "SH3",
+        true, true, true },
+    { 143, "SH3",
         "Moderate load, humid climate shrub (S)",
         2.4, 0.40, 8000., 8000.,
-        0.45*f, 3.0*f, 0, 0, 6.2*f,
+        0.45*tonsPerAcre, 3.0*tonsPerAcre, 0, 0, 6.2*tonsPerAcre,
         1600, 1800, 1400,
-        true, true);
-    setFuelModelRecord(144, "SH4",
+        true, true, true },
+    { 144, "SH4",
         "Low load, humid climate timber-shrub (S)",
         3.0, 0.30, 8000, 8000,
-        0.85*f, 1.15*f, 0.2*f, 0, 2.55*f,
+        0.85*tonsPerAcre, 1.15*tonsPerAcre, 0.2*tonsPerAcre, 0, 2.55*tonsPerAcre,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(145, "SH5",
+        true, true, true },
+    { 145, "SH5",
         "High load, dry climate shrub (S)",
         6.0, 0.15, 8000, 8000,
-        3.6*f, 2.1*f, 0, 0, 2.9*f,
+        3.6*tonsPerAcre, 2.1*tonsPerAcre, 0, 0, 2.9*tonsPerAcre,
         750, 1800, 1600,
-        true, true);
-    setFuelModelRecord(146, "SH6",
+        true, true, true },
+    { 146, "SH6",
         "Low load, humid climate shrub (S)",
         2.0, 0.30, 8000, 8000,
-        2.9*f, 1.45*f, 0, 0, 1.4*f,
+        2.9*tonsPerAcre, 1.45*tonsPerAcre, 0, 0, 1.4*tonsPerAcre,
         750, 1800, 1600,
-        true, true);
-    setFuelModelRecord(147, "SH7",
+        true, true, true },
+    { 147, "SH7",
         "Very high load, dry climate shrub (S)",
         6.0, 0.15, 8000, 8000,
-        3.5*f, 5.3*f, 2.2*f, 0, 3.4*f,
+        3.5*tonsPerAcre, 5.3*tonsPerAcre, 2.2*tonsPerAcre, 0, 3.4*tonsPerAcre,
         750, 1800, 1600,
-        true, true);
-    setFuelModelRecord(148, "SH8",
+        true, true, true },
+    { 148, "SH8",
         "High load, humid climate shrub (S)",
         3.0, 0.40, 8000, 8000,
-        2.05*f, 3.4*f, 0.85*f, 0, 4.35*f,
+        2.05*tonsPerAcre, 3.4*tonsPerAcre, 0.85*tonsPerAcre, 0, 4.35*tonsPerAcre,
         750, 1800, 1600,
-        true, true);
-    setFuelModelRecord(149, "SH9",
+        true, true, true },
+    { 149, "SH9",
         "Very high load, humid climate shrub (D)",
         4.4, 0.40, 8000, 8000,
-        4.5*f, 2.45*f, 0, 1.55*f, 7.0*f,
+        4.5*tonsPerAcre, 2.45*tonsPerAcre, 0, 1.55*tonsPerAcre, 7.0*tonsPerAcre,
         750, 1800, 1500,
-        true, true);
+        true, true, true },
     // 150-152 reserved for future standard shrub models
-    for (int i = 150; i <= 152; i++)
-    {
-        markAsReservedModel(i);
-    }
+    { 150, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 151, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 152, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
     // 153-159 available for custom shrub models
 
     // Timber and understory
     // 160 available for custom timber and understory model
-    setFuelModelRecord(161, "TU1",
+    { 161, "TU1",
         "Light load, dry climate timber-grass-shrub (D)",
         0.6, 0.20, 8000, 8000,
-        0.2*f, 0.9*f, 1.5*f, 0.2*f, 0.9*f,
+        0.2*tonsPerAcre, 0.9*tonsPerAcre, 1.5*tonsPerAcre, 0.2*tonsPerAcre, 0.9*tonsPerAcre,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(162, "TU2",
+        true, true, true },
+    { 162, "TU2",
         "Moderate load, humid climate timber-shrub (S)",
         1.0, 0.30, 8000, 8000,
-        0.95*f, 1.8*f, 1.25*f, 0, 0.2*f,
+        0.95*tonsPerAcre, 1.8*tonsPerAcre, 1.25*tonsPerAcre, 0, 0.2*tonsPerAcre,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(163, "TU3",
+        true, true, true },
+    { 163, "TU3",
         "Moderate load, humid climate timber-grass-shrub (D)",
         1.3, 0.30, 8000, 8000,
-        1.1*f, 0.15*f, 0.25*f, 0.65*f, 1.1*f,
+        1.1*tonsPerAcre, 0.15*tonsPerAcre, 0.25*tonsPerAcre, 0.65*tonsPerAcre, 1.1*tonsPerAcre,
         1800, 1600, 1400,
-        true, true);
-    setFuelModelRecord(164, "TU4",
+        true, true, true },
+    { 164, "TU4",
         "Dwarf conifer understory (S)",
         0.5, 0.12, 8000, 8000,
-        4.5*f, 0, 0, 0, 2.0*f,
+        4.5*tonsPerAcre, 0, 0, 0, 2.0*tonsPerAcre,
         2300, 1800, 2000,
-        true, true);
-    setFuelModelRecord(165, "TU5",
+        true, true, true },
+    { 165, "TU5",
         "Very high load, dry climate timber-shrub (S)",
         1.0, 0.25, 8000, 8000,
-        4.0*f, 4.0*f, 3.0*f, 0, 3.0*f,
+        4.0*tonsPerAcre, 4.0*tonsPerAcre, 3.0*tonsPerAcre, 0, 3.0*tonsPerAcre,
         1500, 1800, 750,
-        true, true);
+        true, true, true },
     // 166-170 reserved for future standard timber and understory models
-    for (int i = 166; i <= 170; i++)
-    {
-        markAsReservedModel(i);
-    }
+    { 166, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 167, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 168, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 169, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 170, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
     // 171-179 available for custom timber and understory models
 
     // Timber and litter
     // 180 available for custom timber and litter models
-    setFuelModelRecord(181, "TL1",
+    { 181, "TL1",
         "Low load, compact conifer litter (S)",
         0.2, 0.30, 8000, 8000,
-        1.0*f, 2.2*f, 3.6*f, 0, 0,
+        1.0*tonsPerAcre, 2.2*tonsPerAcre, 3.6*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(182, "TL2",
+        true, true, true },
+    { 182, "TL2",
         "Low load broadleaf litter (S)",
         0.2, 0.25, 8000, 8000,
-        1.4*f, 2.3*f, 2.2*f, 0, 0,
+        1.4*tonsPerAcre, 2.3*tonsPerAcre, 2.2*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(183, "TL3",
+        true, true, true },
+    { 183, "TL3",
         "Moderate load conifer litter (S)",
         0.3, 0.20, 8000, 8000,
-        0.5*f, 2.2*f, 2.8*f, 0, 0,
+        0.5*tonsPerAcre, 2.2*tonsPerAcre, 2.8*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(184, "TL4",
+        true, true, true },
+    { 184, "TL4",
         "Small downed logs (S)",
         0.4, 0.25, 8000, 8000,
-        0.5*f, 1.5*f, 4.2*f, 0, 0,
+        0.5*tonsPerAcre, 1.5*tonsPerAcre, 4.2*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(185, "TL5",
+        true, true, true },
+    { 185, "TL5",
         "High load conifer litter (S)",
         0.6, 0.25, 8000, 8000,
-        1.15*f, 2.5*f, 4.4*f, 0, 0,
+        1.15*tonsPerAcre, 2.5*tonsPerAcre, 4.4*tonsPerAcre, 0, 0,
         2000, 1800, 160,
-        true, true);
-    setFuelModelRecord(186, "TL6",
+        true, true, true },
+    { 186, "TL6",
         "High load broadleaf litter (S)",
         0.3, 0.25, 8000, 8000,
-        2.4*f, 1.2*f, 1.2*f, 0, 0,
+        2.4*tonsPerAcre, 1.2*tonsPerAcre, 1.2*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(187, "TL7",
+        true, true, true },
+    { 187, "TL7",
         "Large downed logs (S)",
         0.4, 0.25, 8000, 8000,
-        0.3*f, 1.4*f, 8.1*f, 0, 0,
+        0.3*tonsPerAcre, 1.4*tonsPerAcre, 8.1*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(188, "TL8",
+        true, true, true },
+    { 188, "TL8",
         "Long-needle litter (S)",
         0.3, 0.35, 8000, 8000,
-        5.8*f, 1.4*f, 1.1*f, 0, 0,
+        5.8*tonsPerAcre, 1.4*tonsPerAcre, 1.1*tonsPerAcre, 0, 0,
         1800, 1800, 1600,
-        true, true);
-    setFuelModelRecord(189, "TL9",
+        true, true, true },
+    { 189, "TL9",
         "Very high load broadleaf litter (S)",
         0.6, 0.35, 8000, 8000,
-        6.65*f, 3.30*f, 4.15*f, 0, 0,
+        6.65*tonsPerAcre, 3.30*tonsPerAcre, 4.15*tonsPerAcre, 0, 0,
         1800, 1800, 1600,
-        true, true);
+        true, true, true },
     // 190-192 reserved for future standard timber and litter models
-    for (int i = 190; i <= 192; i++)
-    {
-        markAsReservedModel(i);
-    }
+    { 190, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 191, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 192, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
 
     // 193-199 available for custom timber and litter models
 
     // Slash and blowdown
     // 200 available for custom slash and blowdown model
-    setFuelModelRecord(201, "SB1",
+    { 201, "SB1",
         "Low load activity fuel (S)",
         1.0, 0.25, 8000, 8000,
-        1.5*f, 3.0*f, 11.0*f, 0, 0,
+        1.5*tonsPerAcre, 3.0*tonsPerAcre, 11.0*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(202, "SB2",
+        true, true, true },
+    { 202, "SB2",
         "Moderate load activity or low load blowdown (S)",
         1.0, 0.25, 8000, 8000,
-        4.5*f, 4.25*f, 4.0*f, 0, 0,
+        4.5*tonsPerAcre, 4.25*tonsPerAcre, 4.0*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(203, "SB3",
+        true, true, true },
+    { 203, "SB3",
         "High load activity fuel or moderate load blowdown (S)",
         1.2, 0.25, 8000, 8000,
-        5.5*f, 2.75*f, 3.0*f, 0, 0,
+        5.5*tonsPerAcre, 2.75*tonsPerAcre, 3.0*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
-    setFuelModelRecord(204, "SB4",
+        true, true, true },
+    { 204, "SB4",
         "High load blowdown (S)",
         2.7, 0.25, 8000, 8000,
-        5.25*f, 3.5*f, 5.25*f, 0, 0,
+        5.25*tonsPerAcre, 3.5*tonsPerAcre, 5.25*tonsPerAcre, 0, 0,
         2000, 1800, 1600,
-        true, true);
+        true, true, true },
     // 205-210 reserved for future slash and blowdown models
-    for (int i = 205; i <= 210; i++)
-    {
-        markAsReservedModel(i);
-    }
+    { 205, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 206, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 207, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 208, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 209, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
+    { 210, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, true, false },
     // 211-219 available for custom  slash and blowdown models
 
     // 220 - 256 Available for custom models
+};
+
+static constexpr int numberOfStandardFuelModels = (int)(sizeof(standardFuelModels) / sizeof(standardFuelModels[0]));
+
+// Position in standardFuelModels of each fuel model number, -1 if not listed
+struct StandardFuelModelIndex
+{
+    short position[FuelConstants::MaxFuelModels];
+};
+
+static constexpr StandardFuelModelIndex makeStandardFuelModelIndex()
+{
+    StandardFuelModelIndex index = {};
+    for (int i = 0; i < FuelConstants::MaxFuelModels; i++)
+    {
+        index.position[i] = -1;
+    }
+    for (int i = 0; i < numberOfStandardFuelModels; i++)
+    {
+        index.position[standardFuelModels[i].fuelModelNumber_] = (short)i;
+    }
+    return index;
+}
+
+static constexpr StandardFuelModelIndex standardFuelModelIndex = makeStandardFuelModelIndex();
+
+// Record returned for fuel model numbers that are neither standard nor custom
+static constexpr FuelModels::FuelModelRecord undefinedFuelModel =
+    { 0, "NO_CODE", "NO_NAME", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, false, false };
+
+FuelModels::FuelModels()
+{
+    // Nothing to populate, the standard fuel models are in standardFuelModels
+}
+
+FuelModels::FuelModels(const FuelModels& rhs)
+{
+    memberwiseCopyAssignment(rhs);
+}
+
+FuelModels& FuelModels::operator=(const FuelModels& rhs)
+{
+    if (this != &rhs)
+    {
+        memberwiseCopyAssignment(rhs);
+    }
+    return *this;
+}
+
+void FuelModels::memberwiseCopyAssignment(const FuelModels& rhs)
+{
+    // Only the reference count changes, the custom fuel models are immutable
+    customFuelModels_ = rhs.customFuelModels_;
+}
+
+FuelModels::~FuelModels()
+{
+
+}
+
+const FuelModels::FuelModelRecord& FuelModels::getFuelModelRecord(int fuelModelNumber) const
+{
+    // Custom fuel models take precedence over the standard ones
+    if (customFuelModels_)
+    {
+        std::unordered_map<int, unsigned int>::const_iterator found = customFuelModels_->index_.find(fuelModelNumber);
+        if (found != customFuelModels_->index_.end())
+        {
+            return customFuelModels_->records_[found->second].record_;
+        }
+    }
+    if (fuelModelNumber >= 0 && fuelModelNumber < FuelConstants::MaxFuelModels
+        && standardFuelModelIndex.position[fuelModelNumber] >= 0)
+    {
+        return standardFuelModels[standardFuelModelIndex.position[fuelModelNumber]];
+    }
+    return undefinedFuelModel;
+}
+
+void FuelModels::setFuelModelRecord(int fuelModelNumber, std::string code, std::string name,
+    double fuelBedDepth, double moistureOfExtinctionDead, double heatOfCombustionDead, double heatOfCombustionLive,
+    double fuelLoadOneHour, double fuelLoadTenHour, double fuelLoadHundredHour, double fuelLoadliveHerbaceous,
+    double fuelLoadliveWoody, double savrOneHour, double savrLiveHerbaceous, double savrLiveWoody,
+    bool isDynamic, bool isReserved)
+{
+    CustomFuelModelRecord customFuelModel;
+    customFuelModel.code_ = code;
+    customFuelModel.name_ = name;
+    customFuelModel.record_.fuelModelNumber_ = fuelModelNumber;
+    customFuelModel.record_.fuelbedDepth_ = fuelBedDepth;
+    customFuelModel.record_.moistureOfExtinctionDead_ = moistureOfExtinctionDead;
+    customFuelModel.record_.heatOfCombustionDead_ = heatOfCombustionDead;
+    customFuelModel.record_.heatOfCombustionLive_ = heatOfCombustionLive;
+    customFuelModel.record_.fuelLoadOneHour_ = fuelLoadOneHour;
+    customFuelModel.record_.fuelLoadTenHour_ = fuelLoadTenHour;
+    customFuelModel.record_.fuelLoadHundredHour_ = fuelLoadHundredHour;
+    customFuelModel.record_.fuelLoadLiveHerbaceous_ = fuelLoadliveHerbaceous;
+    customFuelModel.record_.fuelLoadLiveWoody_ = fuelLoadliveWoody;
+    customFuelModel.record_.savrOneHour_ = savrOneHour;
+    customFuelModel.record_.savrLiveHerbaceous_ = savrLiveHerbaceous;
+    customFuelModel.record_.savrLiveWoody_ = savrLiveWoody;
+    customFuelModel.record_.isDynamic_ = isDynamic;
+    customFuelModel.record_.isReserved_ = isReserved;
+    customFuelModel.record_.isDefined_ = true;
+
+    // Build the new version aside, then publish it
+    std::shared_ptr<CustomFuelModelCatalog> customFuelModels = copyCustomFuelModels();
+    insertCustomFuelModelRecord(*customFuelModels, customFuelModel);
+    updateCustomFuelModelNames(*customFuelModels);
+    customFuelModels_ = customFuelModels;
+}
+
+void FuelModels::eraseCustomFuelModelRecord(int fuelModelNumber)
+{
+    if (!customFuelModels_ || customFuelModels_->index_.count(fuelModelNumber) == 0)
+    {
+        return;
+    }
+
+    std::shared_ptr<CustomFuelModelCatalog> customFuelModels = copyCustomFuelModels();
+    std::vector<CustomFuelModelRecord>& records = customFuelModels->records_;
+    unsigned int position = customFuelModels->index_[fuelModelNumber];
+    // Move the last record into the hole so only one index entry changes
+    if (position + 1 < records.size())
+    {
+        records[position] = records.back();
+        customFuelModels->index_[records[position].record_.fuelModelNumber_] = position;
+    }
+    records.pop_back();
+    customFuelModels->index_.erase(fuelModelNumber);
+    updateCustomFuelModelNames(*customFuelModels);
+    customFuelModels_ = customFuelModels;
+}
+
+std::shared_ptr<FuelModels::CustomFuelModelCatalog> FuelModels::copyCustomFuelModels() const
+{
+    std::shared_ptr<CustomFuelModelCatalog> customFuelModels = std::make_shared<CustomFuelModelCatalog>();
+    if (customFuelModels_)
+    {
+        *customFuelModels = *customFuelModels_;
+        updateCustomFuelModelNames(*customFuelModels);
+    }
+    return customFuelModels;
+}
+
+void FuelModels::insertCustomFuelModelRecord(CustomFuelModelCatalog& customFuelModels, const CustomFuelModelRecord& customFuelModel)
+{
+    // Callers must call updateCustomFuelModelNames() once done inserting
+    int fuelModelNumber = customFuelModel.record_.fuelModelNumber_;
+    std::unordered_map<int, unsigned int>::iterator found = customFuelModels.index_.find(fuelModelNumber);
+    if (found != customFuelModels.index_.end())
+    {
+        customFuelModels.records_[found->second] = customFuelModel;
+    }
+    else
+    {
+        customFuelModels.index_[fuelModelNumber] = (unsigned int)customFuelModels.records_.size();
+        customFuelModels.records_.push_back(customFuelModel);
+    }
+}
+
+void FuelModels::updateCustomFuelModelNames(CustomFuelModelCatalog& customFuelModels)
+{
+    // The records point into their own strings, which move whenever the vector does
+    std::vector<CustomFuelModelRecord>& records = customFuelModels.records_;
+    for (unsigned int i = 0; i < records.size(); i++)
+    {
+        records[i].record_.code_ = records[i].code_.c_str();
+        records[i].record_.name_ = records[i].name_.c_str();
+    }
+}
+
+bool FuelModels::isCustomFuelModelNumberAllowed(int fuelModelNumber) const
+{
+    return (fuelModelNumber >= 0) && (getFuelModelRecord(fuelModelNumber).isReserved_ == false);
+}
+
+int FuelModels::getNumberOfCustomFuelModels() const
+{
+    return customFuelModels_ ? (int)customFuelModels_->records_.size() : 0;
+}
+
+std::vector<int> FuelModels::getCustomFuelModelNumbers() const
+{
+    std::vector<int> fuelModelNumbers;
+    if (customFuelModels_)
+    {
+        fuelModelNumbers.reserve(customFuelModels_->records_.size());
+        for (unsigned int i = 0; i < customFuelModels_->records_.size(); i++)
+        {
+            fuelModelNumbers.push_back(customFuelModels_->records_[i].record_.fuelModelNumber_);
+        }
+        std::sort(fuelModelNumbers.begin(), fuelModelNumbers.end());
+    }
+    return fuelModelNumbers;
+}
+
+bool FuelModels::loadCustomFuelModels(const std::string& fileName)
+{
+    MappedFile catalogFile;
+    if (!catalogFile.open(fileName))
+    {
+        return false;
+    }
+    const char* data = catalogFile.getData();
+    const std::size_t fileSize = catalogFile.getSize();
+
+    FuelModelCatalogFileHeader header;
+    if (fileSize < sizeof(header))
+    {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, fuelModelCatalogMagic, sizeof(header.magic)) != 0
+        || header.byteOrderMark != fuelModelCatalogByteOrderMark
+        || header.version != fuelModelCatalogVersion
+        || header.recordSize != sizeof(FuelModelCatalogFileRecord))
+    {
+        return false;
+    }
+    const uint64_t recordsSize = (uint64_t)header.numberOfRecords * sizeof(FuelModelCatalogFileRecord);
+    if (header.stringTableOffset < sizeof(header) + recordsSize
+        || header.stringTableOffset > fileSize
+        || header.stringTableSize > fileSize - header.stringTableOffset)
+    {
+        return false;
+    }
+    const char* stringTable = data + header.stringTableOffset;
+    const uint64_t stringTableSize = header.stringTableSize;
+    // Every string must end inside the table
+    if (stringTableSize > 0 && stringTable[stringTableSize - 1] != '\0')
+    {
+        return false;
+    }
+
+    std::shared_ptr<CustomFuelModelCatalog> customFuelModels = copyCustomFuelModels();
+    customFuelModels->records_.reserve(customFuelModels->records_.size() + header.numberOfRecords);
+    customFuelModels->index_.reserve(customFuelModels->records_.size() + header.numberOfRecords);
+    const char* fileRecords = data + sizeof(header);
+    for (uint32_t i = 0; i < header.numberOfRecords; i++)
+    {
+        FuelModelCatalogFileRecord fileRecord;
+        memcpy(&fileRecord, fileRecords + i * sizeof(FuelModelCatalogFileRecord), sizeof(fileRecord));
+        if (!isCustomFuelModelNumberAllowed(fileRecord.fuelModelNumber)
+            || fileRecord.codeOffset >= stringTableSize || fileRecord.nameOffset >= stringTableSize)
+        {
+            return false;
+        }
+
+        CustomFuelModelRecord customFuelModel;
+        customFuelModel.code_ = stringTable + fileRecord.codeOffset;
+        customFuelModel.name_ = stringTable + fileRecord.nameOffset;
+        customFuelModel.record_.fuelModelNumber_ = fileRecord.fuelModelNumber;
+        customFuelModel.record_.fuelbedDepth_ = fileRecord.fuelbedDepth;
+        customFuelModel.record_.moistureOfExtinctionDead_ = fileRecord.moistureOfExtinctionDead;
+        customFuelModel.record_.heatOfCombustionDead_ = fileRecord.heatOfCombustionDead;
+        customFuelModel.record_.heatOfCombustionLive_ = fileRecord.heatOfCombustionLive;
+        customFuelModel.record_.fuelLoadOneHour_ = fileRecord.fuelLoadOneHour;
+        customFuelModel.record_.fuelLoadTenHour_ = fileRecord.fuelLoadTenHour;
+        customFuelModel.record_.fuelLoadHundredHour_ = fileRecord.fuelLoadHundredHour;
+        customFuelModel.record_.fuelLoadLiveHerbaceous_ = fileRecord.fuelLoadLiveHerbaceous;
+        customFuelModel.record_.fuelLoadLiveWoody_ = fileRecord.fuelLoadLiveWoody;
+        customFuelModel.record_.savrOneHour_ = fileRecord.savrOneHour;
+        customFuelModel.record_.savrLiveHerbaceous_ = fileRecord.savrLiveHerbaceous;
+        customFuelModel.record_.savrLiveWoody_ = fileRecord.savrLiveWoody;
+        customFuelModel.record_.isDynamic_ = (fileRecord.flags & fuelModelCatalogDynamicFlag) != 0;
+        customFuelModel.record_.isReserved_ = false;
+        customFuelModel.record_.isDefined_ = true;
+        insertCustomFuelModelRecord(*customFuelModels, customFuelModel);
+    }
+    updateCustomFuelModelNames(*customFuelModels);
+    customFuelModels_ = customFuelModels;
+    return true;
+}
+
+bool FuelModels::saveCustomFuelModels(const std::string& fileName) const
+{
+    std::vector<int> fuelModelNumbers = getCustomFuelModelNumbers();
+
+    std::vector<FuelModelCatalogFileRecord> fileRecords(fuelModelNumbers.size());
+    std::string stringTable;
+    for (unsigned int i = 0; i < fuelModelNumbers.size(); i++)
+    {
+        const FuelModelRecord& record = getFuelModelRecord(fuelModelNumbers[i]);
+        FuelModelCatalogFileRecord& fileRecord = fileRecords[i];
+        memset(&fileRecord, 0, sizeof(fileRecord));
+        fileRecord.fuelModelNumber = record.fuelModelNumber_;
+        fileRecord.codeOffset = (uint32_t)stringTable.size();
+        stringTable.append(record.code_);
+        stringTable.push_back('\0');
+        fileRecord.nameOffset = (uint32_t)stringTable.size();
+        stringTable.append(record.name_);
+        stringTable.push_back('\0');
+        fileRecord.flags = record.isDynamic_ ? fuelModelCatalogDynamicFlag : 0;
+        fileRecord.fuelbedDepth = record.fuelbedDepth_;
+        fileRecord.moistureOfExtinctionDead = record.moistureOfExtinctionDead_;
+        fileRecord.heatOfCombustionDead = record.heatOfCombustionDead_;
+        fileRecord.heatOfCombustionLive = record.heatOfCombustionLive_;
+        fileRecord.fuelLoadOneHour = record.fuelLoadOneHour_;
+        fileRecord.fuelLoadTenHour = record.fuelLoadTenHour_;
+        fileRecord.fuelLoadHundredHour = record.fuelLoadHundredHour_;
+        fileRecord.fuelLoadLiveHerbaceous = record.fuelLoadLiveHerbaceous_;
+        fileRecord.fuelLoadLiveWoody = record.fuelLoadLiveWoody_;
+        fileRecord.savrOneHour = record.savrOneHour_;
+        fileRecord.savrLiveHerbaceous = record.savrLiveHerbaceous_;
+        fileRecord.savrLiveWoody = record.savrLiveWoody_;
+    }
+
+    FuelModelCatalogFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, fuelModelCatalogMagic, sizeof(header.magic));
+    header.byteOrderMark = fuelModelCatalogByteOrderMark;
+    header.version = fuelModelCatalogVersion;
+    header.numberOfRecords = (uint32_t)fileRecords.size();
+    header.recordSize = sizeof(FuelModelCatalogFileRecord);
+    header.stringTableOffset = sizeof(header) + fileRecords.size() * sizeof(FuelModelCatalogFileRecord);
+    header.stringTableSize = stringTable.size();
+
+    std::ofstream outputFile(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!outputFile)
+    {
+        return false;
+    }
+    outputFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!fileRecords.empty())
+    {
+        outputFile.write(reinterpret_cast<const char*>(&fileRecords[0]), fileRecords.size() * sizeof(FuelModelCatalogFileRecord));
+    }
+    outputFile.write(stringTable.data(), stringTable.size());
+    return (bool)outputFile;
 }
 
 // SetCustomFuelModel() is used by client code to define custom fuel types
@@ -607,7 +876,7 @@ bool FuelModels::setCustomFuelModel(int fuelModelNumber, std::string code, std::
         savrLiveWoody = SurfaceAreaToVolumeUnits::toBaseUnits(savrLiveWoody, savrUnits);
     }
 
-    if (FuelModelVector_[fuelModelNumber].isReserved_ == false)
+    if (isCustomFuelModelNumberAllowed(fuelModelNumber))
     {
         setFuelModelRecord(fuelModelNumber, code, name,
             fuelBedDepth, moistureOfExtinctionDead, heatOfCombustionDead, heatOfCombustionLive,
@@ -623,126 +892,149 @@ bool FuelModels::clearCustomFuelModel(int fuelModelNumber)
 {
     bool successStatus = false;
 
-    if (FuelModelVector_[fuelModelNumber].isReserved_)
+    if (!isCustomFuelModelNumberAllowed(fuelModelNumber))
     {
         successStatus = false;
     }
     else
     {
-        initializeSingleFuelModelRecord(fuelModelNumber);
+        eraseCustomFuelModelRecord(fuelModelNumber);
         successStatus = true;
     }
     return successStatus;
 }
 
-void FuelModels::markAsReservedModel(int fuelModelNumber)
+FuelModels FuelModels::withCustomModel(int fuelModelNumber, std::string code, std::string name,
+    double fuelBedDepth, LengthUnits::LengthUnitsEnum lengthUnits, double moistureOfExtinctionDead,
+    FractionUnits::FractionUnitsEnum moistureUnits, double heatOfCombustionDead, double heatOfCombustionLive,
+    HeatOfCombustionUnits::HeatOfCombustionUnitsEnum heatOfCombustionUnits,
+    double fuelLoadOneHour, double fuelLoadTenHour, double fuelLoadHundredHour, double fuelLoadLiveHerbaceous,
+    double fuelLoadLiveWoody, LoadingUnits::LoadingUnitsEnum loadingUnits, double savrOneHour, double savrLiveHerbaceous,
+    double savrLiveWoody, SurfaceAreaToVolumeUnits::SurfaceAreaToVolumeUnitsEnum savrUnits, bool isDynamic) const
+{
+    FuelModels fuelModels(*this);
+    fuelModels.setCustomFuelModel(fuelModelNumber, code, name, fuelBedDepth, lengthUnits, moistureOfExtinctionDead,
+        moistureUnits, heatOfCombustionDead, heatOfCombustionLive, heatOfCombustionUnits,
+        fuelLoadOneHour, fuelLoadTenHour, fuelLoadHundredHour, fuelLoadLiveHerbaceous, fuelLoadLiveWoody,
+        loadingUnits, savrOneHour, savrLiveHerbaceous, savrLiveWoody, savrUnits, isDynamic);
+    return fuelModels;
+}
+
+FuelModels FuelModels::withoutCustomModel(int fuelModelNumber) const
+{
+    FuelModels fuelModels(*this);
+    fuelModels.clearCustomFuelModel(fuelModelNumber);
+    return fuelModels;
+}
+
+bool FuelModels::sharesCustomFuelModelsWith(const FuelModels& rhs) const
 {
-    FuelModelVector_[fuelModelNumber].isReserved_ = true;
+    return customFuelModels_ == rhs.customFuelModels_;
 }
 
 double FuelModels::getFuelbedDepth(int fuelModelNumber, LengthUnits::LengthUnitsEnum lengthUnits) const
 {
-    return LengthUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].fuelbedDepth_, lengthUnits);
+    return LengthUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).fuelbedDepth_, lengthUnits);
 }
 
 std::string FuelModels::getFuelCode(int fuelModelNumber) const
 {
-    return FuelModelVector_[fuelModelNumber].code_;
+    return getFuelModelRecord(fuelModelNumber).code_;
 }
 
 std::string FuelModels::getFuelName(int fuelModelNumber) const
 {
-    return FuelModelVector_[fuelModelNumber].name_;
+    return getFuelModelRecord(fuelModelNumber).name_;
 }
 
 double FuelModels::getMoistureOfExtinctionDead(int fuelModelNumber, FractionUnits::FractionUnitsEnum moistureUnits) const
 {
-    return FractionUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].moistureOfExtinctionDead_, moistureUnits);
+    return FractionUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).moistureOfExtinctionDead_, moistureUnits);
 }
 
 double FuelModels::getHeatOfCombustionDead(int fuelModelNumber, HeatOfCombustionUnits::HeatOfCombustionUnitsEnum heatOfCombustionUnits) const
 {
-    return HeatOfCombustionUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].heatOfCombustionDead_, heatOfCombustionUnits);
+    return HeatOfCombustionUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).heatOfCombustionDead_, heatOfCombustionUnits);
 }
 
 double FuelModels::getHeatOfCombustionLive(int fuelModelNumber, HeatOfCombustionUnits::HeatOfCombustionUnitsEnum heatOfCombustionUnits) const
 {
-    return HeatOfCombustionUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].heatOfCombustionLive_, heatOfCombustionUnits);
+    return HeatOfCombustionUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).heatOfCombustionLive_, heatOfCombustionUnits);
 }
 
 double FuelModels::getFuelLoadOneHour(int fuelModelNumber, LoadingUnits::LoadingUnitsEnum loadingUnits) const
 {
-    return LoadingUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].fuelLoadOneHour_, loadingUnits);
+    return LoadingUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).fuelLoadOneHour_, loadingUnits);
 }
 
 double FuelModels::getFuelLoadTenHour(int fuelModelNumber, LoadingUnits::LoadingUnitsEnum loadingUnits) const
 {
-    return LoadingUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].fuelLoadTenHour_, loadingUnits);
+    return LoadingUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).fuelLoadTenHour_, loadingUnits);
 }
 
 double FuelModels::getFuelLoadHundredHour(int fuelModelNumber, LoadingUnits::LoadingUnitsEnum loadingUnits) const
 {
-    return LoadingUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].fuelLoadHundredHour_, loadingUnits);
+    return LoadingUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).fuelLoadHundredHour_, loadingUnits);
 }
 
 double FuelModels::getFuelLoadLiveHerbaceous(int fuelModelNumber, LoadingUnits::LoadingUnitsEnum loadingUnits) const
 {
-    return LoadingUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].fuelLoadLiveHerbaceous_, loadingUnits);
+    return LoadingUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).fuelLoadLiveHerbaceous_, loadingUnits);
 }
 
 double FuelModels::getFuelLoadLiveWoody(int fuelModelNumber, LoadingUnits::LoadingUnitsEnum loadingUnits) const
 {
-    return LoadingUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].fuelLoadLiveWoody_, loadingUnits);
+    return LoadingUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).fuelLoadLiveWoody_, loadingUnits);
 }
 
 double FuelModels::getSavrOneHour(int fuelModelNumber, SurfaceAreaToVolumeUnits::SurfaceAreaToVolumeUnitsEnum savrUnits) const
 {
-    return SurfaceAreaToVolumeUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].savrOneHour_, savrUnits);
+    return SurfaceAreaToVolumeUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).savrOneHour_, savrUnits);
 }
 
 double FuelModels::getSavrLiveHerbaceous(int fuelModelNumber, SurfaceAreaToVolumeUnits::SurfaceAreaToVolumeUnitsEnum savrUnits) const
 {
-    return SurfaceAreaToVolumeUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].savrLiveHerbaceous_, savrUnits);
+    return SurfaceAreaToVolumeUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).savrLiveHerbaceous_, savrUnits);
 }
 
 double FuelModels::getSavrLiveWoody(int fuelModelNumber, SurfaceAreaToVolumeUnits::SurfaceAreaToVolumeUnitsEnum savrUnits) const
 {
-    return SurfaceAreaToVolumeUnits::fromBaseUnits(FuelModelVector_[fuelModelNumber].savrLiveWoody_, savrUnits);
+    return SurfaceAreaToVolumeUnits::fromBaseUnits(getFuelModelRecord(fuelModelNumber).savrLiveWoody_, savrUnits);
 }
 
 bool FuelModels::getIsDynamic(int fuelModelNumber) const
 {
-    if(fuelModelNumber <= 0 || fuelModelNumber > 256)
+    if (fuelModelNumber <= 0)
     {
         return false;
     }
     else
     {
-        return FuelModelVector_[fuelModelNumber].isDynamic_;
+        return getFuelModelRecord(fuelModelNumber).isDynamic_;
     }
 }
 
 bool FuelModels::isFuelModelDefined(int fuelModelNumber) const
 {
-    if (fuelModelNumber <= 0 || fuelModelNumber > 256)
+    if (fuelModelNumber <= 0)
     {
         return false;
     }
     else
     {
-        return FuelModelVector_[fuelModelNumber].isDefined_;
+        return getFuelModelRecord(fuelModelNumber).isDefined_;
     }
 }
 
 bool FuelModels::isFuelModelReserved(int fuelModelNumber) const
 {
-    if(fuelModelNumber <= 0 || fuelModelNumber > 256)
+    if (fuelModelNumber <= 0)
     {
         return false;
     }
     else
     {
-        return  FuelModelVector_[fuelModelNumber].isReserved_;
+        return  getFuelModelRecord(fuelModelNumber).isReserved_;
     }
 }
 
@@ -33,9 +33,21 @@
 #define FUELMODELS_H
 
 #include "behaveUnits.h"
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+// Copies of a FuelModels share its custom fuel models, which are never modified
+// in place. Changing a custom fuel model gives only the changed object a new
+// version, so copies held by other runs or threads are unaffected.
+//
+// BehaveRun, Surface and Crown keep a pointer to the FuelModels they are given,
+// not a copy, and a FuelModels is not safe to change while another thread reads
+// it. To change custom fuel models while runs are in flight, change a copy (or
+// use withCustomModel() and withoutCustomModel()) and give the new version to
+// runs started later with setFuelModels(); the object in use must outlive its
+// runs and stay unchanged until they finish.
 class FuelModels
 {
 public:
@@ -53,6 +65,32 @@ public:
         double savrLiveWoody, SurfaceAreaToVolumeUnits::SurfaceAreaToVolumeUnitsEnum savrUnits, bool isDynamic);
     bool clearCustomFuelModel(int fuelModelNumber);
 
+    // Builders returning a new version, this object is left unchanged. If the
+    // fuel model number is reserved the returned version equals this one
+    FuelModels withCustomModel(int fuelModelNumber, std::string code, std::string name,
+        double fuelBedDepth, LengthUnits::LengthUnitsEnum lengthUnits, double moistureOfExtinctionDead,
+        FractionUnits::FractionUnitsEnum moistureUnits, double heatOfCombustionDead, double heatOfCombustionLive,
+        HeatOfCombustionUnits::HeatOfCombustionUnitsEnum heatOfCombustionUnits,
+        double fuelLoadOneHour, double fuelLoadTenHour, double fuelLoadHundredHour, double fuelLoadLiveHerbaceous,
+        double fuelLoadLiveWoody, LoadingUnits::LoadingUnitsEnum loadingUnits, double savrOneHour, double savrLiveHerbaceous,
+        double savrLiveWoody, SurfaceAreaToVolumeUnits::SurfaceAreaToVolumeUnitsEnum savrUnits, bool isDynamic) const;
+    FuelModels withoutCustomModel(int fuelModelNumber) const;
+
+    // True if both objects are the same version of the custom fuel models
+    bool sharesCustomFuelModelsWith(const FuelModels& rhs) const;
+
+    // Custom fuel model numbers are not limited to the standard 1 to 256 range,
+    // any non-negative int that is not a reserved standard fuel model may be used
+    int getNumberOfCustomFuelModels() const;
+    std::vector<int> getCustomFuelModelNumbers() const;
+
+    // Bulk load and save of custom fuel models in the binary catalog format
+    // described in fuelModels.cpp. Loading adds to or replaces the custom fuel
+    // models already set and fails without changing anything if the file is
+    // not a valid catalog
+    bool loadCustomFuelModels(const std::string& fileName);
+    bool saveCustomFuelModels(const std::string& fileName) const;
+
     std::string getFuelCode(int fuelModelNumber) const;
     std::string getFuelName(int fuelModelNumber) const;
     double getFuelbedDepth(int fuelModelNumber, LengthUnits::LengthUnitsEnum lengthUnits) const;
@@ -72,23 +110,13 @@ public:
     bool isFuelModelReserved(int fuelModelNumber) const;
     bool isAllFuelLoadZero(int fuelModelNumber) const;
 
-protected:
-    void memberwiseCopyAssignment(const FuelModels& rhs);
-    void initializeSingleFuelModelRecord(int fuelModelNumber);
-    void initializeAllFuelModelRecords();
-    void populateFuelModels();
-    void markAsReservedModel(int fuelModelNumber);
-    void setFuelModelRecord(int fuelModelNumber, std::string code, std::string name,
-        double fuelBedDepth, double moistureOfExtinctionDead, double heatOfCombustionDead, double heatOfCombustionLive,
-        double fuelLoadOneHour, double fuelLoadTenHour, double fuelLoadHundredHour, double fuelLoadLiveHerbaceous,
-        double fuelLoadLiveWoody, double savrOneHourFuel, double savrLiveHerbaceous, double savrLiveWoody,
-        bool isDynamic, bool isReserved);
-
+    // Standard fuel models are kept in a constexpr table shared by every FuelModels
+    // object, each object only holds its custom fuel models
     struct FuelModelRecord
     {
         int fuelModelNumber_;               // Standard ID number for fuel model 
-        std::string code_;                  // Fuel model code, usually 2 letters followed by number,(e.g., "GR1")
-        std::string name_;                  // Fuel model name, (e.g., "Humid Climate Grass")
+        const char* code_;                  // Fuel model code, usually 2 letters followed by number,(e.g., "GR1")
+        const char* name_;                  // Fuel model name, (e.g., "Humid Climate Grass")
         double fuelbedDepth_;               // Fuelbed depth in feet
         double moistureOfExtinctionDead_;   // Dead fuel extinction moisture content (fraction)
         double heatOfCombustionDead_;       // Dead fuel heat of combustion (Btu/lb)
@@ -106,7 +134,35 @@ protected:
         bool isDefined_;                    // If true, record has been populated with values for its fields
     };
 
-    std::vector<FuelModelRecord> FuelModelVector_;
+protected:
+    // A custom fuel model record along with the strings its code and name point to
+    struct CustomFuelModelRecord
+    {
+        FuelModelRecord record_;
+        std::string code_;
+        std::string name_;
+    };
+    // Custom fuel models with a hash index on fuel model number
+    struct CustomFuelModelCatalog
+    {
+        std::vector<CustomFuelModelRecord> records_;
+        std::unordered_map<int, unsigned int> index_;   // fuel model number to position in records_
+    };
+
+    void memberwiseCopyAssignment(const FuelModels& rhs);
+    const FuelModelRecord& getFuelModelRecord(int fuelModelNumber) const;
+    void setFuelModelRecord(int fuelModelNumber, std::string code, std::string name,
+        double fuelBedDepth, double moistureOfExtinctionDead, double heatOfCombustionDead, double heatOfCombustionLive,
+        double fuelLoadOneHour, double fuelLoadTenHour, double fuelLoadHundredHour, double fuelLoadLiveHerbaceous,
+        double fuelLoadLiveWoody, double savrOneHourFuel, double savrLiveHerbaceous, double savrLiveWoody,
+        bool isDynamic, bool isReserved);
+    void eraseCustomFuelModelRecord(int fuelModelNumber);
+    std::shared_ptr<CustomFuelModelCatalog> copyCustomFuelModels() const;
+    static void insertCustomFuelModelRecord(CustomFuelModelCatalog& customFuelModels, const CustomFuelModelRecord& customFuelModel);
+    static void updateCustomFuelModelNames(CustomFuelModelCatalog& customFuelModels);
+    bool isCustomFuelModelNumberAllowed(int fuelModelNumber) const;
+
+    std::shared_ptr<const CustomFuelModelCatalog> customFuelModels_; // null until a custom fuel model is set
 };
 
 #endif // FUELMODELS_H
@@ -0,0 +1,193 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Read-only memory mapping of a whole file
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "mappedFile.h"
+
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : data_(nullptr),
+    size_(0),
+    isMapped_(false),
+    buffer_(nullptr)
+#ifdef _WIN32
+    , fileHandle_(nullptr),
+    mappingHandle_(nullptr)
+#endif
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& fileName)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    if (fileSize.QuadPart == 0)
+    {
+        // Empty files can't be mapped, but are valid
+        CloseHandle(file);
+        return readWholeFile(fileName);
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = (mapping != NULL) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (view == NULL)
+    {
+        if (mapping != NULL)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return readWholeFile(fileName);
+    }
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    data_ = static_cast<const char*>(view);
+    size_ = (std::size_t)fileSize.QuadPart;
+    isMapped_ = true;
+    return true;
+#else
+    int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        return false;
+    }
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0)
+    {
+        ::close(fileDescriptor);
+        return false;
+    }
+    if (fileStatus.st_size == 0)
+    {
+        // Empty files can't be mapped, but are valid
+        ::close(fileDescriptor);
+        return readWholeFile(fileName);
+    }
+    void* view = mmap(nullptr, (std::size_t)fileStatus.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    // The mapping stays valid after the descriptor is closed
+    ::close(fileDescriptor);
+    if (view == MAP_FAILED)
+    {
+        return readWholeFile(fileName);
+    }
+    data_ = static_cast<const char*>(view);
+    size_ = (std::size_t)fileStatus.st_size;
+    isMapped_ = true;
+    return true;
+#endif
+}
+
+void MappedFile::close()
+{
+    if (isMapped_)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mappingHandle_);
+        CloseHandle(fileHandle_);
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+#else
+        munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    delete[] buffer_;
+    buffer_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+    isMapped_ = false;
+}
+
+bool MappedFile::isOpen() const
+{
+    return data_ != nullptr;
+}
+
+const char* MappedFile::getData() const
+{
+    return data_;
+}
+
+std::size_t MappedFile::getSize() const
+{
+    return size_;
+}
+
+bool MappedFile::readWholeFile(const std::string& fileName)
+{
+    std::ifstream inputFile(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (!inputFile)
+    {
+        return false;
+    }
+    inputFile.seekg(0, std::ios::end);
+    std::streamoff fileSize = inputFile.tellg();
+    inputFile.seekg(0, std::ios::beg);
+    if (fileSize < 0)
+    {
+        return false;
+    }
+
+    // Always allocate, so an empty file still reads as open
+    buffer_ = new char[(std::size_t)fileSize + 1];
+    if (fileSize > 0 && !inputFile.read(buffer_, fileSize))
+    {
+        delete[] buffer_;
+        buffer_ = nullptr;
+        return false;
+    }
+    data_ = buffer_;
+    size_ = (std::size_t)fileSize;
+    isMapped_ = false;
+    return true;
+}
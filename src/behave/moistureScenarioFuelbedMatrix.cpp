@@ -0,0 +1,150 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Precomputed fuelbed intermediates of the standard fuel models
+*           under every moisture scenario
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "moistureScenarioFuelbedMatrix.h"
+
+#include "fuelModels.h"
+#include "moistureScenarios.h"
+#include "surfaceFuelbedIntermediates.h"
+#include "surfaceInputs.h"
+
+MoistureScenarioFuelbedMatrix::MoistureScenarioFuelbedMatrix()
+    : numberOfLoads_(0),
+    numberOfMoistureScenarios_(0),
+    numberOfFuelModels_(0)
+{
+    FuelModels fuelModels;
+    MoistureScenarios moistureScenarios;
+
+    // Fuel models that can not be replaced by a custom fuel model never change
+    for (int fuelModelNumber = 0; fuelModelNumber <= FuelConstants::MaxFuelModels; fuelModelNumber++)
+    {
+        fuelModelColumn_[fuelModelNumber] = -1;
+        if (fuelModels.isFuelModelReserved(fuelModelNumber) && fuelModels.isFuelModelDefined(fuelModelNumber))
+        {
+            fuelModelColumn_[fuelModelNumber] = numberOfFuelModels_;
+            numberOfFuelModels_++;
+        }
+    }
+
+    SurfaceInputs surfaceInputs;
+    surfaceInputs.setMoistureScenarios(moistureScenarios);
+    surfaceInputs.setMoistureInputMode(MoistureInputMode::MoistureScenario);
+    SurfaceFuelbedIntermediates fuelbedIntermediates(fuelModels, surfaceInputs);
+
+    numberOfMoistureScenarios_ = moistureScenarios.getNumberOfMoistureScenarios();
+    entries_.resize(numberOfMoistureScenarios_ * numberOfFuelModels_);
+    for (int scenarioIndex = 0; scenarioIndex < numberOfMoistureScenarios_; scenarioIndex++)
+    {
+        surfaceInputs.setCurrentMoistureScenarioByIndex(scenarioIndex);
+        for (int fuelModelNumber = 0; fuelModelNumber <= FuelConstants::MaxFuelModels; fuelModelNumber++)
+        {
+            if (fuelModelColumn_[fuelModelNumber] >= 0)
+            {
+                // Built without the matrix, as it is not enabled on these inputs
+                fuelbedIntermediates.calculateFuelbedIntermediates(fuelModelNumber);
+                MoistureScenarioFuelbedEntry& entry = entries_[scenarioIndex * numberOfFuelModels_ + fuelModelColumn_[fuelModelNumber]];
+                saveEntry(fuelbedIntermediates, entry);
+                entry.moistures[MoistureClassInput::OneHour] = surfaceInputs.getMoistureOneHour(FractionUnits::Fraction);
+                entry.moistures[MoistureClassInput::TenHour] = surfaceInputs.getMoistureTenHour(FractionUnits::Fraction);
+                entry.moistures[MoistureClassInput::HundredHour] = surfaceInputs.getMoistureHundredHour(FractionUnits::Fraction);
+                entry.moistures[MoistureClassInput::LiveHerbaceous] = surfaceInputs.getMoistureLiveHerbaceous(FractionUnits::Fraction);
+                entry.moistures[MoistureClassInput::LiveWoody] = surfaceInputs.getMoistureLiveWoody(FractionUnits::Fraction);
+            }
+        }
+    }
+}
+
+const MoistureScenarioFuelbedMatrix& MoistureScenarioFuelbedMatrix::getSharedMatrix()
+{
+    static const MoistureScenarioFuelbedMatrix sharedMatrix;
+    return sharedMatrix;
+}
+
+const MoistureScenarioFuelbedEntry* MoistureScenarioFuelbedMatrix::getEntry(int moistureScenarioIndex, int fuelModelNumber) const
+{
+    if (moistureScenarioIndex < 0 || moistureScenarioIndex >= numberOfMoistureScenarios_
+        || fuelModelNumber < 0 || fuelModelNumber > FuelConstants::MaxFuelModels || fuelModelColumn_[fuelModelNumber] < 0)
+    {
+        return nullptr;
+    }
+    return &entries_[moistureScenarioIndex * numberOfFuelModels_ + fuelModelColumn_[fuelModelNumber]];
+}
+
+int MoistureScenarioFuelbedMatrix::getNumberOfMoistureScenarios() const
+{
+    return numberOfMoistureScenarios_;
+}
+
+int MoistureScenarioFuelbedMatrix::getNumberOfFuelModels() const
+{
+    return numberOfFuelModels_;
+}
+
+void MoistureScenarioFuelbedMatrix::saveEntry(const SurfaceFuelbedIntermediates& fuelbedIntermediates, MoistureScenarioFuelbedEntry& entry)
+{
+    entry.depth = fuelbedIntermediates.depth_;
+    entry.heatSink = fuelbedIntermediates.heatSink_;
+    entry.sigma = fuelbedIntermediates.sigma_;
+    entry.bulkDensity = fuelbedIntermediates.bulkDensity_;
+    entry.packingRatio = fuelbedIntermediates.packingRatio_;
+    entry.relativePackingRatio = fuelbedIntermediates.relativePackingRatio_;
+    entry.propagatingFlux = fuelbedIntermediates.propagatingFlux_;
+    for (int lifeState = 0; lifeState < FuelConstants::MaxLifeStates; lifeState++)
+    {
+        entry.weightedMoisture[lifeState] = fuelbedIntermediates.weightedMoisture_[lifeState];
+        entry.moistureOfExtinction[lifeState] = fuelbedIntermediates.moistureOfExtinction_[lifeState];
+        entry.weightedHeat[lifeState] = fuelbedIntermediates.weightedHeat_[lifeState];
+        entry.weightedSilica[lifeState] = fuelbedIntermediates.weightedSilica_[lifeState];
+        entry.weightedFuelLoad[lifeState] = fuelbedIntermediates.weightedFuelLoad_[lifeState];
+    }
+}
+
+void MoistureScenarioFuelbedMatrix::loadEntry(const MoistureScenarioFuelbedEntry& entry, SurfaceFuelbedIntermediates& fuelbedIntermediates) const
+{
+    numberOfLoads_++;
+    fuelbedIntermediates.depth_ = entry.depth;
+    fuelbedIntermediates.heatSink_ = entry.heatSink;
+    fuelbedIntermediates.sigma_ = entry.sigma;
+    fuelbedIntermediates.bulkDensity_ = entry.bulkDensity;
+    fuelbedIntermediates.packingRatio_ = entry.packingRatio;
+    fuelbedIntermediates.relativePackingRatio_ = entry.relativePackingRatio;
+    fuelbedIntermediates.propagatingFlux_ = entry.propagatingFlux;
+    for (int lifeState = 0; lifeState < FuelConstants::MaxLifeStates; lifeState++)
+    {
+        fuelbedIntermediates.weightedMoisture_[lifeState] = entry.weightedMoisture[lifeState];
+        fuelbedIntermediates.moistureOfExtinction_[lifeState] = entry.moistureOfExtinction[lifeState];
+        fuelbedIntermediates.weightedHeat_[lifeState] = entry.weightedHeat[lifeState];
+        fuelbedIntermediates.weightedSilica_[lifeState] = entry.weightedSilica[lifeState];
+        fuelbedIntermediates.weightedFuelLoad_[lifeState] = entry.weightedFuelLoad[lifeState];
+    }
+}
+
+unsigned long long MoistureScenarioFuelbedMatrix::getNumberOfLoads() const
+{
+    return numberOfLoads_;
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Precomputed fuelbed intermediates of the standard fuel models
+*           under every moisture scenario
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef MOISTURESCENARIOFUELBEDMATRIX_H
+#define MOISTURESCENARIOFUELBEDMATRIX_H
+
+#include <atomic>
+#include <vector>
+
+#include "surfaceInputEnums.h"
+
+class SurfaceFuelbedIntermediates;
+
+// Fuelbed intermediates of one standard fuel model under one moisture scenario.
+// Dynamic fuel models transfer herbaceous load by live moisture, so loads, sigma
+// and packing ratio are kept along with the moisture dependent values
+struct MoistureScenarioFuelbedEntry
+{
+    double moistures[MoistureClassInput::LiveWoody + 1];                // Scenario moistures (fraction) the entry was built with
+    double depth;                                                       // Fuelbed depth in feet
+    double heatSink;
+    double sigma;
+    double bulkDensity;
+    double packingRatio;
+    double relativePackingRatio;
+    double propagatingFlux;
+    double weightedMoisture[FuelConstants::MaxLifeStates];
+    double moistureOfExtinction[FuelConstants::MaxLifeStates];
+    double weightedHeat[FuelConstants::MaxLifeStates];
+    double weightedSilica[FuelConstants::MaxLifeStates];
+    double weightedFuelLoad[FuelConstants::MaxLifeStates];
+};
+
+// The standard fuel models and the moisture scenarios are fixed, so the matrix
+// of every scenario x standard fuel model pair is built once per process
+class MoistureScenarioFuelbedMatrix
+{
+public:
+    MoistureScenarioFuelbedMatrix();
+
+    // Matrix shared by every Surface in the process, built on first use
+    static const MoistureScenarioFuelbedMatrix& getSharedMatrix();
+
+    // Returns nullptr if the fuel model is not a standard fuel model or the
+    // scenario index is out of range
+    const MoistureScenarioFuelbedEntry* getEntry(int moistureScenarioIndex, int fuelModelNumber) const;
+    int getNumberOfMoistureScenarios() const;
+    int getNumberOfFuelModels() const;
+
+    // Copies the intermediates between a calculated fuelbed and an entry,
+    // every load is counted in getNumberOfLoads()
+    static void saveEntry(const SurfaceFuelbedIntermediates& fuelbedIntermediates, MoistureScenarioFuelbedEntry& entry);
+    void loadEntry(const MoistureScenarioFuelbedEntry& entry, SurfaceFuelbedIntermediates& fuelbedIntermediates) const;
+    unsigned long long getNumberOfLoads() const;
+
+private:
+    mutable std::atomic<unsigned long long> numberOfLoads_; // fuelbeds loaded from the matrix instead of calculated
+    std::vector<MoistureScenarioFuelbedEntry> entries_; // scenario major, one row per moisture scenario
+    int fuelModelColumn_[FuelConstants::MaxFuelModels + 1]; // matrix column by fuel model number, -1 if not standard
+    int numberOfMoistureScenarios_;
+    int numberOfFuelModels_;
+};
+
+#endif // MOISTURESCENARIOFUELBEDMATRIX_H
@@ -34,17 +34,10 @@ int MoistureScenarios::getNumberOfMoistureScenarios()
 int MoistureScenarios::getMoistureScenarioIndexByName(const std::string name)
 {
     int index = -1;
-    std::string searchNameAllUppercase = name;
-    std::transform(searchNameAllUppercase.begin(), searchNameAllUppercase.end(), searchNameAllUppercase.begin(), ::toupper);
-    for(int i = 0; i < moistureScenarioVector_.size(); i++)
+    std::unordered_map<std::string, int>::const_iterator found = moistureScenarioIndexByName_.find(toUppercase(name));
+    if(found != moistureScenarioIndexByName_.end())
     {
-        std::string currentNameAllUppercase = moistureScenarioVector_[i].name_;
-        std::transform(currentNameAllUppercase.begin(), currentNameAllUppercase.end(), currentNameAllUppercase.begin(), ::toupper);
-        if(currentNameAllUppercase == searchNameAllUppercase)
-        {
-            index = i;
-            break;
-        }
+        index = found->second;
     }
     return index;
 }
@@ -210,6 +203,7 @@ double MoistureScenarios::getMoistureScenarioLiveWoodyByIndex(const int vectorIn
 void MoistureScenarios::memberwiseCopyAssignment(const MoistureScenarios& rhs)
 {
     moistureScenarioVector_ = rhs.moistureScenarioVector_;
+    moistureScenarioIndexByName_ = rhs.moistureScenarioIndexByName_;
 }
 
 void MoistureScenarios::setMoistureScenarioRecord(const std::string name, const std::string description,
@@ -225,6 +219,14 @@ void MoistureScenarios::setMoistureScenarioRecord(const std::string name, const
     record.moistureLiveHerbaceous_ = moistureLiveHerbaceous;
     record.moistureLiveWoody_ = moistureLiveWoody;
     moistureScenarioVector_.push_back(record);
+    // Names are matched case insensitively, the first record with a name wins
+    moistureScenarioIndexByName_.insert(std::make_pair(toUppercase(name), (int)moistureScenarioVector_.size() - 1));
+}
+
+std::string MoistureScenarios::toUppercase(std::string name)
+{
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    return name;
 }
 
 void MoistureScenarios::populateMoistureScenarios()
@@ -29,6 +29,7 @@
 #define MOISTURE_SCENARIOS_H
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "behaveUnits.h"
@@ -72,6 +73,7 @@ protected:
         double moistureOneHour, double moistureTenHour, double moistureHundredHour,
         double moistureLiveHerbaceous, double moistureLiveWoody);
     void populateMoistureScenarios();
+    static std::string toUppercase(std::string name);
 
     struct MoistureScenarioRecord
     {
@@ -85,6 +87,7 @@ protected:
     };
 
     std::vector<MoistureScenarioRecord> moistureScenarioVector_;
+    std::unordered_map<std::string, int> moistureScenarioIndexByName_; // Vector index by uppercase scenario name
 };
 
 #endif //MOISTURE_SCENARIOS_H
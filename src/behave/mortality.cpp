@@ -4,10 +4,13 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <thread>
 
 #include "mortality_inputs.h" 
 #include "mortality.h"
+#include "behaveInstrumentation.h"
 #include "species_master_table.h"
 #include "mortality_equation_table.h"
 
@@ -51,6 +54,7 @@ void Mortality::memberwiseCopyAssignment(const Mortality& rhs)
     mortalityInputs_ = rhs.mortalityInputs_;
 
     speciesMasterTable_ = rhs.speciesMasterTable_;
+    resolvedSpecies_ = rhs.resolvedSpecies_;
     equationRequiredFieldTable_ = rhs.equationRequiredFieldTable_;
     boleCharTable_ = rhs.boleCharTable_;
     canopyCoefficientTable_ = rhs.canopyCoefficientTable_;
@@ -105,6 +109,10 @@ void Mortality::setSpeciesCode(std::string speciesCode)
     {
         updateInputsForSpeciesCodeAndEquationType(speciesCode, equationType);
     }
+    else
+    {
+        resolvedSpecies_ = ResolvedSpecies();
+    }
 }
 
 void Mortality::setEquationType(EquationType equationType)
@@ -116,6 +124,10 @@ void Mortality::setEquationType(EquationType equationType)
     {
         updateInputsForSpeciesCodeAndEquationType(speciesCode, equationType);
     }
+    else
+    {
+        resolvedSpecies_ = ResolvedSpecies();
+    }
 }
 
 void Mortality::setFlameLengthOrScorchHeightSwitch(FlameLengthOrScorchHeightSwitch flameLengthOrScorchHeightSwitch)
@@ -282,6 +294,7 @@ double Mortality::calculateMortality(FractionUnits::FractionUnitsEnum probablity
     if (mortalityInputs_.getEquationType() == EquationType::crown_scorch)
     {      
         // Crown Scorch Equations
+        BEHAVE_INSTRUMENT_SCOPE(MortalityCrownScorch);
         probabilityOfMortality_ = calculateMortalityCrownScorch();
         if (probabilityOfMortality_ < 0)
         {
@@ -292,6 +305,7 @@ double Mortality::calculateMortality(FractionUnits::FractionUnitsEnum probablity
     if (mortalityInputs_.getEquationType() == EquationType::crown_damage)
     {     
         // Crown Damage Equations
+        BEHAVE_INSTRUMENT_SCOPE(MortalityCrownDamage);
         probabilityOfMortality_ = PostFireInjuryCalculation();
         if(probabilityOfMortality_ < 0)
         {
@@ -302,6 +316,7 @@ double Mortality::calculateMortality(FractionUnits::FractionUnitsEnum probablity
     if (mortalityInputs_.getEquationType() == EquationType::bole_char)
     {     
         // Bole Char Equations
+        BEHAVE_INSTRUMENT_SCOPE(MortalityBoleChar);
         probabilityOfMortality_ = BoleCharCalculate();
         if(probabilityOfMortality_ < 0)
         {
@@ -312,57 +327,207 @@ double Mortality::calculateMortality(FractionUnits::FractionUnitsEnum probablity
     return FractionUnits::fromBaseUnits(probabilityOfMortality_, probablityUnits);
 }
 
+/*******************************************************************************************************
+* Name: calculateMortalityForTreeList
+* Desc: Calculate Mortality for every tree in a tree list and total the stand.
+*       Fire inputs (flame length or scorch height, fire severity) are the
+*       ones currently set. Each distinct species is looked up in the Species
+*       Master Table once per batch. Trees are calculated in fixed size chunks
+*       by numberOfThreads threads, each with its own copy of this Mortality,
+*       and chunk totals are summed in chunk order so the results do not
+*       depend on the number of threads.
+*   In: treeList....tree list arrays
+*  Out: probabilityOfMortality....one per tree, -1 if the tree is invalid
+*  Ret: stand totals of the valid trees
+*******************************************************************************************************/
+MortalityStandSummary Mortality::calculateMortalityForTreeList(const MortalityTreeList& treeList, double* probabilityOfMortality,
+    FractionUnits::FractionUnitsEnum probabilityUnits, int numberOfThreads)
+{
+    constexpr std::size_t treesPerChunk = 512;
+
+    // Resolve each distinct species once
+    const int numberOfSpecies = speciesMasterTable_->getNumberOfRecords();
+    vector<ResolvedSpecies> resolvedSpecies(numberOfSpecies);
+    for(std::size_t i = 0; i < treeList.numberOfTrees; i++)
+    {
+        const int speciesTableIndex = treeList.speciesTableIndex[i];
+        if(speciesTableIndex >= 0 && speciesTableIndex < numberOfSpecies && resolvedSpecies[speciesTableIndex].speciesTableIndex == -1)
+        {
+            resolveSpecies(speciesTableIndex, resolvedSpecies[speciesTableIndex]);
+        }
+    }
+
+    const std::size_t numberOfChunks = (treeList.numberOfTrees + treesPerChunk - 1) / treesPerChunk;
+    vector<MortalityStandSummary> chunkSummary(numberOfChunks);
+    vector<double> chunkCoveragePrefire(numberOfChunks, 0.0);
+    vector<double> chunkCoveragePostfire(numberOfChunks, 0.0);
+    std::atomic<std::size_t> nextChunk(0);
+
+    auto calculateChunks = [&]()
+    {
+        Mortality mortality(*this);
+        for(std::size_t chunk = nextChunk++; chunk < numberOfChunks; chunk = nextChunk++)
+        {
+            const std::size_t begin = chunk * treesPerChunk;
+            const std::size_t end = std::min(begin + treesPerChunk, treeList.numberOfTrees);
+            mortality.calculateMortalityForTreeListRange(treeList, resolvedSpecies, begin, end, probabilityOfMortality, probabilityUnits,
+                chunkSummary[chunk], chunkCoveragePrefire[chunk], chunkCoveragePostfire[chunk]);
+        }
+    };
+
+    if(numberOfThreads < 1)
+    {
+        numberOfThreads = 1;
+    }
+    if((std::size_t)numberOfThreads > numberOfChunks)
+    {
+        numberOfThreads = (int)std::max<std::size_t>(numberOfChunks, 1);
+    }
+    vector<std::thread> threads;
+    for(int i = 1; i < numberOfThreads; i++)
+    {
+        threads.emplace_back(calculateChunks);
+    }
+    calculateChunks();
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    MortalityStandSummary summary;
+    double coveragePrefire = 0;
+    double coveragePostfire = 0;
+    for(std::size_t chunk = 0; chunk < numberOfChunks; chunk++)
+    {
+        summary.numberOfTrees += chunkSummary[chunk].numberOfTrees;
+        summary.numberOfInvalidTrees += chunkSummary[chunk].numberOfInvalidTrees;
+        summary.treesPrefire += chunkSummary[chunk].treesPrefire;
+        summary.treesKilled += chunkSummary[chunk].treesKilled;
+        summary.basalAreaPrefire += chunkSummary[chunk].basalAreaPrefire;
+        summary.basalAreaKilled += chunkSummary[chunk].basalAreaKilled;
+        coveragePrefire += chunkCoveragePrefire[chunk];
+        coveragePostfire += chunkCoveragePostfire[chunk];
+    }
+    // Crown areas are summed before the overlap correction, as in calculateMortalityTotals()
+    summary.prefireCanopyCover = CC_Overlap(coveragePrefire);
+    summary.postfireCanopyCover = CC_Overlap(coveragePostfire);
+
+    return summary;
+}
+
+/*******************************************************************************************************
+* Name: calculateMortalityForTreeListRange
+* Desc: Calculate trees [begin, end) of a tree list and total them.
+*       Species inputs are only applied when the species changes from
+*       the previous tree.
+*  Out: probabilityOfMortality....for trees begin to end
+*       summary....totals of the valid trees
+*       coveragePrefire, coveragePostfire....crown area in square feet
+*                                            before the overlap correction
+*******************************************************************************************************/
+void Mortality::calculateMortalityForTreeListRange(const MortalityTreeList& treeList, const vector<ResolvedSpecies>& resolvedSpecies,
+    std::size_t begin, std::size_t end, double* probabilityOfMortality, FractionUnits::FractionUnitsEnum probabilityUnits,
+    MortalityStandSummary& summary, double& coveragePrefire, double& coveragePostfire)
+{
+    const int numberOfSpecies = (int)resolvedSpecies.size();
+    int appliedSpeciesTableIndex = -1;
+
+    for(std::size_t i = begin; i < end; i++)
+    {
+        summary.numberOfTrees++;
+
+        const int speciesTableIndex = treeList.speciesTableIndex[i];
+        if(speciesTableIndex < 0 || speciesTableIndex >= numberOfSpecies)
+        {
+            probabilityOfMortality[i] = FractionUnits::fromBaseUnits(-1.0, probabilityUnits);
+            summary.numberOfInvalidTrees++;
+            continue;
+        }
+        if(speciesTableIndex != appliedSpeciesTableIndex)
+        {
+            applyResolvedSpecies(resolvedSpecies[speciesTableIndex]);
+            appliedSpeciesTableIndex = speciesTableIndex;
+        }
+
+        // Fields left out of the tree list are not set
+        mortalityInputs_.setDBH((treeList.dbh) ? treeList.dbh[i] : -1.0, treeList.dbhUnits);
+        mortalityInputs_.setTreeHeight((treeList.treeHeight) ? treeList.treeHeight[i] : -1.0, treeList.heightUnits);
+        mortalityInputs_.setCrownRatio((treeList.crownRatio) ? treeList.crownRatio[i] : -1.0);
+        mortalityInputs_.setTreeDensityPerUnitArea((treeList.expansionFactor) ? treeList.expansionFactor[i] : -1.0,
+            treeList.expansionFactorAreaUnits);
+        mortalityInputs_.setCrownDamage((treeList.crownDamage) ? treeList.crownDamage[i] : -1.0);
+        mortalityInputs_.setCambiumKillRating((treeList.cambiumKillRating) ? treeList.cambiumKillRating[i] : -1.0);
+        mortalityInputs_.setBeetleDamage((treeList.beetleDamage) ? treeList.beetleDamage[i] : BeetleDamage::not_set);
+        mortalityInputs_.setBoleCharHeight((treeList.boleCharHeight) ? treeList.boleCharHeight[i] : -1.0, treeList.heightUnits);
+
+        const double probability = calculateMortality(FractionUnits::Fraction);
+        probabilityOfMortality[i] = FractionUnits::fromBaseUnits(probability, probabilityUnits);
+        if(probability < 0)
+        {
+            summary.numberOfInvalidTrees++;
+            continue;
+        }
+
+        summary.treesPrefire += totalPrefireTrees_;
+        summary.treesKilled += killedTrees_;
+        summary.basalAreaPrefire += basalAreaPrefire_;
+        summary.basalAreaKilled += basalAreaKillled_;
+        coveragePrefire += gloabalTotalCoveragePrefireLive_;
+        coveragePostfire += globalTotalCoverPostfireLive_;
+    }
+}
+
 string Mortality::getSpeciesCodeAtSpeciesTableIndex(int index) const
 {
-    return speciesMasterTable_->record_[index].speciesCode;
+    return speciesMasterTable_->getEntry(index).speciesCode;
 }
 
 string Mortality::getScientificNameAtSpeciesTableIndex(int index) const
 {
-    return speciesMasterTable_->record_[index].scientificName;
+    return speciesMasterTable_->getEntry(index).scientificName;
 }
 
 string Mortality::getCommonNameAtSpeciesTableIndex(int index) const
 {
-    return speciesMasterTable_->record_[index].commonName;
+    return speciesMasterTable_->getEntry(index).commonName;
 }
 
 int Mortality::getMortalityEquationNumberAtSpeciesTableIndex(int index) const
 {
-    return speciesMasterTable_->record_[index].mortalityEquationNumber;
+    return speciesMasterTable_->getEntry(index).mortalityEquationNumber;
 }
 
 int Mortality::getBarkEquationNumberAtSpeciesTableIndex(int index) const
 {
-    return speciesMasterTable_->record_[index].barkEquationNumber;
+    return speciesMasterTable_->getEntry(index).barkEquationNumber;
 }
 
 int Mortality::getCrownCoefficientCodeAtSpeciesTableIndex(int index) const
 {
-    return speciesMasterTable_->record_[index].crownCoefficientCode;
+    return speciesMasterTable_->getEntry(index).crownCoefficientCode;
 }
 
 EquationType Mortality::getEquationTypeAtSpeciesTableIndex(int index) const
 {
-    return speciesMasterTable_->record_[index].equationType;
+    return speciesMasterTable_->getEntry(index).equationType;
 }
 
 CrownDamageEquationCode Mortality::getCrownDamageEquationCodeAtSpeciesTableIndex(int index) const
 {
-    return speciesMasterTable_->record_[index].crownDamageEquationCode;
+    return speciesMasterTable_->getEntry(index).crownDamageEquationCode;
 }
 
 bool Mortality::checkIsInRegionAtSpeciesTableIndex(int index, RegionCode region) const
 {
     bool isInRegion = false;
 
-    if((index >= 0) && (index < speciesMasterTable_->record_.size()))
+    if((index >= 0) && (index < speciesMasterTable_->getNumberOfRecords()))
     {
         switch(region)
         {
             case RegionCode::interior_west:
             {
-                if(speciesMasterTable_->record_[index].regionInteriorWest == (int)RegionCode::interior_west)
+                if(speciesMasterTable_->getEntry(index).regionInteriorWest == (int)RegionCode::interior_west)
                 {
                     isInRegion = true;
                 }
@@ -371,7 +536,7 @@ bool Mortality::checkIsInRegionAtSpeciesTableIndex(int index, RegionCode region)
 
             case RegionCode::pacific_west:
             {
-                if(speciesMasterTable_->record_[index].regionPacificWest == (int)RegionCode::pacific_west)
+                if(speciesMasterTable_->getEntry(index).regionPacificWest == (int)RegionCode::pacific_west)
                 {
                     isInRegion = true;
                 }
@@ -379,7 +544,7 @@ bool Mortality::checkIsInRegionAtSpeciesTableIndex(int index, RegionCode region)
             }
             case RegionCode::north_east:
             {
-                if(speciesMasterTable_->record_[index].regionNorthEast == (int)RegionCode::north_east)
+                if(speciesMasterTable_->getEntry(index).regionNorthEast == (int)RegionCode::north_east)
                 {
                     isInRegion = true;
                 }
@@ -387,7 +552,7 @@ bool Mortality::checkIsInRegionAtSpeciesTableIndex(int index, RegionCode region)
             }
             case RegionCode::south_east:
             {
-                if(speciesMasterTable_->record_[index].regionSouthEast == (int)RegionCode::south_east)
+                if(speciesMasterTable_->getEntry(index).regionSouthEast == (int)RegionCode::south_east)
                 {
                     isInRegion = true;
                 }
@@ -503,10 +668,9 @@ bool Mortality::checkIsInRegionFromSpeciesCode(string speciesCode, RegionCode re
 *******************************************************************************************************/
 double  Mortality::calculateMortalityCrownScorch()
 {
-    double f, barkThicknessPrime, DBHcm, treeHeight, LCR, HCR, CSL, P, Fl, CH;
-    double  blackHillsFlameLength, CBH;
+    double treeHeight, HCR, CSL, P;
+    double  blackHillsFlameLength;
     double  flameLengthOrScorchHeightValue, DBH;
-    int  mortalityEquationNumber;
 
     DBH = mortalityInputs_.getDBH(LengthUnits::Inches);
 
@@ -524,7 +688,7 @@ double  Mortality::calculateMortalityCrownScorch()
     }
 
     // NOTE NOTE - FuelCalc relies on the exact text "Species" being in this error message 
-    if(speciesMasterTable_->getSpeciesTableIndexFromSpeciesCodeAndEquationType(mortalityInputs_.getSpeciesCode(), mortalityInputs_.getEquationType()) == -1) // Check for Valid Species        
+    if(resolvedSpecies_.speciesTableIndex == -1) // Check for Valid Species        
     {
         //sprintf(cr_ErrMes, "Invalid Species: %s", mortalityInputs_.speciesCode_);
         return -1.0;
@@ -564,176 +728,22 @@ double  Mortality::calculateMortalityCrownScorch()
 
     //...........................................................................
 
-    mortalityEquationNumber = mortalityInputs_.getCrownScorchOrBoleCharEquationNumber(); // Get equation number               
-
-    double crownVolumeScorchedPercent = treeCrownVolumeScorched_ * 100.0;
-    switch(mortalityEquationNumber)
+    // Equation resolved along with the species, see getCrownScorchEquation()
+    CrownScorchEquation crownScorchEquation = resolvedSpecies_.crownScorchEquation;
+    if(crownScorchEquation == nullptr)
     {
-        case 1:
-        {
-            if(DBH >= 1.0)
-            {
-                P = 1.0 / (1.0 + exp(-1.941 + (6.316 * (1.0 - exp(-mortalityInputs_.getBarkThickness(LengthUnits::Inches)))) - 0.000535 * (crownVolumeScorchedPercent * crownVolumeScorchedPercent)));
-            }
-            else if(CSL > 50.0)
-            {
-                P = 1.0;
-            }
-            else if(treeHeight < 3.0)
-            {
-                P = 1.0;
-            }
-            else
-            {
-                mortalityInputs_.setBarkThickness(calculateBarkThickness(), LengthUnits::Inches);
-                P = 1.0 / (1.0 + exp(-1.941 + (6.316 * (1.0 - exp(-mortalityInputs_.getBarkThickness(LengthUnits::Inches)))) - 0.000535 * (crownVolumeScorchedPercent * crownVolumeScorchedPercent)));
-                P = P + (1.0 - P) * (1.0 - ((treeHeight - 3.0) / (((1.0 / DBH) * treeHeight) - 3.0)));
-            }
-            break;
-        }
-        case 3:
-        {
-            if(DBH > 1.0)
-            {
-                P = 1.0 / (1.0 + exp(-1.941 + (6.316 * (1.0 - exp(-mortalityInputs_.getBarkThickness(LengthUnits::Inches)))) - 0.000535 * (crownVolumeScorchedPercent * crownVolumeScorchedPercent)));
-            }
-            else if(CSL > 50.0)
-            {
-                P = 1.0;
-            }
-            else if(treeHeight < 3.0)
-            {
-                P = 1.0;
-            }
-            else
-            {
-                mortalityInputs_.setBarkThickness(calculateBarkThickness(), LengthUnits::Inches);
-                P = 1.0 / (1.0 + exp(-1.941 + (6.316 * (1.0 - exp(-mortalityInputs_.getBarkThickness(LengthUnits::Inches)))) - 0.000535 * (crownVolumeScorchedPercent * crownVolumeScorchedPercent)));
-                P = P + (1.0 - P) * (1.0 - ((treeHeight - 3.0) / (((1.0 / DBH) * treeHeight) - 3.0)));
-            }
-            if(P < 0.8)
-            {
-                P = 0.8;
-            }
-            break;
-        }
-        case 4:
-        {
-            Fl = Calc_Flame(flameLengthOrScorchHeightValue);
-            CH = Fl / 1.8;
-            if(mortalityInputs_.getFireSeverity() == FireSeverity::low)
-            {
-                // Fire Severity - See Note-3 Above     
-                P = 1.0 / (1.0 + exp((0.251 * DBH * 2.54) - (0.07 * CH * 2.54 * 12.0) - 4.407));
-            }
-            else
-            {
-                P = 1.0 / (1.0 + exp((0.0858 * DBH * 2.54) - (0.118 * CH * 2.54 * 12.0) - 2.157));
-            }
-            break;
-        }
-        //...................................................
-        //    case 5: 
-        //...................................................
-        // Change - 8-20-2012 
-        // New formula from Duncan Lutes  
-        // we were having trouble with this, the original paper was  
-        // saying that proportion of crown scorch was 0->1 but we found 
-        // that we had to use a value at 1->10   
-        case 5:
-        {
-            if(CSL <= 0.0)
-            {
-                P = 0.0;
-                break;
-            }
-            DBHcm = LengthUnits::fromBaseUnits(DBH, LengthUnits::Centimeters);
-            barkThicknessPrime = 0.435 + (0.031 * DBHcm);
-            f = crownVolumeScorchedPercent / 10.0; // see comments just above 
-            barkThicknessPrime = 0.169 + (5.136 * barkThicknessPrime) + (14.492 * Squaredouble(barkThicknessPrime)) - (0.348 * Squaredouble(f));
-            P = 1.0 / (1.0 + exp(barkThicknessPrime));
-            //sprintf(cr, "%20.18f ", P);
-
-            // I don't know if these conditions could 
-            // happen but I'm checking anyway  
-            if(P > 1.0)
-            {
-                P = 1.0;
-            }
-            if(P < 0.0)
-            {
-                P = 0.0;
-            }
-            break;
-        }
-        // test-pfi 
-        // New equations from Sharon - april/may 2008                                
-        case 10:
-        {
-            P = Whitefir(CSL); // ABICON                            
-            break;
-        }
-        case 11:
-        {
-            P = SubalpineFir(crownVolumeScorchedPercent); // ABILAS                            
-            break;
-        }
-        case 12:
-        {
-            P = IncenseCedar(CSL); // LIBDEC                            
-            break;
-        }
-        case 14:
-        {
-            P = WesternLarch(crownVolumeScorchedPercent, DBH); // LAROCC                            
-            break;
-        }
-        case 15:
-        {
-            P = EngelmannSpruce(crownVolumeScorchedPercent); // PICENG                            
-            break;
-        }
-        case 16:
-        {
-            P = RedFir(CSL); // ABIMAG                          
-            break;
-        }
-        case 17:
-        {
-            P = WhitebarkPine(crownVolumeScorchedPercent, DBH); // PINALB                      
-            break;
-        }
-        case 18:
-        {
-            P = SugarPine(CSL);
-            break;
-        }
-        case 19:
-        {
-            P = PonderosaJeffreyPine(crownVolumeScorchedPercent);
-            break;
-        }
-        case 20:
-        {
-            P = DouglasFir(crownVolumeScorchedPercent);
-            break;
-        }
-        // Change 9-6-2016 - new Black Hills PiPo, see Duncan Lutes's .docx document saved in fofem project folder 
-        case 21:
-        {
-            f = mortalityInputs_.getCrownRatio(); // crown ratio 
-            CBH = mortalityInputs_.getTreeHeight(LengthUnits::Feet) - (mortalityInputs_.getTreeHeight(LengthUnits::Feet) * f);
-            P = Eq21_BlkHilPiPo(mortalityInputs_.getTreeHeight(LengthUnits::Feet), CBH, mortalityInputs_.getDBH(LengthUnits::Feet), flameLengthOrScorchHeightValue, blackHillsFlameLength);
-            break;
-        }
-        default:
-        {
-            //sprintf(cr_ErrMes, "Equation Not implemented,  Equ Num: %d\n", i_MortEqu);
-            P = 0;
-            return -1.0;
-            break;
-        }
-    }  // switch end 
+        //sprintf(cr_ErrMes, "Equation Not implemented,  Equ Num: %d\n", i_MortEqu);
+        return -1.0;
+    }
+
+    CrownScorchTerms terms;
+    terms.dbh = DBH;
+    terms.treeHeight = treeHeight;
+    terms.crownLengthScorchedPercent = CSL;
+    terms.crownVolumeScorchedPercent = treeCrownVolumeScorched_ * 100.0;
+    terms.scorchHeight = flameLengthOrScorchHeightValue;
+    terms.blackHillsFlameLength = blackHillsFlameLength;
+    P = (this->*crownScorchEquation)(terms);
 
     probabilityOfMortality_ = P;
 
@@ -742,6 +752,231 @@ double  Mortality::calculateMortalityCrownScorch()
     return P;
 }
 
+/*******************************************************************************************************
+* Name: getCrownScorchEquation
+* Desc: Find the crown scorch equation function for an equation number
+*  Ret: equation function, nullptr if the equation is not implemented
+*******************************************************************************************************/
+Mortality::CrownScorchEquation Mortality::getCrownScorchEquation(int crownScorchEquationNumber)
+{
+    switch(crownScorchEquationNumber)
+    {
+        case 1: return &Mortality::crownScorchEquation1;
+        case 3: return &Mortality::crownScorchEquation3;
+        case 4: return &Mortality::crownScorchEquation4;
+        case 5: return &Mortality::crownScorchEquation5;
+        case 10: return &Mortality::crownScorchEquation10;
+        case 11: return &Mortality::crownScorchEquation11;
+        case 12: return &Mortality::crownScorchEquation12;
+        case 14: return &Mortality::crownScorchEquation14;
+        case 15: return &Mortality::crownScorchEquation15;
+        case 16: return &Mortality::crownScorchEquation16;
+        case 17: return &Mortality::crownScorchEquation17;
+        case 18: return &Mortality::crownScorchEquation18;
+        case 19: return &Mortality::crownScorchEquation19;
+        case 20: return &Mortality::crownScorchEquation20;
+        case 21: return &Mortality::crownScorchEquation21;
+        default: return nullptr;
+    }
+}
+
+/*******************************************************************************************************
+* Name: getCrownDamageEquation
+* Desc: Find the crown damage (post fire injury) equation function
+*  Ret: equation function, nullptr if there is none for the code
+*******************************************************************************************************/
+Mortality::CrownDamageEquation Mortality::getCrownDamageEquation(CrownDamageEquationCode crownDamageEquationCode)
+{
+    switch(crownDamageEquationCode)
+    {
+        case CrownDamageEquationCode::white_fir: return &Mortality::Eq_WhiteFir_WF;
+        case CrownDamageEquationCode::subalpine_fir: return &Mortality::Eq_SubalpineFir_SF;
+        case CrownDamageEquationCode::incense_cedar: return &Mortality::Eq_IncenseCedar_IC;
+        case CrownDamageEquationCode::western_larch: return &Mortality::Eq_WesternLarch_WL;
+        case CrownDamageEquationCode::whitebark_pine: return &Mortality::Eq_WhitebarkPine_WP;
+        case CrownDamageEquationCode::engelmann_spruce: return &Mortality::Eq_EngelmannSpruce_ES;
+        case CrownDamageEquationCode::sugar_pine: return &Mortality::Eq_SugarPine_SP;
+        case CrownDamageEquationCode::red_fir: return &Mortality::Eq_RedFir_RF;
+        case CrownDamageEquationCode::ponderosa_pine: return &Mortality::Eq_PonderosaPine_PP;
+        case CrownDamageEquationCode::ponderosa_kill: return &Mortality::Eq_PonderosaKill_PK;
+        case CrownDamageEquationCode::douglas_fir: return &Mortality::Eq_DouglasFir_DF;
+        default: return nullptr;
+    }
+}
+
+/*******************************************************************************************************
+* Name: crownScorchEquation1 .. crownScorchEquation21
+* Desc: Crown scorch mortality equations, by equation number
+*   In: terms....values computed in calculateMortalityCrownScorch()
+*  Ret: probability of mortality 0 -> 1.0
+*******************************************************************************************************/
+double Mortality::crownScorchEquation1(const CrownScorchTerms& terms)
+{
+    double P;
+    double barkThickness = mortalityInputs_.getBarkThickness(LengthUnits::Inches);
+    double crownVolumeScorchedPercent = terms.crownVolumeScorchedPercent;
+
+    if(terms.dbh >= 1.0)
+    {
+        P = 1.0 / (1.0 + exp(-1.941 + (6.316 * (1.0 - exp(-barkThickness))) - 0.000535 * (crownVolumeScorchedPercent * crownVolumeScorchedPercent)));
+    }
+    else if(terms.crownLengthScorchedPercent > 50.0)
+    {
+        P = 1.0;
+    }
+    else if(terms.treeHeight < 3.0)
+    {
+        P = 1.0;
+    }
+    else
+    {
+        P = 1.0 / (1.0 + exp(-1.941 + (6.316 * (1.0 - exp(-barkThickness))) - 0.000535 * (crownVolumeScorchedPercent * crownVolumeScorchedPercent)));
+        P = P + (1.0 - P) * (1.0 - ((terms.treeHeight - 3.0) / (((1.0 / terms.dbh) * terms.treeHeight) - 3.0)));
+    }
+    return P;
+}
+
+double Mortality::crownScorchEquation3(const CrownScorchTerms& terms)
+{
+    double P;
+    double barkThickness = mortalityInputs_.getBarkThickness(LengthUnits::Inches);
+    double crownVolumeScorchedPercent = terms.crownVolumeScorchedPercent;
+
+    if(terms.dbh > 1.0)
+    {
+        P = 1.0 / (1.0 + exp(-1.941 + (6.316 * (1.0 - exp(-barkThickness))) - 0.000535 * (crownVolumeScorchedPercent * crownVolumeScorchedPercent)));
+    }
+    else if(terms.crownLengthScorchedPercent > 50.0)
+    {
+        P = 1.0;
+    }
+    else if(terms.treeHeight < 3.0)
+    {
+        P = 1.0;
+    }
+    else
+    {
+        P = 1.0 / (1.0 + exp(-1.941 + (6.316 * (1.0 - exp(-barkThickness))) - 0.000535 * (crownVolumeScorchedPercent * crownVolumeScorchedPercent)));
+        P = P + (1.0 - P) * (1.0 - ((terms.treeHeight - 3.0) / (((1.0 / terms.dbh) * terms.treeHeight) - 3.0)));
+    }
+    if(P < 0.8)
+    {
+        P = 0.8;
+    }
+    return P;
+}
+
+double Mortality::crownScorchEquation4(const CrownScorchTerms& terms)
+{
+    double P, Fl, CH;
+    double DBH = terms.dbh;
+
+    Fl = Calc_Flame(terms.scorchHeight);
+    CH = Fl / 1.8;
+    if(mortalityInputs_.getFireSeverity() == FireSeverity::low)
+    {
+        // Fire Severity - See Note-3 Above     
+        P = 1.0 / (1.0 + exp((0.251 * DBH * 2.54) - (0.07 * CH * 2.54 * 12.0) - 4.407));
+    }
+    else
+    {
+        P = 1.0 / (1.0 + exp((0.0858 * DBH * 2.54) - (0.118 * CH * 2.54 * 12.0) - 2.157));
+    }
+    return P;
+}
+
+// Change - 8-20-2012 
+// New formula from Duncan Lutes  
+// we were having trouble with this, the original paper was  
+// saying that proportion of crown scorch was 0->1 but we found 
+// that we had to use a value at 1->10   
+double Mortality::crownScorchEquation5(const CrownScorchTerms& terms)
+{
+    double P, f, DBHcm, barkThicknessPrime;
+
+    if(terms.crownLengthScorchedPercent <= 0.0)
+    {
+        return 0.0;
+    }
+    DBHcm = LengthUnits::fromBaseUnits(terms.dbh, LengthUnits::Centimeters);
+    barkThicknessPrime = 0.435 + (0.031 * DBHcm);
+    f = terms.crownVolumeScorchedPercent / 10.0; // see comments just above 
+    barkThicknessPrime = 0.169 + (5.136 * barkThicknessPrime) + (14.492 * Squaredouble(barkThicknessPrime)) - (0.348 * Squaredouble(f));
+    P = 1.0 / (1.0 + exp(barkThicknessPrime));
+
+    // I don't know if these conditions could 
+    // happen but I'm checking anyway  
+    if(P > 1.0)
+    {
+        P = 1.0;
+    }
+    if(P < 0.0)
+    {
+        P = 0.0;
+    }
+    return P;
+}
+
+// New equations from Sharon - april/may 2008                                
+double Mortality::crownScorchEquation10(const CrownScorchTerms& terms)
+{
+    return Whitefir(terms.crownLengthScorchedPercent); // ABICON
+}
+
+double Mortality::crownScorchEquation11(const CrownScorchTerms& terms)
+{
+    return SubalpineFir(terms.crownVolumeScorchedPercent); // ABILAS
+}
+
+double Mortality::crownScorchEquation12(const CrownScorchTerms& terms)
+{
+    return IncenseCedar(terms.crownLengthScorchedPercent); // LIBDEC
+}
+
+double Mortality::crownScorchEquation14(const CrownScorchTerms& terms)
+{
+    return WesternLarch(terms.crownVolumeScorchedPercent, terms.dbh); // LAROCC
+}
+
+double Mortality::crownScorchEquation15(const CrownScorchTerms& terms)
+{
+    return EngelmannSpruce(terms.crownVolumeScorchedPercent); // PICENG
+}
+
+double Mortality::crownScorchEquation16(const CrownScorchTerms& terms)
+{
+    return RedFir(terms.crownLengthScorchedPercent); // ABIMAG
+}
+
+double Mortality::crownScorchEquation17(const CrownScorchTerms& terms)
+{
+    return WhitebarkPine(terms.crownVolumeScorchedPercent, terms.dbh); // PINALB
+}
+
+double Mortality::crownScorchEquation18(const CrownScorchTerms& terms)
+{
+    return SugarPine(terms.crownLengthScorchedPercent);
+}
+
+double Mortality::crownScorchEquation19(const CrownScorchTerms& terms)
+{
+    return PonderosaJeffreyPine(terms.crownVolumeScorchedPercent);
+}
+
+double Mortality::crownScorchEquation20(const CrownScorchTerms& terms)
+{
+    return DouglasFir(terms.crownVolumeScorchedPercent);
+}
+
+// Change 9-6-2016 - new Black Hills PiPo, see Duncan Lutes's .docx document saved in fofem project folder 
+double Mortality::crownScorchEquation21(const CrownScorchTerms& terms)
+{
+    double f, CBH;
+    f = mortalityInputs_.getCrownRatio(); // crown ratio 
+    CBH = mortalityInputs_.getTreeHeight(LengthUnits::Feet) - (mortalityInputs_.getTreeHeight(LengthUnits::Feet) * f);
+    return Eq21_BlkHilPiPo(mortalityInputs_.getTreeHeight(LengthUnits::Feet), CBH, mortalityInputs_.getDBH(LengthUnits::Feet), terms.scorchHeight, terms.blackHillsFlameLength);
+}
+
 /**********************************************************************************************************
 * Name: Eq21_BlkHilPiPo
 * Desc: Black Hills Ponderosa Pine PiPo
@@ -1216,72 +1451,13 @@ void  Mortality::initializeOutputs()
 *******************************************************************************************************/
 double Mortality::PostFireInjuryCalculation()
 {
-    std::function<double(void)> func;
-
     //strcpy(cr_ErrMes, "");
 
-    // Execute the appropriate functon
-    switch(mortalityInputs_.getCrownDamageEquationCode())
+    // Execute the appropriate functon, resolved along with the species
+    CrownDamageEquation crownDamageEquation = resolvedSpecies_.crownDamageEquation;
+    if(crownDamageEquation != nullptr)
     {
-        case CrownDamageEquationCode::white_fir:
-        {
-            probabilityOfMortality_ = Eq_WhiteFir_WF();
-            break;
-        }
-        case CrownDamageEquationCode::subalpine_fir:
-        {
-            probabilityOfMortality_ = Eq_SubalpineFir_SF();
-            break;
-        }
-        case CrownDamageEquationCode::incense_cedar:
-        {
-            probabilityOfMortality_ = Eq_IncenseCedar_IC();
-            break;
-        }
-        case CrownDamageEquationCode::western_larch:
-        {
-            probabilityOfMortality_ = Eq_WesternLarch_WL();
-            break;
-        }
-        case CrownDamageEquationCode::whitebark_pine:
-        {
-            probabilityOfMortality_ = Eq_WhitebarkPine_WP();
-            break;
-        }
-        case CrownDamageEquationCode::engelmann_spruce:
-        {
-            probabilityOfMortality_ = Eq_EngelmannSpruce_ES();
-            break;
-        }
-        case CrownDamageEquationCode::sugar_pine:
-        {
-            probabilityOfMortality_ = Eq_SugarPine_SP();
-            break;
-        }
-        case CrownDamageEquationCode::red_fir:
-        {
-            probabilityOfMortality_ = Eq_RedFir_RF();
-            break;
-        }
-        case CrownDamageEquationCode::ponderosa_pine:
-        {
-            probabilityOfMortality_ = Eq_PonderosaPine_PP();
-            break;
-        }
-        case CrownDamageEquationCode::ponderosa_kill:
-        {
-            probabilityOfMortality_ = Eq_PonderosaKill_PK();
-            break;
-        }
-        case CrownDamageEquationCode::douglas_fir:
-        {
-            probabilityOfMortality_ = Eq_DouglasFir_DF();
-            break;
-        }
-        default:
-        {
-            // an error has occurred
-        }
+        probabilityOfMortality_ = (this->*crownDamageEquation)();
     }
 
     // Will also get put into a_MO as a whole int value
@@ -1670,16 +1846,10 @@ double Mortality::BoleCharCalculate()
     double B1, B2, B3;
     f = 0;
 
-    for (i = 0; i < boleCharTable_.size(); i++)
+    i = resolvedSpecies_.boleCharTableIndex; // found when the species was resolved
+    if(i < 0)
     {
-        if(boleCharTable_[i].equationNumber == mortalityInputs_.getCrownScorchOrBoleCharEquationNumber())
-        {
-            break; // found it
-        }
-        else if(boleCharTable_[i].equationNumber == -1)
-        {
-            return -1; // Error - didn't find equation number in table
-        }
+        return -1; // Error - didn't find equation number in table
     }
     
     B1 = boleCharTable_[i].B1; // spreadsheet column - formula coefficent
@@ -1737,7 +1907,7 @@ int Mortality::getSpeciesTableIndexFromSpeciesCode(string speciesCode) const
 
 int Mortality::getNumberOfRecordsInSpeciesTable() const
 {
-    return (int)speciesMasterTable_->record_.size();
+    return speciesMasterTable_->getNumberOfRecords();
 }
 
 int Mortality::getSpeciesTableIndexFromSpeciesCodeAndEquationType(string speciesNameCode, EquationType equationType) const
@@ -1752,52 +1922,52 @@ vector<bool> Mortality::getRequiredFieldVector()
 
 SpeciesMasterTableRecord Mortality::getSpeciesRecordAtIndex(int index) const
 {
-    return speciesMasterTable_->record_[index];
+    return speciesMasterTable_->getRecord(index);
 }
 
 SpeciesMasterTableRecord Mortality::getSpeciesRecordBySpeciesCodeAndEquationType(string speciesCode, EquationType equationType) const
 {
     int index = speciesMasterTable_->getSpeciesTableIndexFromSpeciesCodeAndEquationType(speciesCode, equationType);
-    return speciesMasterTable_->record_[index];
+    return speciesMasterTable_->getRecord(index);
 }
 
 std::vector<SpeciesMasterTableRecord> Mortality::getSpeciesRecordVectorForRegion(RegionCode region) const
 {
     std::vector<SpeciesMasterTableRecord> speciesInSelectedRegion;
     bool isErroneousInput = false;
-    for(int i = 0; i < speciesMasterTable_->record_.size(); i++)
+    for(int i = 0; i < speciesMasterTable_->getNumberOfRecords(); i++)
     {
         switch(region)
         {
             case RegionCode::interior_west:
             {
-                if(speciesMasterTable_->record_[i].regionInteriorWest == (int)RegionCode::interior_west)
+                if(speciesMasterTable_->getEntry(i).regionInteriorWest == (int)RegionCode::interior_west)
                 {
-                    speciesInSelectedRegion.push_back(speciesMasterTable_->record_[i]);
+                    speciesInSelectedRegion.push_back(speciesMasterTable_->getRecord(i));
                 }
                 break;
             }
             case RegionCode::pacific_west:
             {
-                if(speciesMasterTable_->record_[i].regionPacificWest == (int)RegionCode::pacific_west)
+                if(speciesMasterTable_->getEntry(i).regionPacificWest == (int)RegionCode::pacific_west)
                 {
-                    speciesInSelectedRegion.push_back(speciesMasterTable_->record_[i]);
+                    speciesInSelectedRegion.push_back(speciesMasterTable_->getRecord(i));
                 }
                 break;
             }
             case RegionCode::north_east:
             {
-                if(speciesMasterTable_->record_[i].regionNorthEast == (int)RegionCode::north_east)
+                if(speciesMasterTable_->getEntry(i).regionNorthEast == (int)RegionCode::north_east)
                 {
-                    speciesInSelectedRegion.push_back(speciesMasterTable_->record_[i]);
+                    speciesInSelectedRegion.push_back(speciesMasterTable_->getRecord(i));
                 }
                 break;
             }
             case RegionCode::south_east:
             {
-                if(speciesMasterTable_->record_[i].regionSouthEast == (int)RegionCode::south_east)
+                if(speciesMasterTable_->getEntry(i).regionSouthEast == (int)RegionCode::south_east)
                 {
-                    speciesInSelectedRegion.push_back(speciesMasterTable_->record_[i]);
+                    speciesInSelectedRegion.push_back(speciesMasterTable_->getRecord(i));
                 }
                 break;
             }
@@ -1822,43 +1992,43 @@ std::vector<SpeciesMasterTableRecord> Mortality::getSpeciesRecordVectorForRegion
     std::vector<SpeciesMasterTableRecord> speciesInSelectedRegion;
     bool isErroneousInput = false;
    
-    for(int i = 0; i < speciesMasterTable_->record_.size(); i++)
+    for(int i = 0; i < speciesMasterTable_->getNumberOfRecords(); i++)
     {
         switch(region)
         {
             case RegionCode::interior_west:
             {
-                if((speciesMasterTable_->record_[i].regionInteriorWest == (int)RegionCode::interior_west) &&
-                    (speciesMasterTable_->record_[i].equationType == equationType))
+                if((speciesMasterTable_->getEntry(i).regionInteriorWest == (int)RegionCode::interior_west) &&
+                    (speciesMasterTable_->getEntry(i).equationType == equationType))
                 {
-                    speciesInSelectedRegion.push_back(speciesMasterTable_->record_[i]);
+                    speciesInSelectedRegion.push_back(speciesMasterTable_->getRecord(i));
                 }
                 break;
             }
             case RegionCode::pacific_west:
             {
-                if((speciesMasterTable_->record_[i].regionPacificWest == (int)RegionCode::pacific_west) &&
-                    (speciesMasterTable_->record_[i].equationType == equationType))
+                if((speciesMasterTable_->getEntry(i).regionPacificWest == (int)RegionCode::pacific_west) &&
+                    (speciesMasterTable_->getEntry(i).equationType == equationType))
                 {
-                    speciesInSelectedRegion.push_back(speciesMasterTable_->record_[i]);
+                    speciesInSelectedRegion.push_back(speciesMasterTable_->getRecord(i));
                 }
                 break;
             }
             case RegionCode::north_east:
             {
-                if((speciesMasterTable_->record_[i].regionNorthEast == (int)RegionCode::north_east) &&
-                    (speciesMasterTable_->record_[i].equationType == equationType))
+                if((speciesMasterTable_->getEntry(i).regionNorthEast == (int)RegionCode::north_east) &&
+                    (speciesMasterTable_->getEntry(i).equationType == equationType))
                 {
-                    speciesInSelectedRegion.push_back(speciesMasterTable_->record_[i]);
+                    speciesInSelectedRegion.push_back(speciesMasterTable_->getRecord(i));
                 }
                 break;
             }
             case RegionCode::south_east:
             {
-                if((speciesMasterTable_->record_[i].regionSouthEast == (int)RegionCode::south_east) &&
-                    (speciesMasterTable_->record_[i].equationType == equationType))
+                if((speciesMasterTable_->getEntry(i).regionSouthEast == (int)RegionCode::south_east) &&
+                    (speciesMasterTable_->getEntry(i).equationType == equationType))
                 {
-                    speciesInSelectedRegion.push_back(speciesMasterTable_->record_[i]);
+                    speciesInSelectedRegion.push_back(speciesMasterTable_->getRecord(i));
                 }
                 break;
             }
@@ -1939,18 +2109,84 @@ bool Mortality::updateInputsForSpeciesCodeAndEquationType(std::string speciesCod
     
     if(speciesIndex >= 0)
     {
-        mortalityInputs_.setEquationType(speciesMasterTable_->record_[speciesIndex].equationType);
-        mortalityInputs_.setCrownScorchOrBoleCharEquationNumber(speciesMasterTable_->record_[speciesIndex].mortalityEquationNumber);
-        mortalityInputs_.setCrownDamageEquationCode(speciesMasterTable_->record_[speciesIndex].crownDamageEquationCode);
-
-        mortalityInputs_.isFieldRequiredVector_ = equationRequiredFieldTable_.getRequiredFieldVector(mortalityInputs_.getEquationType(), mortalityInputs_.getCrownDamageEquationCode());
-        mortalityInputs_.setCrownDamageType(equationRequiredFieldTable_.getCrownDamageType(mortalityInputs_.getEquationType(), mortalityInputs_.getCrownDamageEquationCode()));
+        ResolvedSpecies resolvedSpecies;
+        resolveSpecies(speciesIndex, resolvedSpecies);
+        applyResolvedSpecies(resolvedSpecies);
         return true; // OK
     }
 
+    resolvedSpecies_ = ResolvedSpecies();
     return false; // Error
 }
 
+/*************************************************************
+* Name: resolveSpecies
+* Desc: Look up everything needed to calculate mortality from the
+*       Species Master Table record at speciesTableIndex: the
+*       mortalityInputs_ equation inputs, the bark, canopy and bole
+*       char coefficients and the equation function
+*  Out: resolvedSpecies
+**************************************************************/
+void Mortality::resolveSpecies(int speciesTableIndex, ResolvedSpecies& resolvedSpecies)
+{
+    const SpeciesMasterTableEntry& record = speciesMasterTable_->getEntry(speciesTableIndex);
+
+    resolvedSpecies.speciesTableIndex = speciesTableIndex;
+    resolvedSpecies.record = &record;
+    resolvedSpecies.speciesCode = record.speciesCode;
+    resolvedSpecies.equationType = record.equationType;
+    resolvedSpecies.crownScorchOrBoleCharEquationNumber = record.mortalityEquationNumber;
+    resolvedSpecies.crownDamageEquationCode = record.crownDamageEquationCode;
+    resolvedSpecies.requiredFieldVector = equationRequiredFieldTable_.getRequiredFieldVector(record.equationType, record.crownDamageEquationCode);
+    resolvedSpecies.crownDamageType = equationRequiredFieldTable_.getCrownDamageType(record.equationType, record.crownDamageEquationCode);
+
+    resolvedSpecies.barkThicknessCoefficient = getBarkThicknessCoefficient(record.barkEquationNumber);
+
+    const CanopyCoefficientTableRecord& canopyCoefficients = canopyCoefficientTable_.getRecord(record.crownCoefficientCode);
+    resolvedSpecies.canopyCoefficientA = canopyCoefficients.coefficientA_;
+    resolvedSpecies.canopyCoefficientB = canopyCoefficients.coefficientB_;
+    resolvedSpecies.canopyCoefficientR = canopyCoefficients.coefficientR_;
+
+    resolvedSpecies.boleCharTableIndex = -1;
+    resolvedSpecies.crownScorchEquation = nullptr;
+    resolvedSpecies.crownDamageEquation = nullptr;
+    if(record.equationType == EquationType::crown_scorch)
+    {
+        resolvedSpecies.crownScorchEquation = getCrownScorchEquation(record.mortalityEquationNumber);
+    }
+    else if(record.equationType == EquationType::crown_damage)
+    {
+        resolvedSpecies.crownDamageEquation = getCrownDamageEquation(record.crownDamageEquationCode);
+    }
+    else if(record.equationType == EquationType::bole_char)
+    {
+        for(std::size_t i = 0; i < boleCharTable_.size() && boleCharTable_[i].equationNumber != -1; i++)
+        {
+            if(boleCharTable_[i].equationNumber == record.mortalityEquationNumber)
+            {
+                resolvedSpecies.boleCharTableIndex = i;
+                break; // found it
+            }
+        }
+    }
+}
+
+/*************************************************************
+* Name: applyResolvedSpecies
+* Desc: Set mortalityInputs_ species and equation inputs
+*       from a resolved Species Master Table record
+**************************************************************/
+void Mortality::applyResolvedSpecies(const ResolvedSpecies& resolvedSpecies)
+{
+    resolvedSpecies_ = resolvedSpecies;
+    mortalityInputs_.setSpeciesCode(resolvedSpecies.speciesCode);
+    mortalityInputs_.setEquationType(resolvedSpecies.equationType);
+    mortalityInputs_.setCrownScorchOrBoleCharEquationNumber(resolvedSpecies.crownScorchOrBoleCharEquationNumber);
+    mortalityInputs_.setCrownDamageEquationCode(resolvedSpecies.crownDamageEquationCode);
+    mortalityInputs_.isFieldRequiredVector_ = resolvedSpecies.requiredFieldVector;
+    mortalityInputs_.setCrownDamageType(resolvedSpecies.crownDamageType);
+}
+
 /****************************************************************************
 * Name: calculateBarkThickness
 * Desc: Calculate the Bark Thickness
@@ -1963,16 +2199,29 @@ bool Mortality::updateInputsForSpeciesCodeAndEquationType(std::string speciesCod
 ****************************************************************************/
 double Mortality::calculateBarkThickness()
 {
-    int index, barkEquation;
-    double f, barkThickness;
-    index = speciesMasterTable_->getSpeciesTableIndexFromSpeciesCodeAndEquationType(mortalityInputs_.getSpeciesCode(), mortalityInputs_.getEquationType());
-    if(index < 0)
+    if(resolvedSpecies_.speciesTableIndex < 0)
     {
         //strcpy(errMes, "Logic Error - Can't Find Species in function calculateBarkThickness");
         return -1;
     }
+    if(resolvedSpecies_.barkThicknessCoefficient < 0)
+    {
+        return -1;
+    }
 
-    barkEquation = speciesMasterTable_->record_[index].barkEquationNumber;
+    return resolvedSpecies_.barkThicknessCoefficient * mortalityInputs_.getDBH(LengthUnits::Inches);
+}
+
+/****************************************************************************
+* Name: getBarkThicknessCoefficient
+* Desc: Bark thickness per inch of DBH for a bark equation number
+* Note-1: Equation(s) that do not use a bark thickness equation
+*         Ex: PIPA2
+*  Ret: coefficient, -1 if no equation
+****************************************************************************/
+double Mortality::getBarkThicknessCoefficient(int barkEquation)
+{
+    double f;
 
     switch(barkEquation)
     {
@@ -2183,8 +2432,7 @@ double Mortality::calculateBarkThickness()
         }
     }
 
-    barkThickness = f * mortalityInputs_.getDBH(LengthUnits::Inches);
-    return barkThickness;
+    return f;
 }
 
 /****************************************************************************
@@ -2201,7 +2449,6 @@ double Mortality::calculateBarkThickness()
 ****************************************************************************/
 double Mortality::calculateCrownCover()
 {
-    int speciesTableIndex;
     double f, r, a;
 
     if(mortalityInputs_.getTreeHeight(LengthUnits::Feet) <= 0)
@@ -2213,22 +2460,23 @@ double Mortality::calculateCrownCover()
         return 0;
     }
 
-    speciesTableIndex = speciesMasterTable_->getSpeciesTableIndexFromSpeciesCodeAndEquationType(mortalityInputs_.getSpeciesCode(), mortalityInputs_.getEquationType()); // Get index into Species table
-
-    const int canopyCoefficientTableIndex = speciesMasterTable_->record_[speciesTableIndex].crownCoefficientCode;
+    if(resolvedSpecies_.speciesTableIndex < 0)
+    {
+        return 0;
+    }
 
     /* Get Diameter of Crown using Coefficients                                  */
     if(mortalityInputs_.getTreeHeight(LengthUnits::Feet) <= 4.5) // Small trees
     {
         //f = s_CCT.coefficientR_ * Dia;
-        f = canopyCoefficientTable_.record_[canopyCoefficientTableIndex].coefficientR_ * mortalityInputs_.getDBH(LengthUnits::Inches);
+        f = resolvedSpecies_.canopyCoefficientR * mortalityInputs_.getDBH(LengthUnits::Inches);
     }
     else // Large Trees
     {
         //f = pow((double)Dia, (double)s_CCT.coefficientB_); // raise it to power
-        f = pow((double)mortalityInputs_.getDBH(LengthUnits::Inches), (double)canopyCoefficientTable_.record_[canopyCoefficientTableIndex].coefficientB_); // raise it to power
+        f = pow((double)mortalityInputs_.getDBH(LengthUnits::Inches), (double)resolvedSpecies_.canopyCoefficientB); // raise it to power
         //f = f * s_CCT.coefficientA_;  // and multiply
-        f = f * canopyCoefficientTable_.record_[canopyCoefficientTableIndex].coefficientA_;  // and multiply
+        f = f * resolvedSpecies_.canopyCoefficientA;  // and multiply
     }
 
     /* Use Diameter of Crown to get Area..........                               */
@@ -7,12 +7,48 @@
 #ifndef MORTALITY_H
 #define MORTALITY_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
 #include "canopy_coefficient_table.h"
 #include "mortality_inputs.h"
 
+//.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
+// Tree list for calculateMortalityForTreeList, one array per field, all of
+// length numberOfTrees. Fields the species' equation does not require may be
+// left as nullptr.
+struct MortalityTreeList
+{
+    std::size_t numberOfTrees = 0;
+    const int* speciesTableIndex = nullptr;     // index into the Species Master Table
+    const double* dbh = nullptr;
+    const double* treeHeight = nullptr;
+    const double* crownRatio = nullptr;         // fraction 0.0 to 1.0
+    const double* expansionFactor = nullptr;    // trees per unit area represented by each tree
+    const double* crownDamage = nullptr;
+    const double* cambiumKillRating = nullptr;
+    const BeetleDamage* beetleDamage = nullptr;
+    const double* boleCharHeight = nullptr;
+
+    LengthUnits::LengthUnitsEnum dbhUnits = LengthUnits::Inches;
+    LengthUnits::LengthUnitsEnum heightUnits = LengthUnits::Feet; // tree and bole char height
+    AreaUnits::AreaUnitsEnum expansionFactorAreaUnits = AreaUnits::Acres;
+};
+
+// Stand level totals of a tree list, per acre
+struct MortalityStandSummary
+{
+    std::size_t numberOfTrees = 0;
+    std::size_t numberOfInvalidTrees = 0;   // trees with no valid species or equation, not in totals
+    double treesPrefire = 0;                // trees per acre
+    double treesKilled = 0;                 // trees per acre
+    double basalAreaPrefire = 0;            // square feet per acre
+    double basalAreaKilled = 0;             // square feet per acre
+    double prefireCanopyCover = 0;          // percent, after crown overlap correction
+    double postfireCanopyCover = 0;         // percent, after crown overlap correction
+};
+
 //.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.
 class Mortality
 {
@@ -67,6 +103,12 @@ public:
 
     double calculateMortality(FractionUnits::FractionUnitsEnum probablityUnits);
 
+    // Calculates every tree of treeList with the current fire inputs (flame length
+    // or scorch height, fire severity), writing each tree's probability of mortality
+    // (-1 if invalid) to probabilityOfMortality, and returns the stand totals
+    MortalityStandSummary calculateMortalityForTreeList(const MortalityTreeList& treeList, double* probabilityOfMortality,
+        FractionUnits::FractionUnitsEnum probabilityUnits, int numberOfThreads = 1);
+
     // Species Master Table Interface
     string getSpeciesCodeAtSpeciesTableIndex(int index) const;
     string getScientificNameAtSpeciesTableIndex(int index) const;
@@ -113,10 +155,73 @@ public:
     double postfireCanopyCover() const;         // Postfire Canopy Cover             
 
 protected:
+    // Values shared by the crown scorch equations, computed once per tree in
+    // calculateMortalityCrownScorch()
+    struct CrownScorchTerms
+    {
+        double dbh;                         // inches
+        double treeHeight;                  // feet
+        double crownLengthScorchedPercent;
+        double crownVolumeScorchedPercent;
+        double scorchHeight;                // feet
+        double blackHillsFlameLength;       // feet
+    };
+
+    typedef double (Mortality::*CrownScorchEquation)(const CrownScorchTerms& terms);
+    typedef double (Mortality::*CrownDamageEquation)();
+
+    // Species Master Table record and everything that follows from it (equation
+    // inputs, coefficients and the equation to call), looked up once per species
+    // so repeated calculations skip the table searches and equation switches
+    struct ResolvedSpecies
+    {
+        int speciesTableIndex = -1;
+        const SpeciesMasterTableEntry* record = nullptr;
+        string speciesCode;
+        EquationType equationType = EquationType::not_set;
+        int crownScorchOrBoleCharEquationNumber = -1;
+        CrownDamageEquationCode crownDamageEquationCode = CrownDamageEquationCode::not_set;
+        CrownDamageType crownDamageType = CrownDamageType::not_set;
+        vector<bool> requiredFieldVector;
+
+        double barkThicknessCoefficient = -1;   // bark thickness per inch of DBH, -1 if no bark equation
+        double canopyCoefficientA = 0;          // large tree crown diameter coefficients
+        double canopyCoefficientB = 0;
+        double canopyCoefficientR = 0;          // small tree crown diameter coefficient
+        int boleCharTableIndex = -1;            // index into boleCharTable_, -1 if not bole char
+        CrownScorchEquation crownScorchEquation = nullptr;
+        CrownDamageEquation crownDamageEquation = nullptr;
+    };
+
     void memberwiseCopyAssignment(const Mortality& rhs);
     void initializeOutputs();
 
+    void resolveSpecies(int speciesTableIndex, ResolvedSpecies& resolvedSpecies);
+    void applyResolvedSpecies(const ResolvedSpecies& resolvedSpecies);
+    void calculateMortalityForTreeListRange(const MortalityTreeList& treeList, const vector<ResolvedSpecies>& resolvedSpecies,
+        std::size_t begin, std::size_t end, double* probabilityOfMortality, FractionUnits::FractionUnitsEnum probabilityUnits,
+        MortalityStandSummary& summary, double& coveragePrefire, double& coveragePostfire);
+
     double calculateMortalityCrownScorch();
+    static CrownScorchEquation getCrownScorchEquation(int crownScorchEquationNumber);
+    static CrownDamageEquation getCrownDamageEquation(CrownDamageEquationCode crownDamageEquationCode);
+    static double getBarkThicknessCoefficient(int barkEquationNumber);
+
+    double crownScorchEquation1(const CrownScorchTerms& terms);
+    double crownScorchEquation3(const CrownScorchTerms& terms);
+    double crownScorchEquation4(const CrownScorchTerms& terms);
+    double crownScorchEquation5(const CrownScorchTerms& terms);
+    double crownScorchEquation10(const CrownScorchTerms& terms);
+    double crownScorchEquation11(const CrownScorchTerms& terms);
+    double crownScorchEquation12(const CrownScorchTerms& terms);
+    double crownScorchEquation14(const CrownScorchTerms& terms);
+    double crownScorchEquation15(const CrownScorchTerms& terms);
+    double crownScorchEquation16(const CrownScorchTerms& terms);
+    double crownScorchEquation17(const CrownScorchTerms& terms);
+    double crownScorchEquation18(const CrownScorchTerms& terms);
+    double crownScorchEquation19(const CrownScorchTerms& terms);
+    double crownScorchEquation20(const CrownScorchTerms& terms);
+    double crownScorchEquation21(const CrownScorchTerms& terms);
 
     void calculateMortalityTotals();
     double Squaredouble(double f);
@@ -164,6 +269,7 @@ protected:
     //MortalityOutputs mortalityOutputs_;
 
     SpeciesMasterTable* speciesMasterTable_;
+    ResolvedSpecies resolvedSpecies_; // current species code and equation type, speciesTableIndex -1 if not valid
     EquationRequiredFieldTable equationRequiredFieldTable_;
     std::vector <BoleCharCoefficientTableRecord> boleCharTable_;
     CanopyCoefficientTable canopyCoefficientTable_;
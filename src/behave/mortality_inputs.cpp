@@ -12,6 +12,7 @@
 
 MortalityInputs::MortalityInputs()
 {
+    region_ = RegionCode::interior_west;
     speciesCode_ = "";
     equationType_ = EquationType::not_set;
     densityPerAcre_ = -1.0;
@@ -25,6 +26,10 @@ MortalityInputs::MortalityInputs()
     cambiumKillRating_ = -1.0;
     beetleDamage_ = BeetleDamage::not_set;
     boleCharHeight_ = -1.0;
+    crownScorchOrBoleCharEquationNumber_ = -1;
+    crownDamageEquationCode_ = CrownDamageEquationCode::not_set;
+    crownDamageType_ = CrownDamageType::not_set;
+    barkThickness_ = -1.0;
    
     isFieldRequiredVector_.resize((int)RequiredFieldNames::num_inputs);
     std::fill(isFieldRequiredVector_.begin(), isFieldRequiredVector_.end(), false);
@@ -50,6 +55,7 @@ MortalityInputs& MortalityInputs::operator=(const MortalityInputs& rhs)
 
 void MortalityInputs::memberwiseCopyAssignment(const MortalityInputs& rhs)
 {
+    region_ = rhs.region_;
     speciesCode_ = rhs.speciesCode_;
     equationType_ = rhs.equationType_;
     densityPerAcre_ = rhs.densityPerAcre_;
@@ -63,6 +69,10 @@ void MortalityInputs::memberwiseCopyAssignment(const MortalityInputs& rhs)
     cambiumKillRating_ = rhs.cambiumKillRating_;
     beetleDamage_ = rhs.beetleDamage_;
     boleCharHeight_ = rhs.boleCharHeight_;
+    crownScorchOrBoleCharEquationNumber_ = rhs.crownScorchOrBoleCharEquationNumber_;
+    crownDamageEquationCode_ = rhs.crownDamageEquationCode_;
+    crownDamageType_ = rhs.crownDamageType_;
+    barkThickness_ = rhs.barkThickness_;
     isFieldRequiredVector_ = rhs.isFieldRequiredVector_; 
 }
 
@@ -76,7 +76,7 @@ Extension::~Extension(void)
 //------------------------------------------------------------------------------
 
 bool Extension::allocExtension(long p_blocks, long p_cols, long p_rows,
-    long p_fuels)
+    long p_fuels, RandArena *p_arena)
 {
     freeExtension();
 
@@ -97,7 +97,16 @@ bool Extension::allocExtension(long p_blocks, long p_cols, long p_rows,
     int doubles = 2 * m_blocks + 2 * (m_blocks * m_cells);
     int pointers = 2 * m_blocks;
     int blockSize = pointers * sizeof(double *) + doubles * sizeof(double);
-    m_blockPtr = new char[blockSize];
+    if (p_arena)
+    {
+        // the arena owns the block, so freeExtension() leaves it alone
+        m_arena = p_arena;
+        m_blockPtr = m_arena->allocArray<char>(blockSize);
+    }
+    else
+    {
+        m_blockPtr = new char[blockSize];
+    }
     if (!m_blockPtr)
     {
         return(false);
@@ -213,7 +222,7 @@ double Extension::calcProb(long p_block, bool p_subtFaster)
 void Extension::freeExtension(void)
 {
 #ifndef USE_OLD_METHOD
-    if (m_blockPtr)
+    if (m_blockPtr && !m_arena)
     {
         delete[] m_blockPtr;
     }
@@ -306,6 +315,7 @@ void Extension::init(void)
     m_leeFuels = 0;
     m_cuumProb = 0;
     m_blockPtr = 0;
+    m_arena = 0;
     m_latRosArray = 0;
     m_latCombArray = 0;
     return;
@@ -341,9 +351,13 @@ void Extension::run(long p_lats, double *p_latRos, double *p_latComb,
         return;
     }
 
+    // everything below comes from the RandFuel arena and is given back
+    // on return, so the recursion nests its allocations
+    RandArena *arena = m_rf->getBlockArena();
+    RandArena::Marker marker = arena->mark();
     long newLats = 2 * (p_lats + 1);
-    double *latros2 = new double[newLats];
-    double *latcomb2 = new double[newLats];
+    double *latros2 = arena->allocArray<double>(newLats);
+    double *latcomb2 = arena->allocArray<double>(newLats);
     long fuelCombs;
     long j, k;
 
@@ -382,32 +396,9 @@ void Extension::run(long p_lats, double *p_latRos, double *p_latComb,
         // Accumulate cumulative probabilities from next extension
         m_extCuumProb += m_cuumProb[i];
     }
-    if (m_latCombArray)
-    {
-        for (i = 0; i < fuelCombs; i++)
-        {
-            delete[] m_latCombArray[i];
-        }
-        delete[] m_latCombArray;
-        m_latCombArray = 0;
-    }
-    if (m_latRosArray)
-    {
-        for (i = 0; i < fuelCombs; i++)
-        {
-            delete[] m_latRosArray[i];
-        }
-        delete[] m_latRosArray;
-        m_latRosArray = 0;
-    }
-    if (latros2)
-    {
-        delete[] latros2;
-    }
-    if (latcomb2)
-    {
-        delete[] latcomb2;
-    }
+    m_latCombArray = 0;
+    m_latRosArray = 0;
+    arena->release(marker);
     return;
 }
 
@@ -54,6 +54,7 @@
 // Custom include files
 #include "randfuel.h"
 
+class RandArena;
 class RandFuel;
 
 class Extension
@@ -64,7 +65,8 @@ public:
     Extension( void );
     ~Extension( void );
     // These are called by RandFuel::computeSpread2()
-    bool   allocExtension( long p_blocks, long p_cols, long p_rows, long p_fuels ) ;
+    bool   allocExtension( long p_blocks, long p_cols, long p_rows, long p_fuels,
+                           RandArena *p_arena ) ;
     double calcProb( long p_block, bool p_subtFaster ) ;
     void   run( long p_lats, double *p_latRos, double *p_latComb,
                 double p_maxRos ) ;
@@ -99,6 +101,7 @@ protected:
     long       m_fuels;         //!< number of fuel types
     long       m_leeFuels;      //!< number of lee fuel combinations
     char      *m_blockPtr;      //!< Pointer to single dynamic memory block
+    RandArena *m_arena;         //!< arena m_blockPtr came from, 0 if from new[]
     double    *m_cuumProb;      //!< cumulative prob of faster spread rates
     double   **m_latRosArray;   //!< lee side spread rates and probabilities
     double   **m_latCombArray;  //!< lee side spread rates and probabilities
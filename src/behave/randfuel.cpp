@@ -53,11 +53,17 @@
 #endif
 
 #include "randfuel.h"
+#include "behaveInstrumentation.h"
+#include <limits.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <chrono>
+#include <thread>
+#include <vector>
+
 //------------------------------------------------------------------------------
 
 RandFuel::RandFuel(void)
@@ -70,11 +76,8 @@ RandFuel::RandFuel(void)
 
 RandFuel::~RandFuel(void)
 {
+    // all arrays belong to the workspace
     freeBlockArrays();
-    if (m_maxRosArray)
-    {
-        delete[] m_maxRosArray;
-    }
     m_maxRosArray = 0;
     freeFuels();
     return;
@@ -85,10 +88,9 @@ RandFuel::~RandFuel(void)
 bool RandFuel::allocFuels(long p_fuels)
 {
     freeFuels();
-    if (!(m_fuelTypeArray = new FuelType[p_fuels]))
-    {
-        return(false);
-    }
+    RandArena *fuelArena = m_workspace->getFuelArena();
+    fuelArena->reset();
+    m_fuelTypeArray = fuelArena->allocArray<FuelType>(p_fuels);
     m_fuels = p_fuels;
     return(true);
 }
@@ -98,13 +100,50 @@ bool RandFuel::allocFuels(long p_fuels)
 bool RandFuel::allocRandThreads(void)
 {
     closeRandThreads();
-    if (!(m_randThread = new RandThread[m_threads]))
+    if (!(m_randThread = m_workspace->getRandThreads(m_threads)))
     {
         return(false);
     }
     return(true);
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Calculates the number of factorial combinations of all fuel types
+ *  over p_cells cells, m_fuels^p_cells.
+ *
+ *  \return false if the count does not fit in a long.
+ */
+
+bool RandFuel::calcBlockCount(long p_cells, long *p_nT) const
+{
+    long count = 1;
+    for (long i = 0; i < p_cells; i++)
+    {
+        if (count > LONG_MAX / m_fuels)
+        {
+            return(false);
+        }
+        count *= m_fuels;
+    }
+    *p_nT = count;
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Calculates the probability of sample block p_comb occurring
+ *  without materializing it, using the calcCombinations() ordering.
+ */
+
+double RandFuel::calcBlockProb(long p_comb) const
+{
+    double prob = 1.0;
+    for (long n = 0; n < m_samples * m_depths; n++)
+    {
+        prob *= m_fuelTypeArray[p_comb % m_fuels].m_fract;
+        p_comb /= m_fuels;
+    }
+    return(prob);
+}
 
 //------------------------------------------------------------------------------
 /*! \brief
@@ -124,18 +163,13 @@ bool RandFuel::calcCombinations(long p_nX, long p_nY, long *p_nT,
     double *comb;                          // array of probability distribution
     double *ros;                           // array of spread rate distribution
 
+    // comb and ros stay in the arena until it is reset or released
+    RandArena *arena = m_workspace->getBlockArena();
     unsigned long types = (unsigned long)pow((double)m_fuels, (int)p_nX) * p_nX;
-    if (!(comb = new double[types]))
-    {
-        return(false);
-    }
+    comb = arena->allocArray<double>(types);
     memset(comb, 0x0, types * sizeof(double));
 
-    if (!(ros = new double[types]))
-    {
-        delete[] comb;
-        return(false);
-    }
+    ros = arena->allocArray<double>(types);
     memset(ros, 0x0, types * sizeof(double));
 
     // calculate the combinations that form the breadth of the fuel patch
@@ -173,26 +207,14 @@ bool RandFuel::calcCombinations(long p_nX, long p_nY, long *p_nT,
     {
         *p_nT = (long)pow((double)cols, (int)p_nY);
     }
-    if (!(*p_ca = new double*[*p_nT]))
-    {
-        delete[] comb;
-        delete[] ros;
-        return(false);
-    }
-
-    if (!(*p_ra = new double*[*p_nT]))
-    {
-        delete[] comb;
-        delete[] ros;
-        delete[] * p_ca;
-        return(false);
-    }
+    *p_ca = arena->allocArray<double *>(*p_nT);
+    *p_ra = arena->allocArray<double *>(*p_nT);
 
     // calculate block array probabilities and spread rates
     for (i = 0; i < *p_nT; i++)
     {
-        (*p_ca)[i] = new double[p_nX * p_nY];
-        (*p_ra)[i] = new double[p_nX * p_nY];
+        (*p_ca)[i] = arena->allocArray<double>(p_nX * p_nY);
+        (*p_ra)[i] = arena->allocArray<double>(p_nX * p_nY);
     }
 
     terms = 1;
@@ -226,9 +248,6 @@ bool RandFuel::calcCombinations(long p_nX, long p_nY, long *p_nT,
         }
         terms *= cols;
     }
-
-    delete[] comb;
-    delete[] ros;
     return(true);
 }
 
@@ -260,7 +279,9 @@ void RandFuel::calcExtendedSpreadRates2(long p_cols, long p_rows,
     }
     long begin = 0;
     long end = 0;
-    for (int i = 0; i < m_threads; i++)
+    long active = 0;
+    int i;
+    for (i = 0; i < m_threads; i++)
     {
         end = begin + range;
         if (begin >= p_latCombs)
@@ -274,9 +295,10 @@ void RandFuel::calcExtendedSpreadRates2(long p_cols, long p_rows,
         m_randThread[i].setThreadData(p_cols, p_rows, p_latCombs,
             m_lbRatio, p_combArray, p_rosArray, p_maxRosExtArray, begin, end, p_laterals,
             (p_cols - p_laterals), p_latRosArray, m_lessIgns);
+        active++;
         begin = end;
     }
-    m_randThread[0].calcSpreadPaths2();
+    runRandThreads(active);
     return;
 }
 
@@ -289,16 +311,22 @@ void RandFuel::calcExtendedSpreadRates2(long p_cols, long p_rows,
  *  -#  Runs each thread and wait until they are all finished (hRandSyncEvent)
  *  -#  Calculates Expected Spread Rates by Prob[i] X MaxSpread[i]
  *
+ *  If m_combArray has not been filled by calcCombinations(), each thread
+ *  enumerates its own range of blocks in a scratch buffer and accumulates
+ *  the expected and harmonic sums itself.  m_maxRosArray is then only
+ *  allocated if m_retainBlockRos is set.
+ *
+ *  \return The number of RandThreads run; only these hold sums of this call.
  */
 
-void RandFuel::calcSpreadRates(void)
+long RandFuel::calcSpreadRates(void)
 {
-    if (m_maxRosArray)
+    m_maxRosArray = 0;
+    if (m_combArray || m_retainBlockRos)
     {
-        delete[] m_maxRosArray;
+        m_maxRosArray = m_workspace->getBlockArena()->allocArray<double>(m_combs);
+        memset(m_maxRosArray, 0x0, m_combs * sizeof(double));
     }
-    m_maxRosArray = new double[m_combs];
-    memset(m_maxRosArray, 0x0, m_combs * sizeof(double));
 
     double interval = ((double)m_combs) / ((double)m_threads);
     double ipart;
@@ -310,7 +338,9 @@ void RandFuel::calcSpreadRates(void)
     }
     long begin = 0;
     long end = 0;
-    for (int i = 0; i < m_threads; i++)
+    long active = 0;
+    int i;
+    for (i = 0; i < m_threads; i++)
     {
         end = begin + range;
         if (begin >= m_combs)
@@ -321,24 +351,47 @@ void RandFuel::calcSpreadRates(void)
         {
             end = m_combs;
         }
+        m_randThread[i].setFuelTypes(m_fuels, m_fuelTypeArray);
         m_randThread[i].setThreadData(m_samples, m_depths, m_combs, m_lbRatio,
             m_combArray, m_rosArray, m_maxRosArray, begin, end, 0, m_samples,
             0, m_lessIgns);
+        active++;
         begin = end;
     }
-    m_randThread[0].calcSpreadPaths2();
-    return;
+    runRandThreads(active);
+    return(active);
 }
 
 //------------------------------------------------------------------------------
+/*! \brief Normalizes each fuel's spread rate by the fastest fuel.
+ *
+ *  \return The fastest absolute spread rate.
+ */
 
-void RandFuel::closeRandThreads(void)
+double RandFuel::calcRelativeRos(void)
 {
-    if (m_randThread)
+    double maxRos = 0.0;
+    long i;
+    for (i = 0; i < m_fuels; i++)
+    {
+        if (maxRos < m_fuelTypeArray[i].m_absRos)
+        {
+            maxRos = m_fuelTypeArray[i].m_absRos;
+        }
+    }
+    for (i = 0; i < m_fuels; i++)
     {
-        delete[] m_randThread;
-        m_randThread = 0;
+        m_fuelTypeArray[i].m_relRos = m_fuelTypeArray[i].m_absRos / maxRos;
     }
+    return(maxRos);
+}
+
+//------------------------------------------------------------------------------
+
+void RandFuel::closeRandThreads(void)
+{
+    // the RandThreads stay pooled in the workspace
+    m_randThread = 0;
     return;
 }
 //------------------------------------------------------------------------------
@@ -346,15 +399,21 @@ void RandFuel::closeRandThreads(void)
  *  of fuels and their probabilities.
  *
  *  Also adds ROS from lateral extensions=Extend.
+ *
+ *  Without lateral extensions the sample blocks are enumerated on the fly
+ *  by the RandThreads, so memory no longer grows with the number of blocks
+ *  (except m_maxRosArray, see setRetainBlockSpreadRates()).  The extension
+ *  splicing still works on blocks materialized by calcCombinations(), as
+ *  does every run after setEnumerateBlocks(false).
  */
 
 double RandFuel::computeSpread2(long p_samples, long p_depths,
     double p_lbRatio, long p_threads, double *p_maxRos,
     double *p_harmonicRos, long p_exts, long p_lessIgns)
 {
+    BEHAVE_INSTRUMENT_SCOPE(RandFuelComputeSpread);
     long i, j, k, m, fuelCombs;
     double maxRos = 0.0;
-    double minRos = 1e12;
     double harmonic = 0.0;
     double average = 0.0;
 
@@ -369,30 +428,28 @@ double RandFuel::computeSpread2(long p_samples, long p_depths,
     m_lessIgns = p_lessIgns;
     m_lbRatio = p_lbRatio;
 
-    for (i = 0; i < m_fuels; i++)
+    // start over on the block arena; this drops any previous m_maxRosArray
+    freeBlockArrays();
+    m_maxRosArray = 0;
+    m_workspace->getBlockArena()->reset();
+
+    maxRos = calcRelativeRos();
+
+    // base combinations for sample block
+    if (p_exts > 0 || !m_enumerateBlocks)
     {
-        if (maxRos < m_fuelTypeArray[i].m_absRos)
-        {
-            maxRos = m_fuelTypeArray[i].m_absRos;
-        }
-        if (minRos > m_fuelTypeArray[i].m_absRos)
-        {
-            minRos = m_fuelTypeArray[i].m_absRos;
-        }
+        calcCombinations(m_samples, m_depths, &m_combs, &m_combArray, &m_rosArray);
     }
-    for (i = 0; i < m_fuels; i++)
+    else if (!calcBlockCount(m_samples * m_depths, &m_combs))
     {
-        m_fuelTypeArray[i].m_relRos = m_fuelTypeArray[i].m_absRos / maxRos;
+        return(-1.0);
     }
-
-    // base combinations for sample block
-    calcCombinations(m_samples, m_depths, &m_combs, &m_combArray, &m_rosArray);
     if (!allocRandThreads())
     {
         return(-1.0);
     }
 
-    calcSpreadRates(); // ri for sample block
+    long activeThreads = calcSpreadRates(); // ri for sample block
     double **latComb, **latRos;
 
     double prob, cuumProb;
@@ -401,13 +458,13 @@ double RandFuel::computeSpread2(long p_samples, long p_depths,
     {
         calcCombinations(2, m_depths, &m_exts, &m_combExtArray, &m_rosExtArray); // extensions only
         calcCombinations(1, 2, &fuelCombs, &latComb, &latRos);
-        Extension *ext = new Extension[p_exts];
+        Extension *ext = m_workspace->getExtensions(p_exts);
 
         // allocate the number of extensions
         for (j = 0; j < p_exts; j++)
         {
             ext[j].allocExtension(m_exts, (m_samples + (j * 2) + 2),
-                m_depths, m_fuels);
+                m_depths, m_fuels, m_workspace->getBlockArena());
             ext[j].m_rf = this;
         }
         // assign a pointer to the next one
@@ -473,43 +530,32 @@ double RandFuel::computeSpread2(long p_samples, long p_depths,
             fprintf(stderr, ".");
         }
         fprintf(stderr, "\n");
-        delete[] ext;
-        if (latComb)
+    }
+    else if (m_combArray)
+    {
+        // weight each materialized block's spread rate by its probability
+        for (j = 0; j < m_combs; j++)
         {
-            for (i = 0; i < fuelCombs; i++)
+            prob = 1.0;
+            for (i = 0; i < m_samples*m_depths; i++)
             {
-                delete[] latComb[i];
+                prob *= ((double)m_combArray[j][i]);
             }
-            delete[] latComb;
-            latComb = 0;
-        }
-        if (latRos)
-        {
-            for (i = 0; i < fuelCombs; i++)
+            average += prob * m_maxRosArray[j];
+            if (m_maxRosArray[j] > 0.0)
             {
-                delete[] latRos[i];
+                harmonic += prob / m_maxRosArray[j];
             }
-            delete[] latRos;
-            latRos = 0;
         }
     }
     else
     {
-        for (i = 0; i < m_combs; i++)
+        // the threads accumulated prob-weighted sums over their blocks; the
+        // pooled threads not run this call still hold an earlier call's sums
+        for (i = 0; i < activeThreads; i++)
         {
-            prob = 1.0;
-            for (j = 0; j < m_depths; j++)
-            {
-                for (k = 0; k < m_samples; k++)
-                {
-                    prob *= m_combArray[i][j*m_samples + k];
-                }
-            }
-            average += m_maxRosArray[i] * prob;
-            if (m_maxRosArray[i] > 0.0)
-            {
-                harmonic += prob / m_maxRosArray[i];
-            }
+            average += m_randThread[i].getExpectedRos();
+            harmonic += m_randThread[i].getHarmonicRos();
         }
     }
 
@@ -534,10 +580,7 @@ double RandFuel::computeSpread2(long p_samples, long p_depths,
 
 void RandFuel::freeFuels(void)
 {
-    if (m_fuelTypeArray)
-    {
-        delete[] m_fuelTypeArray;
-    }
+    // the FuelType array stays in the workspace's fuel arena
     m_fuelTypeArray = 0;
     m_fuels = 0;
     return;
@@ -547,53 +590,27 @@ void RandFuel::freeFuels(void)
 
 void RandFuel::freeBlockArrays(void)
 {
-    long i;
-    if (m_combArray)
-    {
-        for (i = 0; i < m_combs; i++)
-        {
-            delete[] m_combArray[i];
-        }
-        delete[] m_combArray;
-        m_combArray = 0;
-    }
-    if (m_rosArray)
-    {
-        for (i = 0; i < m_combs; i++)
-        {
-            delete[] m_rosArray[i];
-        }
-        delete[] m_rosArray;
-        m_rosArray = 0;
-    }
-    if (m_combExtArray)
-    {
-        for (i = 0; i < m_exts; i++)
-        {
-            delete[] m_combExtArray[i];
-        }
-        delete[] m_combExtArray;
-        m_combExtArray = 0;
-    }
-    if (m_rosExtArray)
-    {
-        for (i = 0; i < m_exts; i++)
-        {
-            delete[] m_rosExtArray[i];
-        }
-        delete[] m_rosExtArray;
-        m_rosExtArray = 0;
-    }
-    if (m_maxRosExtArray)
-    {
-        delete[] m_maxRosExtArray;
-        m_maxRosExtArray = 0;
-    }
+    // the arrays live in the workspace's block arena, which is reset by
+    // the next computeSpread2()
+    m_combArray = 0;
+    m_rosArray = 0;
+    m_combExtArray = 0;
+    m_rosExtArray = 0;
+    m_maxRosExtArray = 0;
     m_combs = 0;
     m_exts = 0;
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Returns the arena block arrays come from, for Extension::run().
+ */
+
+RandArena *RandFuel::getBlockArena(void)
+{
+    return(m_workspace->getBlockArena());
+}
+
 //------------------------------------------------------------------------------
 
 void RandFuel::init(void)
@@ -605,6 +622,8 @@ void RandFuel::init(void)
     m_exts = 0;
     m_threads = 0;
     m_lessIgns = 0;
+    m_retainBlockRos = true;
+    m_enumerateBlocks = true;
     m_lbRatio = 0.0;
     m_cellSize = 0.0;
     m_combArray = 0;
@@ -615,6 +634,7 @@ void RandFuel::init(void)
     m_maxRosExtArray = 0;
     m_fuelTypeArray = 0;
     m_randThread = 0;
+    m_workspace = &m_ownWorkspace;
     return;
 }
 
@@ -630,6 +650,7 @@ void RandFuel::init(void)
 
 double RandFuel::recomputeSpread(double *p_harmonicRos)
 {
+    BEHAVE_INSTRUMENT_SCOPE(RandFuelRecomputeSpread);
     if (!m_maxRosArray)
     {
         *p_harmonicRos = -1.0;
@@ -639,17 +660,11 @@ double RandFuel::recomputeSpread(double *p_harmonicRos)
     double expectedRos = 0.0;
     double harmonicRos = 0.0;
     double totalProb = 0.0;
-    calcCombinations(m_samples, m_depths, &m_combs, &m_combArray, &m_rosArray);
-    for (int i = 0; i < m_combs; i++)
+    long combs = 0;
+    calcBlockCount(m_samples * m_depths, &combs);
+    for (long i = 0; i < combs; i++)
     {
-        double prob = 1.0;
-        for (int j = 0; j < m_depths; j++)
-        {
-            for (int k = 0; k < m_samples; k++)
-            {
-                prob *= ((double)(m_combArray[i][j*m_samples + k]));
-            }
-        }
+        double prob = calcBlockProb(i);
         expectedRos += ((double)m_maxRosArray[i]) * prob;
         if (m_maxRosArray[i] > 0.0)
         {
@@ -660,10 +675,168 @@ double RandFuel::recomputeSpread(double *p_harmonicRos)
 
     // convert harmonicRos to double for return
     *p_harmonicRos = (double)totalProb / harmonicRos;
-    freeBlockArrays();
     return(expectedRos);
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Runs calcSpreadPaths2() on the first p_active RandThreads,
+ *  each on its own system thread, and waits for all of them to finish.
+ */
+
+void RandFuel::runRandThreads(long p_active)
+{
+    std::vector<std::thread> workers;
+    for (long i = 1; i < p_active; i++)
+    {
+        workers.push_back(std::thread(&RandThread::calcSpreadPaths2, &m_randThread[i]));
+    }
+    if (p_active > 0)
+    {
+        m_randThread[0].calcSpreadPaths2();
+    }
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Estimates the Expected Spread Rate by Monte Carlo sampling of
+ *  random fuel arrangements instead of enumerating every combination.
+ *
+ *  Each cell of a drawn block gets fuel i with probability m_fract[i], and
+ *  the block's maximum spread rate is found by the same RandThread path
+ *  timing computeSpread2() uses, so the sample mean converges to the
+ *  computeSpread2() result (without lateral extensions) as draws increase.
+ *  Every RandThread draws from its own random number stream derived from
+ *  p_seed, so a run is reproducible for a given seed and thread count
+ *  unless it is stopped by the time budget.
+ *
+ *  Draws are made in rounds until the first of these is met:
+ *  -#  the standard error of the mean is at most p_targetStdErr
+ *      (relative spread rate units, ignored if <= 0),
+ *  -#  p_maxSeconds of wall time have elapsed (ignored if <= 0),
+ *  -#  p_maxDraws blocks have been drawn (ignored if <= 0).
+ *  If none is set, a single round is drawn.
+ *
+ *  \param p_stdErr  Returned standard error of the relative expected ROS.
+ *  \param p_draws   Returned number of blocks drawn.
+ *  \return The relative expected ROS; multiply by *p_maxRos for absolute.
+ */
+
+double RandFuel::sampleSpread2(long p_samples, long p_depths, double p_lbRatio,
+    long p_threads, double *p_maxRos, double *p_stdErr, long *p_draws,
+    double p_targetStdErr, double p_maxSeconds, long p_maxDraws,
+    unsigned long p_seed, long p_lessIgns)
+{
+    BEHAVE_INSTRUMENT_SCOPE(RandFuelSampleSpread);
+    const long drawsPerRound = 64;      // draws per thread per round
+    const long minDraws = 30;           // before the standard error is trusted
+
+    if (p_samples < 1 || p_samples > 50 || p_threads < 1)
+    {
+        return(0.0);
+    }
+
+    m_samples = p_samples;
+    m_depths = p_depths;
+    m_threads = p_threads;
+    m_lessIgns = p_lessIgns;
+    m_lbRatio = p_lbRatio;
+    double maxRos = calcRelativeRos();
+
+    if (!allocRandThreads())
+    {
+        return(-1.0);
+    }
+    long i;
+    for (i = 0; i < m_threads; i++)
+    {
+        m_randThread[i].setFuelTypes(m_fuels, m_fuelTypeArray);
+        m_randThread[i].setSampleStream(p_seed, i);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    long draws = 0;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    double mean = 0.0;
+    double stdErr = 0.0;
+    bool done = false;
+    while (!done)
+    {
+        long roundDraws = drawsPerRound * m_threads;
+        if (p_maxDraws > 0 && roundDraws > p_maxDraws - draws)
+        {
+            roundDraws = p_maxDraws - draws;
+        }
+        long range = (roundDraws + m_threads - 1) / m_threads;
+        long begin = 0;
+        long active = 0;
+        for (i = 0; i < m_threads && begin < roundDraws; i++)
+        {
+            long end = (begin + range < roundDraws) ? begin + range : roundDraws;
+            m_randThread[i].setThreadData(m_samples, m_depths, roundDraws,
+                m_lbRatio, 0, 0, 0, begin, end, 0, m_samples, 0, m_lessIgns);
+            active++;
+            begin = end;
+        }
+        runRandThreads(active);
+        for (i = 0; i < active; i++)
+        {
+            sum += m_randThread[i].getExpectedRos();
+            sumSquares += m_randThread[i].getExpectedSquaredRos();
+        }
+        draws += roundDraws;
+
+        mean = sum / draws;
+        stdErr = 0.0;
+        if (draws > 1)
+        {
+            double variance = (sumSquares - draws * mean * mean) / (draws - 1);
+            if (variance > 0.0)
+            {
+                stdErr = sqrt(variance / draws);
+            }
+        }
+
+        double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        if (p_maxDraws > 0 && draws >= p_maxDraws)
+        {
+            done = true;
+        }
+        else if (p_targetStdErr > 0.0 && draws >= minDraws && stdErr <= p_targetStdErr)
+        {
+            done = true;
+        }
+        else if (p_maxSeconds > 0.0 && elapsed >= p_maxSeconds)
+        {
+            done = true;
+        }
+        else if (p_targetStdErr <= 0.0 && p_maxSeconds <= 0.0 && p_maxDraws <= 0)
+        {
+            done = true;
+        }
+    }
+
+    if (p_maxRos)
+    {
+        *p_maxRos = maxRos;
+    }
+    if (p_stdErr)
+    {
+        *p_stdErr = stdErr;
+    }
+    if (p_draws)
+    {
+        *p_draws = draws;
+    }
+    closeRandThreads();
+    return(mean);
+}
+
 //------------------------------------------------------------------------------
 
 void RandFuel::setCellDimensions(double p_cellSize)
@@ -671,6 +844,18 @@ void RandFuel::setCellDimensions(double p_cellSize)
     m_cellSize = p_cellSize;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Sets whether computeSpread2() without lateral extensions
+ *  enumerates the sample blocks on the fly.  Defaults to true; false
+ *  materializes every block with calcCombinations() first, as it did
+ *  before, which is only useful as a reference for the enumeration.
+ */
+
+void RandFuel::setEnumerateBlocks(bool p_enumerate)
+{
+    m_enumerateBlocks = p_enumerate;
+}
+
 //------------------------------------------------------------------------------
 
 void RandFuel::setFuelData(long p_type, double p_ros, double p_fract)
@@ -684,6 +869,30 @@ void RandFuel::setFuelData(long p_type, double p_ros, double p_fract)
     return;
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Sets whether computeSpread2() keeps the maximum spread rate of
+ *  every sample block in m_maxRosArray so recomputeSpread() can reweight
+ *  them later.  Defaults to true; turning it off makes computeSpread2()
+ *  without lateral extensions run in memory independent of the block count.
+ */
+
+void RandFuel::setRetainBlockSpreadRates(bool p_retain)
+{
+    m_retainBlockRos = p_retain;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the working memory all arrays, RandThreads and Extensions
+ *  are taken from.  Keeping one RandWorkspace across RandFuel instances
+ *  avoids the heap allocations of every calculation; 0 goes back to this
+ *  RandFuel's own workspace.  Call before allocFuels().
+ */
+
+void RandFuel::setWorkspace(RandWorkspace *p_workspace)
+{
+    m_workspace = p_workspace ? p_workspace : &m_ownWorkspace;
+}
+
 //------------------------------------------------------------------------------
 /*! \brief Splices *p_ca into m_combExtArray and *p_ra into m_rosExtArray
  *  and puts the results into **p_cs and **p_rs.
@@ -55,18 +55,6 @@
 #include "newext.h"
 #include "randthread.h"
 
-//------------------------------------------------------------------------------
-/*! \typedef FuelType
- *  \brief Contains fuel types and their properties (RandFuel)
- */
-
-typedef struct
-{
-    double  m_relRos;   //!< relative spread rate 0-1
-    double  m_absRos;   //!< actual spread rate
-    double  m_fract;    //!< fraction of landscape occupied
-} FuelType;
-
 //------------------------------------------------------------------------------
 /*! \class Randfuel randfuel.h
  */
@@ -87,19 +75,31 @@ public:
         long p_threads, double *p_maxRos, double *p_harmonicRos,
         long p_exts, long p_lessIgns);
     void    freeFuels(void);
+    RandArena *getBlockArena(void);
     double  recomputeSpread(double *p_harmonicRos);
+    double  sampleSpread2(long p_samples, long p_depths, double p_lbRatio,
+        long p_threads, double *p_maxRos, double *p_stdErr, long *p_draws,
+        double p_targetStdErr, double p_maxSeconds, long p_maxDraws,
+        unsigned long p_seed, long p_lessIgns);
     void    setCellDimensions(double p_cellSize);
+    void    setEnumerateBlocks(bool p_enumerate);
     void    setFuelData(long p_type, double p_ros, double p_fract);
+    void    setRetainBlockSpreadRates(bool p_retain);
+    void    setWorkspace(RandWorkspace *p_workspace);
     void    spliceExtensions2(double *p_ca, double *p_ra, double ***p_cs,
         double ***p_rs, long p_oldCols);
 
     // Private methods
 protected:
     bool    allocRandThreads(void);
-    void    calcSpreadRates(void);
+    double  calcBlockProb(long p_comb) const;
+    bool    calcBlockCount(long p_cells, long *p_nT) const;
+    double  calcRelativeRos(void);
+    long    calcSpreadRates(void);
     void    closeRandThreads(void);
     void    freeBlockArrays(void);
     void    init(void);
+    void    runRandThreads(long p_active);
 
     // Private data
 protected:
@@ -110,6 +110,8 @@ protected:
     long        m_exts;             //!< number of combinations in extension
     long        m_threads;          //!< number of threads allocated (<64)
     long        m_lessIgns;         //!< number of ignition points FEWER than NumSamples;
+    bool        m_retainBlockRos;   //!< keep m_maxRosArray for recomputeSpread()
+    bool        m_enumerateBlocks;  //!< enumerate blocks on the fly without extensions
     double      m_lbRatio;          //!< length to breadth ratio of fire
     double      m_cellSize;         //!< size of raster cell
     double    **m_combArray;        //!< array of block probabilities
@@ -120,6 +122,8 @@ protected:
     double     *m_maxRosExtArray;   //!< max spread rate for all blocks in extension
     FuelType   *m_fuelTypeArray;    //!< array of FuelType structs
     RandThread *m_randThread;       //!< array of RandThread classes=m_threads
+    RandWorkspace *m_workspace;     //!< working memory in use, m_ownWorkspace or the caller's
+    RandWorkspace m_ownWorkspace;   //!< working memory if the caller gives none
 };
 
 #endif // RANDFUEL_H
@@ -49,6 +49,7 @@
 
 // Custom include files
 #include "randthread.h"
+#include "behaveInstrumentation.h"
 
 // Standard include files
 #include <math.h>
@@ -94,6 +95,16 @@ RandThread::RandThread(void)
     m_startDelay[0] = 0;
     m_startDelay[1] = 0;
     m_latRosArray = 0;
+    m_fuels = 0;
+    m_fuelTypeArray = 0;
+    m_blockDigits = 0;
+    m_blockRos = 0;
+    m_blockProb = 0.0;
+    m_expectedRos = 0.0;
+    m_expectedSquaredRos = 0.0;
+    m_harmonicRos = 0.0;
+    m_totalProb = 0.0;
+    m_sampling = false;
     return;
 }
 
@@ -207,6 +218,7 @@ double RandThread::calcLateralRos(double p_forwardRos)
 
 void RandThread::calcSpreadPaths2(void)
 {
+    BEHAVE_INSTRUMENT_SCOPE(RandThreadSpreadPaths);
     bool Lateral = false;
     long i, j, k, m, n, p;
     long NumPath1, NumPath2, ParentLoc, NumMax, StraightNum;
@@ -214,33 +226,50 @@ void RandThread::calcSpreadPaths2(void)
     double     Delay, *SampleTime, ParentRos, ParentTime;
     double     Separation, Overlap, OldOverlap, OldSeparation, StraightTime;
     double    DirectTime, *ExitTime, *LateralDistances, *SpreadRates;
+    double    *BlockRos, BlockMaxRos;
+    bool      Enumerate = (m_rosArray == 0);
 
     if (m_firstSample != 0)
     {
         Lateral = true;
     }
+    m_expectedRos = 0.0;
+    m_expectedSquaredRos = 0.0;
+    m_harmonicRos = 0.0;
+    m_totalProb = 0.0;
+    // all working arrays come from this thread's arena, which keeps its
+    // memory for the next call
+    m_arena.reset();
+    if (Enumerate)
+    {
+        // one block is built at a time from a counter over fuel indices;
+        // the padding keeps the row-overrun reads below inside the buffer
+        m_blockDigits = m_arena.allocArray<long>(m_samples * m_depths);
+        m_blockRos = m_arena.allocArray<double>(m_samples * m_depths + m_samples);
+        memset(m_blockRos, 0x0, (m_samples * m_depths + m_samples) * sizeof(double));
+    }
 
-    ExitTime = new double[m_samples];
+    ExitTime = m_arena.allocArray<double>(m_samples);
     memset(ExitTime, 0x0, m_samples*sizeof(double));
     if (m_firstSample > 0)
     {
         // store number of startdelays
-        m_startDelay[0] = new double[m_firstSample];
-        m_startDelay[1] = new double[m_firstSample];
+        m_startDelay[0] = m_arena.allocArray<double>(m_firstSample);
+        m_startDelay[1] = m_arena.allocArray<double>(m_firstSample);
         memset(m_startDelay[0], 0x0, m_firstSample*sizeof(double));
         memset(m_startDelay[1], 0x0, m_firstSample*sizeof(double));
     }
-    SampleTime = new double[m_samples];
+    SampleTime = m_arena.allocArray<double>(m_samples);
     NumAlloc = (unsigned long)pow((double)m_samples, (int)m_depths);
-    m_firstPath = new PathStruct[NumAlloc];
-    m_newPath = new PathStruct[NumAlloc];
+    m_firstPath = m_arena.allocArray<PathStruct>(NumAlloc);
+    m_newPath = m_arena.allocArray<PathStruct>(NumAlloc);
     NumMax = m_samples;
     if (m_depths > m_samples)
     {
         NumMax = m_depths;
     }
-    LateralDistances = new double[NumMax];
-    SpreadRates = new double[NumMax + 1];
+    LateralDistances = m_arena.allocArray<double>(NumMax);
+    SpreadRates = m_arena.allocArray<double>(NumMax + 1);
     calcEllipticalDimensions();
     if (m_firstSample > 0)
     {
@@ -251,7 +280,27 @@ void RandThread::calcSpreadPaths2(void)
     }
     for (i = m_start; i < m_end; i++)
     {
-        m_maxRosArray[i] = 0.0;
+        if (Enumerate)
+        {
+            if (m_sampling)
+            {
+                drawBlock();
+            }
+            else if (i == m_start)
+            {
+                firstBlock(i);
+            }
+            else
+            {
+                nextBlock();
+            }
+            BlockRos = m_blockRos;
+        }
+        else
+        {
+            BlockRos = m_rosArray[i];
+        }
+        BlockMaxRos = 0.0;
         for (p = 0; p < m_samples; p++)   // make it very large
         {
             SampleTime[p] = 9e12;
@@ -301,7 +350,7 @@ void RandThread::calcSpreadPaths2(void)
             NumPath2 = 0;
             for (n = 0; n < NumPath1; n++)
             {
-                ParentRos = m_rosArray[i][j * m_samples + m_curPath->m_loc];
+                ParentRos = BlockRos[j * m_samples + m_curPath->m_loc];
                 if (ParentRos > 0.0)
                 {
                     Separation = m_cellSize;
@@ -316,7 +365,7 @@ void RandThread::calcSpreadPaths2(void)
                     do
                     {
                         LateralDistances[p] = Overlap;
-                        SpreadRates[p] = m_rosArray[i][p*m_samples + m_curPath->m_loc];
+                        SpreadRates[p] = BlockRos[p*m_samples + m_curPath->m_loc];
                         if (Separation > m_cellSize)
                         {
                             LateralDistances[p] = Overlap / (double)(j + 1);
@@ -337,7 +386,7 @@ void RandThread::calcSpreadPaths2(void)
                         for (p = 0; p < StraightNum; p++)
                         {
                             StraightTime += m_cellSize
-                                / m_rosArray[i]
+                                / BlockRos
                                 [(j - p - 1) * m_samples + m_curPath->m_loc];
                         }
                         Delay += (ParentTime - StraightTime);
@@ -368,7 +417,7 @@ void RandThread::calcSpreadPaths2(void)
                             {
                                 break;
                             }
-                            SpreadRates[p] = m_rosArray[i]
+                            SpreadRates[p] = BlockRos
                                 [j * m_samples + ParentLoc - p];
                         }
                         for (p = 1; p < m_samples - 1; p++)
@@ -400,7 +449,7 @@ void RandThread::calcSpreadPaths2(void)
                             {
                                 break;
                             }
-                            SpreadRates[p] = m_rosArray[i]
+                            SpreadRates[p] = BlockRos
                                 [j*m_samples + ParentLoc + p];
                         }
                         for (p = 1; p < m_samples - 1; p++)
@@ -490,28 +539,34 @@ void RandThread::calcSpreadPaths2(void)
             }
             // calculate overall spread rate
             SampleTime[j] = (m_depths*m_cellSize) / SampleTime[j];
-            if (SampleTime[j] > m_maxRosArray[i])
+            if (SampleTime[j] > BlockMaxRos)
             {
-                m_maxRosArray[i] = SampleTime[j];
+                BlockMaxRos = SampleTime[j];
             }
         }
-    } // all combinations are done
-
-    // Release resources
-    delete[] SampleTime;
-    delete[] ExitTime;
-    for (i = 0; i < 2; i++)
-    {
-        if (m_startDelay[i])
+        if (m_maxRosArray)
         {
-            delete[] m_startDelay[i];
-            m_startDelay[i] = 0;
+            m_maxRosArray[i] = BlockMaxRos;
         }
-    }
-    delete[] m_firstPath;
-    delete[] m_newPath;
-    delete[] LateralDistances;
-    delete[] SpreadRates;
+        if (Enumerate)
+        {
+            m_expectedRos += m_blockProb * BlockMaxRos;
+            m_expectedSquaredRos += m_blockProb * BlockMaxRos * BlockMaxRos;
+            if (BlockMaxRos > 0.0)
+            {
+                m_totalProb += m_blockProb;
+                m_harmonicRos += m_blockProb / BlockMaxRos;
+            }
+        }
+    } // all combinations are done
+
+    // The arena keeps the memory, just forget the pointers into it
+    m_startDelay[0] = 0;
+    m_startDelay[1] = 0;
+    m_firstPath = 0;
+    m_newPath = 0;
+    m_blockDigits = 0;
+    m_blockRos = 0;
     return;
 }
 
@@ -523,8 +578,9 @@ void RandThread::calcSpreadPaths2(void)
 void RandThread::calcStartDelay(long p_laterals, long p_leftRight)
 {
     // reverse the spread rate orders
-    double *lateralDist = new double[p_laterals];
-    double *spreadRates = new double[p_laterals];
+    RandArena::Marker marker = m_arena.mark();
+    double *lateralDist = m_arena.allocArray<double>(p_laterals);
+    double *spreadRates = m_arena.allocArray<double>(p_laterals);
     double  separation = m_cellSize;
     double  overlap = m_cellSize / 2.0;
 
@@ -563,8 +619,89 @@ void RandThread::calcStartDelay(long p_laterals, long p_leftRight)
             spreadRates, REFRACT_LATERAL);
         overlap += m_cellSize;
     }
-    delete[] lateralDist;
-    delete[] spreadRates;
+    m_arena.release(marker);
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Fills the scratch block with a random fuel arrangement, drawing
+ *  each cell's fuel independently with probability m_fract from this
+ *  thread's random number stream.  The block is given unit weight so the
+ *  accumulated sums are plain sums over the draws.
+ */
+
+void RandThread::drawBlock(void)
+{
+    double totalFract = 0.0;
+    long f;
+    for (f = 0; f < m_fuels; f++)
+    {
+        totalFract += m_fuelTypeArray[f].m_fract;
+    }
+    std::uniform_real_distribution<double> uniform(0.0, totalFract);
+    for (long n = 0; n < m_samples * m_depths; n++)
+    {
+        double u = uniform(m_rng);
+        for (f = 0; f < m_fuels - 1; f++)
+        {
+            u -= m_fuelTypeArray[f].m_fract;
+            if (u < 0.0)
+            {
+                break;
+            }
+        }
+        m_blockDigits[n] = f;
+        m_blockRos[n] = m_fuelTypeArray[f].m_relRos;
+    }
+    m_blockProb = 1.0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Builds block number p_comb of the factorial enumeration into the
+ *  scratch block without materializing the blocks before it.
+ *
+ *  Block p_comb holds fuel (p_comb / m_fuels^n) % m_fuels in cell n, which
+ *  is the same ordering RandFuel::calcCombinations() produces.
+ */
+
+void RandThread::firstBlock(long p_comb)
+{
+    long cells = m_samples * m_depths;
+    m_blockProb = 1.0;
+    for (long n = 0; n < cells; n++)
+    {
+        m_blockDigits[n] = p_comb % m_fuels;
+        p_comb /= m_fuels;
+        m_blockRos[n] = m_fuelTypeArray[m_blockDigits[n]].m_relRos;
+        m_blockProb *= m_fuelTypeArray[m_blockDigits[n]].m_fract;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Advances the scratch block to the next combination by incrementing
+ *  the mixed-radix counter, touching only the cells whose fuel changes.
+ */
+
+void RandThread::nextBlock(void)
+{
+    long cells = m_samples * m_depths;
+    for (long n = 0; n < cells; n++)
+    {
+        if (++m_blockDigits[n] < m_fuels)
+        {
+            m_blockRos[n] = m_fuelTypeArray[m_blockDigits[n]].m_relRos;
+            break;
+        }
+        m_blockDigits[n] = 0;
+        m_blockRos[n] = m_fuelTypeArray[0].m_relRos;
+    }
+    m_blockProb = 1.0;
+    for (long n = 0; n < cells; n++)
+    {
+        m_blockProb *= m_fuelTypeArray[m_blockDigits[n]].m_fract;
+    }
     return;
 }
 
@@ -724,6 +861,75 @@ double RandThread::fastFlankTime(long XStart, long YStart, double Xmid,
     return(TravelTime);
 }
 
+//------------------------------------------------------------------------------
+/*! \brief Returns the sum of probability times maximum spread rate over
+ *  the blocks enumerated by the last calcSpreadPaths2() call.
+ */
+
+double RandThread::getExpectedRos(void) const
+{
+    return(m_expectedRos);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the sum of probability times squared maximum spread rate
+ *  over the blocks enumerated by the last calcSpreadPaths2() call.
+ */
+
+double RandThread::getExpectedSquaredRos(void) const
+{
+    return(m_expectedSquaredRos);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the sum of probability over maximum spread rate over
+ *  the blocks enumerated by the last calcSpreadPaths2() call.
+ */
+
+double RandThread::getHarmonicRos(void) const
+{
+    return(m_harmonicRos);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns the summed probability of the enumerated blocks
+ *  having a maximum spread rate greater than zero.
+ */
+
+double RandThread::getTotalProb(void) const
+{
+    return(m_totalProb);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Sets the fuel types used to enumerate blocks on the fly when
+ *  setThreadData() is given no combination and spread rate arrays.
+ *  Also returns a reused thread to enumeration after setSampleStream().
+ */
+
+void RandThread::setFuelTypes(long p_fuels, const FuelType *p_fuelTypeArray)
+{
+    m_fuels = p_fuels;
+    m_fuelTypeArray = p_fuelTypeArray;
+    m_sampling = false;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Switches calcSpreadPaths2() to drawing random blocks, seeding this
+ *  thread's generator so that each stream index gives an independent and
+ *  reproducible sequence for a given seed.
+ */
+
+void RandThread::setSampleStream(unsigned long p_seed, long p_stream)
+{
+    std::seed_seq seq{ (unsigned long)(p_seed & 0xffffffffUL),
+        (unsigned long)((p_seed >> 16) >> 16), (unsigned long)p_stream };
+    m_rng.seed(seq);
+    m_sampling = true;
+    return;
+}
+
 //------------------------------------------------------------------------------
 
 void RandThread::setThreadData(long p_samples, long p_depths, long p_combs,
@@ -51,6 +51,10 @@
 #ifndef RANDTHREAD_H
 #define RANDTHREAD_H
 
+#include <random>
+
+#include "randworkspace.h"
+
 #define REFRACT_LATERAL 0
 #define REFRACT_FORWARD 1
 
@@ -58,6 +62,18 @@
 
 double pow2(double input);
 
+//------------------------------------------------------------------------------
+/*! \typedef FuelType
+ *  \brief Contains fuel types and their properties (RandFuel)
+ */
+
+typedef struct
+{
+    double  m_relRos;   //!< relative spread rate 0-1
+    double  m_absRos;   //!< actual spread rate
+    double  m_fract;    //!< fraction of landscape occupied
+} FuelType;
+
 //------------------------------------------------------------------------------
 /*! \typedef PathStruct
  *  \brief Linked list structure for pathtimes allocated by each RandThread
@@ -82,6 +98,12 @@ public:
     RandThread();
     ~RandThread();
     void    calcSpreadPaths2(void);
+    double  getExpectedRos(void) const;
+    double  getExpectedSquaredRos(void) const;
+    double  getHarmonicRos(void) const;
+    double  getTotalProb(void) const;
+    void    setFuelTypes(long p_fuels, const FuelType *p_fuelTypeArray);
+    void    setSampleStream(unsigned long p_seed, long p_stream);
     void    setThreadData(long p_samples, long p_depths, long p_combs,
         double p_lbRatio, double **p_combArray, double **p_rosArray,
         double *p_maxRosArray, long p_start, long p_end,
@@ -97,6 +119,9 @@ protected:
         double p_overlap, double *p_latDist, double *p_ros,
         long p_refractDir);
     double  calcLateralRos(double p_forwardRos);
+    void    drawBlock(void);
+    void    firstBlock(long p_comb);
+    void    nextBlock(void);
     void    calcStartDelay(long p_laterals, long p_leftRight);
     double  fastFlankTime(long XStart, long YStart, double Xmid,
         long XEnd, long YEnd, long NumX, double **ros);
@@ -128,6 +153,18 @@ protected:
     PathStruct *m_newPath;      //!< pointer to array of PathStructs
     double     *m_startDelay[2];//!< pointer to delay data for extra row
     double     *m_latRosArray;  //!< pointer to delay data for extra row
+    long        m_fuels;        //!< number of fuel types when enumerating blocks
+    const FuelType *m_fuelTypeArray; //!< fuel types when enumerating blocks, from RandFuel
+    long       *m_blockDigits;  //!< mixed-radix counter of fuel indices, one per cell
+    double     *m_blockRos;     //!< scratch spread rates for the current block
+    double      m_blockProb;    //!< probability of the current block
+    double      m_expectedRos;  //!< sum of prob * max ROS over enumerated blocks
+    double      m_expectedSquaredRos; //!< sum of prob * max ROS^2 over enumerated blocks
+    double      m_harmonicRos;  //!< sum of prob / max ROS over enumerated blocks
+    double      m_totalProb;    //!< sum of prob over enumerated blocks with max ROS > 0
+    bool        m_sampling;     //!< draw random blocks instead of enumerating them
+    std::mt19937_64 m_rng;      //!< this thread's random number stream when sampling
+    RandArena   m_arena;        //!< working arrays of calcSpreadPaths2(), kept between calls
 };
 
 #endif // RANDTHREAD_H
@@ -0,0 +1,249 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Part of Mark Finney's EXRATE package for determining expected
+*           and harmonic mean spread rate in randomly arranged fuels
+* Credits:  Some of the code in this file is, in part or in whole, from
+*           BehavePlus5 and EXRATE source originally authored by Collin D.
+*           Bevins and Mark Finney respectively, and is used with or without
+*           modification.
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+******************************************************************************/
+//-----------------------------------------------------------------------------
+/*! \file randworkspace.cpp
+ *
+ *  \brief Reusable working memory for the EXRATE package.
+ */
+
+// Custom include files
+#include "randworkspace.h"
+#include "newext.h"
+#include "randthread.h"
+
+//------------------------------------------------------------------------------
+
+static const size_t ArenaAlignment = 16;
+static const size_t ArenaMinChunk = 64 * 1024;
+
+//------------------------------------------------------------------------------
+
+RandArena::RandArena(void)
+{
+    m_current = 0;
+    m_used = 0;
+    m_base = 0;
+    m_peak = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+
+RandArena::~RandArena(void)
+{
+    freeChunks();
+    return;
+}
+
+//------------------------------------------------------------------------------
+
+void RandArena::addChunk(size_t p_bytes)
+{
+    m_chunk.push_back(new char[p_bytes]);
+    m_size.push_back(p_bytes);
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns p_bytes of uninitialized memory aligned for any plain
+ *  data type.  Chunks are added as needed and kept until the arena dies.
+ */
+
+void *RandArena::alloc(size_t p_bytes)
+{
+    p_bytes = (p_bytes + ArenaAlignment - 1) & ~(ArenaAlignment - 1);
+    while (m_current < m_chunk.size()
+        && m_used + p_bytes > m_size[m_current])
+    {
+        // the rest of this chunk is skipped
+        m_base += m_size[m_current];
+        m_current++;
+        m_used = 0;
+    }
+    if (m_current == m_chunk.size())
+    {
+        size_t bytes = ArenaMinChunk;
+        if (!m_size.empty() && 2 * m_size.back() > bytes)
+        {
+            bytes = 2 * m_size.back();
+        }
+        if (p_bytes > bytes)
+        {
+            bytes = p_bytes;
+        }
+        addChunk(bytes);
+    }
+    void *ptr = m_chunk[m_current] + m_used;
+    m_used += p_bytes;
+    if (m_base + m_used > m_peak)
+    {
+        m_peak = m_base + m_used;
+    }
+    return(ptr);
+}
+
+//------------------------------------------------------------------------------
+
+void RandArena::freeChunks(void)
+{
+    for (size_t i = 0; i < m_chunk.size(); i++)
+    {
+        delete[] m_chunk[i];
+    }
+    m_chunk.clear();
+    m_size.clear();
+    return;
+}
+
+//------------------------------------------------------------------------------
+
+RandArena::Marker RandArena::mark(void) const
+{
+    Marker marker;
+    marker.m_chunk = m_current;
+    marker.m_used = m_used;
+    marker.m_base = m_base;
+    return(marker);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Gives back everything allocated since p_marker was taken.
+ */
+
+void RandArena::release(const Marker &p_marker)
+{
+    m_current = p_marker.m_chunk;
+    m_used = p_marker.m_used;
+    m_base = p_marker.m_base;
+    return;
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Gives back everything.  If the last use spilled over into more
+ *  than one chunk, they are replaced by a single chunk of the peak size so
+ *  the next use of the same size fits without allocating.
+ */
+
+void RandArena::reset(void)
+{
+    if (m_chunk.size() > 1)
+    {
+        size_t bytes = m_peak;
+        freeChunks();
+        addChunk(bytes);
+    }
+    m_current = 0;
+    m_used = 0;
+    m_base = 0;
+    m_peak = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+
+RandWorkspace::RandWorkspace(void)
+{
+    m_extension = 0;
+    m_extensions = 0;
+    m_randThread = 0;
+    m_randThreads = 0;
+    return;
+}
+
+//------------------------------------------------------------------------------
+
+RandWorkspace::~RandWorkspace(void)
+{
+    if (m_extension)
+    {
+        delete[] m_extension;
+    }
+    if (m_randThread)
+    {
+        delete[] m_randThread;
+    }
+    return;
+}
+
+//------------------------------------------------------------------------------
+
+RandArena *RandWorkspace::getBlockArena(void)
+{
+    return(&m_blockArena);
+}
+
+//------------------------------------------------------------------------------
+
+RandArena *RandWorkspace::getFuelArena(void)
+{
+    return(&m_fuelArena);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns at least p_count Extensions, reusing the pooled ones
+ *  when there are enough.
+ */
+
+Extension *RandWorkspace::getExtensions(long p_count)
+{
+    if (p_count > m_extensions)
+    {
+        if (m_extension)
+        {
+            delete[] m_extension;
+        }
+        m_extension = new Extension[p_count];
+        m_extensions = p_count;
+    }
+    return(m_extension);
+}
+
+//------------------------------------------------------------------------------
+/*! \brief Returns at least p_count RandThreads, reusing the pooled ones
+ *  (and their arenas) when there are enough.
+ */
+
+RandThread *RandWorkspace::getRandThreads(long p_count)
+{
+    if (p_count > m_randThreads)
+    {
+        if (m_randThread)
+        {
+            delete[] m_randThread;
+        }
+        m_randThread = new RandThread[p_count];
+        m_randThreads = p_count;
+    }
+    return(m_randThread);
+}
+
+//------------------------------------------------------------------------------
+//  End of randworkspace.cpp
+//------------------------------------------------------------------------------
@@ -0,0 +1,145 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Part of Mark Finney's EXRATE package for determining expected
+*           and harmonic mean spread rate in randomly arranged fuels
+* Credits:  Some of the code in this file is, in part or in whole, from
+*           BehavePlus5 and EXRATE source originally authored by Collin D.
+*           Bevins and Mark Finney respectively, and is used with or without
+*           modification.
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+******************************************************************************/
+//-----------------------------------------------------------------------------
+/*! \file randworkspace.h
+ *
+ *  \brief Reusable working memory for the EXRATE package.
+ *
+ *  RandFuel, RandThread and Extension used to new[] and delete[] all of
+ *  their arrays on every expected spread rate calculation.  They now draw
+ *  them from a RandArena, and RandFuel takes its RandThreads, Extensions
+ *  and FuelTypes from a RandWorkspace.  A caller that keeps one workspace
+ *  across calculations does no heap allocations once it has grown to the
+ *  largest block size used.
+ */
+
+#ifndef RANDWORKSPACE_H
+#define RANDWORKSPACE_H
+
+#include <stddef.h>
+#include <vector>
+
+class Extension;
+class RandThread;
+
+//------------------------------------------------------------------------------
+/*! \class RandArena randworkspace.h
+ *
+ *  \brief Bump allocator for plain data arrays.
+ *
+ *  Memory is only handed back all at once, either by reset() or by
+ *  release() of an earlier mark(), so nested users must release in
+ *  reverse order.  The chunks are kept for reuse; reset() merges them
+ *  into one chunk large enough for everything used since the last reset.
+ */
+
+class RandArena
+{
+    // Public methods
+public:
+    /*! \brief Position in the arena, from mark(), for release(). */
+    struct Marker
+    {
+        size_t m_chunk;         //!< chunk in use
+        size_t m_used;          //!< bytes used in that chunk
+        size_t m_base;          //!< bytes in the chunks before it
+    };
+
+    RandArena();
+    ~RandArena();
+    void   *alloc(size_t p_bytes);
+    Marker  mark(void) const;
+    void    release(const Marker &p_marker);
+    void    reset(void);
+
+    /*! \brief Allocates an uninitialized array of p_count plain data items. */
+    template <class T>
+    T *allocArray(long p_count)
+    {
+        return((T *)alloc(((p_count > 0) ? p_count : 1) * sizeof(T)));
+    }
+
+    // Private methods
+protected:
+    void    addChunk(size_t p_bytes);
+    void    freeChunks(void);
+
+    // Private data
+protected:
+    std::vector<char *> m_chunk;    //!< start of each chunk
+    std::vector<size_t> m_size;     //!< size of each chunk in bytes
+    size_t      m_current;          //!< chunk allocations come from
+    size_t      m_used;             //!< bytes used in the current chunk
+    size_t      m_base;             //!< bytes in the chunks before the current one
+    size_t      m_peak;             //!< most bytes used since the last reset()
+
+private:
+    RandArena(const RandArena &);
+    RandArena &operator=(const RandArena &);
+};
+
+//------------------------------------------------------------------------------
+/*! \class RandWorkspace randworkspace.h
+ *
+ *  \brief Working memory one RandFuel draws from, kept across calls.
+ *
+ *  A workspace may only serve one RandFuel calculation at a time.
+ */
+
+class RandWorkspace
+{
+    // Public methods
+public:
+    RandWorkspace();
+    ~RandWorkspace();
+    RandArena  *getBlockArena(void);
+    RandArena  *getFuelArena(void);
+    Extension  *getExtensions(long p_count);
+    RandThread *getRandThreads(long p_count);
+
+    // Private data
+protected:
+    RandArena   m_blockArena;       //!< RandFuel and Extension block arrays
+    RandArena   m_fuelArena;        //!< RandFuel FuelType array
+    Extension  *m_extension;        //!< pooled Extensions
+    long        m_extensions;       //!< number of pooled Extensions
+    RandThread *m_randThread;       //!< pooled RandThreads, each with its own arena
+    long        m_randThreads;      //!< number of pooled RandThreads
+
+private:
+    RandWorkspace(const RandWorkspace &);
+    RandWorkspace &operator=(const RandWorkspace &);
+};
+
+#endif // RANDWORKSPACE_H
+
+//------------------------------------------------------------------------------
+//  End of randworkspace.h
+//------------------------------------------------------------------------------
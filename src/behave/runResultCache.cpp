@@ -0,0 +1,406 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Thread-safe, bounded cache of surface and crown run results keyed
+*           on quantized inputs
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "runResultCache.h"
+
+#include <cmath>
+#include <functional>
+
+#include "crown.h"
+#include "surface.h"
+
+namespace
+{
+
+// Runs whose outputs depend on more than the inputs of a RunResultKey
+bool isKeyable(const SurfaceInputs& surfaceInputs)
+{
+    if (surfaceInputs.isUsingTwoFuelModels() || surfaceInputs.getIsUsingPalmettoGallberry()
+        || surfaceInputs.getIsUsingWesternAspen() || surfaceInputs.getIsUsingChaparral())
+    {
+        return false;
+    }
+    if (surfaceInputs.getMoistureInputMode() != MoistureInputMode::BySizeClass
+        || surfaceInputs.getIsUsingMoistureScenarioMatrix())
+    {
+        return false;
+    }
+    // A direct midflame wind speed is used as is
+    if (surfaceInputs.getWindAdjustmentFactorCalculationMethod() == WindAdjustmentFactorCalculationMethod::UserInput
+        && surfaceInputs.getWindHeightInputMode() != WindHeightInputMode::DirectMidflame)
+    {
+        return false;
+    }
+    return true;
+}
+
+void setSurfaceKey(const SurfaceInputs& surfaceInputs, RunResultKey& key)
+{
+    key.fuelModelNumber = surfaceInputs.getFuelModelNumber();
+    key.windHeightInputMode = surfaceInputs.getWindHeightInputMode();
+    key.windAndSpreadOrientationMode = surfaceInputs.getWindAndSpreadOrientationMode();
+    key.windAdjustmentFactorCalculationMethod = surfaceInputs.getWindAdjustmentFactorCalculationMethod();
+    for (int i = 0; i < RunResultInput::NumberOfInputs; i++)
+    {
+        key.inputs[i] = 0.0;
+    }
+    key.inputs[RunResultInput::MoistureOneHour] = surfaceInputs.getMoistureOneHour(FractionUnits::Fraction);
+    key.inputs[RunResultInput::MoistureTenHour] = surfaceInputs.getMoistureTenHour(FractionUnits::Fraction);
+    key.inputs[RunResultInput::MoistureHundredHour] = surfaceInputs.getMoistureHundredHour(FractionUnits::Fraction);
+    key.inputs[RunResultInput::MoistureLiveHerbaceous] = surfaceInputs.getMoistureLiveHerbaceous(FractionUnits::Fraction);
+    key.inputs[RunResultInput::MoistureLiveWoody] = surfaceInputs.getMoistureLiveWoody(FractionUnits::Fraction);
+    key.inputs[RunResultInput::WindSpeed] = surfaceInputs.getWindSpeed(SpeedUnits::FeetPerMinute);
+    key.inputs[RunResultInput::WindDirection] = surfaceInputs.getWindDirection();
+    key.inputs[RunResultInput::Slope] = surfaceInputs.getSlope(SlopeUnits::Degrees);
+    key.inputs[RunResultInput::Aspect] = surfaceInputs.getAspect();
+    key.inputs[RunResultInput::CanopyCover] = surfaceInputs.getCanopyCover(FractionUnits::Fraction);
+    key.inputs[RunResultInput::CanopyHeight] = surfaceInputs.getCanopyHeight(LengthUnits::Feet);
+    key.inputs[RunResultInput::CrownRatio] = surfaceInputs.getCrownRatio();
+}
+
+// A NaN input never equals itself, so its key could never be found or evicted
+bool isFinite(const RunResultKey& key)
+{
+    for (int i = 0; i < RunResultInput::NumberOfInputs; i++)
+    {
+        if (!std::isfinite(key.inputs[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Directions are kept in [0, 360) so that 359.9 and 0 share a key
+double wrapDirection(double direction)
+{
+    direction = std::fmod(direction, 360.0);
+    if (direction < 0.0)
+    {
+        direction += 360.0;
+    }
+    return (direction >= 360.0) ? 0.0 : direction;
+}
+
+} // namespace
+
+bool RunResultKey::operator==(const RunResultKey& rhs) const
+{
+    if (runType != rhs.runType
+        || fuelModelNumber != rhs.fuelModelNumber
+        || windHeightInputMode != rhs.windHeightInputMode
+        || windAndSpreadOrientationMode != rhs.windAndSpreadOrientationMode
+        || windAdjustmentFactorCalculationMethod != rhs.windAdjustmentFactorCalculationMethod)
+    {
+        return false;
+    }
+    for (int i = 0; i < RunResultInput::NumberOfInputs; i++)
+    {
+        if (inputs[i] != rhs.inputs[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t RunResultKeyHash::operator()(const RunResultKey& key) const
+{
+    std::hash<double> hashDouble;
+    std::size_t seed = 0;
+    auto combine = [&seed](std::size_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(std::hash<int>()(key.runType));
+    combine(std::hash<int>()(key.fuelModelNumber));
+    combine(std::hash<int>()(key.windHeightInputMode));
+    combine(std::hash<int>()(key.windAndSpreadOrientationMode));
+    combine(std::hash<int>()(key.windAdjustmentFactorCalculationMethod));
+    for (int i = 0; i < RunResultInput::NumberOfInputs; i++)
+    {
+        combine(hashDouble(key.inputs[i]));
+    }
+    return seed;
+}
+
+RunResultCache::RunResultCache()
+    : capacity_(65536),
+    moistureStep_(0.0),
+    windSpeedStep_(0.0),
+    slopeStep_(0.0),
+    directionStep_(0.0),
+    enabled_(false),
+    hits_(0),
+    misses_(0),
+    bypasses_(0)
+{
+
+}
+
+RunResult RunResultCache::doSurfaceRunInDirectionOfMaxSpread(Surface& surface)
+{
+    RunResult result;
+    RunResultKey key;
+    bool isCaching = enabled_ && isKeyable(surface.getSurfaceInputs());
+    if (isCaching)
+    {
+        key.runType = RunType::SurfaceRun;
+        setSurfaceKey(surface.getSurfaceInputs(), key);
+        isCaching = isFinite(key);
+    }
+    if (isCaching)
+    {
+        quantizeKey(key);
+        if (find(key, result))
+        {
+            hits_++;
+            return result;
+        }
+        misses_++;
+    }
+    else if (enabled_)
+    {
+        bypasses_++;
+    }
+
+    // Calculated outside of the lock, concurrent misses on one key just calculate twice
+    surface.doSurfaceRunInDirectionOfMaxSpread();
+    result = getSurfaceResult(surface);
+    if (isCaching)
+    {
+        insert(key, result);
+    }
+    return result;
+}
+
+RunResult RunResultCache::doCrownRunRothermel(Crown& crown)
+{
+    return doCrownRun(crown, RunType::CrownRothermelRun);
+}
+
+RunResult RunResultCache::doCrownRunScottAndReinhardt(Crown& crown)
+{
+    return doCrownRun(crown, RunType::CrownScottAndReinhardtRun);
+}
+
+RunResult RunResultCache::doCrownRun(Crown& crown, RunType::RunTypeEnum runType)
+{
+    RunResult result;
+    RunResultKey key;
+    bool isCaching = enabled_ && isKeyable(crown.getSurfaceInputs());
+    if (isCaching)
+    {
+        key.runType = runType;
+        setSurfaceKey(crown.getSurfaceInputs(), key);
+        key.inputs[RunResultInput::CanopyBaseHeight] = crown.getCanopyBaseHeight(LengthUnits::Feet);
+        key.inputs[RunResultInput::CanopyBulkDensity] = crown.getCanopyBulkDensity(DensityUnits::PoundsPerCubicFoot);
+        key.inputs[RunResultInput::MoistureFoliar] = crown.getMoistureFoliar(FractionUnits::Fraction);
+        isCaching = isFinite(key);
+    }
+    if (isCaching)
+    {
+        quantizeKey(key);
+        if (find(key, result))
+        {
+            hits_++;
+            return result;
+        }
+        misses_++;
+    }
+    else if (enabled_)
+    {
+        bypasses_++;
+    }
+
+    if (runType == RunType::CrownRothermelRun)
+    {
+        crown.doCrownRunRothermel();
+    }
+    else
+    {
+        crown.doCrownRunScottAndReinhardt();
+    }
+    result = getCrownResult(crown);
+    if (isCaching)
+    {
+        insert(key, result);
+    }
+    return result;
+}
+
+void RunResultCache::setEnabled(bool enabled)
+{
+    enabled_ = enabled;
+}
+
+void RunResultCache::setCapacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    while (entries_.size() > capacity_)
+    {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+void RunResultCache::setQuantization(double moistureStep, FractionUnits::FractionUnitsEnum moistureUnits, double windSpeedStep,
+    SpeedUnits::SpeedUnitsEnum windSpeedUnits, double slopeStep, SlopeUnits::SlopeUnitsEnum slopeUnits, double directionStep)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    moistureStep_ = (moistureStep > 0.0) ? FractionUnits::toBaseUnits(moistureStep, moistureUnits) : 0.0;
+    windSpeedStep_ = (windSpeedStep > 0.0) ? SpeedUnits::toBaseUnits(windSpeedStep, windSpeedUnits) : 0.0;
+    slopeStep_ = (slopeStep > 0.0) ? SlopeUnits::toBaseUnits(slopeStep, slopeUnits) : 0.0;
+    directionStep_ = (directionStep > 0.0) ? directionStep : 0.0;
+    // Entries made with other steps would never be hit again
+    entries_.clear();
+    index_.clear();
+}
+
+void RunResultCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    hits_ = 0;
+    misses_ = 0;
+    bypasses_ = 0;
+}
+
+bool RunResultCache::isEnabled() const
+{
+    return enabled_;
+}
+
+std::size_t RunResultCache::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+std::size_t RunResultCache::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+unsigned long long RunResultCache::getHits() const
+{
+    return hits_;
+}
+
+unsigned long long RunResultCache::getMisses() const
+{
+    return misses_;
+}
+
+unsigned long long RunResultCache::getBypasses() const
+{
+    return bypasses_;
+}
+
+void RunResultCache::quantizeKey(RunResultKey& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = RunResultInput::MoistureOneHour; i <= RunResultInput::MoistureLiveWoody; i++)
+    {
+        key.inputs[i] = quantize(key.inputs[i], moistureStep_);
+    }
+    key.inputs[RunResultInput::MoistureFoliar] = quantize(key.inputs[RunResultInput::MoistureFoliar], moistureStep_);
+    key.inputs[RunResultInput::WindSpeed] = quantize(key.inputs[RunResultInput::WindSpeed], windSpeedStep_);
+    key.inputs[RunResultInput::Slope] = quantize(key.inputs[RunResultInput::Slope], slopeStep_);
+    key.inputs[RunResultInput::WindDirection] = wrapDirection(quantize(key.inputs[RunResultInput::WindDirection], directionStep_));
+    key.inputs[RunResultInput::Aspect] = wrapDirection(quantize(key.inputs[RunResultInput::Aspect], directionStep_));
+}
+
+bool RunResultCache::find(const RunResultKey& key, RunResult& result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    EntryIndex::iterator indexEntry = index_.find(key);
+    if (indexEntry == index_.end())
+    {
+        return false;
+    }
+    // Move to the front of the recently used list
+    entries_.splice(entries_.begin(), entries_, indexEntry->second);
+    result = indexEntry->second->second;
+    return true;
+}
+
+void RunResultCache::insert(const RunResultKey& key, const RunResult& result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0 || index_.find(key) != index_.end())
+    {
+        return;
+    }
+    entries_.push_front(Entry(key, result));
+    index_[key] = entries_.begin();
+    if (entries_.size() > capacity_)
+    {
+        // Evict the least recently used entry
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+RunResult RunResultCache::getSurfaceResult(const Surface& surface)
+{
+    // Base units
+    SurfaceResults surfaceResults = surface.getResults(UnitSystem());
+    RunResult result;
+    result.spreadRate = surfaceResults.spreadRate;
+    result.flameLength = surfaceResults.flameLength;
+    result.firelineIntensity = surfaceResults.firelineIntensity;
+    result.heatPerUnitArea = surfaceResults.heatPerUnitArea;
+    result.directionOfMaxSpread = surfaceResults.directionOfMaxSpread;
+    result.fireType = FireType::Surface;
+    return result;
+}
+
+RunResult RunResultCache::getCrownResult(const Crown& crown)
+{
+    CrownResults crownResults = crown.getResults(UnitSystem());
+    RunResult result;
+    result.spreadRate = crownResults.finalSpreadRate;
+    result.flameLength = crownResults.finalFlameLength;
+    result.firelineIntensity = crownResults.finalFirelineIntensity;
+    result.heatPerUnitArea = crownResults.finalHeatPerUnitArea;
+    result.directionOfMaxSpread = crownResults.surfaceFireDirectionOfMaxSpread;
+    result.fireType = crownResults.fireType;
+    return result;
+}
+
+double RunResultCache::quantize(double value, double step)
+{
+    if (step <= 0.0)
+    {
+        return value;
+    }
+    return std::floor(value / step + 0.5) * step;
+}
@@ -0,0 +1,166 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Thread-safe, bounded cache of surface and crown run results keyed
+*           on quantized inputs
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef RUNRESULTCACHE_H
+#define RUNRESULTCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "behaveUnits.h"
+
+class Crown;
+class Surface;
+
+struct RunResultInput
+{
+    enum RunResultInputEnum
+    {
+        MoistureOneHour,
+        MoistureTenHour,
+        MoistureHundredHour,
+        MoistureLiveHerbaceous,
+        MoistureLiveWoody,
+        WindSpeed,
+        WindDirection,
+        Slope,
+        Aspect,
+        CanopyCover,
+        CanopyHeight,
+        CrownRatio,
+        CanopyBaseHeight,       // crown runs only
+        CanopyBulkDensity,      // crown runs only
+        MoistureFoliar,         // crown runs only
+        NumberOfInputs
+    };
+};
+
+struct RunResultKey
+{
+    int runType;                // surface or crown method
+    int fuelModelNumber;
+    int windHeightInputMode;
+    int windAndSpreadOrientationMode;
+    int windAdjustmentFactorCalculationMethod;
+    double inputs[RunResultInput::NumberOfInputs];  // base units, quantized
+
+    bool operator==(const RunResultKey& rhs) const;
+};
+
+struct RunResultKeyHash
+{
+    std::size_t operator()(const RunResultKey& key) const;
+};
+
+// Outputs of one run in base units. Surface runs leave fireType at 0 (surface),
+// crown runs give the final values by fire type
+struct RunResult
+{
+    double spreadRate;          // feet per minute
+    double flameLength;         // feet
+    double firelineIntensity;   // Btu/ft/s
+    double heatPerUnitArea;     // Btu/ft^2
+    double directionOfMaxSpread;
+    int fireType;               // FireType
+};
+
+// Memoizes whole runs of batches that repeat inputs, such as weather station
+// rows of one fuel model on calm hours or flat terrain. Keys are the run's
+// inputs rounded to the quantization steps, exact by default, so with steps
+// set rows within half a step of a cached row take its results.
+//
+// Off until setEnabled(true). One cache may be shared by threads that each
+// run their own Surface or Crown, all over the same fuel models. A hit skips
+// the calculation, leaving the Surface or Crown outputs of its last run.
+// Surface runs with two fuel models, special fuel types, moistures entered
+// by anything but size class, a user entered wind adjustment factor or an
+// input that is not finite are always calculated. Crown runs are keyed on
+// their size class moistures.
+class RunResultCache
+{
+public:
+    RunResultCache();
+
+    RunResult doSurfaceRunInDirectionOfMaxSpread(Surface& surface);
+    RunResult doCrownRunRothermel(Crown& crown);
+    RunResult doCrownRunScottAndReinhardt(Crown& crown);
+
+    void setEnabled(bool enabled);
+    void setCapacity(std::size_t capacity);
+    // Steps of 0 keep that input exact, directions are wind direction and aspect
+    void setQuantization(double moistureStep, FractionUnits::FractionUnitsEnum moistureUnits, double windSpeedStep,
+        SpeedUnits::SpeedUnitsEnum windSpeedUnits, double slopeStep, SlopeUnits::SlopeUnitsEnum slopeUnits, double directionStep);
+    void clear();
+
+    bool isEnabled() const;
+    std::size_t getCapacity() const;
+    std::size_t getSize() const;
+    unsigned long long getHits() const;
+    unsigned long long getMisses() const;
+    unsigned long long getBypasses() const;   // runs the cache can not key
+
+private:
+    struct RunType
+    {
+        enum RunTypeEnum
+        {
+            SurfaceRun,
+            CrownRothermelRun,
+            CrownScottAndReinhardtRun
+        };
+    };
+
+    typedef std::pair<RunResultKey, RunResult> Entry;
+    typedef std::unordered_map<RunResultKey, std::list<Entry>::iterator, RunResultKeyHash> EntryIndex;
+
+    RunResult doCrownRun(Crown& crown, RunType::RunTypeEnum runType);
+    void quantizeKey(RunResultKey& key) const;
+    bool find(const RunResultKey& key, RunResult& result);
+    void insert(const RunResultKey& key, const RunResult& result);
+    static RunResult getSurfaceResult(const Surface& surface);
+    static RunResult getCrownResult(const Crown& crown);
+    static double quantize(double value, double step);
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;      // most recently used first
+    EntryIndex index_;
+    std::size_t capacity_;
+    double moistureStep_;           // fraction, 0 for exact keys
+    double windSpeedStep_;          // feet per minute, 0 for exact keys
+    double slopeStep_;              // degrees, 0 for exact keys
+    double directionStep_;          // degrees, 0 for exact keys
+    std::atomic<bool> enabled_;
+    std::atomic<unsigned long long> hits_;
+    std::atomic<unsigned long long> misses_;
+    std::atomic<unsigned long long> bypasses_;
+};
+
+#endif // RUNRESULTCACHE_H
@@ -41,19 +41,43 @@ struct SpeciesMasterTableRecord
     CrownDamageEquationCode crownDamageEquationCode = CrownDamageEquationCode::not_set;
 };
 
+/*.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.- */
+/*       Species Master Table Entry, a literal view of a table record        */
+/* Same fields as SpeciesMasterTableRecord, so the built-in records can live */
+/*  in a constexpr array rather than being copied into every table           */
+struct SpeciesMasterTableEntry
+{
+    const char* speciesCode;
+    const char* scientificName;
+    const char* commonName;
+    int  mortalityEquationNumber;
+    int  barkEquationNumber;
+    int  crownCoefficientCode;
+    int8_t  regionInteriorWest;
+    int8_t  regionPacificWest;
+    int8_t  regionNorthEast;
+    int8_t  regionSouthEast;
+    EquationType equationType;
+    CrownDamageEquationCode crownDamageEquationCode;
+};
+
 class SpeciesMasterTable
 {
 public:
     /*.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.-.- */
     SpeciesMasterTable();
+    SpeciesMasterTable(const SpeciesMasterTable& rhs);
+    SpeciesMasterTable& operator=(const SpeciesMasterTable& rhs);
     ~SpeciesMasterTable();
 
     void  initializeMasterTable();
   
     int getSpeciesTableIndexFromSpeciesCode(string speciesCode) const;
     int getSpeciesTableIndexFromSpeciesCodeAndEquationType(string speciesCode, EquationType equationType) const;
-   
-    vector<SpeciesMasterTableRecord> record_;
+
+    int getNumberOfRecords() const;
+    const SpeciesMasterTableEntry& getEntry(int index) const;
+    SpeciesMasterTableRecord getRecord(int index) const;
 
     CanopyCoefficientTable canopyCoefficientTable;
 
@@ -61,6 +85,15 @@ public:
         int  mortalityEquation, int  brkEqu, int  crownCoefficientCode,
         int8_t region1, int8_t  region2, int8_t  region3, int8_t region4, EquationType equationType,
         CrownDamageEquationCode crownDamageEquationCode);
+
+protected:
+    void memberwiseCopyAssignment(const SpeciesMasterTable& rhs);
+    int findSpeciesTableIndex(const string& speciesCode, EquationType equationType, bool matchEquationType) const;
+    void updateCustomEntries();
+
+    // Records added with insertRecord(), indexed after the built-in records
+    vector<SpeciesMasterTableRecord> customRecords_;
+    vector<SpeciesMasterTableEntry> customEntries_; // views of customRecords_
 };
 
 #endif // SPECIES_MASTER_TABLE_H
@@ -31,6 +31,7 @@
 
 #include "spot.h"
 #define _USE_MATH_DEFINES
+#include <algorithm>
 #include <cstring>
 #include <cmath>
 
@@ -156,7 +157,7 @@ void Spot::initializeMembers()
     mountainDistanceFromTorchingTrees_ = 0.0;
 }
 
-double Spot::calculateSpotCriticalCoverHeight(double firebrandHeight, double coverHeight)
+double Spot::calculateSpotCriticalCoverHeight(double firebrandHeight, double coverHeight) const
 {
     // Minimum value of coverHeight used to calculate flatDistance
     // using log variation with ht.
@@ -189,7 +190,7 @@ double Spot::spotDistanceMountainTerrain(
     double flatDistance,
     SpotFireLocation::SpotFireLocationEnum location,
     double ridgeToValleyDistance,
-    double ridgeToValleyElevation)
+    double ridgeToValleyElevation) const
 {
     double mountainDistance = flatDistance;
     if (ridgeToValleyElevation > 1e-7 && ridgeToValleyDistance > 1e-7)
@@ -210,7 +211,7 @@ double Spot::spotDistanceMountainTerrain(
 double Spot::spotDistanceFlatTerrain(
     double firebrandHeight,
     double coverHeight,
-    double windSpeedAtTwentyFeet)
+    double windSpeedAtTwentyFeet) const
 {
     // Flat terrain spotting distance.
     double flatDistance = 0.0;
@@ -381,6 +382,270 @@ void Spot::calculateSpottingDistanceFromTorchingTrees()
     }
 }
 
+// Scenarios are calculated in blocks small enough to keep their scratch
+// columns on the stack and in cache, with each step a simple loop over a block
+static const std::size_t spotBatchBlockSize = 256;
+
+// Common inputs of one block, in the units the spotting equations use
+struct SpotBatchBlock
+{
+    std::size_t size;
+    double windSpeedAtTwentyFeet[spotBatchBlockSize];   // mph
+    double downwindCoverHeight[spotBatchBlockSize];     // ft, after the open canopy adjustment
+    double ridgeToValleyDistance[spotBatchBlockSize];   // mi
+    double ridgeToValleyElevation[spotBatchBlockSize];  // ft
+    double locationPhase[spotBatchBlockSize];           // location * pi / 2
+    double firebrandHeight[spotBatchBlockSize];         // ft, 0 where there is no spotting
+    double firebrandDrift[spotBatchBlockSize];          // mi
+};
+
+static void convertLengthColumn(const double* values, std::size_t count, LengthUnits::LengthUnitsEnum fromUnits,
+    LengthUnits::LengthUnitsEnum toUnits, double* converted)
+{
+    for (std::size_t i = 0; i < count; i++)
+    {
+        converted[i] = (fromUnits == toUnits)
+            ? values[i]
+            : LengthUnits::fromBaseUnits(LengthUnits::toBaseUnits(values[i], fromUnits), toUnits);
+    }
+}
+
+static void loadSpotBatchBlock(const SpotBatchInputs& inputs, std::size_t begin, SpotBatchBlock& block)
+{
+    const std::size_t size = std::min(spotBatchBlockSize, inputs.numberOfScenarios - begin);
+    block.size = size;
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        block.windSpeedAtTwentyFeet[i] = (inputs.windSpeedUnits == SpeedUnits::MilesPerHour)
+            ? inputs.windSpeedAtTwentyFeet[begin + i]
+            : SpeedUnits::fromBaseUnits(SpeedUnits::toBaseUnits(inputs.windSpeedAtTwentyFeet[begin + i], inputs.windSpeedUnits), SpeedUnits::MilesPerHour);
+    }
+
+    convertLengthColumn(inputs.downwindCoverHeight + begin, size, inputs.heightUnits, LengthUnits::Feet, block.downwindCoverHeight);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum downwindCanopyMode = (inputs.downwindCanopyMode != nullptr)
+            ? inputs.downwindCanopyMode[begin + i]
+            : inputs.batchDownwindCanopyMode;
+        if (downwindCanopyMode == SpotDownWindCanopyMode::OPEN)
+        {
+            block.downwindCoverHeight[i] *= 0.5;
+        }
+    }
+
+    if (inputs.ridgeToValleyDistance != nullptr && inputs.ridgeToValleyElevation != nullptr)
+    {
+        convertLengthColumn(inputs.ridgeToValleyDistance + begin, size, inputs.ridgeToValleyDistanceUnits, LengthUnits::Miles, block.ridgeToValleyDistance);
+        convertLengthColumn(inputs.ridgeToValleyElevation + begin, size, inputs.heightUnits, LengthUnits::Feet, block.ridgeToValleyElevation);
+    }
+    else
+    {
+        std::fill(block.ridgeToValleyDistance, block.ridgeToValleyDistance + size, 0.0);
+        std::fill(block.ridgeToValleyElevation, block.ridgeToValleyElevation + size, 0.0);
+    }
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        int location = (inputs.location != nullptr) ? inputs.location[begin + i] : inputs.batchLocation;
+        block.locationPhase[i] = location * M_PI / 2.0;
+    }
+
+    std::fill(block.firebrandHeight, block.firebrandHeight + size, 0.0);
+    std::fill(block.firebrandDrift, block.firebrandDrift + size, 0.0);
+}
+
+// Flat and mountainous terrain spotting distance of each scenario of a block
+// from its firebrand height and drift, the same steps as the single scenario
+// calculations
+static void calculateSpotBatchBlockDistances(SpotBatchBlock& block, std::size_t begin, double* flatDistance,
+    double* mountainDistance, LengthUnits::LengthUnitsEnum spottingDistanceUnits)
+{
+    const std::size_t size = block.size;
+    double coverHeightUsed[spotBatchBlockSize];
+    double flat[spotBatchBlockSize];
+    double a1[spotBatchBlockSize];
+    double b1[spotBatchBlockSize];
+    double x[spotBatchBlockSize];
+
+    // Cover height used, the larger of the cover height and the critical cover height
+    for (std::size_t i = 0; i < size; i++)
+    {
+        double firebrandHeight = block.firebrandHeight[i];
+        double criticalHeight = (firebrandHeight < 1e-7)
+            ? (0.0)
+            : (2.2 * pow(firebrandHeight, 0.337) - 4.0);
+        coverHeightUsed[i] = (block.downwindCoverHeight[i] > criticalHeight)
+            ? (block.downwindCoverHeight[i])
+            : (criticalHeight);
+    }
+
+    // Flat terrain spotting distance (mi), 0 for scenarios without firebrands
+    for (std::size_t i = 0; i < size; i++)
+    {
+        double coverHeight = coverHeightUsed[i];
+        double firebrandHeight = block.firebrandHeight[i];
+        flat[i] = 0.0;
+        if (firebrandHeight > 0.0 && coverHeight > 1e-7)
+        {
+            double heightRatio = firebrandHeight / coverHeight;
+            flat[i] = 0.000718 * block.windSpeedAtTwentyFeet[i] * sqrt(coverHeight)
+                * (0.362 + sqrt(heightRatio) / 2.0 * log(heightRatio))
+                + block.firebrandDrift[i];
+        }
+    }
+
+    // Mountainous terrain, each iteration of the fixed point solution runs over
+    // the whole block. Scenarios without ridge and valley terrain get b1 = 0,
+    // which leaves x at a1
+    for (std::size_t i = 0; i < size; i++)
+    {
+        bool isMountainous = block.ridgeToValleyElevation[i] > 1e-7 && block.ridgeToValleyDistance[i] > 1e-7;
+        a1[i] = isMountainous ? flat[i] / block.ridgeToValleyDistance[i] : 0.0;
+        b1[i] = isMountainous ? block.ridgeToValleyElevation[i] / (10.0 * M_PI) / 1000.0 : 0.0;
+        x[i] = a1[i];
+    }
+    for (int iteration = 0; iteration < 6; iteration++)
+    {
+        for (std::size_t i = 0; i < size; i++)
+        {
+            x[i] = a1[i] - b1[i] * (cos(M_PI * x[i] - block.locationPhase[i])
+                - cos(block.locationPhase[i]));
+        }
+    }
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        bool isMountainous = block.ridgeToValleyElevation[i] > 1e-7 && block.ridgeToValleyDistance[i] > 1e-7;
+        double mountain = isMountainous ? x[i] * block.ridgeToValleyDistance[i] : flat[i];
+        flatDistance[begin + i] = LengthUnits::fromBaseUnits(LengthUnits::toBaseUnits(flat[i], LengthUnits::Miles), spottingDistanceUnits);
+        mountainDistance[begin + i] = LengthUnits::fromBaseUnits(LengthUnits::toBaseUnits(mountain, LengthUnits::Miles), spottingDistanceUnits);
+    }
+}
+
+void Spot::calculateSpottingDistanceFromBurningPileForBatch(const SpotBatchInputs& inputs, double* flatDistance,
+    double* mountainDistance, LengthUnits::LengthUnitsEnum spottingDistanceUnits) const
+{
+    SpotBatchBlock block;
+    double flameHeight[spotBatchBlockSize];
+    for (std::size_t begin = 0; begin < inputs.numberOfScenarios; begin += spotBatchBlockSize)
+    {
+        loadSpotBatchBlock(inputs, begin, block);
+        convertLengthColumn(inputs.burningPileFlameHeight + begin, block.size, inputs.heightUnits, LengthUnits::Feet, flameHeight);
+        for (std::size_t i = 0; i < block.size; i++)
+        {
+            if ((block.windSpeedAtTwentyFeet[i] > 1e-7) && (flameHeight[i] > 1e-7))
+            {
+                block.firebrandHeight[i] = 12.2 * flameHeight[i];
+            }
+        }
+        calculateSpotBatchBlockDistances(block, begin, flatDistance, mountainDistance, spottingDistanceUnits);
+    }
+}
+
+void Spot::calculateSpottingDistanceFromSurfaceFireForBatch(const SpotBatchInputs& inputs, double* flatDistance,
+    double* mountainDistance, LengthUnits::LengthUnitsEnum spottingDistanceUnits) const
+{
+    SpotBatchBlock block;
+    double flameLength[spotBatchBlockSize];
+    for (std::size_t begin = 0; begin < inputs.numberOfScenarios; begin += spotBatchBlockSize)
+    {
+        loadSpotBatchBlock(inputs, begin, block);
+        convertLengthColumn(inputs.flameLength + begin, block.size, inputs.heightUnits, LengthUnits::Feet, flameLength);
+        for (std::size_t i = 0; i < block.size; i++)
+        {
+            double windSpeedAtTwentyFeet = block.windSpeedAtTwentyFeet[i];
+            if ((windSpeedAtTwentyFeet > 1e-7) && (flameLength[i] > 1e-7))
+            {
+                // f * Byram's fireline intensity in a single exponential, rather than
+                // 322 * (0.474 * U)^-1.01 * (L / 0.45)^(1 / 0.46)
+                double fTimesByrams = 322.0 * exp(-1.01 * log(0.474 * windSpeedAtTwentyFeet)
+                    + log(flameLength[i] / 0.45) / 0.46);
+                if (fTimesByrams >= 1e-7)
+                {
+                    block.firebrandHeight[i] = 1.055 * sqrt(fTimesByrams);
+                }
+            }
+        }
+        for (std::size_t i = 0; i < block.size; i++)
+        {
+            if (block.firebrandHeight[i] > 0.0)
+            {
+                block.firebrandDrift[i] = 0.000278 * block.windSpeedAtTwentyFeet[i] * pow(block.firebrandHeight[i], 0.643);
+            }
+        }
+        calculateSpotBatchBlockDistances(block, begin, flatDistance, mountainDistance, spottingDistanceUnits);
+    }
+}
+
+void Spot::calculateSpottingDistanceFromTorchingTreesForBatch(const SpotBatchInputs& inputs, double* flatDistance,
+    double* mountainDistance, LengthUnits::LengthUnitsEnum spottingDistanceUnits) const
+{
+    const int numberOfSpecies = SpotInputs::SpotArrayConstants::NUM_SPECIES;
+
+    // Gather the species parameters once per batch, as logs of the coefficients
+    // so each power below becomes one exponential of a sum
+    double logFlameHeightCoefficient[numberOfSpecies];
+    double logFlameDurationCoefficient[numberOfSpecies];
+    for (int species = 0; species < numberOfSpecies; species++)
+    {
+        logFlameHeightCoefficient[species] = log(speciesFlameHeightParameters_[species][0]);
+        logFlameDurationCoefficient[species] = log(speciesFlameDurationParameters_[species][0]);
+    }
+
+    SpotBatchBlock block;
+    double DBH[spotBatchBlockSize];
+    double treeHeight[spotBatchBlockSize];
+    for (std::size_t begin = 0; begin < inputs.numberOfScenarios; begin += spotBatchBlockSize)
+    {
+        loadSpotBatchBlock(inputs, begin, block);
+        convertLengthColumn(inputs.DBH + begin, block.size, inputs.DBHUnits, LengthUnits::Inches, DBH);
+        convertLengthColumn(inputs.treeHeight + begin, block.size, inputs.heightUnits, LengthUnits::Feet, treeHeight);
+        for (std::size_t i = 0; i < block.size; i++)
+        {
+            int species = (inputs.treeSpecies != nullptr) ? inputs.treeSpecies[begin + i] : inputs.batchTreeSpecies;
+            double torchingTrees = inputs.torchingTrees[begin + i];
+            if (!(block.windSpeedAtTwentyFeet[i] > 1e-7 && DBH[i] > 1e-7 && torchingTrees >= 1.0)
+                || species < 0 || species >= numberOfSpecies)
+            {
+                continue;
+            }
+
+            double logDBH = log(DBH[i]);
+            double logTorchingTrees = log(torchingTrees);
+            // Steady flame height (ft) and duration
+            double flameHeight = exp(logFlameHeightCoefficient[species]
+                + speciesFlameHeightParameters_[species][1] * logDBH + 0.4 * logTorchingTrees);
+            double flameDuration = exp(logFlameDurationCoefficient[species]
+                + speciesFlameDurationParameters_[species][1] * logDBH - 0.2 * logTorchingTrees);
+            double flameRatio = treeHeight[i] / flameHeight;
+
+            int row;
+            if (flameRatio >= 1.0)
+            {
+                row = 0;
+            }
+            else if (flameRatio >= 0.5)
+            {
+                row = 1;
+            }
+            else if (flameDuration < 3.5)
+            {
+                row = 2;
+            }
+            else
+            {
+                row = 3;
+            }
+
+            // Initial firebrand height (ft)
+            block.firebrandHeight[i] = firebrandHeightFactors_[row][0] * pow(flameDuration, firebrandHeightFactors_[row][1])
+                * flameHeight + treeHeight[i] / 2.0;
+        }
+        calculateSpotBatchBlockDistances(block, begin, flatDistance, mountainDistance, spottingDistanceUnits);
+    }
+}
+
 void Spot::setBurningPileFlameHeight(double buringPileFlameHeight, LengthUnits::LengthUnitsEnum flameHeightUnits)
 {
     spotInputs_.setBurningPileFlameHeight(buringPileFlameHeight, flameHeightUnits);
@@ -32,10 +32,46 @@
 #ifndef SPOT_H
 #define SPOT_H
 
+#include <cstddef>
+
 #include "spotInputs.h"
 
+// Columns of spotting scenarios for the batch calculations, one element per
+// scenario, all of length numberOfScenarios. Only the firebrand source columns
+// of the source being calculated are read. Optional columns left as nullptr
+// use the batch wide value instead.
+struct SpotBatchInputs
+{
+    std::size_t numberOfScenarios = 0;
+    const double* windSpeedAtTwentyFeet = nullptr;
+    const double* downwindCoverHeight = nullptr;
+    const double* ridgeToValleyDistance = nullptr;      // optional, flat terrain if nullptr
+    const double* ridgeToValleyElevation = nullptr;     // optional, flat terrain if nullptr
+    const SpotFireLocation::SpotFireLocationEnum* location = nullptr;                   // optional
+    const SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum* downwindCanopyMode = nullptr; // optional
+
+    // Firebrand sources
+    const double* burningPileFlameHeight = nullptr;
+    const double* flameLength = nullptr;                // surface fire flame length
+    const int* torchingTrees = nullptr;
+    const double* DBH = nullptr;
+    const double* treeHeight = nullptr;
+    const SpotTreeSpecies::SpotTreeSpeciesEnum* treeSpecies = nullptr;                  // optional
+
+    // Batch wide values for optional columns
+    SpotFireLocation::SpotFireLocationEnum batchLocation = SpotFireLocation::MIDSLOPE_WINDWARD;
+    SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum batchDownwindCanopyMode = SpotDownWindCanopyMode::CLOSED;
+    SpotTreeSpecies::SpotTreeSpeciesEnum batchTreeSpecies = SpotTreeSpecies::ENGELMANN_SPRUCE;
+
+    SpeedUnits::SpeedUnitsEnum windSpeedUnits = SpeedUnits::MilesPerHour;
+    LengthUnits::LengthUnitsEnum heightUnits = LengthUnits::Feet;   // flame, cover and tree heights, ridge elevation
+    LengthUnits::LengthUnitsEnum DBHUnits = LengthUnits::Inches;
+    LengthUnits::LengthUnitsEnum ridgeToValleyDistanceUnits = LengthUnits::Miles;
+};
+
 class Spot
 {
+    friend class SpotLandingDistribution; // samples firebrands around the protected spotting physics
 public:
     Spot();
     ~Spot();
@@ -49,6 +85,16 @@ public:
     void calculateSpottingDistanceFromSurfaceFire();
     void calculateSpottingDistanceFromTorchingTrees();
 
+    // Batch versions of the above, writing each scenario's maximum flat and
+    // mountainous terrain spotting distance (0 where there is no spotting).
+    // They do not use or change this object's inputs and outputs
+    void calculateSpottingDistanceFromBurningPileForBatch(const SpotBatchInputs& inputs, double* flatDistance,
+        double* mountainDistance, LengthUnits::LengthUnitsEnum spottingDistanceUnits) const;
+    void calculateSpottingDistanceFromSurfaceFireForBatch(const SpotBatchInputs& inputs, double* flatDistance,
+        double* mountainDistance, LengthUnits::LengthUnitsEnum spottingDistanceUnits) const;
+    void calculateSpottingDistanceFromTorchingTreesForBatch(const SpotBatchInputs& inputs, double* flatDistance,
+        double* mountainDistance, LengthUnits::LengthUnitsEnum spottingDistanceUnits) const;
+
   // Spot Inputs Setters
     void setBurningPileFlameHeight(double buringPileflameHeight, LengthUnits::LengthUnitsEnum flameHeightUnits);
     void setDBH(double DBH, LengthUnits::LengthUnitsEnum DBHUnits);
@@ -111,11 +157,11 @@ public:
 
 protected:
     void memberwiseCopyAssignment(const Spot& rhs);
-    double calculateSpotCriticalCoverHeight(double firebrandHeight, double coverHeight);
+    double calculateSpotCriticalCoverHeight(double firebrandHeight, double coverHeight) const;
     double calculateDownwindCanopyCoverHeight() const;
-    double spotDistanceFlatTerrain(double firebrandHeight, double coverHeight, double windSpeedAtTwentyFeet);
+    double spotDistanceFlatTerrain(double firebrandHeight, double coverHeight, double windSpeedAtTwentyFeet) const;
     double spotDistanceMountainTerrain(double flatDistance, SpotFireLocation::SpotFireLocationEnum location,
-    double ridgeToValleyDistance, double ridgeToValleyElevation);
+    double ridgeToValleyDistance, double ridgeToValleyElevation) const;
 
     SpotInputs spotInputs_;
 
@@ -0,0 +1,357 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Stochastic distribution of firebrand landing locations around the
+*           maximum spotting distance of a burning pile, surface fire or
+*           torching trees
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "spotLandingDistribution.h"
+
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include "spot.h"
+
+namespace
+{
+
+// Firebrands are sampled in fixed chunks so the sums over a chunk, and so the
+// results, are the same whatever thread samples it
+const std::uint64_t firebrandsPerChunk = 65536;
+
+// Philox4x32-10 counter based random numbers (Salmon et al. 2011). The numbers
+// for a firebrand are a function of the seed, stream and firebrand index only,
+// so any firebrand can be sampled on any thread in any order.
+inline void philox4x32(std::uint32_t counter[4], std::uint32_t key0, std::uint32_t key1)
+{
+    for (int round = 0; round < 10; round++)
+    {
+        std::uint64_t product0 = 0xD2511F53ULL * counter[0];
+        std::uint64_t product1 = 0xCD9E8D57ULL * counter[2];
+        std::uint32_t next0 = (std::uint32_t)(product1 >> 32) ^ counter[1] ^ key0;
+        std::uint32_t next2 = (std::uint32_t)(product0 >> 32) ^ counter[3] ^ key1;
+        counter[0] = next0;
+        counter[1] = (std::uint32_t)product1;
+        counter[2] = next2;
+        counter[3] = (std::uint32_t)product0;
+        key0 += 0x9E3779B9U;
+        key1 += 0xBB67AE85U;
+    }
+}
+
+// Uniform on the open interval (0, 1)
+inline double toUniform(std::uint32_t value)
+{
+    return (value + 0.5) * (1.0 / 4294967296.0);
+}
+
+struct SpotLandingChunkTotals
+{
+    std::uint64_t numberOfLandedFirebrands = 0;
+    std::uint64_t numberOfBurnedOutFirebrands = 0;
+    std::uint64_t numberOfFirebrandsOffGrid = 0;
+    double sumOfLandingDistances = 0.0;
+    double maxLandingDistance = 0.0;
+};
+
+} // namespace
+
+SpotLandingDistribution::SpotLandingDistribution()
+{
+    setGrid(SpotLandingGrid());
+}
+
+bool SpotLandingDistribution::setGrid(const SpotLandingGrid& grid)
+{
+    // Written so that NaN bounds are rejected too
+    if (!(grid.downwindMaximum > grid.downwindMinimum) || !(grid.crosswindMaximum > grid.crosswindMinimum))
+    {
+        return false;
+    }
+    grid_ = grid;
+    grid_.numberOfDownwindCells = std::max(grid_.numberOfDownwindCells, 1);
+    grid_.numberOfCrosswindCells = std::max(grid_.numberOfCrosswindCells, 1);
+    clear();
+    return true;
+}
+
+void SpotLandingDistribution::setSamplingParameters(const SpotLandingSamplingParameters& samplingParameters)
+{
+    samplingParameters_ = samplingParameters;
+}
+
+void SpotLandingDistribution::clear()
+{
+    counts_.assign((std::size_t)grid_.numberOfDownwindCells * grid_.numberOfCrosswindCells, 0);
+    numberOfSampledFirebrands_ = 0;
+    numberOfLandedFirebrands_ = 0;
+    numberOfBurnedOutFirebrands_ = 0;
+    numberOfFirebrandsOffGrid_ = 0;
+    sumOfLandingDistances_ = 0.0;
+    maxLandingDistance_ = 0.0;
+}
+
+void SpotLandingDistribution::sampleFromBurningPile(const Spot& spot)
+{
+    SpotFirebrandSource source;
+    source.maxFirebrandHeight = spot.getMaxFirebrandHeightFromBurningPile(LengthUnits::Feet);
+    source.downwindCoverHeight = spot.calculateDownwindCanopyCoverHeight();
+    source.windSpeedAtTwentyFeet = spot.getWindSpeedAtTwentyFeet(SpeedUnits::MilesPerHour);
+    source.hasDrift = false;
+    sample(spot, source);
+}
+
+void SpotLandingDistribution::sampleFromSurfaceFire(const Spot& spot)
+{
+    SpotFirebrandSource source;
+    source.maxFirebrandHeight = spot.getMaxFirebrandHeightFromSurfaceFire(LengthUnits::Feet);
+    source.downwindCoverHeight = spot.calculateDownwindCanopyCoverHeight();
+    source.windSpeedAtTwentyFeet = spot.getWindSpeedAtTwentyFeet(SpeedUnits::MilesPerHour);
+    source.hasDrift = true;
+    sample(spot, source);
+}
+
+void SpotLandingDistribution::sampleFromTorchingTrees(const Spot& spot)
+{
+    SpotFirebrandSource source;
+    source.maxFirebrandHeight = spot.getMaxFirebrandHeightFromTorchingTrees(LengthUnits::Feet);
+    source.downwindCoverHeight = spot.calculateDownwindCanopyCoverHeight();
+    source.windSpeedAtTwentyFeet = spot.getWindSpeedAtTwentyFeet(SpeedUnits::MilesPerHour);
+    source.hasDrift = false;
+    sample(spot, source);
+}
+
+void SpotLandingDistribution::sample(const Spot& spot, const SpotFirebrandSource& source)
+{
+    // A source that lofts no firebrands adds nothing
+    if (source.maxFirebrandHeight < 1e-7 || source.windSpeedAtTwentyFeet < 1e-7)
+    {
+        return;
+    }
+
+    const SpotLandingSamplingParameters parameters = samplingParameters_;
+    const std::uint64_t numberOfFirebrands = parameters.numberOfFirebrands;
+    const std::uint64_t numberOfChunks = (numberOfFirebrands + firebrandsPerChunk - 1) / firebrandsPerChunk;
+    const int numberOfThreads = (int)std::max<std::uint64_t>(1,
+        std::min<std::uint64_t>(std::max(parameters.numberOfThreads, 1), numberOfChunks));
+
+    const SpotFireLocation::SpotFireLocationEnum location = spot.getLocation();
+    const double ridgeToValleyDistance = spot.getRidgeToValleyDistance(LengthUnits::Miles);
+    const double ridgeToValleyElevation = spot.getRidgeToValleyElevation(LengthUnits::Feet);
+    const double gustMeanCorrection = -0.5 * parameters.gustFactorDeviation * parameters.gustFactorDeviation;
+    const double windDirectionDeviation = parameters.windDirectionDeviation * M_PI / 180.0;
+
+    // Landing distances are in miles, the grid is in its own units
+    const double milesToGridUnits = LengthUnits::fromBaseUnits(LengthUnits::toBaseUnits(1.0, LengthUnits::Miles), grid_.units);
+    const int numberOfDownwindCells = grid_.numberOfDownwindCells;
+    const int numberOfCrosswindCells = grid_.numberOfCrosswindCells;
+    const double downwindCellsPerUnit = numberOfDownwindCells / (grid_.downwindMaximum - grid_.downwindMinimum);
+    const double crosswindCellsPerUnit = numberOfCrosswindCells / (grid_.crosswindMaximum - grid_.crosswindMinimum);
+
+    const std::uint32_t key0 = (std::uint32_t)parameters.seed;
+    const std::uint32_t key1 = (std::uint32_t)(parameters.seed >> 32);
+
+    std::vector<SpotLandingChunkTotals> chunkTotals((std::size_t)numberOfChunks);
+    std::vector<std::vector<std::uint64_t> > threadCounts(numberOfThreads);
+    std::atomic<std::uint64_t> nextChunk(0);
+
+    auto sampleChunks = [&](int thread)
+    {
+        std::vector<std::uint64_t>& counts = threadCounts[thread];
+        counts.assign(counts_.size(), 0);
+        for (;;)
+        {
+            std::uint64_t chunk = nextChunk.fetch_add(1);
+            if (chunk >= numberOfChunks)
+            {
+                return;
+            }
+            SpotLandingChunkTotals& totals = chunkTotals[(std::size_t)chunk];
+            const std::uint64_t end = std::min(numberOfFirebrands, (chunk + 1) * firebrandsPerChunk);
+            for (std::uint64_t firebrand = chunk * firebrandsPerChunk; firebrand < end; firebrand++)
+            {
+                std::uint32_t draws[4] = { (std::uint32_t)firebrand, (std::uint32_t)(firebrand >> 32), parameters.stream, 0 };
+                philox4x32(draws, key0, key1);
+
+                double loftingFraction = 1.0;
+                if (parameters.loftingHeightExponent == 1.0)
+                {
+                    loftingFraction = toUniform(draws[0]);
+                }
+                else if (parameters.loftingHeightExponent > 0.0)
+                {
+                    loftingFraction = pow(toUniform(draws[0]), parameters.loftingHeightExponent);
+                }
+                double firebrandHeight = source.maxFirebrandHeight * loftingFraction;
+
+                // Lofted above its burnout height the firebrand is out before it lands.
+                // The burnout height is lognormal, so given the lofting height that
+                // happens with probability Phi(log(loftingFraction) / deviation)
+                if (parameters.burnoutHeightDeviation > 0.0)
+                {
+                    double burnoutProbability = 0.5 * erfc(-log(loftingFraction) / (parameters.burnoutHeightDeviation * M_SQRT2));
+                    if (toUniform(draws[3]) < burnoutProbability)
+                    {
+                        totals.numberOfBurnedOutFirebrands++;
+                        continue;
+                    }
+                }
+
+                // Box-Muller pair for the gust factor and the direction off the wind
+                double radius = sqrt(-2.0 * log(toUniform(draws[1])));
+                double angle = 2.0 * M_PI * toUniform(draws[2]);
+                double windSpeed = source.windSpeedAtTwentyFeet
+                    * exp(parameters.gustFactorDeviation * radius * cos(angle) + gustMeanCorrection);
+                double direction = windDirectionDeviation * radius * sin(angle);
+
+                double coverHeight = spot.calculateSpotCriticalCoverHeight(firebrandHeight, source.downwindCoverHeight);
+                double flatDistance = (coverHeight > 1e-7)
+                    ? spot.spotDistanceFlatTerrain(firebrandHeight, coverHeight, windSpeed)
+                    : 0.0;
+                if (source.hasDrift)
+                {
+                    flatDistance += 0.000278 * windSpeed * pow(firebrandHeight, 0.643);
+                }
+                flatDistance = std::max(flatDistance, 0.0);
+                double distance = spot.spotDistanceMountainTerrain(flatDistance, location,
+                    ridgeToValleyDistance, ridgeToValleyElevation);
+
+                totals.numberOfLandedFirebrands++;
+                totals.sumOfLandingDistances += distance;
+                totals.maxLandingDistance = std::max(totals.maxLandingDistance, distance);
+
+                double downwindCell = (distance * milesToGridUnits * cos(direction) - grid_.downwindMinimum) * downwindCellsPerUnit;
+                double crosswindCell = (distance * milesToGridUnits * sin(direction) - grid_.crosswindMinimum) * crosswindCellsPerUnit;
+                if (downwindCell >= 0.0 && downwindCell < numberOfDownwindCells
+                    && crosswindCell >= 0.0 && crosswindCell < numberOfCrosswindCells)
+                {
+                    counts[(std::size_t)downwindCell * numberOfCrosswindCells + (std::size_t)crosswindCell]++;
+                }
+                else
+                {
+                    totals.numberOfFirebrandsOffGrid++;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int thread = 1; thread < numberOfThreads; thread++)
+    {
+        threads.push_back(std::thread(sampleChunks, thread));
+    }
+    sampleChunks(0);
+    for (std::size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    for (int thread = 0; thread < numberOfThreads; thread++)
+    {
+        const std::vector<std::uint64_t>& counts = threadCounts[thread];
+        for (std::size_t cell = 0; cell < counts_.size(); cell++)
+        {
+            counts_[cell] += counts[cell];
+        }
+    }
+    // Chunks are added in order so the sums do not depend on the threads
+    for (std::size_t chunk = 0; chunk < chunkTotals.size(); chunk++)
+    {
+        numberOfLandedFirebrands_ += chunkTotals[chunk].numberOfLandedFirebrands;
+        numberOfBurnedOutFirebrands_ += chunkTotals[chunk].numberOfBurnedOutFirebrands;
+        numberOfFirebrandsOffGrid_ += chunkTotals[chunk].numberOfFirebrandsOffGrid;
+        sumOfLandingDistances_ += chunkTotals[chunk].sumOfLandingDistances;
+        maxLandingDistance_ = std::max(maxLandingDistance_, chunkTotals[chunk].maxLandingDistance);
+    }
+    numberOfSampledFirebrands_ += numberOfFirebrands;
+}
+
+const SpotLandingGrid& SpotLandingDistribution::getGrid() const
+{
+    return grid_;
+}
+
+const SpotLandingSamplingParameters& SpotLandingDistribution::getSamplingParameters() const
+{
+    return samplingParameters_;
+}
+
+std::uint64_t SpotLandingDistribution::getNumberOfSampledFirebrands() const
+{
+    return numberOfSampledFirebrands_;
+}
+
+std::uint64_t SpotLandingDistribution::getNumberOfLandedFirebrands() const
+{
+    return numberOfLandedFirebrands_;
+}
+
+std::uint64_t SpotLandingDistribution::getNumberOfBurnedOutFirebrands() const
+{
+    return numberOfBurnedOutFirebrands_;
+}
+
+std::uint64_t SpotLandingDistribution::getNumberOfFirebrandsOffGrid() const
+{
+    return numberOfFirebrandsOffGrid_;
+}
+
+std::uint64_t SpotLandingDistribution::getCount(int downwindCell, int crosswindCell) const
+{
+    if (downwindCell < 0 || downwindCell >= grid_.numberOfDownwindCells
+        || crosswindCell < 0 || crosswindCell >= grid_.numberOfCrosswindCells)
+    {
+        return 0;
+    }
+    return counts_[(std::size_t)downwindCell * grid_.numberOfCrosswindCells + crosswindCell];
+}
+
+double SpotLandingDistribution::getDensity(int downwindCell, int crosswindCell) const
+{
+    if (numberOfSampledFirebrands_ == 0)
+    {
+        return 0.0;
+    }
+    double cellArea = ((grid_.downwindMaximum - grid_.downwindMinimum) / grid_.numberOfDownwindCells)
+        * ((grid_.crosswindMaximum - grid_.crosswindMinimum) / grid_.numberOfCrosswindCells);
+    return getCount(downwindCell, crosswindCell) / (double)numberOfSampledFirebrands_ / cellArea;
+}
+
+double SpotLandingDistribution::getMeanLandingDistance(LengthUnits::LengthUnitsEnum distanceUnits) const
+{
+    if (numberOfLandedFirebrands_ == 0)
+    {
+        return 0.0;
+    }
+    double meanLandingDistance = sumOfLandingDistances_ / numberOfLandedFirebrands_;
+    return LengthUnits::fromBaseUnits(LengthUnits::toBaseUnits(meanLandingDistance, LengthUnits::Miles), distanceUnits);
+}
+
+double SpotLandingDistribution::getMaxLandingDistance(LengthUnits::LengthUnitsEnum distanceUnits) const
+{
+    return LengthUnits::fromBaseUnits(LengthUnits::toBaseUnits(maxLandingDistance_, LengthUnits::Miles), distanceUnits);
+}
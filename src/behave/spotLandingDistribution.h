@@ -0,0 +1,125 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Stochastic distribution of firebrand landing locations around the
+*           maximum spotting distance of a burning pile, surface fire or
+*           torching trees
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef SPOTLANDINGDISTRIBUTION_H
+#define SPOTLANDINGDISTRIBUTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "behaveUnits.h"
+
+class Spot;
+
+// Each firebrand is lofted to a fraction of the source's maximum firebrand height,
+// carried by a gusting twenty foot wind that may veer off the mean wind direction,
+// and lands where Spot's flat and mountainous terrain equations put a firebrand of
+// that height. It burns out in flight if lofted above its own burnout height,
+// which varies around the maximum firebrand height. With every variation turned
+// off each firebrand lands at Spot's maximum mountainous terrain spotting distance.
+struct SpotLandingSamplingParameters
+{
+    std::uint64_t numberOfFirebrands = 1000000;
+    std::uint64_t seed = 0;
+    std::uint32_t stream = 0;               // independent random numbers per stream, e.g. one per source
+    double loftingHeightExponent = 1.0;     // lofting height = maximum firebrand height * U^exponent, 0 for always the maximum
+    double gustFactorDeviation = 0.2;       // log standard deviation of the wind gust factor, whose mean is 1
+    double windDirectionDeviation = 10.0;   // standard deviation of the firebrand's direction off the wind (degrees)
+    double burnoutHeightDeviation = 0.3;    // log standard deviation of the burnout height, whose median is the maximum firebrand height
+    int numberOfThreads = 1;
+};
+
+// Landing grid, downwind along the mean wind direction and crosswind to its right
+struct SpotLandingGrid
+{
+    double downwindMinimum = 0.0;
+    double downwindMaximum = 1.0;
+    int numberOfDownwindCells = 1;
+    double crosswindMinimum = -0.5;
+    double crosswindMaximum = 0.5;
+    int numberOfCrosswindCells = 1;
+    LengthUnits::LengthUnitsEnum units = LengthUnits::Miles;
+};
+
+// Landing counts of the firebrands sampled from one or more sources on a grid.
+// Individual firebrands are never stored, and the counts do not depend on the
+// number of threads.
+class SpotLandingDistribution
+{
+public:
+    SpotLandingDistribution();
+
+    // Clears the counts. A grid whose maximum is not past its minimum in either
+    // direction is rejected, keeping the current grid and counts
+    bool setGrid(const SpotLandingGrid& grid);
+    void setSamplingParameters(const SpotLandingSamplingParameters& samplingParameters);
+    void clear();
+
+    // Add the firebrands from the source last calculated by spot, call after
+    // the matching Spot::calculateSpottingDistanceFrom...()
+    void sampleFromBurningPile(const Spot& spot);
+    void sampleFromSurfaceFire(const Spot& spot);
+    void sampleFromTorchingTrees(const Spot& spot);
+
+    const SpotLandingGrid& getGrid() const;
+    const SpotLandingSamplingParameters& getSamplingParameters() const;
+
+    std::uint64_t getNumberOfSampledFirebrands() const;
+    std::uint64_t getNumberOfLandedFirebrands() const;          // includes those landing off the grid
+    std::uint64_t getNumberOfBurnedOutFirebrands() const;
+    std::uint64_t getNumberOfFirebrandsOffGrid() const;
+    std::uint64_t getCount(int downwindCell, int crosswindCell) const;
+    // Landed firebrands per sampled firebrand per unit area of the grid units
+    double getDensity(int downwindCell, int crosswindCell) const;
+    double getMeanLandingDistance(LengthUnits::LengthUnitsEnum distanceUnits) const;
+    double getMaxLandingDistance(LengthUnits::LengthUnitsEnum distanceUnits) const;
+
+private:
+    struct SpotFirebrandSource
+    {
+        double maxFirebrandHeight;          // ft
+        double downwindCoverHeight;         // ft
+        double windSpeedAtTwentyFeet;       // mph
+        bool hasDrift;                      // surface fire firebrands drift as they are lofted
+    };
+
+    void sample(const Spot& spot, const SpotFirebrandSource& source);
+
+    SpotLandingGrid grid_;
+    SpotLandingSamplingParameters samplingParameters_;
+    std::vector<std::uint64_t> counts_;     // downwind cells x crosswind cells, crosswind fastest
+    std::uint64_t numberOfSampledFirebrands_;
+    std::uint64_t numberOfLandedFirebrands_;
+    std::uint64_t numberOfBurnedOutFirebrands_;
+    std::uint64_t numberOfFirebrandsOffGrid_;
+    double sumOfLandingDistances_;          // mi
+    double maxLandingDistance_;             // mi
+};
+
+#endif // SPOTLANDINGDISTRIBUTION_H
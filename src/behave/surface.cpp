@@ -34,18 +34,24 @@
 #include "surfaceInputs.h"
 
 #include <cmath>
+#include <unordered_map>
+#include <vector>
 
 Surface::Surface(const FuelModels& fuelModels)
     : surfaceInputs_(),
-    surfaceFire_(fuelModels, surfaceInputs_, size_)
+    surfaceFire_(fuelModels, surfaceInputs_, size_),
+    surfaceTwoFuelModels_(surfaceFire_)
 {
     fuelModels_ = &fuelModels;
 }
 
 // Copy Ctor
 Surface::Surface(const Surface& rhs)
-    : surfaceFire_()
+    : surfaceInputs_(),
+    surfaceFire_(*rhs.fuelModels_, surfaceInputs_, size_),
+    surfaceTwoFuelModels_(surfaceFire_)
 {
+    fuelModels_ = rhs.fuelModels_;
     memberwiseCopyAssignment(rhs);
 }
 
@@ -80,12 +86,11 @@ void Surface::doSurfaceRunInDirectionOfMaxSpread()
     if (isUsingTwoFuelModels())
     {
         // Calculate spread rate for Two Fuel Models
-        SurfaceTwoFuelModels surfaceTwoFuelModels(surfaceFire_);
         TwoFuelModelsMethod::TwoFuelModelsMethodEnum twoFuelModelsMethod = surfaceInputs_.getTwoFuelModelsMethod();
         int firstFuelModelNumber = surfaceInputs_.getFirstFuelModelNumber();
         double firstFuelModelCoverage = surfaceInputs_.getFirstFuelModelCoverage();
         int secondFuelModelNumber = surfaceInputs_.getSecondFuelModelNumber();
-        surfaceTwoFuelModels.calculateWeightedSpreadRate(twoFuelModelsMethod, firstFuelModelNumber, firstFuelModelCoverage,
+        surfaceTwoFuelModels_.calculateWeightedSpreadRate(twoFuelModelsMethod, firstFuelModelNumber, firstFuelModelCoverage,
             secondFuelModelNumber, hasDirectionOfInterest, directionOfInterest, directionMode);
     }
     else // Use only one fuel model
@@ -107,6 +112,126 @@ void Surface::doSurfaceRunInDirectionOfMaxSpread()
     }
 }
 
+void Surface::doSurfaceRunInDirectionOfMaxSpreadForOneHourMoistures(std::size_t numberOfRuns, const double* moistureOneHour,
+    FractionUnits::FractionUnitsEnum moistureUnits, double* spreadRate, SpeedUnits::SpeedUnitsEnum spreadRateUnits,
+    double* flameLength, LengthUnits::LengthUnitsEnum flameLengthUnits)
+{
+    const double savedMoistureOneHour = surfaceInputs_.getMoistureOneHour(FractionUnits::Fraction);
+
+    // Tabled fine dead fuel moistures take only a few distinct values, so most
+    // runs reuse the outputs of an earlier run with the same moisture
+    std::unordered_map<double, std::size_t> distinctRunIndex;
+    std::vector<double> distinctSpreadRates;
+    std::vector<double> distinctFlameLengths;
+
+    for (std::size_t i = 0; i < numberOfRuns; i++)
+    {
+        double moisture = moistureOneHour[i];
+        if (moisture < 0.0)
+        {
+            spreadRate[i] = -1.0;
+            flameLength[i] = -1.0;
+            continue;
+        }
+        std::unordered_map<double, std::size_t>::const_iterator distinctRun = distinctRunIndex.find(moisture);
+        if (distinctRun == distinctRunIndex.end())
+        {
+            surfaceInputs_.setMoistureOneHour(moisture, moistureUnits);
+            doSurfaceRunInDirectionOfMaxSpread();
+            distinctRun = distinctRunIndex.insert(std::make_pair(moisture, distinctSpreadRates.size())).first;
+            distinctSpreadRates.push_back(getSpreadRate(spreadRateUnits));
+            distinctFlameLengths.push_back(getFlameLength(flameLengthUnits));
+        }
+        spreadRate[i] = distinctSpreadRates[distinctRun->second];
+        flameLength[i] = distinctFlameLengths[distinctRun->second];
+    }
+
+    surfaceInputs_.setMoistureOneHour(savedMoistureOneHour, FractionUnits::Fraction);
+}
+
+void Surface::doSurfaceRunInDirectionOfMaxSpreadForBatch(const SurfaceBatchInputs& inputs, double* spreadRate,
+    SpeedUnits::SpeedUnitsEnum spreadRateUnits, double* flameLength, LengthUnits::LengthUnitsEnum flameLengthUnits)
+{
+    const int savedFuelModelNumber = surfaceInputs_.getFuelModelNumber();
+    const double savedMoistureOneHour = surfaceInputs_.getMoistureOneHour(FractionUnits::Fraction);
+    const double savedWindSpeed = surfaceInputs_.getWindSpeed(SpeedUnits::FeetPerMinute);
+    const double savedWindDirection = surfaceInputs_.getWindDirection();
+    const double savedWindAdjustmentFactor = surfaceInputs_.getUserProvidedWindAdjustmentFactor();
+    const WindHeightInputMode::WindHeightInputModeEnum windHeightInputMode = surfaceInputs_.getWindHeightInputMode();
+    const WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum savedWindAdjustmentFactorCalculationMethod =
+        surfaceInputs_.getWindAdjustmentFactorCalculationMethod();
+
+    if (inputs.windAdjustmentFactor != nullptr)
+    {
+        surfaceInputs_.setWindAdjustmentFactorCalculationMethod(WindAdjustmentFactorCalculationMethod::UserInput);
+    }
+    for (std::size_t i = 0; i < inputs.numberOfRuns; i++)
+    {
+        if (inputs.fuelModelNumber != nullptr)
+        {
+            surfaceInputs_.setFuelModelNumber(inputs.fuelModelNumber[i]);
+        }
+        if (inputs.moistureOneHour != nullptr)
+        {
+            surfaceInputs_.setMoistureOneHour(inputs.moistureOneHour[i], inputs.moistureUnits);
+        }
+        if (inputs.windSpeed != nullptr)
+        {
+            surfaceInputs_.setWindSpeed(inputs.windSpeed[i], inputs.windSpeedUnits, windHeightInputMode);
+        }
+        if (inputs.windDirection != nullptr)
+        {
+            surfaceInputs_.setWindDirection(inputs.windDirection[i]);
+        }
+        if (inputs.windAdjustmentFactor != nullptr)
+        {
+            surfaceInputs_.setUserProvidedWindAdjustmentFactor(inputs.windAdjustmentFactor[i]);
+        }
+        doSurfaceRunInDirectionOfMaxSpread();
+        spreadRate[i] = getSpreadRate(spreadRateUnits);
+        flameLength[i] = getFlameLength(flameLengthUnits);
+    }
+
+    surfaceInputs_.setFuelModelNumber(savedFuelModelNumber);
+    surfaceInputs_.setMoistureOneHour(savedMoistureOneHour, FractionUnits::Fraction);
+    surfaceInputs_.setWindSpeed(savedWindSpeed, SpeedUnits::FeetPerMinute, windHeightInputMode);
+    surfaceInputs_.setWindDirection(savedWindDirection);
+    surfaceInputs_.setUserProvidedWindAdjustmentFactor(savedWindAdjustmentFactor);
+    surfaceInputs_.setWindAdjustmentFactorCalculationMethod(savedWindAdjustmentFactorCalculationMethod);
+}
+
+void Surface::calculateWindAdjustmentFactorsForCells(std::size_t numberOfCells, const double* canopyCover,
+    FractionUnits::FractionUnitsEnum coverUnits, const double* canopyHeight, LengthUnits::LengthUnitsEnum canopyHeightUnits,
+    const double* crownRatio, const int* fuelModelNumber, double* windAdjustmentFactor) const
+{
+    WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum windAdjustmentFactorCalculationMethod =
+        surfaceInputs_.getWindAdjustmentFactorCalculationMethod();
+    if (windAdjustmentFactorCalculationMethod == WindAdjustmentFactorCalculationMethod::UserInput)
+    {
+        for (std::size_t i = 0; i < numberOfCells; i++)
+        {
+            windAdjustmentFactor[i] = surfaceInputs_.getUserProvidedWindAdjustmentFactor();
+        }
+        return;
+    }
+
+    // Neighbouring cells of a stand share their canopy, so most are found in the table
+    WindAdjustmentFactorTable windAdjustmentFactorTable;
+    WindAdjustmentFactorShelterMethod::WindAdjustmentFactorShelterMethodEnum shelterMethod;
+    for (std::size_t i = 0; i < numberOfCells; i++)
+    {
+        double cellCanopyCover = (canopyCover != nullptr) ? FractionUnits::toBaseUnits(canopyCover[i], coverUnits)
+            : surfaceInputs_.getCanopyCover(FractionUnits::Fraction);
+        double cellCanopyHeight = (canopyHeight != nullptr) ? LengthUnits::toBaseUnits(canopyHeight[i], canopyHeightUnits)
+            : surfaceInputs_.getCanopyHeight(LengthUnits::Feet);
+        double cellCrownRatio = (crownRatio != nullptr) ? crownRatio[i] : surfaceInputs_.getCrownRatio();
+        int cellFuelModelNumber = (fuelModelNumber != nullptr) ? fuelModelNumber[i] : surfaceInputs_.getFuelModelNumber();
+        double fuelbedDepth = fuelModels_->getFuelbedDepth(cellFuelModelNumber, LengthUnits::Feet);
+        windAdjustmentFactor[i] = windAdjustmentFactorTable.getWindAdjustmentFactor(windAdjustmentFactorCalculationMethod,
+            cellCanopyCover, cellCanopyHeight, cellCrownRatio, fuelbedDepth, shelterMethod);
+    }
+}
+
 void Surface::doSurfaceRunInDirectionOfInterest(double directionOfInterest, SurfaceFireSpreadDirectionMode::SurfaceFireSpreadDirectionModeEnum directionMode)
 {
     surfaceInputs_.updateMoisturesBasedOnInputMode();
@@ -114,12 +239,11 @@ void Surface::doSurfaceRunInDirectionOfInterest(double directionOfInterest, Surf
     if (isUsingTwoFuelModels())
     {
         // Calculate spread rate for Two Fuel Models
-        SurfaceTwoFuelModels surfaceTwoFuelModels(surfaceFire_);
         TwoFuelModelsMethod::TwoFuelModelsMethodEnum  twoFuelModelsMethod = surfaceInputs_.getTwoFuelModelsMethod();
         int firstFuelModelNumber = surfaceInputs_.getFirstFuelModelNumber();
         double firstFuelModelCoverage = surfaceInputs_.getFirstFuelModelCoverage();
         int secondFuelModelNumber = surfaceInputs_.getSecondFuelModelNumber();
-        surfaceTwoFuelModels.calculateWeightedSpreadRate(twoFuelModelsMethod, firstFuelModelNumber, firstFuelModelCoverage,
+        surfaceTwoFuelModels_.calculateWeightedSpreadRate(twoFuelModelsMethod, firstFuelModelNumber, firstFuelModelCoverage,
             secondFuelModelNumber, hasDirectionOfInterest, directionOfInterest, directionMode);
     }
     else // Use only one fuel model
@@ -172,6 +296,53 @@ double Surface::calculateSpreadRateAtVector(double directionOfinterest, SurfaceF
     return surfaceFire_.calculateSpreadRateAtVector(directionOfinterest, directionMode);
 }
 
+SurfaceResults Surface::getResults(const UnitSystem& unitSystem) const
+{
+    SurfaceResults results;
+    const double elapsedTime = surfaceInputs_.getElapsedTime(TimeUnits::Minutes);
+    const double spreadRate = surfaceFire_.getSpreadRate();
+    const double backingSpreadRate = size_.getBackingSpreadRate(SpeedUnits::FeetPerMinute);
+    const double flankingSpreadRate = size_.getFlankingSpreadRate(SpeedUnits::FeetPerMinute);
+
+    results.spreadRate = SpeedUnits::fromBaseUnits(spreadRate, unitSystem.spreadRateUnits);
+    results.spreadRateInDirectionOfInterest = SpeedUnits::fromBaseUnits(surfaceFire_.getSpreadRateInDirectionOfInterest(),
+        unitSystem.spreadRateUnits);
+    results.backingSpreadRate = SpeedUnits::fromBaseUnits(backingSpreadRate, unitSystem.spreadRateUnits);
+    results.flankingSpreadRate = SpeedUnits::fromBaseUnits(flankingSpreadRate, unitSystem.spreadRateUnits);
+    results.directionOfMaxSpread = surfaceFire_.getDirectionOfMaxSpread();
+
+    results.flameLength = LengthUnits::fromBaseUnits(surfaceFire_.getFlameLength(), unitSystem.flameLengthUnits);
+    results.backingFlameLength = LengthUnits::fromBaseUnits(surfaceFire_.getBackingFlameLength(), unitSystem.flameLengthUnits);
+    results.flankingFlameLength = LengthUnits::fromBaseUnits(surfaceFire_.getFlankingFlameLength(), unitSystem.flameLengthUnits);
+
+    results.firelineIntensity = FirelineIntensityUnits::fromBaseUnits(surfaceFire_.getFirelineIntensity(),
+        unitSystem.firelineIntensityUnits);
+    results.backingFirelineIntensity = FirelineIntensityUnits::fromBaseUnits(surfaceFire_.getBackingFirelineIntensity(),
+        unitSystem.firelineIntensityUnits);
+    results.flankingFirelineIntensity = FirelineIntensityUnits::fromBaseUnits(surfaceFire_.getFlankingFirelineIntensity(),
+        unitSystem.firelineIntensityUnits);
+    results.heatPerUnitArea = HeatPerUnitAreaUnits::fromBaseUnits(surfaceFire_.getHeatPerUnitArea(), unitSystem.heatPerUnitAreaUnits);
+    results.reactionIntensity = HeatSourceAndReactionIntensityUnits::fromBaseUnits(surfaceFire_.getReactionIntensity(),
+        unitSystem.reactionIntensityUnits);
+    results.residenceTime = TimeUnits::fromBaseUnits(surfaceFire_.getResidenceTime(), unitSystem.timeUnits);
+    results.midflameWindSpeed = SpeedUnits::fromBaseUnits(surfaceFire_.getMidflameWindSpeed(), unitSystem.windSpeedUnits);
+
+    results.fireLengthToWidthRatio = size_.getFireLengthToWidthRatio();
+    results.fireEccentricity = size_.getEccentricity();
+    results.headingToBackingRatio = size_.getHeadingToBackingRatio();
+    results.spreadDistance = LengthUnits::fromBaseUnits(spreadRate * elapsedTime, unitSystem.lengthUnits);
+    results.backingSpreadDistance = LengthUnits::fromBaseUnits(backingSpreadRate * elapsedTime, unitSystem.lengthUnits);
+    results.flankingSpreadDistance = LengthUnits::fromBaseUnits(flankingSpreadRate * elapsedTime, unitSystem.lengthUnits);
+    results.ellipticalA = size_.getEllipticalA(unitSystem.lengthUnits, elapsedTime, TimeUnits::Minutes);
+    results.ellipticalB = size_.getEllipticalB(unitSystem.lengthUnits, elapsedTime, TimeUnits::Minutes);
+    results.ellipticalC = size_.getEllipticalC(unitSystem.lengthUnits, elapsedTime, TimeUnits::Minutes);
+    results.fireLength = size_.getFireLength(unitSystem.lengthUnits, elapsedTime, TimeUnits::Minutes);
+    results.maxFireWidth = size_.getMaxFireWidth(unitSystem.lengthUnits, elapsedTime, TimeUnits::Minutes);
+    results.firePerimeter = size_.getFirePerimeter(false, unitSystem.lengthUnits, elapsedTime, TimeUnits::Minutes);
+    results.fireArea = size_.getFireArea(false, unitSystem.areaUnits, elapsedTime, TimeUnits::Minutes);
+    return results;
+}
+
 double Surface::getSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
 {
     return SpeedUnits::fromBaseUnits(surfaceFire_.getSpreadRate(), spreadRateUnits);
@@ -182,12 +353,39 @@ double Surface::getSpreadRateInDirectionOfInterest(SpeedUnits::SpeedUnitsEnum sp
     return SpeedUnits::fromBaseUnits(surfaceFire_.getSpreadRateInDirectionOfInterest(), spreadRateUnits);
 }
 
-double Surface::getBackingSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits)
+double Surface::getSpreadRateStandardError(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
+{
+    return SpeedUnits::fromBaseUnits(surfaceFire_.getSpreadRateStandardError(), spreadRateUnits);
+}
+
+double Surface::getSpreadRateLowerConfidenceLimit(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
+{
+    // 95% confidence interval of a sampled spread rate
+    double lowerLimit = surfaceFire_.getSpreadRate() - 1.96 * surfaceFire_.getSpreadRateStandardError();
+    if (lowerLimit < 0.0)
+    {
+        lowerLimit = 0.0;
+    }
+    return SpeedUnits::fromBaseUnits(lowerLimit, spreadRateUnits);
+}
+
+double Surface::getSpreadRateUpperConfidenceLimit(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
+{
+    double upperLimit = surfaceFire_.getSpreadRate() + 1.96 * surfaceFire_.getSpreadRateStandardError();
+    return SpeedUnits::fromBaseUnits(upperLimit, spreadRateUnits);
+}
+
+long Surface::getSpreadRateSampleCount() const
+{
+    return surfaceFire_.getSpreadRateSampleCount();
+}
+
+double Surface::getBackingSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
 {
     return SpeedUnits::fromBaseUnits(size_.getBackingSpreadRate(SpeedUnits::FeetPerMinute), spreadRateUnits);
 }
 
-double Surface::getFlankingSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits)
+double Surface::getFlankingSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
 {
     return SpeedUnits::fromBaseUnits(size_.getFlankingSpreadRate(SpeedUnits::FeetPerMinute), spreadRateUnits);
 }
@@ -208,7 +406,7 @@ double Surface::getSpreadDistanceInDirectionOfInterest(LengthUnits::LengthUnitsE
     return LengthUnits::fromBaseUnits(spreadDistanceInBaseUnits, lengthUnits);
 }
 
-double Surface::getBackingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits)
+double Surface::getBackingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const
 {
     double elapsedTimeInBaseUnits = TimeUnits::toBaseUnits(elapsedTime, timeUnits);
     double spreadRateInBaseUnits = size_.getBackingSpreadRate(SpeedUnits::FeetPerMinute);
@@ -216,7 +414,7 @@ double Surface::getBackingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnit
     return LengthUnits::fromBaseUnits(spreadDistanceInBaseUnits, lengthUnits);
 }
 
-double Surface::getFlankingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits)
+double Surface::getFlankingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const
 {
     double elapsedTimeInBaseUnits = TimeUnits::toBaseUnits(elapsedTime, timeUnits);
     double spreadRateInBaseUnits = size_.getFlankingSpreadRate(SpeedUnits::FeetPerMinute);
@@ -491,6 +689,11 @@ bool Surface::isAllFuelLoadZero(int fuelModelNumber) const
     return fuelModels_->isAllFuelLoadZero(fuelModelNumber);
 }
 
+const SurfaceInputs& Surface::getSurfaceInputs() const
+{
+    return surfaceInputs_;
+}
+
 bool Surface::isUsingTwoFuelModels() const
 {
     return surfaceInputs_.isUsingTwoFuelModels();
@@ -609,6 +812,11 @@ MoistureInputMode::MoistureInputModeEnum Surface::getMoistureInputMode() const
     return surfaceInputs_.getMoistureInputMode();
 }
 
+bool Surface::getIsUsingMoistureScenarioMatrix() const
+{
+    return surfaceInputs_.getIsUsingMoistureScenarioMatrix();
+}
+
 int Surface::getNumberOfMoistureScenarios() const
 {
     return surfaceInputs_.getNumberOfMoistureScenarios();
@@ -972,6 +1180,11 @@ bool Surface::setCurrentMoistureScenarioByIndex(int moistureScenarioIndex)
     return surfaceInputs_.setCurrentMoistureScenarioByIndex(moistureScenarioIndex);
 }
 
+void Surface::setIsUsingMoistureScenarioMatrix(bool isUsingMoistureScenarioMatrix)
+{
+    surfaceInputs_.setIsUsingMoistureScenarioMatrix(isUsingMoistureScenarioMatrix);
+}
+
 void Surface::setMoistureInputMode(MoistureInputMode::MoistureInputModeEnum moistureInputMode)
 {
     surfaceInputs_.setMoistureInputMode(moistureInputMode);
@@ -1034,6 +1247,36 @@ void Surface::setTwoFuelModelsFirstFuelModelCoverage(double firstFuelModelCovera
     surfaceInputs_.setTwoFuelModelsFirstFuelModelCoverage(firstFuelModelCoverage, coverageUnits);
 }
 
+bool Surface::setTwoDimensionalBlockSize(int samples, int depth)
+{
+    return surfaceInputs_.setTwoDimensionalBlockSize(samples, depth);
+}
+
+void Surface::setTwoDimensionalSamplingTargetStandardError(double targetStandardError, SpeedUnits::SpeedUnitsEnum spreadRateUnits)
+{
+    surfaceInputs_.setTwoDimensionalSamplingTargetStandardError(targetStandardError, spreadRateUnits);
+}
+
+void Surface::setTwoDimensionalSamplingTimeBudget(double timeBudget, TimeUnits::TimeUnitsEnum timeUnits)
+{
+    surfaceInputs_.setTwoDimensionalSamplingTimeBudget(timeBudget, timeUnits);
+}
+
+void Surface::setTwoDimensionalSamplingMaxDraws(int maxDraws)
+{
+    surfaceInputs_.setTwoDimensionalSamplingMaxDraws(maxDraws);
+}
+
+void Surface::setTwoDimensionalSamplingThreads(int threads)
+{
+    surfaceInputs_.setTwoDimensionalSamplingThreads(threads);
+}
+
+void Surface::setTwoDimensionalSamplingSeed(unsigned long seed)
+{
+    surfaceInputs_.setTwoDimensionalSamplingSeed(seed);
+}
+
 void Surface::setWindAdjustmentFactorCalculationMethod(WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum windAdjustmentFactorCalculationMethod)
 {
     surfaceInputs_.setWindAdjustmentFactorCalculationMethod(windAdjustmentFactorCalculationMethod);
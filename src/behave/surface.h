@@ -33,10 +33,62 @@
 #define SURFACE_H
 
 // The SURFACE module of BehavePlus
+#include <cstddef>
 #include "behaveUnits.h"
 #include "fireSize.h"
 #include "surfaceFire.h"
 #include "surfaceInputs.h"
+#include "surfaceTwoFuelModels.h"
+
+// Columns of surface runs for the batch calculation, one element per run (a
+// landscape cell or a time step), all of length numberOfRuns. Columns left as
+// nullptr use the current surface input instead.
+struct SurfaceBatchInputs
+{
+    std::size_t numberOfRuns = 0;
+    const int* fuelModelNumber = nullptr;
+    const double* moistureOneHour = nullptr;
+    const double* windSpeed = nullptr;                  // at the current wind height input mode
+    const double* windDirection = nullptr;
+    const double* windAdjustmentFactor = nullptr;       // precomputed per cell, replaces the canopy based factor
+
+    FractionUnits::FractionUnitsEnum moistureUnits = FractionUnits::Percent;
+    SpeedUnits::SpeedUnitsEnum windSpeedUnits = SpeedUnits::MilesPerHour;
+};
+
+// Outputs of the last surface run in the units of a UnitSystem. Spread
+// distances and fire dimensions are those at the elapsed time input
+struct SurfaceResults
+{
+    double spreadRate;
+    double spreadRateInDirectionOfInterest;
+    double backingSpreadRate;
+    double flankingSpreadRate;
+    double directionOfMaxSpread;                // degrees
+    double flameLength;
+    double backingFlameLength;
+    double flankingFlameLength;
+    double firelineIntensity;
+    double backingFirelineIntensity;
+    double flankingFirelineIntensity;
+    double heatPerUnitArea;
+    double reactionIntensity;
+    double residenceTime;
+    double midflameWindSpeed;
+    double fireLengthToWidthRatio;
+    double fireEccentricity;
+    double headingToBackingRatio;
+    double spreadDistance;
+    double backingSpreadDistance;
+    double flankingSpreadDistance;
+    double ellipticalA;
+    double ellipticalB;
+    double ellipticalC;
+    double fireLength;
+    double maxFireWidth;
+    double firePerimeter;
+    double fireArea;
+};
 
 class Surface
 {
@@ -49,6 +101,25 @@ public:
     bool isAllFuelLoadZero(int fuelModelNumber);
     void doSurfaceRunInDirectionOfMaxSpread();
     void doSurfaceRunInDirectionOfInterest(double directionOfInterest, SurfaceFireSpreadDirectionMode::SurfaceFireSpreadDirectionModeEnum directionMode);
+    // Runs the current inputs in the direction of maximum spread once per one-hour
+    // moisture, such as those from FineDeadFuelMoistureTool::calculateForWeatherSeries(),
+    // writing each run's spread rate and flame length (-1 for a negative moisture).
+    // Repeated moistures are only run once. The one-hour moisture input is restored
+    // afterwards, the other outputs are those of the last run
+    void doSurfaceRunInDirectionOfMaxSpreadForOneHourMoistures(std::size_t numberOfRuns, const double* moistureOneHour,
+        FractionUnits::FractionUnitsEnum moistureUnits, double* spreadRate, SpeedUnits::SpeedUnitsEnum spreadRateUnits,
+        double* flameLength, LengthUnits::LengthUnitsEnum flameLengthUnits);
+    // Runs each row of the batch in the direction of maximum spread, writing its
+    // spread rate and flame length. The inputs replaced by columns are restored
+    // afterwards, the other outputs are those of the last run
+    void doSurfaceRunInDirectionOfMaxSpreadForBatch(const SurfaceBatchInputs& inputs, double* spreadRate,
+        SpeedUnits::SpeedUnitsEnum spreadRateUnits, double* flameLength, LengthUnits::LengthUnitsEnum flameLengthUnits);
+    // Wind adjustment factor of each cell by the current calculation method, to be
+    // calculated once per landscape and passed to the batch runs. Columns left as
+    // nullptr use the current input
+    void calculateWindAdjustmentFactorsForCells(std::size_t numberOfCells, const double* canopyCover,
+        FractionUnits::FractionUnitsEnum coverUnits, const double* canopyHeight, LengthUnits::LengthUnitsEnum canopyHeightUnits,
+        const double* crownRatio, const int* fuelModelNumber, double* windAdjustmentFactor) const;
 
     double calculateFlameLength(double firelineIntensity, FirelineIntensityUnits::FirelineIntensityUnitsEnum firelineIntensityUnits,
         LengthUnits::LengthUnitsEnum flameLengthUnits);
@@ -56,15 +127,22 @@ public:
     void setFuelModels(FuelModels& fuelModels);
     void initializeMembers();
 
+    // Every output of SurfaceResults in one call, instead of one getter per output
+    SurfaceResults getResults(const UnitSystem& unitSystem) const;
+
     // SurfaceFire getters
     double getSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
     double getSpreadRateInDirectionOfInterest(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
-    double getBackingSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits);
-    double getFlankingSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits);
+    double getSpreadRateStandardError(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
+    double getSpreadRateLowerConfidenceLimit(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
+    double getSpreadRateUpperConfidenceLimit(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
+    long getSpreadRateSampleCount() const;
+    double getBackingSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
+    double getFlankingSpreadRate(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
     double getSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const;
     double getSpreadDistanceInDirectionOfInterest(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const;
-    double getBackingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits);
-    double getFlankingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits);
+    double getBackingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const;
+    double getFlankingSpreadDistance(LengthUnits::LengthUnitsEnum lengthUnits, double elapsedTime, TimeUnits::TimeUnitsEnum timeUnits) const;
     double getDirectionOfMaxSpread() const;
     double getFlameLength(LengthUnits::LengthUnitsEnum flameLengthUnits) const;
     double getBackingFlameLength(LengthUnits::LengthUnitsEnum flameLengthUnits) const;
@@ -115,6 +193,9 @@ public:
     void setMoistureScenarios(MoistureScenarios& moistureScenarios);
     bool setCurrentMoistureScenarioByName(std::string moistureScenarioName);
     bool setCurrentMoistureScenarioByIndex(int moistureScenarioIndex);
+    // Standard fuel models run with a moisture scenario take their fuelbed
+    // intermediates from a matrix precomputed for every scenario and fuel model
+    void setIsUsingMoistureScenarioMatrix(bool isUsingMoistureScenarioMatrix);
     void setMoistureInputMode(MoistureInputMode::MoistureInputModeEnum moistureInputMode);
     void setSlope(double slope, SlopeUnits::SlopeUnitsEnum slopeUnits);
     void setAspect(double aspect);
@@ -127,6 +208,12 @@ public:
     void setSecondFuelModelNumber(int secondFuelModelNumber);
     void setTwoFuelModelsMethod(TwoFuelModelsMethod::TwoFuelModelsMethodEnum  twoFuelModelsMethod);
     void setTwoFuelModelsFirstFuelModelCoverage(double firstFuelModelCoverage, FractionUnits::FractionUnitsEnum coverageUnits);
+    bool setTwoDimensionalBlockSize(int samples, int depth);
+    void setTwoDimensionalSamplingTargetStandardError(double targetStandardError, SpeedUnits::SpeedUnitsEnum spreadRateUnits);
+    void setTwoDimensionalSamplingTimeBudget(double timeBudget, TimeUnits::TimeUnitsEnum timeUnits);
+    void setTwoDimensionalSamplingMaxDraws(int maxDraws);
+    void setTwoDimensionalSamplingThreads(int threads);
+    void setTwoDimensionalSamplingSeed(unsigned long seed);
     void setWindAdjustmentFactorCalculationMethod(WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum windAdjustmentFactorCalculationMethod);
     void updateSurfaceInputs(int fuelModelNumber, double moistureOneHour, double moistureTenHour, double moistureHundredHour,
         double moistureLiveHerbaceous, double moistureLiveWoody, FractionUnits::FractionUnitsEnum moistureUnits, double windSpeed, SpeedUnits::SpeedUnitsEnum windSpeedUnits,
@@ -198,6 +285,7 @@ public:
     bool isAllFuelLoadZero(int fuelModelNumber) const;
 
     // SurfaceInputs getters
+    const SurfaceInputs& getSurfaceInputs() const;
     bool isUsingTwoFuelModels() const;
     double getElapsedTime(TimeUnits::TimeUnitsEnum timeUnits) const;
     int getFuelModelNumber() const;
@@ -210,6 +298,7 @@ public:
     double getMoistureLiveAggregateValue(FractionUnits::FractionUnitsEnum moistureUnits) const;
     bool isMoistureClassInputNeededForCurrentFuelModel(MoistureClassInput::MoistureClassInputEnum moistureClass) const;
     MoistureInputMode::MoistureInputModeEnum getMoistureInputMode() const;
+    bool getIsUsingMoistureScenarioMatrix() const;
     int getNumberOfMoistureScenarios() const;
     int getMoistureScenarioIndexByName(std::string name) const;
     bool getIsMoistureScenarioDefinedByName(std::string name) const;
@@ -307,6 +396,7 @@ protected:
     // Surface Module components
     SurfaceInputs surfaceInputs_;
     SurfaceFire surfaceFire_;
+    SurfaceTwoFuelModels surfaceTwoFuelModels_; // kept so its RandFuel workspace is reused across runs
 
     // Size Module
     FireSize size_;
@@ -32,6 +32,7 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+#include "behaveInstrumentation.h"
 #include "surfaceFire.h"
 #include "surfaceFuelbedIntermediates.h"
 #include "surfaceInputs.h"
@@ -99,6 +100,9 @@ void SurfaceFire::initializeMembers()
     windAdjustmentFactorShelterMethod_ = WindAdjustmentFactorShelterMethod::Unsheltered;
     canopyCrownFraction_ = 0.0;
 
+    spreadRateStandardError_ = 0.0;
+    spreadRateSampleCount_ = 0;
+
     surfaceFuelbedIntermediates_ = SurfaceFuelbedIntermediates(*fuelModels_, *surfaceInputs_);
     surfaceFireReactionIntensity_ = SurfaceFireReactionIntensity(surfaceFuelbedIntermediates_);
 }
@@ -135,6 +139,9 @@ void SurfaceFire::memberwiseCopyAssignment(const SurfaceFire& rhs)
     windAdjustmentFactor_ = rhs.windAdjustmentFactor_;
     windAdjustmentFactorShelterMethod_ = rhs.windAdjustmentFactorShelterMethod_;
     canopyCrownFraction_ = rhs.canopyCrownFraction_;
+
+    spreadRateStandardError_ = rhs.spreadRateStandardError_;
+    spreadRateSampleCount_ = rhs.spreadRateSampleCount_;
 }
 
 double SurfaceFire::calculateNoWindNoSlopeSpreadRate(double reactionIntensity, double propagatingFlux, double heatSink)
@@ -173,6 +180,7 @@ void SurfaceFire::calculateFlankingFireFirelineIntensity(double flankingSpreadRa
 
 void SurfaceFire::skipCalculationForZeroLoad()
 {
+    BEHAVE_INSTRUMENT_EVENT(ZeroLoadSkipped);
     initializeMembers();
 }
 
@@ -216,6 +224,7 @@ double SurfaceFire::calculateForwardSpreadRate(int fuelModelNumber, bool hasDire
 {
     // Reset member variables to prepare for next calculation
     initializeMembers();
+    BEHAVE_INSTRUMENT_SEQUENCE(stages);
 
     // Calculate fuelbed intermediates
     surfaceFuelbedIntermediates_.calculateFuelbedIntermediates(fuelModelNumber);
@@ -223,7 +232,9 @@ double SurfaceFire::calculateForwardSpreadRate(int fuelModelNumber, bool hasDire
     // Get needed fuelbed intermediates
     double propagatingFlux = surfaceFuelbedIntermediates_.getPropagatingFlux();
     double heatSink = surfaceFuelbedIntermediates_.getHeatSink();
+    BEHAVE_INSTRUMENT_SEQUENCE_FINISH(stages, SurfaceFuelbedIntermediates);
     reactionIntensity_ = surfaceFireReactionIntensity_.calculateReactionIntensity();
+    BEHAVE_INSTRUMENT_SEQUENCE_FINISH(stages, SurfaceReactionIntensity);
 
     // Calculate Wind and Slope Factors
     calculateMidflameWindSpeed();
@@ -250,6 +261,7 @@ double SurfaceFire::calculateForwardSpreadRate(int fuelModelNumber, bool hasDire
 
     effectiveWindSpeed_ = SpeedUnits::fromBaseUnits(effectiveWindSpeed_, SpeedUnits::FeetPerMinute);
     calculateResidenceTime();
+    BEHAVE_INSTRUMENT_SEQUENCE_FINISH(stages, SurfaceWindAndSlopeFactors);
 
     // Calculate fire ellipse and related properties
     size_->calculateFireBasicDimensions(false, effectiveWindSpeed_, SpeedUnits::FeetPerMinute, forwardSpreadRate_, SpeedUnits::FeetPerMinute);
@@ -258,6 +270,7 @@ double SurfaceFire::calculateForwardSpreadRate(int fuelModelNumber, bool hasDire
 
     backingSpreadRate_ = size_->getBackingSpreadRate(SpeedUnits::FeetPerMinute);
     flankingSpreadRate_ = size_->getFlankingSpreadRate(SpeedUnits::FeetPerMinute);
+    BEHAVE_INSTRUMENT_SEQUENCE_FINISH(stages, SurfaceEllipse);
 
     calculateHeatPerUnitArea();
     calculateFirelineIntensity(forwardSpreadRate_);
@@ -267,6 +280,7 @@ double SurfaceFire::calculateForwardSpreadRate(int fuelModelNumber, bool hasDire
     calculateFlameLength();
     calculateBackingFlameLength();
     calculateFlankingFlameLength();
+    BEHAVE_INSTRUMENT_SEQUENCE_FINISH(stages, SurfaceFlameAndIntensity);
 
     bool isUsingWesternAspen = surfaceInputs_->getIsUsingWesternAspen();
     if (isUsingWesternAspen)
@@ -348,6 +362,7 @@ double SurfaceFire::calculateSpreadRateAtVector(double directionOfInterest, Surf
 
 void SurfaceFire::applyWindSpeedLimit()
 {
+    BEHAVE_INSTRUMENT_EVENT(WindSpeedLimitApplied);
     isWindLimitExceeded_ = true;
     effectiveWindSpeed_ = windSpeedLimit_;
 
@@ -462,8 +477,6 @@ void SurfaceFire::calculateWindFactor()
 
 void SurfaceFire::calculateWindAdjustmentFactor()
 {
-    WindAjustmentFactor windAdjustmentFactor;
-
     double canopyCover = surfaceInputs_->getCanopyCover(FractionUnits::Fraction);
     double canopyHeight = surfaceInputs_->getCanopyHeight(LengthUnits::Feet);
     double crownRatio = surfaceInputs_->getCrownRatio();
@@ -471,15 +484,8 @@ void SurfaceFire::calculateWindAdjustmentFactor()
 
     WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum windAdjustmentFactorCalculationMethod =
         surfaceInputs_->getWindAdjustmentFactorCalculationMethod();
-    if(windAdjustmentFactorCalculationMethod == WindAdjustmentFactorCalculationMethod::UseCrownRatio)
-    {
-        windAdjustmentFactor_ = windAdjustmentFactor.calculateWindAdjustmentFactorWithCrownRatio(canopyCover, canopyHeight, crownRatio, fuelbedDepth);
-    }
-    else if(windAdjustmentFactorCalculationMethod == WindAdjustmentFactorCalculationMethod::DontUseCrownRatio)
-    {
-        windAdjustmentFactor_ = windAdjustmentFactor.calculateWindAdjustmentFactorWithoutCrownRatio(canopyCover, canopyHeight, fuelbedDepth);
-    }
-    windAdjustmentFactorShelterMethod_ = windAdjustmentFactor.getWindAdjustmentFactorShelterMethod();
+    windAdjustmentFactor_ = windAdjustmentFactorTable_.getWindAdjustmentFactor(windAdjustmentFactorCalculationMethod,
+        canopyCover, canopyHeight, crownRatio, fuelbedDepth, windAdjustmentFactorShelterMethod_);
 }
 
 void SurfaceFire::calculateMidflameWindSpeed()
@@ -690,6 +696,16 @@ double SurfaceFire::getPackingRatio() const {
   return surfaceFuelbedIntermediates_.getPackingRatio();
 }
 
+double SurfaceFire::getSpreadRateStandardError() const
+{
+    return spreadRateStandardError_;
+}
+
+long SurfaceFire::getSpreadRateSampleCount() const
+{
+    return spreadRateSampleCount_;
+}
+
 double SurfaceFire::getPalmettoGallberryMoistureOfExtinctionDead() const
 {
     return surfaceFuelbedIntermediates_.getPalmettoGallberryMoistureOfExtinctionDead();
@@ -949,3 +965,9 @@ void SurfaceFire::setMidflameWindSpeed(double midflameWindSpeed)
 {
     midflameWindSpeed_ = midflameWindSpeed;
 }
+
+void SurfaceFire::setSpreadRateStandardError(double spreadRateStandardError, long spreadRateSampleCount)
+{
+    spreadRateStandardError_ = spreadRateStandardError;
+    spreadRateSampleCount_ = spreadRateSampleCount;
+}
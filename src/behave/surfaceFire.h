@@ -35,6 +35,7 @@
 #include "fireSize.h"
 #include "surfaceFireReactionIntensity.h"
 #include "surfaceFuelbedIntermediates.h"
+#include "windAdjustmentFactor.h"
 
 class SurfaceFire
 {
@@ -85,6 +86,8 @@ public:
     bool getIsWindLimitExceeded() const;
     double getRelativePackingRatio() const;
     double getPackingRatio()const;
+    double getSpreadRateStandardError() const;
+    long getSpreadRateSampleCount() const;
 
     // Palmetto-Gallberry getters
     double getPalmettoGallberryMoistureOfExtinctionDead() const;
@@ -147,6 +150,7 @@ protected:
     void setIsWindLimitExceeded(bool isWindLimitExceeded);
     void setWindAdjustmentFactor(double windAdjustmentFactor);
     void setMidflameWindSpeed(double midflameWindSpeed);
+    void setSpreadRateStandardError(double spreadRateStandardError, long spreadRateSampleCount);
 
 protected:
     void memberwiseCopyAssignment(const SurfaceFire& rhs);
@@ -212,6 +216,10 @@ protected:
     double windAdjustmentFactor_;
     WindAdjustmentFactorShelterMethod::WindAdjustmentFactorShelterMethodEnum windAdjustmentFactorShelterMethod_;
     double canopyCrownFraction_;
+    WindAdjustmentFactorTable windAdjustmentFactorTable_;  // Memo of factors by canopy geometry, not copied
+
+    double spreadRateStandardError_;                        // Standard error of a sampled spread rate (ft/min), 0 if not sampled
+    long spreadRateSampleCount_;                            // Number of fuel arrangements drawn for a sampled spread rate
 };
 
 #endif // SURFACEFIRE_H
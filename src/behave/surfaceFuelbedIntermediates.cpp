@@ -33,6 +33,7 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include "fuelModels.h"
+#include "moistureScenarioFuelbedMatrix.h"
 #include "surfaceInputs.h"
 
 SurfaceFuelbedIntermediates::SurfaceFuelbedIntermediates()
@@ -141,6 +142,11 @@ void SurfaceFuelbedIntermediates::calculateFuelbedIntermediates(int fuelModelNum
 
     fuelModelNumber_ = fuelModelNumber;
 
+    if (loadFromMoistureScenarioMatrix())
+    {
+        return;
+    }
+
     setFuelbedDepth();
 
     setFuelLoad();
@@ -189,6 +195,32 @@ void SurfaceFuelbedIntermediates::calculateFuelbedIntermediates(int fuelModelNum
     calculatePropagatingFlux();
 }
 
+bool SurfaceFuelbedIntermediates::loadFromMoistureScenarioMatrix()
+{
+    // Only standard fuel models driven by a moisture scenario are in the matrix
+    if (!surfaceInputs_->getIsUsingMoistureScenarioMatrix()
+        || surfaceInputs_->getMoistureInputMode() != MoistureInputMode::MoistureScenario
+        || surfaceInputs_->getIsUsingPalmettoGallberry() || surfaceInputs_->getIsUsingWesternAspen()
+        || surfaceInputs_->getIsUsingChaparral())
+    {
+        return false;
+    }
+    const MoistureScenarioFuelbedMatrix& matrix = MoistureScenarioFuelbedMatrix::getSharedMatrix();
+    const MoistureScenarioFuelbedEntry* entry = matrix.getEntry(surfaceInputs_->getCurrentMoistureScenarioIndex(), fuelModelNumber_);
+    // The scenario list given to the inputs may differ from the standard one
+    if (entry == nullptr
+        || entry->moistures[MoistureClassInput::OneHour] != surfaceInputs_->getMoistureOneHour(FractionUnits::Fraction)
+        || entry->moistures[MoistureClassInput::TenHour] != surfaceInputs_->getMoistureTenHour(FractionUnits::Fraction)
+        || entry->moistures[MoistureClassInput::HundredHour] != surfaceInputs_->getMoistureHundredHour(FractionUnits::Fraction)
+        || entry->moistures[MoistureClassInput::LiveHerbaceous] != surfaceInputs_->getMoistureLiveHerbaceous(FractionUnits::Fraction)
+        || entry->moistures[MoistureClassInput::LiveWoody] != surfaceInputs_->getMoistureLiveWoody(FractionUnits::Fraction))
+    {
+        return false;
+    }
+    matrix.loadEntry(*entry, *this);
+    return true;
+}
+
 void SurfaceFuelbedIntermediates::setFuelLoad()
 {
     if (surfaceInputs_->getIsUsingPalmettoGallberry())
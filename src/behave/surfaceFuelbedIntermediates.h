@@ -39,6 +39,9 @@
 
 class SurfaceFuelbedIntermediates
 {
+    // The moisture scenario matrix saves and restores calculated intermediates
+    friend class MoistureScenarioFuelbedMatrix;
+
 public:
     SurfaceFuelbedIntermediates();
     SurfaceFuelbedIntermediates(const SurfaceFuelbedIntermediates& rhs);
@@ -112,6 +115,7 @@ public:
 
 protected:
     void initializeMembers();
+    bool loadFromMoistureScenarioMatrix();
     void memberwiseCopyAssignment(const SurfaceFuelbedIntermediates& rhs);
     void setFuelLoad();
     void setMoistureContent();
@@ -100,7 +100,8 @@ struct TwoFuelModelsMethod
         NoMethod = 0,          // Don't use TwoFuel Models method
         Arithmetic = 1,        // Use arithmetic mean
         Harmonic = 2,          // Use harmoic mean
-        TwoDimensional = 3     // Use Finney's two dimensional method
+        TwoDimensional = 3,    // Use Finney's two dimensional method
+        TwoDimensionalSampled = 4 // Use Monte Carlo sampling of Finney's two dimensional method
     };
 };
 
@@ -28,6 +28,7 @@
 
 #include "surfaceInputs.h"
 
+#include <climits>
 #include <cmath>
 
 // Default Ctor
@@ -78,6 +79,13 @@ void SurfaceInputs::initializeMembers()
     surfaceFireSpreadDirectionMode_ = SurfaceFireSpreadDirectionMode::FromIgnitionPoint;
 
     firstFuelModelCoverage_ = 0.0;
+    twoDimensionalSamples_ = 2; // from behavePlus.xml
+    twoDimensionalDepth_ = 2; // from behavePlus.xml
+    twoDimensionalTargetStandardError_ = 0.0;
+    twoDimensionalTimeBudget_ = 0.0;
+    twoDimensionalMaxDraws_ = 10000;
+    twoDimensionalThreads_ = 1;
+    twoDimensionalSeed_ = 1;
 
     ageOfRough_ = 0.0;
     heightOfUnderstory_ = 0.0;
@@ -100,6 +108,7 @@ void SurfaceInputs::initializeMembers()
     moistureScenarios_ = nullptr;
     currentMoistureScenarioName_ = "";
     currentMoistureScenarioIndex_ = -1;
+    isUsingMoistureScenarioMatrix_ = false;
     moistureValuesBySizeClass_ = {-1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0};
 }
 
@@ -314,13 +323,13 @@ bool SurfaceInputs::setCurrentMoistureScenarioByName(std::string moistureScenari
     bool isMoistureScenarioDefined = false;
     if (moistureScenarios_ != nullptr)
     {
-        isMoistureScenarioDefined = moistureScenarios_->getIsMoistureScenarioDefinedByName(moistureScenarioName);
-        moistureScenarios_->getIsMoistureScenarioDefinedByName(moistureScenarioName);
+        int moistureScenarioIndex = moistureScenarios_->getMoistureScenarioIndexByName(moistureScenarioName);
+        isMoistureScenarioDefined = (moistureScenarioIndex >= 0);
         currentMoistureScenarioName_ = "";
         if (isMoistureScenarioDefined)
         {
             currentMoistureScenarioName_ = moistureScenarioName;
-            currentMoistureScenarioIndex_ = moistureScenarios_->getMoistureScenarioIndexByName(moistureScenarioName);
+            currentMoistureScenarioIndex_ = moistureScenarioIndex;
             updateMoisturesBasedOnInputMode();
         }
     }
@@ -344,6 +353,11 @@ bool SurfaceInputs::setCurrentMoistureScenarioByIndex(int moistureScenarioIndex)
     return isMoistureScenarioDefined;
 }
 
+void SurfaceInputs::setIsUsingMoistureScenarioMatrix(bool isUsingMoistureScenarioMatrix)
+{
+    isUsingMoistureScenarioMatrix_ = isUsingMoistureScenarioMatrix;
+}
+
 void SurfaceInputs::setMoistureInputMode(MoistureInputMode::MoistureInputModeEnum moistureInputMode)
 {
     moistureInputMode_ = moistureInputMode;
@@ -370,6 +384,52 @@ void SurfaceInputs::setTwoFuelModelsFirstFuelModelCoverage(double firstFuelModel
     firstFuelModelCoverage_ = FractionUnits::toBaseUnits(firstFuelModelCoverage, fractionUnits);
 }
 
+bool SurfaceInputs::setTwoDimensionalBlockSize(int samples, int depth)
+{
+    // RandFuel calculates 1 to 50 samples and at least one row
+    samples = (samples < 1) ? 1 : ((samples > 50) ? 50 : samples);
+    depth = (depth < 1) ? 1 : depth;
+    // Two fuel models make 2^(samples * depth) sample blocks, which RandFuel
+    // counts in a long, so larger blocks keep the previous size
+    long blockCount = 1;
+    for (long long cell = 0; cell < (long long)samples * depth; cell++)
+    {
+        if (blockCount > LONG_MAX / 2)
+        {
+            return false;
+        }
+        blockCount *= 2;
+    }
+    twoDimensionalSamples_ = samples;
+    twoDimensionalDepth_ = depth;
+    return true;
+}
+
+void SurfaceInputs::setTwoDimensionalSamplingTargetStandardError(double targetStandardError, SpeedUnits::SpeedUnitsEnum spreadRateUnits)
+{
+    twoDimensionalTargetStandardError_ = SpeedUnits::toBaseUnits(targetStandardError, spreadRateUnits);
+}
+
+void SurfaceInputs::setTwoDimensionalSamplingTimeBudget(double timeBudget, TimeUnits::TimeUnitsEnum timeUnits)
+{
+    twoDimensionalTimeBudget_ = TimeUnits::toBaseUnits(timeBudget, timeUnits);
+}
+
+void SurfaceInputs::setTwoDimensionalSamplingMaxDraws(int maxDraws)
+{
+    twoDimensionalMaxDraws_ = maxDraws;
+}
+
+void SurfaceInputs::setTwoDimensionalSamplingThreads(int threads)
+{
+    twoDimensionalThreads_ = (threads < 1) ? 1 : threads;
+}
+
+void SurfaceInputs::setTwoDimensionalSamplingSeed(unsigned long seed)
+{
+    twoDimensionalSeed_ = seed;
+}
+
 void  SurfaceInputs::setWindSpeed(double windSpeed, SpeedUnits::SpeedUnitsEnum windSpeedUnits, WindHeightInputMode::WindHeightInputModeEnum windHeightInputMode)
 {
     windHeightInputMode_ = windHeightInputMode;
@@ -421,6 +481,41 @@ double SurfaceInputs::getFirstFuelModelCoverage() const
     return firstFuelModelCoverage_;
 }
 
+int SurfaceInputs::getTwoDimensionalSamples() const
+{
+    return twoDimensionalSamples_;
+}
+
+int SurfaceInputs::getTwoDimensionalDepth() const
+{
+    return twoDimensionalDepth_;
+}
+
+double SurfaceInputs::getTwoDimensionalSamplingTargetStandardError(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const
+{
+    return SpeedUnits::fromBaseUnits(twoDimensionalTargetStandardError_, spreadRateUnits);
+}
+
+double SurfaceInputs::getTwoDimensionalSamplingTimeBudget(TimeUnits::TimeUnitsEnum timeUnits) const
+{
+    return TimeUnits::fromBaseUnits(twoDimensionalTimeBudget_, timeUnits);
+}
+
+int SurfaceInputs::getTwoDimensionalSamplingMaxDraws() const
+{
+    return twoDimensionalMaxDraws_;
+}
+
+int SurfaceInputs::getTwoDimensionalSamplingThreads() const
+{
+    return twoDimensionalThreads_;
+}
+
+unsigned long SurfaceInputs::getTwoDimensionalSamplingSeed() const
+{
+    return twoDimensionalSeed_;
+}
+
 TwoFuelModelsMethod::TwoFuelModelsMethodEnum SurfaceInputs::getTwoFuelModelsMethod() const
 {
     return twoFuelModelsMethod_;
@@ -670,6 +765,13 @@ void SurfaceInputs::memberwiseCopyAssignment(const SurfaceInputs & rhs)
     isUsingTwoFuelModels_ = rhs.isUsingTwoFuelModels_;
     secondFuelModelNumber_ = rhs.secondFuelModelNumber_;
     firstFuelModelCoverage_ = rhs.firstFuelModelCoverage_;
+    twoDimensionalSamples_ = rhs.twoDimensionalSamples_;
+    twoDimensionalDepth_ = rhs.twoDimensionalDepth_;
+    twoDimensionalTargetStandardError_ = rhs.twoDimensionalTargetStandardError_;
+    twoDimensionalTimeBudget_ = rhs.twoDimensionalTimeBudget_;
+    twoDimensionalMaxDraws_ = rhs.twoDimensionalMaxDraws_;
+    twoDimensionalThreads_ = rhs.twoDimensionalThreads_;
+    twoDimensionalSeed_ = rhs.twoDimensionalSeed_;
 
     isUsingPalmettoGallberry_ = rhs.isUsingPalmettoGallberry_;
     ageOfRough_ = rhs.ageOfRough_;
@@ -701,6 +803,7 @@ void SurfaceInputs::memberwiseCopyAssignment(const SurfaceInputs & rhs)
     moistureScenarios_ = rhs.moistureScenarios_;
     currentMoistureScenarioName_ = rhs.currentMoistureScenarioName_;
     currentMoistureScenarioIndex_ = rhs.currentMoistureScenarioIndex_;
+    isUsingMoistureScenarioMatrix_ = rhs.isUsingMoistureScenarioMatrix_;
     moistureValuesBySizeClass_ = rhs.moistureValuesBySizeClass_;
 }
 
@@ -868,6 +971,11 @@ int SurfaceInputs::getCurrentMoistureScenarioIndex() const
     return currentMoistureScenarioIndex_;
 }
 
+bool SurfaceInputs::getIsUsingMoistureScenarioMatrix() const
+{
+    return isUsingMoistureScenarioMatrix_;
+}
+
 int SurfaceInputs::getNumberOfMoistureScenarios() const
 {
     int numberOfMoistureScenarios = -1;
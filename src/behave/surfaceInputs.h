@@ -60,6 +60,7 @@ public:
     void setMoistureScenarios(MoistureScenarios& moistureScenarios);
     bool setCurrentMoistureScenarioByName(std::string moistureScenarioName);
     bool setCurrentMoistureScenarioByIndex(int moistureScenarioIndex);
+    void setIsUsingMoistureScenarioMatrix(bool isUsingMoistureScenarioMatrix);
     void setMoistureInputMode(MoistureInputMode::MoistureInputModeEnum moistureInputMode);
     void setSlope(double slope, SlopeUnits::SlopeUnitsEnum slopeUnits);
     void setAspect(double aspect);
@@ -104,6 +105,7 @@ public:
     MoistureInputMode::MoistureInputModeEnum getMoistureInputMode() const;
     std::string getCurrentMoistureScenarioName() const;
     int getCurrentMoistureScenarioIndex() const;
+    bool getIsUsingMoistureScenarioMatrix() const;
     int getNumberOfMoistureScenarios() const;
     int getMoistureScenarioIndexByName(std::string name) const;
     bool getIsMoistureScenarioDefinedByName(std::string name) const;
@@ -135,6 +137,12 @@ public:
     void setSecondFuelModelNumber(int secondFuelModelNumber);
     void setTwoFuelModelsMethod(TwoFuelModelsMethod::TwoFuelModelsMethodEnum twoFuelModelsMethod);
     void setTwoFuelModelsFirstFuelModelCoverage(double firstFuelModelCoverage, FractionUnits::FractionUnitsEnum fractionUnits);
+    bool setTwoDimensionalBlockSize(int samples, int depth);
+    void setTwoDimensionalSamplingTargetStandardError(double targetStandardError, SpeedUnits::SpeedUnitsEnum spreadRateUnits);
+    void setTwoDimensionalSamplingTimeBudget(double timeBudget, TimeUnits::TimeUnitsEnum timeUnits);
+    void setTwoDimensionalSamplingMaxDraws(int maxDraws);
+    void setTwoDimensionalSamplingThreads(int threads);
+    void setTwoDimensionalSamplingSeed(unsigned long seed);
 
     // Two fuel models inputs getters
     bool isUsingTwoFuelModels() const;
@@ -142,6 +150,13 @@ public:
     int getFirstFuelModelNumber() const;
     int getSecondFuelModelNumber() const;
     double getFirstFuelModelCoverage() const;
+    int getTwoDimensionalSamples() const;
+    int getTwoDimensionalDepth() const;
+    double getTwoDimensionalSamplingTargetStandardError(SpeedUnits::SpeedUnitsEnum spreadRateUnits) const;
+    double getTwoDimensionalSamplingTimeBudget(TimeUnits::TimeUnitsEnum timeUnits) const;
+    int getTwoDimensionalSamplingMaxDraws() const;
+    int getTwoDimensionalSamplingThreads() const;
+    unsigned long getTwoDimensionalSamplingSeed() const;
 
     // Palmetto-Gallberry inputs setters
     void updateSurfaceInputsForPalmettoGallbery(double moistureOneHour, double moistureTenHour, double moistureHundredHour,
@@ -205,7 +220,7 @@ protected:
     void memberwiseCopyAssignment(const SurfaceInputs& rhs);
    
     bool isCalculatingScorchHeight_;    // Switch to determine whether scorch height is calculated (requires air temperature to be set)
-    int fuelModelNumber_;               // 1 to 256
+    int fuelModelNumber_;               // Standard 1 to 256, or any custom number
 
     // Weather/Terrain inputs
     double airTemperature_;             // air temperature, degrees Fahrenheit
@@ -226,12 +241,20 @@ protected:
     std::string currentMoistureScenarioName_;  // Currently used moisture scenario name
     int currentMoistureScenarioIndex_;         // Currently used moisture scenario vector index
     std::vector<double> moistureValuesBySizeClass_; // Stores moisture values which will be used during surface and crown runs
+    bool isUsingMoistureScenarioMatrix_;       // Whether standard fuel models use the precomputed scenario x fuel model fuelbed matrix
     MoistureScenarios* moistureScenarios_; // Moisture scenarios (optional list of moisture scenarios to simplify user input 
 
     // Two Fuel Models inputs
     bool isUsingTwoFuelModels_;         // Whether fire spread calculation is using Two Fuel Models
-    int secondFuelModelNumber_;         // 1 to 256, second fuel used in Two Fuel Models
+    int secondFuelModelNumber_;         // Standard 1 to 256 or custom, second fuel used in Two Fuel Models
     double firstFuelModelCoverage_;     // percent of landscape occupied by first fuel in Two Fuel Models
+    int twoDimensionalSamples_;         // columns in the two dimensional method's sample block
+    int twoDimensionalDepth_;           // rows in the two dimensional method's sample block
+    double twoDimensionalTargetStandardError_; // sampling stops at this standard error, ft/min (0 = unused)
+    double twoDimensionalTimeBudget_;   // sampling stops after this much time, minutes (0 = unused)
+    int twoDimensionalMaxDraws_;        // sampling stops after this many blocks (0 = unused)
+    int twoDimensionalThreads_;         // threads drawing blocks in parallel
+    unsigned long twoDimensionalSeed_;  // seed for the sampling random number streams
 
     // Palmetto-Gallberry inputs
     bool isUsingPalmettoGallberry_;
@@ -35,8 +35,10 @@
 #include "newext.h"
 #include "randfuel.h"
 #include "randthread.h"
+#include "randworkspace.h"
 #include "surfaceFire.h"
 #include "surfaceFuelbedIntermediates.h"
+#include "twoFuelModelsSpreadRateCache.h"
 
 SurfaceTwoFuelModels::SurfaceTwoFuelModels(SurfaceFire& surfaceFireSpread)
 {
@@ -108,6 +110,16 @@ double SurfaceTwoFuelModels::getFireLengthToWidthRatio() const
     return fireLengthToWidthRatio_;
 }
 
+double SurfaceTwoFuelModels::getSpreadRateStandardError() const
+{
+    return spreadRateStandardError_;
+}
+
+long SurfaceTwoFuelModels::getSpreadRateSampleCount() const
+{
+    return spreadRateSampleCount_;
+}
+
 void SurfaceTwoFuelModels::calculateWeightedSpreadRate(TwoFuelModelsMethod::TwoFuelModelsMethodEnum twoFuelModelsMethod,
     int firstFuelModelNumber, double firstFuelModelCoverage, int secondFuelModelNumber,
     bool hasDirectionOfInterest, double directionOfInterest, SurfaceFireSpreadDirectionMode::SurfaceFireSpreadDirectionModeEnum directionMode)
@@ -126,6 +138,8 @@ void SurfaceTwoFuelModels::calculateWeightedSpreadRate(TwoFuelModelsMethod::TwoF
     //------------------------------------------------
     // Fire spread rate depends upon the weighting method...
     twoFuelModelsMethod_ = twoFuelModelsMethod;
+    spreadRateStandardError_ = 0.0;
+    spreadRateSampleCount_ = 0;
     calculateSpreadRateBasedOnMethod();
 
     // The following assignments are based on Pat's rules:
@@ -228,6 +242,7 @@ void SurfaceTwoFuelModels::calculateWeightedSpreadRate(TwoFuelModelsMethod::TwoF
             fuelbedDepthForFuelModel_[TwoFuelModelsContants::First] : fuelbedDepthForFuelModel_[TwoFuelModelsContants::Second];
     }
     surfaceFireSpread_->forwardSpreadRate_ = spreadRate_;
+    surfaceFireSpread_->setSpreadRateStandardError(spreadRateStandardError_, spreadRateSampleCount_);
 }
 
 double SurfaceTwoFuelModels::surfaceFireExpectedSpreadRate(double* ros, double* cov, int fuels,
@@ -236,12 +251,42 @@ double SurfaceTwoFuelModels::surfaceFireExpectedSpreadRate(double* ros, double*
     // Initialize results
     double expectedRos = 0.0;
 
+    // Two fuel models only depend on their relative spread rates, so
+    // recurring combinations come from the shared cache
+    if (fuels == TwoFuelModelsContants::NumberOfModels)
+    {
+        double totalCov = cov[0] + cov[1];
+        double maximumRos = (ros[0] > ros[1]) ? ros[0] : ros[1];
+        if (totalCov <= 0.0)
+        {
+            return(expectedRos);
+        }
+        if (maximumRos > 0.0)
+        {
+            cov[0] = cov[0] / totalCov;
+            cov[1] = cov[1] / totalCov;
+            TwoFuelModelsSpreadRateCache& cache = TwoFuelModelsSpreadRateCache::getSharedCache();
+            TwoFuelModelsSpreadRateKey key = cache.makeKey(ros[0] / maximumRos, ros[1] / maximumRos,
+                cov[0], cov[1], lbRatio, samples, depth, laterals);
+            double relativeRos = cache.getRelativeSpreadRate(key, &randWorkspace_);
+            if (relativeRos > 0.0)
+            {
+                expectedRos = relativeRos * maximumRos;
+            }
+            return(expectedRos);
+        }
+    }
+
     // Create a RandFuel instance
     RandFuel randFuel;
+    randFuel.setWorkspace(&randWorkspace_);
 
     // Mark says the cell size is irrelevant, but he sets it anyway.
     randFuel.setCellDimensions(10);
 
+    // recomputeSpread() is never used, so don't keep a spread rate per block
+    randFuel.setRetainBlockSpreadRates(false);
+
     // Get total fuel coverage
     double totalCov = 0.0;
     int i;
@@ -266,7 +311,7 @@ double SurfaceTwoFuelModels::surfaceFireExpectedSpreadRate(double* ros, double*
         randFuel.setFuelData(i, ros[i], cov[i]);
     }
     
-    double maximumRos;
+    double maximumRos = 0.0;
     double* harmonicRos;    // only exists to match computeSpread2's method signature
     harmonicRos = 0;        // point harmonicRos to null
     // Compute the expected rate
@@ -281,12 +326,87 @@ double SurfaceTwoFuelModels::surfaceFireExpectedSpreadRate(double* ros, double*
         0);                 // less ignitions
     randFuel.freeFuels();
 
-    // Determine expected spread rates.
+    // Determine expected spread rates, computeSpread2() returns 0 or -1
+    // without a maximum spread rate for block sizes it cannot calculate
+    if (expectedRos <= 0.0)
+    {
+        return(0.0);
+    }
     expectedRos *= maximumRos;
 
     return(expectedRos);
 }
 
+double SurfaceTwoFuelModels::surfaceFireSampledSpreadRate(double* ros, double* cov, int fuels,
+    double lbRatio, int samples, int depth)
+{
+    // Monte Carlo counterpart of surfaceFireExpectedSpreadRate(), stopping
+    // rules come from the sampling inputs
+    const SurfaceInputs& surfaceInputs = *surfaceFireSpread_->surfaceInputs_;
+    double expectedRos = 0.0;
+    RandFuel randFuel;
+    randFuel.setWorkspace(&randWorkspace_);
+    randFuel.setCellDimensions(10);
+
+    double totalCov = 0.0;
+    int i;
+    for (i = 0; i < fuels; i++)
+    {
+        totalCov += cov[i];
+    }
+    if (totalCov <= 0.0)
+    {
+        return(expectedRos);
+    }
+    if (!randFuel.allocFuels(fuels))
+    {
+        return(expectedRos);
+    }
+    for (i = 0; i < fuels; i++)
+    {
+        cov[i] = cov[i] / totalCov;
+        randFuel.setFuelData(i, ros[i], cov[i]);
+    }
+
+    // The target standard error is given in ft/min, RandFuel works in
+    // spread rates relative to the fastest fuel
+    double maximumRos = 0.0;
+    for (i = 0; i < fuels; i++)
+    {
+        if (ros[i] > maximumRos)
+        {
+            maximumRos = ros[i];
+        }
+    }
+    if (maximumRos <= 0.0)
+    {
+        return(expectedRos);
+    }
+    double targetStdErr = surfaceInputs.getTwoDimensionalSamplingTargetStandardError(SpeedUnits::FeetPerMinute) / maximumRos;
+    double maxSeconds = surfaceInputs.getTwoDimensionalSamplingTimeBudget(TimeUnits::Seconds);
+
+    double stdErr = 0.0;
+    long draws = 0;
+    expectedRos = randFuel.sampleSpread2(
+        samples,            // columns
+        depth,              // rows
+        lbRatio,            // fire length-to-breadth ratio
+        surfaceInputs.getTwoDimensionalSamplingThreads(),
+        &maximumRos,        // returned maximum spread rate
+        &stdErr,            // returned standard error of relative spread rate
+        &draws,             // returned number of fuel arrangements drawn
+        targetStdErr,
+        maxSeconds,
+        surfaceInputs.getTwoDimensionalSamplingMaxDraws(),
+        surfaceInputs.getTwoDimensionalSamplingSeed(),
+        0);                 // less ignitions
+    randFuel.freeFuels();
+
+    spreadRateStandardError_ = stdErr * maximumRos;
+    spreadRateSampleCount_ = draws;
+    return(expectedRos * maximumRos);
+}
+
 void SurfaceTwoFuelModels::calculateFireOutputsForEachModel(bool hasDirectionOfInterest, double directionOfInterest, SurfaceFireSpreadDirectionMode::SurfaceFireSpreadDirectionModeEnum directionMode)
 {
     for (int i = 0; i < TwoFuelModelsContants::NumberOfModels; i++)
@@ -332,10 +452,19 @@ void SurfaceTwoFuelModels::calculateSpreadRateBasedOnMethod()
     {
         //double lbRatio = lengthToWidthRatioForFuelModel_[TwoFuelModels::FIRST]; // get first fuel model's length-to-width ratio
         double lbRatio = lengthToWidthRatioForFuelModel_[TwoFuelModelsContants::Second]; // using fuel model's length-to-width ratio seems to agree with BehavePlus
-        int samples = 2; // from behavePlus.xml
-        int depth = 2; // from behavePlus.xml
+        int samples = surfaceFireSpread_->surfaceInputs_->getTwoDimensionalSamples(); // 2 from behavePlus.xml
+        int depth = surfaceFireSpread_->surfaceInputs_->getTwoDimensionalDepth(); // 2 from behavePlus.xml
         int laterals = 0; // from behavePlus.xml
         spreadRate_ = surfaceFireExpectedSpreadRate(rosForFuelModel_, coverageForFuelModel_, TwoFuelModelsContants::NumberOfModels, lbRatio,
             samples, depth, laterals);
     }
+    // else if sampled estimate of Finney's 2-dimensional spread rate...
+    else if (twoFuelModelsMethod_ == TwoFuelModelsMethod::TwoDimensionalSampled)
+    {
+        double lbRatio = lengthToWidthRatioForFuelModel_[TwoFuelModelsContants::Second];
+        int samples = surfaceFireSpread_->surfaceInputs_->getTwoDimensionalSamples();
+        int depth = surfaceFireSpread_->surfaceInputs_->getTwoDimensionalDepth();
+        spreadRate_ = surfaceFireSampledSpreadRate(rosForFuelModel_, coverageForFuelModel_, TwoFuelModelsContants::NumberOfModels, lbRatio,
+            samples, depth);
+    }
 }
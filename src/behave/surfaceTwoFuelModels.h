@@ -32,6 +32,7 @@
 #ifndef SURFACETWOFUELMODELS_H
 #define SURFACETWOFUELMODELS_H
 
+#include "randworkspace.h"
 #include "surfaceInputs.h"
 
 class SurfaceFuelbedIntermediates;
@@ -41,6 +42,8 @@ class SurfaceTwoFuelModels
 {
 public:
     SurfaceTwoFuelModels(SurfaceFire& surfaceFireSpread);
+    SurfaceTwoFuelModels(const SurfaceTwoFuelModels& rhs) = delete;
+    SurfaceTwoFuelModels& operator=(const SurfaceTwoFuelModels& rhs) = delete;
     void calculateWeightedSpreadRate(TwoFuelModelsMethod::TwoFuelModelsMethodEnum twoFuelModelsMethod,
         int firstFuelModelNumber, double firstFuelModelCoverage, int secondFuelModelNumber,
         bool hasDirectionOfInterest, double directionOfInterest,
@@ -60,15 +63,20 @@ public:
     double getFireLineIntensity() const;
     double getflameLength() const;
     double getFireLengthToWidthRatio() const;
+    double getSpreadRateStandardError() const;
+    long getSpreadRateSampleCount() const;
 
 protected:
     double surfaceFireExpectedSpreadRate(double* ros, double* coverage, int fuels,
         double lbRatio, int samples, int depth, int laterals);
+    double surfaceFireSampledSpreadRate(double* ros, double* coverage, int fuels,
+        double lbRatio, int samples, int depth);
     void calculateFireOutputsForEachModel(bool hasDirectionOfInterest, double directionOfInterest,
         SurfaceFireSpreadDirectionMode::SurfaceFireSpreadDirectionModeEnum directionMode);
     void calculateSpreadRateBasedOnMethod();
 
     SurfaceFire* surfaceFireSpread_;
+    RandWorkspace randWorkspace_;   // RandFuel working memory, kept from run to run
 
     // Member arrays, stores data for each of the two fuel models
     int fuelModelNumber_[TwoFuelModelsContants::NumberOfModels];                      // fuel model number
@@ -104,6 +112,8 @@ protected:
     double flameLength_;            // (ft)
     double maxFlameLength_;         // flame length in direction of maximum spread (ft)
     double fireLengthToWidthRatio_;
+    double spreadRateStandardError_;   // standard error of a sampled spread rate (ft / min)
+    long spreadRateSampleCount_;       // fuel arrangements drawn for a sampled spread rate
 };
 
 #endif // SURFACETWOFUELMODELS_H
@@ -0,0 +1,334 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Thread-safe, bounded cache of Finney's two dimensional expected
+*           spread rate for two fuel models
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "twoFuelModelsSpreadRateCache.h"
+
+#include <cmath>
+#include <functional>
+
+#include "randfuel.h"
+
+bool TwoFuelModelsSpreadRateKey::operator==(const TwoFuelModelsSpreadRateKey& rhs) const
+{
+    return firstRelativeRos == rhs.firstRelativeRos
+        && secondRelativeRos == rhs.secondRelativeRos
+        && firstCoverage == rhs.firstCoverage
+        && secondCoverage == rhs.secondCoverage
+        && lbRatio == rhs.lbRatio
+        && samples == rhs.samples
+        && depth == rhs.depth
+        && laterals == rhs.laterals;
+}
+
+std::size_t TwoFuelModelsSpreadRateKeyHash::operator()(const TwoFuelModelsSpreadRateKey& key) const
+{
+    std::hash<double> hashDouble;
+    std::size_t seed = 0;
+    auto combine = [&seed](std::size_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(hashDouble(key.firstRelativeRos));
+    combine(hashDouble(key.secondRelativeRos));
+    combine(hashDouble(key.firstCoverage));
+    combine(hashDouble(key.secondCoverage));
+    combine(hashDouble(key.lbRatio));
+    combine(std::hash<int>()(key.samples));
+    combine(std::hash<int>()(key.depth));
+    combine(std::hash<int>()(key.laterals));
+    return seed;
+}
+
+TwoFuelModelsSpreadRateCache::TwoFuelModelsSpreadRateCache()
+    : capacity_(4096),
+    rosRatioStep_(0.0),
+    coverageStep_(0.0),
+    lbRatioStep_(0.0),
+    enabled_(true),
+    hits_(0),
+    misses_(0)
+{
+
+}
+
+TwoFuelModelsSpreadRateCache& TwoFuelModelsSpreadRateCache::getSharedCache()
+{
+    static TwoFuelModelsSpreadRateCache sharedCache;
+    return sharedCache;
+}
+
+double TwoFuelModelsSpreadRateCache::computeRelativeSpreadRate(const TwoFuelModelsSpreadRateKey& key, RandWorkspace* workspace)
+{
+    double relativeRos = -1.0;
+
+    RandFuel randFuel;
+    randFuel.setWorkspace(workspace);
+    // Mark says the cell size is irrelevant, but he sets it anyway.
+    randFuel.setCellDimensions(10);
+    // recomputeSpread() is never used, so don't keep a spread rate per block
+    randFuel.setRetainBlockSpreadRates(false);
+
+    if (!randFuel.allocFuels(2))
+    {
+        return(relativeRos);
+    }
+    randFuel.setFuelData(0, key.firstRelativeRos, key.firstCoverage);
+    randFuel.setFuelData(1, key.secondRelativeRos, key.secondCoverage);
+
+    double maximumRos = 0.0;
+    relativeRos = randFuel.computeSpread2(
+        key.samples,        // columns
+        key.depth,          // rows
+        key.lbRatio,        // fire length-to-breadth ratio
+        1,                  // always use 1 thread
+        &maximumRos,        // returned maximum spread rate, 1 for relative rates
+        0,                  // no harmonic spread rate
+        key.laterals,       // lateral extensions
+        0);                 // less ignitions
+    randFuel.freeFuels();
+
+    // computeSpread2() returns 0 or -1 without a maximum spread rate for
+    // block sizes it cannot calculate
+    if (relativeRos <= 0.0 || maximumRos <= 0.0)
+    {
+        return(-1.0);
+    }
+    return(relativeRos * maximumRos);
+}
+
+TwoFuelModelsSpreadRateKey TwoFuelModelsSpreadRateCache::makeKey(double firstRelativeRos, double secondRelativeRos,
+    double firstCoverage, double secondCoverage, double lbRatio, int samples, int depth, int laterals) const
+{
+    TwoFuelModelsSpreadRateKey key;
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A disabled cache calculates every run at its exact inputs
+    double rosRatioStep = enabled_ ? rosRatioStep_ : 0.0;
+    double coverageStep = enabled_ ? coverageStep_ : 0.0;
+    double lbRatioStep = enabled_ ? lbRatioStep_ : 0.0;
+    // The fastest fuel keeps its relative spread rate of exactly 1
+    key.firstRelativeRos = (firstRelativeRos < 1.0) ? quantize(firstRelativeRos, rosRatioStep) : firstRelativeRos;
+    key.secondRelativeRos = (secondRelativeRos < 1.0) ? quantize(secondRelativeRos, rosRatioStep) : secondRelativeRos;
+    if (coverageStep > 0.0)
+    {
+        key.firstCoverage = quantize(firstCoverage, coverageStep);
+        key.secondCoverage = 1.0 - key.firstCoverage;
+    }
+    else
+    {
+        key.firstCoverage = firstCoverage;
+        key.secondCoverage = secondCoverage;
+    }
+    key.lbRatio = quantize(lbRatio, lbRatioStep);
+    key.samples = samples;
+    key.depth = depth;
+    key.laterals = laterals;
+    return key;
+}
+
+double TwoFuelModelsSpreadRateCache::getRelativeSpreadRate(const TwoFuelModelsSpreadRateKey& key, RandWorkspace* workspace)
+{
+    double relativeRos = 0.0;
+    if (enabled_ && find(key, relativeRos))
+    {
+        hits_++;
+        return relativeRos;
+    }
+    misses_++;
+
+    // Computed outside of the lock, concurrent misses on one key just compute twice
+    relativeRos = computeRelativeSpreadRate(key, workspace);
+    if (enabled_ && relativeRos > 0.0)
+    {
+        insert(key, relativeRos);
+    }
+    return relativeRos;
+}
+
+void TwoFuelModelsSpreadRateCache::prebuildTable(double lbRatio, int samples, int depth, int laterals)
+{
+    // Fills a relative spread rate x coverage table for one length-to-breadth
+    // ratio, only meaningful with quantized keys of an enabled cache
+    if (!enabled_)
+    {
+        return;
+    }
+    double rosRatioStep;
+    double coverageStep;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rosRatioStep = rosRatioStep_;
+        coverageStep = coverageStep_;
+    }
+    if (rosRatioStep <= 0.0 || coverageStep <= 0.0)
+    {
+        return;
+    }
+
+    int rosRatioBins = (int)std::floor(1.0 / rosRatioStep + 0.5);
+    int coverageBins = (int)std::floor(1.0 / coverageStep + 0.5);
+    for (int i = 0; i <= rosRatioBins; i++)
+    {
+        double rosRatio = (i < rosRatioBins) ? i * rosRatioStep : 1.0;
+        for (int j = 0; j <= coverageBins; j++)
+        {
+            double coverage = (j < coverageBins) ? j * coverageStep : 1.0;
+            // Either fuel model may be the faster one
+            TwoFuelModelsSpreadRateKey keys[2] =
+            {
+                makeKey(1.0, rosRatio, coverage, 1.0 - coverage, lbRatio, samples, depth, laterals),
+                makeKey(rosRatio, 1.0, coverage, 1.0 - coverage, lbRatio, samples, depth, laterals)
+            };
+            for (int k = 0; k < 2; k++)
+            {
+                double relativeRos = computeRelativeSpreadRate(keys[k]);
+                if (relativeRos <= 0.0)
+                {
+                    continue;
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                table_[keys[k]] = relativeRos;
+            }
+        }
+    }
+}
+
+void TwoFuelModelsSpreadRateCache::setEnabled(bool enabled)
+{
+    enabled_ = enabled;
+}
+
+void TwoFuelModelsSpreadRateCache::setCapacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    while (entries_.size() > capacity_)
+    {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+void TwoFuelModelsSpreadRateCache::setQuantization(double rosRatioStep, double coverageStep, double lbRatioStep)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    rosRatioStep_ = (rosRatioStep > 0.0) ? rosRatioStep : 0.0;
+    coverageStep_ = (coverageStep > 0.0) ? coverageStep : 0.0;
+    lbRatioStep_ = (lbRatioStep > 0.0) ? lbRatioStep : 0.0;
+    // Entries made with other steps would never be hit again
+    entries_.clear();
+    index_.clear();
+    table_.clear();
+}
+
+void TwoFuelModelsSpreadRateCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    table_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+bool TwoFuelModelsSpreadRateCache::isEnabled() const
+{
+    return enabled_;
+}
+
+std::size_t TwoFuelModelsSpreadRateCache::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+std::size_t TwoFuelModelsSpreadRateCache::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::size_t TwoFuelModelsSpreadRateCache::getTableSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return table_.size();
+}
+
+unsigned long long TwoFuelModelsSpreadRateCache::getHits() const
+{
+    return hits_;
+}
+
+unsigned long long TwoFuelModelsSpreadRateCache::getMisses() const
+{
+    return misses_;
+}
+
+bool TwoFuelModelsSpreadRateCache::find(const TwoFuelModelsSpreadRateKey& key, double& relativeRos)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Table::const_iterator tableEntry = table_.find(key);
+    if (tableEntry != table_.end())
+    {
+        relativeRos = tableEntry->second;
+        return true;
+    }
+    EntryIndex::iterator indexEntry = index_.find(key);
+    if (indexEntry == index_.end())
+    {
+        return false;
+    }
+    // Move to the front of the recently used list
+    entries_.splice(entries_.begin(), entries_, indexEntry->second);
+    relativeRos = indexEntry->second->second;
+    return true;
+}
+
+void TwoFuelModelsSpreadRateCache::insert(const TwoFuelModelsSpreadRateKey& key, double relativeRos)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0 || index_.find(key) != index_.end())
+    {
+        return;
+    }
+    entries_.push_front(Entry(key, relativeRos));
+    index_[key] = entries_.begin();
+    if (entries_.size() > capacity_)
+    {
+        // Evict the least recently used entry
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+double TwoFuelModelsSpreadRateCache::quantize(double value, double step)
+{
+    if (step <= 0.0)
+    {
+        return value;
+    }
+    return std::floor(value / step + 0.5) * step;
+}
@@ -0,0 +1,114 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Thread-safe, bounded cache of Finney's two dimensional expected
+*           spread rate for two fuel models
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef TWOFUELMODELSSPREADRATECACHE_H
+#define TWOFUELMODELSSPREADRATECACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+class RandWorkspace;
+
+// The expected spread rate relative to the faster fuel model depends only on
+// the relative spread rates, the coverages, the fire length-to-breadth ratio
+// and the sample block geometry, so those are the cache key.
+struct TwoFuelModelsSpreadRateKey
+{
+    double firstRelativeRos;    // first fuel model spread rate / fastest spread rate
+    double secondRelativeRos;   // second fuel model spread rate / fastest spread rate
+    double firstCoverage;       // normalized coverage of the first fuel model
+    double secondCoverage;      // normalized coverage of the second fuel model
+    double lbRatio;             // fire length-to-breadth ratio
+    int samples;
+    int depth;
+    int laterals;
+
+    bool operator==(const TwoFuelModelsSpreadRateKey& rhs) const;
+};
+
+struct TwoFuelModelsSpreadRateKeyHash
+{
+    std::size_t operator()(const TwoFuelModelsSpreadRateKey& key) const;
+};
+
+class TwoFuelModelsSpreadRateCache
+{
+public:
+    TwoFuelModelsSpreadRateCache();
+
+    // Cache shared by every SurfaceTwoFuelModels in the process
+    static TwoFuelModelsSpreadRateCache& getSharedCache();
+
+    // Computes the expected spread rate relative to the fastest fuel with RandFuel,
+    // drawing its working memory from workspace if given; -1 if RandFuel fails
+    static double computeRelativeSpreadRate(const TwoFuelModelsSpreadRateKey& key, RandWorkspace* workspace = nullptr);
+
+    TwoFuelModelsSpreadRateKey makeKey(double firstRelativeRos, double secondRelativeRos,
+        double firstCoverage, double secondCoverage, double lbRatio, int samples, int depth, int laterals) const;
+    // Cached computeRelativeSpreadRate(), failed results are never cached
+    double getRelativeSpreadRate(const TwoFuelModelsSpreadRateKey& key, RandWorkspace* workspace = nullptr);
+    void prebuildTable(double lbRatio, int samples, int depth, int laterals);
+
+    void setEnabled(bool enabled);
+    void setCapacity(std::size_t capacity);
+    void setQuantization(double rosRatioStep, double coverageStep, double lbRatioStep);
+    void clear();
+
+    bool isEnabled() const;
+    std::size_t getCapacity() const;
+    std::size_t getSize() const;
+    std::size_t getTableSize() const;
+    unsigned long long getHits() const;
+    unsigned long long getMisses() const;
+
+private:
+    typedef std::pair<TwoFuelModelsSpreadRateKey, double> Entry;
+    typedef std::unordered_map<TwoFuelModelsSpreadRateKey, std::list<Entry>::iterator, TwoFuelModelsSpreadRateKeyHash> EntryIndex;
+    typedef std::unordered_map<TwoFuelModelsSpreadRateKey, double, TwoFuelModelsSpreadRateKeyHash> Table;
+
+    bool find(const TwoFuelModelsSpreadRateKey& key, double& relativeRos);
+    void insert(const TwoFuelModelsSpreadRateKey& key, double relativeRos);
+    static double quantize(double value, double step);
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;      // most recently used first
+    EntryIndex index_;
+    Table table_;                   // prebuilt entries, never evicted
+    std::size_t capacity_;
+    double rosRatioStep_;           // quantization step of relative spread rates, 0 for exact keys
+    double coverageStep_;           // quantization step of coverages, 0 for exact keys
+    double lbRatioStep_;            // quantization step of length-to-breadth ratio, 0 for exact keys
+    std::atomic<bool> enabled_;
+    std::atomic<unsigned long long> hits_;
+    std::atomic<unsigned long long> misses_;
+};
+
+#endif // TWOFUELMODELSSPREADRATECACHE_H
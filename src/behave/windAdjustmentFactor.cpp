@@ -30,6 +30,7 @@
 
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <functional>
 #include "windAdjustmentFactor.h"
 
 WindAjustmentFactor::WindAjustmentFactor()
@@ -105,3 +106,62 @@ void WindAjustmentFactor::applyLogProfile(const double canopyCover, const double
         windAdjustmentFactor_ = 0.555 / (sqrt(canopyCrownFraction_ * canopyHeight) * log((20.0 + 0.36 * canopyHeight) / (0.13 * canopyHeight)));
     }
 }
+
+WindAdjustmentFactorTable::WindAdjustmentFactorTable()
+{
+    clear();
+}
+
+double WindAdjustmentFactorTable::getWindAdjustmentFactor(WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum calculationMethod,
+    double canopyCover, double canopyHeight, double crownRatio, double fuelbedDepth,
+    WindAdjustmentFactorShelterMethod::WindAdjustmentFactorShelterMethodEnum& shelterMethod)
+{
+    if (calculationMethod != WindAdjustmentFactorCalculationMethod::UseCrownRatio)
+    {
+        crownRatio = 0.0; // not an input, cells differing only by crown ratio share an entry
+    }
+
+    std::hash<double> hashDouble;
+    std::size_t seed = calculationMethod;
+    auto combine = [&seed](std::size_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(hashDouble(canopyCover));
+    combine(hashDouble(canopyHeight));
+    combine(hashDouble(crownRatio));
+    combine(hashDouble(fuelbedDepth));
+    Entry& entry = entries_[seed & (NumberOfEntries - 1)];
+
+    if (!entry.isValid || entry.calculationMethod != calculationMethod || entry.canopyCover != canopyCover
+        || entry.canopyHeight != canopyHeight || entry.crownRatio != crownRatio || entry.fuelbedDepth != fuelbedDepth)
+    {
+        WindAjustmentFactor windAdjustmentFactor;
+        entry.windAdjustmentFactor = 0.0;
+        if (calculationMethod == WindAdjustmentFactorCalculationMethod::UseCrownRatio)
+        {
+            entry.windAdjustmentFactor = windAdjustmentFactor.calculateWindAdjustmentFactorWithCrownRatio(canopyCover, canopyHeight, crownRatio, fuelbedDepth);
+        }
+        else if (calculationMethod == WindAdjustmentFactorCalculationMethod::DontUseCrownRatio)
+        {
+            entry.windAdjustmentFactor = windAdjustmentFactor.calculateWindAdjustmentFactorWithoutCrownRatio(canopyCover, canopyHeight, fuelbedDepth);
+        }
+        entry.shelterMethod = windAdjustmentFactor.getWindAdjustmentFactorShelterMethod();
+        entry.calculationMethod = calculationMethod;
+        entry.canopyCover = canopyCover;
+        entry.canopyHeight = canopyHeight;
+        entry.crownRatio = crownRatio;
+        entry.fuelbedDepth = fuelbedDepth;
+        entry.isValid = true;
+    }
+    shelterMethod = entry.shelterMethod;
+    return entry.windAdjustmentFactor;
+}
+
+void WindAdjustmentFactorTable::clear()
+{
+    for (int i = 0; i < NumberOfEntries; i++)
+    {
+        entries_[i].isValid = false;
+    }
+}
@@ -52,4 +52,33 @@ protected:
     WindAdjustmentFactorShelterMethod::WindAdjustmentFactorShelterMethodEnum windAdjustmentFactorShelterMethod_;
 };
 
+// Small direct mapped memo of wind adjustment factors. Canopy cover, canopy height,
+// crown ratio and fuelbed depth are fixed for a stand or landscape cell, so runs
+// over many time steps find their factor here instead of recalculating it
+class WindAdjustmentFactorTable
+{
+public:
+    WindAdjustmentFactorTable();
+    double getWindAdjustmentFactor(WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum calculationMethod,
+        double canopyCover, double canopyHeight, double crownRatio, double fuelbedDepth,
+        WindAdjustmentFactorShelterMethod::WindAdjustmentFactorShelterMethodEnum& shelterMethod);
+    void clear();
+
+protected:
+    struct Entry
+    {
+        bool isValid;
+        WindAdjustmentFactorCalculationMethod::WindAdjustmentFactorCalculationMethodEnum calculationMethod;
+        double canopyCover;
+        double canopyHeight;
+        double crownRatio;
+        double fuelbedDepth;
+        double windAdjustmentFactor;
+        WindAdjustmentFactorShelterMethod::WindAdjustmentFactorShelterMethodEnum shelterMethod;
+    };
+    static const int NumberOfEntries = 64; // power of two
+
+    Entry entries_[NumberOfEntries];
+};
+
 #endif // WINDADJUSTMENTFACTOR_H
@@ -0,0 +1,917 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Unix domain socket compute server with warm fuel model and species tables
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include "behaveServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "behaveRun.h"
+#include "behaveTrace.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // SIGPIPE has to be ignored by the process instead
+#endif
+
+using namespace BehaveServerProtocol;
+
+namespace
+{
+
+// Header bytes following the length field
+const std::uint32_t requestHeaderLength = sizeof(RequestHeader) - sizeof(std::uint32_t);
+// How often the accept loop checks for stop()
+const int stopPollMilliseconds = 200;
+
+bool readAll(int socket, void* buffer, std::size_t length)
+{
+    char* bytes = static_cast<char*>(buffer);
+    while (length > 0)
+    {
+        ssize_t count = recv(socket, bytes, length, 0);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+        bytes += count;
+        length -= (std::size_t)count;
+    }
+    return true;
+}
+
+bool writeAll(int socket, const void* buffer, std::size_t length)
+{
+    const char* bytes = static_cast<const char*>(buffer);
+    while (length > 0)
+    {
+        ssize_t count = send(socket, bytes, length, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+        bytes += count;
+        length -= (std::size_t)count;
+    }
+    return true;
+}
+
+void setError(Status::StatusEnum status, const std::string& message, ResponseHeader& response,
+    std::vector<char>& responsePayload)
+{
+    response.status = status;
+    response.outputMask = 0;
+    response.numberOfRows = 0;
+    response.numberOfColumns = 0;
+    responsePayload.assign(message.begin(), message.end());
+}
+
+// Integral value within [minimum, maximum]
+bool readEnum(double value, int minimum, int maximum, int& result)
+{
+    if (!(value >= minimum && value <= maximum) || value != std::floor(value))
+    {
+        return false;
+    }
+    result = (int)value;
+    return true;
+}
+
+std::string describeRow(std::size_t row)
+{
+    return "row " + std::to_string(row) + ": ";
+}
+
+std::string describeFuelModel(double fuelModelNumber)
+{
+    std::ostringstream description;
+    description << "fuel model " << fuelModelNumber << " is not defined";
+    return description.str();
+}
+
+// The doubles of a request payload split into parameters and rows
+struct RequestValues
+{
+    std::vector<double> values;
+    const double* parameters = nullptr;
+    const double* rows = nullptr;
+    std::size_t numberOfRows = 0;
+    std::size_t numberOfColumns = 0;
+
+    const double* row(std::size_t index) const
+    {
+        return rows + index * numberOfColumns;
+    }
+};
+
+// Writes the outputs selected by the request's mask from rows of every output
+class OutputWriter
+{
+public:
+    OutputWriter(std::uint32_t requestMask, int numberOfOutputs)
+        : mask_((requestMask == 0) ? ((1u << numberOfOutputs) - 1u) : requestMask),
+        numberOfOutputs_(numberOfOutputs)
+    {
+        for (int output = 0; output < numberOfOutputs; output++)
+        {
+            if (mask_ & (1u << output))
+            {
+                selectedOutputs_.push_back(output);
+            }
+        }
+    }
+
+    bool isValid() const
+    {
+        return (mask_ >> numberOfOutputs_) == 0;
+    }
+
+    bool isSelected(int output) const
+    {
+        return (mask_ & (1u << output)) != 0;
+    }
+
+    void start(std::size_t numberOfRows, ResponseHeader& response, std::vector<char>& responsePayload)
+    {
+        response.status = Status::Ok;
+        response.outputMask = mask_;
+        response.numberOfRows = (std::uint32_t)numberOfRows;
+        response.numberOfColumns = (std::uint32_t)selectedOutputs_.size();
+        responsePayload.resize(numberOfRows * selectedOutputs_.size() * sizeof(double));
+        payload_ = &responsePayload;
+    }
+
+    void writeRow(std::size_t row, const double* outputs)
+    {
+        char* destination = &(*payload_)[0] + row * selectedOutputs_.size() * sizeof(double);
+        for (std::size_t i = 0; i < selectedOutputs_.size(); i++)
+        {
+            std::memcpy(destination + i * sizeof(double), &outputs[selectedOutputs_[i]], sizeof(double));
+        }
+    }
+
+private:
+    std::uint32_t mask_;
+    int numberOfOutputs_;
+    std::vector<int> selectedOutputs_;
+    std::vector<char>* payload_ = nullptr;
+};
+
+bool updateSurfaceInputs(BehaveRun& behaveRun, const double* row, std::string& error)
+{
+    int fuelModelNumber = 0;
+    if (!readEnum(row[SurfaceInput::FuelModelNumber], 0, std::numeric_limits<int>::max(), fuelModelNumber)
+        || !behaveRun.isFuelModelDefined(fuelModelNumber))
+    {
+        error = describeFuelModel(row[SurfaceInput::FuelModelNumber]);
+        return false;
+    }
+    behaveRun.surface.updateSurfaceInputs(fuelModelNumber, row[SurfaceInput::MoistureOneHour],
+        row[SurfaceInput::MoistureTenHour], row[SurfaceInput::MoistureHundredHour], row[SurfaceInput::MoistureLiveHerbaceous],
+        row[SurfaceInput::MoistureLiveWoody], FractionUnits::Percent, row[SurfaceInput::WindSpeed], SpeedUnits::MilesPerHour,
+        WindHeightInputMode::TwentyFoot, row[SurfaceInput::WindDirection], WindAndSpreadOrientationMode::RelativeToNorth,
+        row[SurfaceInput::Slope], SlopeUnits::Percent, row[SurfaceInput::Aspect], row[SurfaceInput::CanopyCover],
+        FractionUnits::Percent, row[SurfaceInput::CanopyHeight], LengthUnits::Feet, row[SurfaceInput::CrownRatio]);
+    return true;
+}
+
+bool calculateSurface(BehaveRun& behaveRun, const RequestValues& request, OutputWriter& writer, std::string& error)
+{
+    double outputs[SurfaceOutput::NumberOfOutputs];
+    for (std::size_t i = 0; i < request.numberOfRows; i++)
+    {
+        if (!updateSurfaceInputs(behaveRun, request.row(i), error))
+        {
+            error = describeRow(i) + error;
+            return false;
+        }
+        Surface& surface = behaveRun.surface;
+        surface.doSurfaceRunInDirectionOfMaxSpread();
+        outputs[SurfaceOutput::SpreadRate] = surface.getSpreadRate(SpeedUnits::FeetPerMinute);
+        outputs[SurfaceOutput::BackingSpreadRate] = writer.isSelected(SurfaceOutput::BackingSpreadRate)
+            ? surface.getBackingSpreadRate(SpeedUnits::FeetPerMinute) : 0.0;
+        outputs[SurfaceOutput::FlameLength] = surface.getFlameLength(LengthUnits::Feet);
+        outputs[SurfaceOutput::FirelineIntensity] = surface.getFirelineIntensity(FirelineIntensityUnits::BtusPerFootPerSecond);
+        outputs[SurfaceOutput::DirectionOfMaxSpread] = surface.getDirectionOfMaxSpread();
+        outputs[SurfaceOutput::LengthToWidthRatio] = surface.getFireLengthToWidthRatio();
+        outputs[SurfaceOutput::HeatPerUnitArea] = surface.getHeatPerUnitArea(HeatPerUnitAreaUnits::BtusPerSquareFoot);
+        writer.writeRow(i, outputs);
+    }
+    return true;
+}
+
+bool calculateCrown(BehaveRun& behaveRun, const RequestValues& request, OutputWriter& writer, std::string& error)
+{
+    int method = 0;
+    if (!readEnum(request.parameters[0], 0, 1, method))
+    {
+        error = "crown method must be 0 or 1";
+        return false;
+    }
+
+    double outputs[CrownOutput::NumberOfOutputs];
+    Crown& crown = behaveRun.crown;
+    for (std::size_t i = 0; i < request.numberOfRows; i++)
+    {
+        const double* row = request.row(i);
+        int fuelModelNumber = 0;
+        if (!readEnum(row[SurfaceInput::FuelModelNumber], 0, std::numeric_limits<int>::max(), fuelModelNumber)
+            || !behaveRun.isFuelModelDefined(fuelModelNumber))
+        {
+            error = describeRow(i) + describeFuelModel(row[SurfaceInput::FuelModelNumber]);
+            return false;
+        }
+        crown.updateCrownInputs(fuelModelNumber, row[SurfaceInput::MoistureOneHour], row[SurfaceInput::MoistureTenHour],
+            row[SurfaceInput::MoistureHundredHour], row[SurfaceInput::MoistureLiveHerbaceous], row[SurfaceInput::MoistureLiveWoody],
+            row[CrownInput::MoistureFoliar], FractionUnits::Percent, row[SurfaceInput::WindSpeed], SpeedUnits::MilesPerHour,
+            WindHeightInputMode::TwentyFoot, row[SurfaceInput::WindDirection], WindAndSpreadOrientationMode::RelativeToNorth,
+            row[SurfaceInput::Slope], SlopeUnits::Percent, row[SurfaceInput::Aspect], row[SurfaceInput::CanopyCover],
+            FractionUnits::Percent, row[SurfaceInput::CanopyHeight], row[CrownInput::CanopyBaseHeight], LengthUnits::Feet,
+            row[SurfaceInput::CrownRatio], row[CrownInput::CanopyBulkDensity], DensityUnits::PoundsPerCubicFoot);
+        if (method == 0)
+        {
+            crown.doCrownRunRothermel();
+        }
+        else
+        {
+            crown.doCrownRunScottAndReinhardt();
+        }
+        outputs[CrownOutput::SpreadRate] = crown.getFinalSpreadRate(SpeedUnits::FeetPerMinute);
+        outputs[CrownOutput::FlameLength] = crown.getFinalFlameLength(LengthUnits::Feet);
+        outputs[CrownOutput::FirelineIntensity] = crown.getFinalFirelineIntesity(FirelineIntensityUnits::BtusPerFootPerSecond);
+        outputs[CrownOutput::FireType] = (double)crown.getFireType();
+        outputs[CrownOutput::CrownFireSpreadRate] = crown.getCrownFireSpreadRate(SpeedUnits::FeetPerMinute);
+        writer.writeRow(i, outputs);
+    }
+    return true;
+}
+
+bool calculateSpot(BehaveRun& behaveRun, const RequestValues& request, OutputWriter& writer, std::string& error)
+{
+    int source = 0;
+    if (!readEnum(request.parameters[0], SpotSource::BurningPile, SpotSource::TorchingTrees, source))
+    {
+        error = "spot source must be 0, 1 or 2";
+        return false;
+    }
+
+    std::size_t numberOfRows = request.numberOfRows;
+    std::vector<double> columns(SpotInput::NumberOfInputs * numberOfRows);
+    std::vector<SpotFireLocation::SpotFireLocationEnum> location(numberOfRows);
+    std::vector<SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum> downwindCanopyMode(numberOfRows);
+    std::vector<SpotTreeSpecies::SpotTreeSpeciesEnum> treeSpecies(numberOfRows);
+    std::vector<int> torchingTrees(numberOfRows);
+    for (std::size_t i = 0; i < numberOfRows; i++)
+    {
+        const double* row = request.row(i);
+        int value = 0;
+        if (!readEnum(row[SpotInput::Location], SpotFireLocation::MIDSLOPE_WINDWARD, SpotFireLocation::RIDGE_TOP, value))
+        {
+            error = describeRow(i) + "location must be 0 to 3";
+            return false;
+        }
+        location[i] = (SpotFireLocation::SpotFireLocationEnum)value;
+        if (!readEnum(row[SpotInput::DownwindCanopyMode], SpotDownWindCanopyMode::CLOSED, SpotDownWindCanopyMode::OPEN, value))
+        {
+            error = describeRow(i) + "downwind canopy mode must be 1 (closed) or 2 (open)";
+            return false;
+        }
+        downwindCanopyMode[i] = (SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum)value;
+        if (source == SpotSource::TorchingTrees)
+        {
+            if (!readEnum(row[SpotInput::TreeSpecies], SpotTreeSpecies::ENGELMANN_SPRUCE, SpotTreeSpecies::LOBLOLLY_PINE, value))
+            {
+                error = describeRow(i) + "tree species must be 0 to 13";
+                return false;
+            }
+            treeSpecies[i] = (SpotTreeSpecies::SpotTreeSpeciesEnum)value;
+            if (!readEnum(row[SpotInput::TorchingTrees], 0, std::numeric_limits<int>::max(), torchingTrees[i]))
+            {
+                error = describeRow(i) + "torching trees must be a whole number";
+                return false;
+            }
+        }
+        // Transpose the numeric inputs into the batch's columns
+        for (int input = 0; input < SpotInput::NumberOfInputs; input++)
+        {
+            columns[input * numberOfRows + i] = row[input];
+        }
+    }
+
+    SpotBatchInputs inputs;
+    inputs.numberOfScenarios = numberOfRows;
+    inputs.windSpeedAtTwentyFeet = &columns[SpotInput::WindSpeed * numberOfRows];
+    inputs.downwindCoverHeight = &columns[SpotInput::DownwindCoverHeight * numberOfRows];
+    inputs.ridgeToValleyDistance = &columns[SpotInput::RidgeToValleyDistance * numberOfRows];
+    inputs.ridgeToValleyElevation = &columns[SpotInput::RidgeToValleyElevation * numberOfRows];
+    inputs.location = &location[0];
+    inputs.downwindCanopyMode = &downwindCanopyMode[0];
+    inputs.burningPileFlameHeight = &columns[SpotInput::BurningPileFlameHeight * numberOfRows];
+    inputs.flameLength = &columns[SpotInput::FlameLength * numberOfRows];
+    inputs.torchingTrees = &torchingTrees[0];
+    inputs.DBH = &columns[SpotInput::DBH * numberOfRows];
+    inputs.treeHeight = &columns[SpotInput::TreeHeight * numberOfRows];
+    inputs.treeSpecies = &treeSpecies[0];
+
+    std::vector<double> flatDistance(numberOfRows);
+    std::vector<double> mountainDistance(numberOfRows);
+    if (source == SpotSource::BurningPile)
+    {
+        behaveRun.spot.calculateSpottingDistanceFromBurningPileForBatch(inputs, &flatDistance[0], &mountainDistance[0],
+            LengthUnits::Miles);
+    }
+    else if (source == SpotSource::SurfaceFire)
+    {
+        behaveRun.spot.calculateSpottingDistanceFromSurfaceFireForBatch(inputs, &flatDistance[0], &mountainDistance[0],
+            LengthUnits::Miles);
+    }
+    else
+    {
+        behaveRun.spot.calculateSpottingDistanceFromTorchingTreesForBatch(inputs, &flatDistance[0], &mountainDistance[0],
+            LengthUnits::Miles);
+    }
+
+    double outputs[SpotOutput::NumberOfOutputs];
+    for (std::size_t i = 0; i < numberOfRows; i++)
+    {
+        outputs[SpotOutput::FlatDistance] = flatDistance[i];
+        outputs[SpotOutput::MountainDistance] = mountainDistance[i];
+        writer.writeRow(i, outputs);
+    }
+    return true;
+}
+
+bool calculateContain(BehaveRun& behaveRun, const RequestValues& request, OutputWriter& writer, std::string& error)
+{
+    int numberOfResources = (int)request.parameters[0];
+    double outputs[ContainOutput::NumberOfOutputs];
+    ContainAdapter& contain = behaveRun.contain;
+    for (std::size_t i = 0; i < request.numberOfRows; i++)
+    {
+        const double* row = request.row(i);
+        int tactic = 0;
+        if (!readEnum(row[ContainInput::Tactic], ContainTactic::HeadAttack, ContainTactic::RearAttack, tactic))
+        {
+            error = describeRow(i) + "tactic must be 0 or 1";
+            return false;
+        }
+        contain.removeAllResources();
+        contain.setReportSize(row[ContainInput::ReportSize], AreaUnits::Acres);
+        contain.setReportRate(row[ContainInput::ReportRate], SpeedUnits::ChainsPerHour);
+        contain.setLwRatio(row[ContainInput::LengthToWidthRatio]);
+        contain.setTactic((ContainTactic::ContainTacticEnum)tactic);
+        contain.setAttackDistance(row[ContainInput::AttackDistance], LengthUnits::Chains);
+        const double* resource = row + ContainInput::NumberOfInputs;
+        for (int j = 0; j < numberOfResources; j++, resource += ContainInputsPerResource)
+        {
+            contain.addResource(resource[0], resource[1], TimeUnits::Minutes, resource[2], SpeedUnits::ChainsPerHour);
+        }
+        contain.doContainRun();
+
+        outputs[ContainOutput::ContainmentStatus] = (double)contain.getContainmentStatus();
+        outputs[ContainOutput::FinalFireLineLength] = contain.getFinalFireLineLength(LengthUnits::Chains);
+        outputs[ContainOutput::FinalFireSize] = contain.getFinalFireSize(AreaUnits::Acres);
+        outputs[ContainOutput::FinalContainmentArea] = contain.getFinalContainmentArea(AreaUnits::Acres);
+        outputs[ContainOutput::FinalTimeSinceReport] = contain.getFinalTimeSinceReport(TimeUnits::Minutes);
+        outputs[ContainOutput::PerimeterAtContainment] = contain.getPerimeterAtContainment(LengthUnits::Chains);
+        writer.writeRow(i, outputs);
+    }
+    contain.removeAllResources();
+    return true;
+}
+
+bool calculateMortality(BehaveRun& behaveRun, const RequestValues& request, OutputWriter& writer, std::string& error)
+{
+    int isScorchHeight = 0;
+    int fireSeverity = 0;
+    if (!readEnum(request.parameters[MortalityParameter::IsScorchHeight], 0, 1, isScorchHeight)
+        || !readEnum(request.parameters[MortalityParameter::FireSeverity], (int)FireSeverity::not_set, (int)FireSeverity::low,
+            fireSeverity))
+    {
+        error = "scorch height switch must be 0 or 1 and fire severity -1, 0 or 1";
+        return false;
+    }
+
+    std::size_t numberOfRows = request.numberOfRows;
+    std::vector<double> columns(MortalityInput::NumberOfInputs * numberOfRows);
+    std::vector<int> speciesTableIndex(numberOfRows);
+    std::vector<BeetleDamage> beetleDamage(numberOfRows);
+    for (std::size_t i = 0; i < numberOfRows; i++)
+    {
+        const double* row = request.row(i);
+        int value = 0;
+        if (!readEnum(row[MortalityInput::SpeciesTableIndex], -1, std::numeric_limits<int>::max(), speciesTableIndex[i])
+            || !readEnum(row[MortalityInput::BeetleDamage], (int)BeetleDamage::not_set, (int)BeetleDamage::yes, value))
+        {
+            error = describeRow(i) + "species table index must be a whole number and beetle damage -1, 0 or 1";
+            return false;
+        }
+        beetleDamage[i] = (BeetleDamage)value;
+        for (int input = 0; input < MortalityInput::NumberOfInputs; input++)
+        {
+            columns[input * numberOfRows + i] = row[input];
+        }
+    }
+
+    MortalityTreeList treeList;
+    treeList.numberOfTrees = numberOfRows;
+    treeList.speciesTableIndex = &speciesTableIndex[0];
+    treeList.dbh = &columns[MortalityInput::DBH * numberOfRows];
+    treeList.treeHeight = &columns[MortalityInput::TreeHeight * numberOfRows];
+    treeList.crownRatio = &columns[MortalityInput::CrownRatio * numberOfRows];
+    treeList.expansionFactor = &columns[MortalityInput::ExpansionFactor * numberOfRows];
+    treeList.crownDamage = &columns[MortalityInput::CrownDamage * numberOfRows];
+    treeList.cambiumKillRating = &columns[MortalityInput::CambiumKillRating * numberOfRows];
+    treeList.beetleDamage = &beetleDamage[0];
+    treeList.boleCharHeight = &columns[MortalityInput::BoleCharHeight * numberOfRows];
+
+    Mortality& mortality = behaveRun.mortality;
+    mortality.setFlameLengthOrScorchHeightSwitch(isScorchHeight ? FlameLengthOrScorchHeightSwitch::scorch_height
+        : FlameLengthOrScorchHeightSwitch::flame_length);
+    mortality.setFlameLengthOrScorchHeightValue(request.parameters[MortalityParameter::FlameLengthOrScorchHeight],
+        LengthUnits::Feet);
+    mortality.setFireSeverity((FireSeverity)fireSeverity);
+
+    std::vector<double> probabilityOfMortality(numberOfRows);
+    // The worker pool is the parallelism, each request runs on one thread
+    mortality.calculateMortalityForTreeList(treeList, &probabilityOfMortality[0], FractionUnits::Fraction, 1);
+    for (std::size_t i = 0; i < numberOfRows; i++)
+    {
+        writer.writeRow(i, &probabilityOfMortality[i]);
+    }
+    return true;
+}
+
+}
+
+struct BehaveServer::Connection
+{
+    explicit Connection(int socket)
+        : socket(socket)
+    {
+
+    }
+
+    ~Connection()
+    {
+        close(socket);
+    }
+
+    int socket;
+    std::mutex writeMutex;  // one response is written at a time
+};
+
+BehaveServer::BehaveServer(const BehaveServerOptions& options)
+    : options_(options),
+    listenSocket_(-1),
+    isStopping_(false),
+    isDraining_(false),
+    numberOfReaders_(0)
+{
+
+}
+
+BehaveServer::~BehaveServer()
+{
+    if (listenSocket_ >= 0)
+    {
+        close(listenSocket_);
+    }
+}
+
+bool BehaveServer::run()
+{
+    if (!options_.customFuelModelsFileName.empty() && !fuelModels_.loadCustomFuelModels(options_.customFuelModelsFileName))
+    {
+        errorMessage_ = "could not load custom fuel models from " + options_.customFuelModelsFileName;
+        return false;
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (options_.socketPath.empty() || options_.socketPath.size() >= sizeof(address.sun_path))
+    {
+        errorMessage_ = "socket path must be 1 to " + std::to_string(sizeof(address.sun_path) - 1) + " characters";
+        return false;
+    }
+    std::memcpy(address.sun_path, options_.socketPath.c_str(), options_.socketPath.size());
+
+    // Only a socket file left behind by a server that did not shut down
+    // cleanly is removed, never another file or a server still answering
+    struct stat pathStatus;
+    if (lstat(options_.socketPath.c_str(), &pathStatus) == 0)
+    {
+        if (!S_ISSOCK(pathStatus.st_mode))
+        {
+            errorMessage_ = options_.socketPath + " exists and is not a socket";
+            return false;
+        }
+        int probeSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probeSocket < 0)
+        {
+            errorMessage_ = std::string("could not create socket: ") + std::strerror(errno);
+            return false;
+        }
+        bool isAnswered = connect(probeSocket, (sockaddr*)&address, sizeof(address)) == 0;
+        close(probeSocket);
+        if (isAnswered)
+        {
+            errorMessage_ = "another server is listening on " + options_.socketPath;
+            return false;
+        }
+        unlink(options_.socketPath.c_str());
+    }
+
+    listenSocket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenSocket_ < 0)
+    {
+        errorMessage_ = std::string("could not create socket: ") + std::strerror(errno);
+        return false;
+    }
+    if (bind(listenSocket_, (sockaddr*)&address, sizeof(address)) != 0 || listen(listenSocket_, SOMAXCONN) != 0)
+    {
+        errorMessage_ = "could not listen on " + options_.socketPath + ": " + std::strerror(errno);
+        return false;
+    }
+    std::cerr << "behave-server listening on " << options_.socketPath << "\n";
+
+    int numberOfThreads = options_.numberOfThreads;
+    if (numberOfThreads <= 0)
+    {
+        numberOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    std::vector<std::thread> workers;
+    for (int i = 0; i < numberOfThreads; i++)
+    {
+        workers.push_back(std::thread(&BehaveServer::workerLoop, this, i));
+    }
+
+    while (!isStopping_)
+    {
+        pollfd listenPoll;
+        listenPoll.fd = listenSocket_;
+        listenPoll.events = POLLIN;
+        listenPoll.revents = 0;
+        if (poll(&listenPoll, 1, stopPollMilliseconds) <= 0 || !(listenPoll.revents & POLLIN))
+        {
+            continue;
+        }
+        int connectionSocket = accept(listenSocket_, nullptr, nullptr);
+        if (connectionSocket < 0)
+        {
+            continue;
+        }
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(connectionSocket);
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex_);
+            openSockets_.insert(connectionSocket);
+            numberOfReaders_++;
+        }
+        std::thread(&BehaveServer::readConnection, this, connection).detach();
+    }
+
+    close(listenSocket_);
+    listenSocket_ = -1;
+    unlink(options_.socketPath.c_str());
+
+    // Wake the readers and any of them waiting for queue space, the
+    // requests already queued are still answered
+    {
+        std::unique_lock<std::mutex> lock(connectionsMutex_);
+        for (std::set<int>::const_iterator it = openSockets_.begin(); it != openSockets_.end(); ++it)
+        {
+            shutdown(*it, SHUT_RD);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queueSpace_.notify_all();
+    }
+    {
+        std::unique_lock<std::mutex> lock(connectionsMutex_);
+        connectionsDone_.wait(lock, [this] { return numberOfReaders_ == 0; });
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        isDraining_ = true;
+    }
+    jobReady_.notify_all();
+    for (std::size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+    return true;
+}
+
+void BehaveServer::stop()
+{
+    isStopping_ = true;
+}
+
+const std::string& BehaveServer::getErrorMessage() const
+{
+    return errorMessage_;
+}
+
+void BehaveServer::readConnection(std::shared_ptr<Connection> connection)
+{
+    Trace::setThreadName("reader " + std::to_string(connection->socket));
+    for (;;)
+    {
+        Job job;
+        if (!readAll(connection->socket, &job.request, sizeof(RequestHeader)))
+        {
+            break;
+        }
+        if (job.request.length < requestHeaderLength || job.request.length > MaxMessageLength)
+        {
+            // The stream can not be resynchronized, answer and hang up
+            ResponseHeader response;
+            std::vector<char> responsePayload;
+            setError(Status::InvalidRequest, "message length out of range", response, responsePayload);
+            response.requestId = job.request.requestId;
+            response.length = (std::uint32_t)(sizeof(ResponseHeader) - sizeof(std::uint32_t) + responsePayload.size());
+            std::lock_guard<std::mutex> lock(connection->writeMutex);
+            writeAll(connection->socket, &response, sizeof(response));
+            writeAll(connection->socket, responsePayload.data(), responsePayload.size());
+            break;
+        }
+        job.payload.resize(job.request.length - requestHeaderLength);
+        if (!job.payload.empty() && !readAll(connection->socket, &job.payload[0], job.payload.size()))
+        {
+            break;
+        }
+        job.connection = connection;
+        if (!pushJob(job))
+        {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    openSockets_.erase(connection->socket);
+    numberOfReaders_--;
+    connectionsDone_.notify_all();
+}
+
+bool BehaveServer::pushJob(Job& job)
+{
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    {
+        TraceSpan span("server", "wait for queue space");
+        queueSpace_.wait(lock, [this] { return isStopping_ || jobs_.size() < options_.maxQueuedRequests; });
+    }
+    if (isStopping_)
+    {
+        return false;
+    }
+    jobs_.push_back(std::move(job));
+    Trace::addCounter("queued requests", (double)jobs_.size());
+    jobReady_.notify_one();
+    return true;
+}
+
+void BehaveServer::workerLoop(int workerIndex)
+{
+    Trace::setThreadName("worker " + std::to_string(workerIndex));
+    BehaveRun behaveRun(fuelModels_, speciesMasterTable_);
+    ResponseHeader response;
+    std::vector<char> responsePayload;
+    std::vector<char> message;
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            {
+                TraceSpan span("server", "wait for request");
+                jobReady_.wait(lock, [this] { return isDraining_ || !jobs_.empty(); });
+            }
+            if (jobs_.empty())
+            {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            Trace::addCounter("queued requests", (double)jobs_.size());
+        }
+        queueSpace_.notify_one();
+
+        {
+            TraceSpan span("server", "calculate request");
+            calculateRequest(behaveRun, speciesMasterTable_, job.request, job.payload, response, responsePayload);
+        }
+        response.requestId = job.request.requestId;
+        response.length = (std::uint32_t)(sizeof(ResponseHeader) - sizeof(std::uint32_t) + responsePayload.size());
+
+        // One write per response keeps the system calls down when pipelining
+        message.resize(sizeof(ResponseHeader) + responsePayload.size());
+        std::memcpy(&message[0], &response, sizeof(ResponseHeader));
+        if (!responsePayload.empty())
+        {
+            std::memcpy(&message[sizeof(ResponseHeader)], &responsePayload[0], responsePayload.size());
+        }
+        TraceSpan span("server", "write response");
+        std::lock_guard<std::mutex> lock(job.connection->writeMutex);
+        // A client that went away just loses its responses
+        writeAll(job.connection->socket, &message[0], message.size());
+    }
+}
+
+void BehaveServer::calculateRequest(BehaveRun& behaveRun, SpeciesMasterTable& speciesMasterTable,
+    const RequestHeader& request, const std::vector<char>& payload, ResponseHeader& response,
+    std::vector<char>& responsePayload)
+{
+    response.requestId = request.requestId;
+
+    int numberOfParameters = 0;
+    std::size_t numberOfColumns = 0;
+    int numberOfOutputs = 0;
+    switch (request.module)
+    {
+        case Module::Surface:
+            numberOfColumns = SurfaceInput::NumberOfInputs;
+            numberOfOutputs = SurfaceOutput::NumberOfOutputs;
+            break;
+        case Module::Crown:
+            numberOfParameters = 1;
+            numberOfColumns = CrownInput::NumberOfInputs;
+            numberOfOutputs = CrownOutput::NumberOfOutputs;
+            break;
+        case Module::Spot:
+            numberOfParameters = 1;
+            numberOfColumns = SpotInput::NumberOfInputs;
+            numberOfOutputs = SpotOutput::NumberOfOutputs;
+            break;
+        case Module::Contain:
+            numberOfParameters = 1;
+            numberOfOutputs = ContainOutput::NumberOfOutputs;
+            break;
+        case Module::Mortality:
+            numberOfParameters = MortalityParameter::NumberOfParameters;
+            numberOfColumns = MortalityInput::NumberOfInputs;
+            numberOfOutputs = MortalityOutput::NumberOfOutputs;
+            break;
+        case Module::SpeciesLookup:
+            numberOfParameters = 1;
+            numberOfOutputs = SpeciesLookupOutput::NumberOfOutputs;
+            break;
+        default:
+            setError(Status::InvalidRequest, "unknown module " + std::to_string(request.module), response, responsePayload);
+            return;
+    }
+
+    OutputWriter writer(request.outputMask, numberOfOutputs);
+    std::size_t parameterBytes = numberOfParameters * sizeof(double);
+    if (request.numberOfParameters != numberOfParameters || payload.size() < parameterBytes || !writer.isValid())
+    {
+        setError(Status::InvalidRequest, "module " + std::to_string(request.module) + " takes "
+            + std::to_string(numberOfParameters) + " parameters and " + std::to_string(numberOfOutputs) + " outputs",
+            response, responsePayload);
+        return;
+    }
+
+    RequestValues values;
+    values.values.resize(payload.size() / sizeof(double));
+    if (!values.values.empty())
+    {
+        std::memcpy(&values.values[0], &payload[0], values.values.size() * sizeof(double));
+    }
+    values.parameters = values.values.data();
+    values.numberOfRows = request.numberOfRows;
+
+    std::string error;
+    try
+    {
+        if (request.module == Module::SpeciesLookup)
+        {
+            int equationType = 0;
+            if (!readEnum(values.parameters[0], (int)EquationType::crown_scorch, (int)EquationType::crown_damage, equationType))
+            {
+                setError(Status::InvalidInput, "equation type must be 0, 1 or 2", response, responsePayload);
+                return;
+            }
+            std::vector<double> speciesTableIndex;
+            std::istringstream codes(std::string(payload.begin() + parameterBytes, payload.end()));
+            std::string code;
+            while (std::getline(codes, code))
+            {
+                if (!code.empty() && code[code.size() - 1] == '\r')
+                {
+                    code.erase(code.size() - 1);
+                }
+                speciesTableIndex.push_back(speciesMasterTable.getSpeciesTableIndexFromSpeciesCodeAndEquationType(code,
+                    (EquationType)equationType));
+            }
+            if (speciesTableIndex.size() != request.numberOfRows)
+            {
+                setError(Status::InvalidRequest, "expected " + std::to_string(request.numberOfRows) + " species codes, found "
+                    + std::to_string(speciesTableIndex.size()), response, responsePayload);
+                return;
+            }
+            writer.start(speciesTableIndex.size(), response, responsePayload);
+            for (std::size_t i = 0; i < speciesTableIndex.size(); i++)
+            {
+                writer.writeRow(i, &speciesTableIndex[i]);
+            }
+            return;
+        }
+
+        if (request.module == Module::Contain)
+        {
+            int numberOfResources = 0;
+            if (!readEnum(values.parameters[0], 0, 1024, numberOfResources))
+            {
+                setError(Status::InvalidInput, "number of resources must be 0 to 1024", response, responsePayload);
+                return;
+            }
+            numberOfColumns = ContainInput::NumberOfInputs + numberOfResources * ContainInputsPerResource;
+        }
+        std::uint64_t expectedBytes = ((std::uint64_t)numberOfParameters
+            + (std::uint64_t)request.numberOfRows * numberOfColumns) * sizeof(double);
+        if (request.numberOfColumns != numberOfColumns || payload.size() != expectedBytes)
+        {
+            setError(Status::InvalidRequest, "module " + std::to_string(request.module) + " takes rows of "
+                + std::to_string(numberOfColumns) + " values", response, responsePayload);
+            return;
+        }
+        values.rows = values.parameters + numberOfParameters;
+        values.numberOfColumns = numberOfColumns;
+
+        writer.start(values.numberOfRows, response, responsePayload);
+        if (values.numberOfRows == 0)
+        {
+            return;
+        }
+        bool isCalculated = false;
+        switch (request.module)
+        {
+            case Module::Surface:
+                isCalculated = calculateSurface(behaveRun, values, writer, error);
+                break;
+            case Module::Crown:
+                isCalculated = calculateCrown(behaveRun, values, writer, error);
+                break;
+            case Module::Spot:
+                isCalculated = calculateSpot(behaveRun, values, writer, error);
+                break;
+            case Module::Contain:
+                isCalculated = calculateContain(behaveRun, values, writer, error);
+                break;
+            case Module::Mortality:
+                isCalculated = calculateMortality(behaveRun, values, writer, error);
+                break;
+        }
+        if (!isCalculated)
+        {
+            setError(Status::InvalidInput, error, response, responsePayload);
+        }
+    }
+    catch (const std::exception& exception)
+    {
+        setError(Status::InternalError, exception.what(), response, responsePayload);
+    }
+}
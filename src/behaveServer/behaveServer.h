@@ -0,0 +1,114 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Unix domain socket compute server with warm fuel model and species tables
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef BEHAVESERVER_H
+#define BEHAVESERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "behaveServerProtocol.h"
+#include "fuelModels.h"
+#include "species_master_table.h"
+
+class BehaveRun;
+
+struct BehaveServerOptions
+{
+    std::string socketPath = "/tmp/behave.sock";
+    int numberOfThreads = 1;                        // 0 for one per hardware thread
+    std::size_t maxQueuedRequests = 1024;           // connections stop being read while this many requests wait
+    std::string customFuelModelsFileName;           // optional
+};
+
+// Answers batch requests framed as in behaveServerProtocol.h on a Unix domain
+// socket. The fuel models and species table are built once and shared, each
+// worker thread keeps its own BehaveRun.
+class BehaveServer
+{
+public:
+    explicit BehaveServer(const BehaveServerOptions& options);
+    ~BehaveServer();
+
+    // Loads the tables, binds the socket, reports on stderr once it listens
+    // and serves until stop(), returns false with getErrorMessage() set if the
+    // server could not start
+    bool run();
+    // Safe to call from a signal handler
+    void stop();
+
+    const std::string& getErrorMessage() const;
+
+    // Calculates one request on behaveRun, used by the workers and exposed
+    // so requests can be answered without a socket
+    static void calculateRequest(BehaveRun& behaveRun, SpeciesMasterTable& speciesMasterTable,
+        const BehaveServerProtocol::RequestHeader& request, const std::vector<char>& payload,
+        BehaveServerProtocol::ResponseHeader& response, std::vector<char>& responsePayload);
+
+private:
+    BehaveServer(const BehaveServer&) = delete;
+    BehaveServer& operator=(const BehaveServer&) = delete;
+
+    struct Connection;
+    struct Job
+    {
+        std::shared_ptr<Connection> connection;
+        BehaveServerProtocol::RequestHeader request;
+        std::vector<char> payload;
+    };
+
+    void readConnection(std::shared_ptr<Connection> connection);
+    void workerLoop(int workerIndex);
+    bool pushJob(Job& job);
+
+    BehaveServerOptions options_;
+    std::string errorMessage_;
+    FuelModels fuelModels_;
+    SpeciesMasterTable speciesMasterTable_;
+    int listenSocket_;
+    std::atomic<bool> isStopping_;
+
+    std::mutex queueMutex_;
+    std::condition_variable jobReady_;
+    std::condition_variable queueSpace_;
+    std::deque<Job> jobs_;
+    bool isDraining_;                   // no more jobs will be queued, workers exit once idle
+
+    std::mutex connectionsMutex_;
+    std::condition_variable connectionsDone_;
+    std::set<int> openSockets_;         // sockets being read, shut down on stop
+    int numberOfReaders_;
+};
+
+#endif // BEHAVESERVER_H
@@ -0,0 +1,142 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Command line entry point of the behave compute server
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "behaveServer.h"
+#include "behaveTrace.h"
+
+#define EQUAL(a,b) (strcmp(a,b)==0)
+
+namespace
+{
+BehaveServer* runningServer = nullptr;
+
+void stopServer(int)
+{
+    if (runningServer)
+    {
+        runningServer->stop();
+    }
+}
+}
+
+void Usage()
+{
+    printf("Usage:\n");
+    printf("behave-server [--socket path] [--threads n] [--queue n] [--custom-fuel-models file]\n");
+    printf("              [--trace file]\n");
+    printf("\n");
+    printf("Serves surface, crown, spot, contain and mortality batch requests on a\n");
+    printf("Unix domain socket until interrupted. Requests and responses are framed\n");
+    printf("as described in behaveServerProtocol.h.\n");
+    printf("\n");
+    printf("    --socket               socket path, /tmp/behave.sock by default\n");
+    printf("    --threads              worker threads, 0 for one per processor, 1 by default\n");
+    printf("    --queue                requests waiting for a worker before connections\n");
+    printf("                           stop being read, 1024 by default\n");
+    printf("    --custom-fuel-models   custom fuel model file loaded at start up\n");
+    printf("    --trace                Chrome trace event JSON of queue waits and requests,\n");
+    printf("                           written at shut down\n");
+    printf("\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    BehaveServerOptions options;
+    std::string traceFileName;
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc)
+        {
+            Usage();
+        }
+        if (EQUAL(argv[i], "--socket"))
+        {
+            options.socketPath = argv[++i];
+        }
+        else if (EQUAL(argv[i], "--threads"))
+        {
+            options.numberOfThreads = atoi(argv[++i]);
+        }
+        else if (EQUAL(argv[i], "--queue"))
+        {
+            int maxQueuedRequests = atoi(argv[++i]);
+            if (maxQueuedRequests < 1)
+            {
+                Usage();
+            }
+            options.maxQueuedRequests = (std::size_t)maxQueuedRequests;
+        }
+        else if (EQUAL(argv[i], "--custom-fuel-models"))
+        {
+            options.customFuelModelsFileName = argv[++i];
+        }
+        else if (EQUAL(argv[i], "--trace"))
+        {
+            traceFileName = argv[++i];
+        }
+        else
+        {
+            Usage();
+        }
+    }
+
+    BehaveServer server(options);
+    runningServer = &server;
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+    // Writes to a client that hung up fail instead of ending the process
+    signal(SIGPIPE, SIG_IGN);
+
+    if (!traceFileName.empty())
+    {
+        Trace::start();
+    }
+
+    if (!server.run())
+    {
+        std::cerr << "behave-server: " << server.getErrorMessage() << "\n";
+        return 1;
+    }
+
+    if (!traceFileName.empty())
+    {
+        Trace::stop();
+        if (!Trace::writeChromeTrace(traceFileName))
+        {
+            std::cerr << "behave-server: could not write " << traceFileName << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
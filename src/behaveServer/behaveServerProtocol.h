@@ -0,0 +1,249 @@
+/******************************************************************************
+*
+* Project:  Behave
+* Purpose:  Binary request and response framing of the behave compute server
+*
+*******************************************************************************
+*
+* THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+* MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT
+* IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105
+* OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT
+* PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES
+* LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER
+* PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY,
+* RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+* DEALINGS IN THE SOFTWARE.
+*
+******************************************************************************/
+
+#ifndef BEHAVESERVERPROTOCOL_H
+#define BEHAVESERVERPROTOCOL_H
+
+#include <cstdint>
+
+// Every message on the socket is a fixed header followed by a payload. The
+// length field counts the bytes after itself. All fields and values are in
+// the host's byte order, the server only accepts local connections.
+//
+// A request payload holds numberOfParameters doubles of batch wide
+// parameters, then numberOfRows rows of numberOfColumns doubles, row major.
+// Species lookup requests instead follow their parameters with the species
+// codes as text, one per line.
+//
+// The response payload holds numberOfRows rows of the outputs selected by
+// outputMask, in bit order. A request with outputMask 0 gets every output.
+// A failed request gets a negative status and an error message as payload.
+//
+// Clients may send any number of requests before reading responses, the
+// responses come back as each request finishes, matched by requestId.
+//
+// Units are fixed: moisture and cover in percent, wind speed in miles per
+// hour at 20 feet, slope in percent, directions in degrees clockwise from
+// north, lengths in feet, spread rates in feet per minute, fireline
+// intensity in Btu/ft/s, bulk density in lb/ft3 and spotting distances in
+// miles. Contain uses acres, chains, chains per hour and minutes.
+
+namespace BehaveServerProtocol
+{
+
+const std::uint32_t MaxMessageLength = 256u * 1024u * 1024u;
+
+struct Module
+{
+    enum ModuleEnum
+    {
+        Surface = 1,
+        Crown = 2,
+        Spot = 3,
+        Contain = 4,
+        Mortality = 5,
+        SpeciesLookup = 6
+    };
+};
+
+struct Status
+{
+    enum StatusEnum
+    {
+        Ok = 0,
+        InvalidRequest = -1,    // bad module, sizes or output mask
+        InvalidInput = -2,      // a value out of range, e.g. an unknown enumeration
+        InternalError = -3
+    };
+};
+
+struct RequestHeader
+{
+    std::uint32_t length;               // bytes after this field
+    std::uint32_t requestId;            // echoed in the response
+    std::uint16_t module;               // Module::ModuleEnum
+    std::uint16_t numberOfParameters;
+    std::uint32_t outputMask;           // bit i selects output i, 0 for all
+    std::uint32_t numberOfRows;
+    std::uint32_t numberOfColumns;      // doubles per row
+};
+
+struct ResponseHeader
+{
+    std::uint32_t length;               // bytes after this field
+    std::uint32_t requestId;
+    std::int32_t status;                // Status::StatusEnum
+    std::uint32_t outputMask;           // outputs present in each row
+    std::uint32_t numberOfRows;
+    std::uint32_t numberOfColumns;      // doubles per row
+};
+
+static_assert(sizeof(RequestHeader) == 24, "RequestHeader must have no padding");
+static_assert(sizeof(ResponseHeader) == 24, "ResponseHeader must have no padding");
+
+// Surface: no parameters
+struct SurfaceInput
+{
+    enum SurfaceInputEnum
+    {
+        FuelModelNumber, MoistureOneHour, MoistureTenHour, MoistureHundredHour, MoistureLiveHerbaceous,
+        MoistureLiveWoody, WindSpeed, WindDirection, Slope, Aspect, CanopyCover, CanopyHeight, CrownRatio,
+        NumberOfInputs
+    };
+};
+
+struct SurfaceOutput
+{
+    enum SurfaceOutputEnum
+    {
+        SpreadRate, BackingSpreadRate, FlameLength, FirelineIntensity, DirectionOfMaxSpread,
+        LengthToWidthRatio, HeatPerUnitArea,    // Btu/ft2
+        NumberOfOutputs
+    };
+};
+
+// Crown: parameter 0 is the crown method, 0 Rothermel, 1 Scott and Reinhardt.
+// Rows are the surface inputs followed by these
+struct CrownInput
+{
+    enum CrownInputEnum
+    {
+        CanopyBaseHeight = SurfaceInput::NumberOfInputs, CanopyBulkDensity, MoistureFoliar,
+        NumberOfInputs
+    };
+};
+
+struct CrownOutput
+{
+    enum CrownOutputEnum
+    {
+        SpreadRate, FlameLength, FirelineIntensity, FireType, CrownFireSpreadRate,
+        NumberOfOutputs
+    };
+};
+
+// Spot: parameter 0 is the firebrand source, 0 burning pile, 1 surface fire,
+// 2 torching trees. Columns not used by the source are ignored. Location is
+// 0 midslope windward, 1 valley bottom, 2 midslope leeward or 3 ridge top,
+// the downwind canopy mode 1 closed or 2 open and tree species 0 to 13 as in
+// SpotTreeSpecies
+struct SpotInput
+{
+    enum SpotInputEnum
+    {
+        Location, RidgeToValleyDistance, RidgeToValleyElevation, DownwindCoverHeight, DownwindCanopyMode,
+        WindSpeed, BurningPileFlameHeight, FlameLength, TorchingTrees, DBH, TreeHeight, TreeSpecies,
+        NumberOfInputs
+    };
+};
+
+struct SpotOutput
+{
+    enum SpotOutputEnum
+    {
+        FlatDistance, MountainDistance,
+        NumberOfOutputs
+    };
+};
+
+struct SpotSource
+{
+    enum SpotSourceEnum
+    {
+        BurningPile = 0, SurfaceFire = 1, TorchingTrees = 2
+    };
+};
+
+// Contain: parameter 0 is the number of resource groups per row. Rows are
+// these inputs followed by arrival time, duration and production rate of
+// each resource group. Tactic is 0 head attack or 1 rear attack, the
+// containment status output is a ContainStatus
+struct ContainInput
+{
+    enum ContainInputEnum
+    {
+        ReportSize, ReportRate, LengthToWidthRatio, Tactic, AttackDistance,
+        NumberOfInputs
+    };
+};
+
+const int ContainInputsPerResource = 3;
+
+struct ContainOutput
+{
+    enum ContainOutputEnum
+    {
+        ContainmentStatus, FinalFireLineLength, FinalFireSize, FinalContainmentArea, FinalTimeSinceReport,
+        PerimeterAtContainment,
+        NumberOfOutputs
+    };
+};
+
+// Mortality: parameters are the flame length or scorch height, 1 if it is a
+// scorch height, and the fire severity, -1 not set, 0 empty, 1 low
+struct MortalityParameter
+{
+    enum MortalityParameterEnum
+    {
+        FlameLengthOrScorchHeight, IsScorchHeight, FireSeverity,
+        NumberOfParameters
+    };
+};
+
+struct MortalityInput
+{
+    enum MortalityInputEnum
+    {
+        SpeciesTableIndex, DBH, TreeHeight, CrownRatio, ExpansionFactor, CrownDamage, CambiumKillRating,
+        BeetleDamage, BoleCharHeight,
+        NumberOfInputs
+    };
+};
+
+struct MortalityOutput
+{
+    enum MortalityOutputEnum
+    {
+        ProbabilityOfMortality,
+        NumberOfOutputs
+    };
+};
+
+// Species lookup: parameter 0 is the equation type, 0 crown scorch, 1 bole
+// char, 2 crown damage. Answers one Species Master Table index per code,
+// -1 if not found, for use as the mortality SpeciesTableIndex column
+struct SpeciesLookupOutput
+{
+    enum SpeciesLookupOutputEnum
+    {
+        SpeciesTableIndex,
+        NumberOfOutputs
+    };
+};
+
+}
+
+#endif // BEHAVESERVERPROTOCOL_H
@@ -7,9 +7,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <algorithm>
+#include <vector>
 
 #include "fuelModels.h"
 #include "behaveRun.h"
+#include "behaveTrace.h"
+#include "runResultCache.h"
 
 #define EQUAL(a,b) (strcmp(a,b)==0)
 
@@ -35,10 +38,25 @@ void Usage()
     printf("\nUsage:\n");
     printf("behave-raws-batch [--input-file-name name]   Optional\n");
     printf("                  [--output-file-name name]  Optional\n");
+    printf("                  [--chunk-size n]           Optional\n");
+    printf("                  [--trace name]             Optional\n");
+    printf("                  [--result-cache]           Optional\n");
+    printf("                  [--result-cache-precision moisture wind slope direction]  Optional\n");
     printf("--input-file-name <name>                Optional: Specify input file name\n");
     printf("                                            default file name: input.txt\n");
     printf("--output-file-name <name>               Optional: Specify output file name\n");
     printf("                                            default file name: output.txt\n");
+    printf("--chunk-size <n>                        Optional: Lines read, calculated and written\n");
+    printf("                                            at a time, default 10000\n");
+    printf("--trace <name>                          Optional: Write a Chrome trace event JSON\n");
+    printf("                                            timeline of the chunks to name\n");
+    printf("--result-cache                          Optional: Reuse the results of rows with the\n");
+    printf("                                            same fuel model and inputs\n");
+    printf("--result-cache-precision <moisture> <wind> <slope> <direction>\n");
+    printf("                                        Optional: With --result-cache, rows within half\n");
+    printf("                                            a step of a cached row take its results.\n");
+    printf("                                            Steps in percent, m/s and degrees,\n");
+    printf("                                            default 0 0 0 0 for exact inputs\n");
     printf("\nA properly formatted input file consisting of RAWS data must exist\n");
     printf("RAWS data must be comma delimited and inputs for each behave run separated\nby a new line");
     printf("Inputs must be in the following order within a line:\n");
@@ -61,6 +79,10 @@ int main(int argc, char *argv[])
     std::string inputFileName = "input.txt"; // default input file name
     std::string outFileName = "output.txt"; // default output file name
     std::string runIdentifier = "";
+    std::string traceFileName = "";
+    int chunkSize = 10000;
+    bool isUsingResultCache = false;
+    double resultCacheSteps[4] = { 0.0, 0.0, 0.0, 0.0 }; // moisture, wind speed, slope, direction
 
     // Surface Fire Inputs;
     int fuelModelNumber = 0;
@@ -82,11 +104,11 @@ int main(int argc, char *argv[])
     double spreadRate = 0;
 
     FuelModels fuelModels;
-    BehaveRun behave(fuelModels);
+    SpeciesMasterTable speciesMasterTable;
+    BehaveRun behave(fuelModels, speciesMasterTable);
 
     std::string line = "";
     std::string token = "";
-    std::string outputLine = "";
     std::string spreadRateString = "";
     std::string flameLengthString = "";
 
@@ -126,6 +148,48 @@ int main(int argc, char *argv[])
                     inputFileName += ".txt";
                 }
             }
+            else if (EQUAL(argv[argIndex], "--chunk-size"))
+            {
+                if ((argIndex + 1) > MAX_ARGUMENT_INDEX || atoi(argv[argIndex + 1]) < 1) // An error has occurred
+                {
+                    // Report error
+                    printf("ERROR: Chunk size must be a positive integer\n");
+                    Usage(); // Exits program
+                }
+                chunkSize = atoi(argv[++argIndex]);
+            }
+            else if (EQUAL(argv[argIndex], "--trace"))
+            {
+                if ((argIndex + 1) > MAX_ARGUMENT_INDEX) // An error has occurred
+                {
+                    // Report error
+                    printf("ERROR: No trace file name entered\n");
+                    Usage(); // Exits program
+                }
+                traceFileName = argv[++argIndex];
+            }
+            else if (EQUAL(argv[argIndex], "--result-cache"))
+            {
+                isUsingResultCache = true;
+            }
+            else if (EQUAL(argv[argIndex], "--result-cache-precision"))
+            {
+                if ((argIndex + 4) > MAX_ARGUMENT_INDEX) // An error has occurred
+                {
+                    // Report error
+                    printf("ERROR: Result cache precision needs moisture, wind, slope and direction steps\n");
+                    Usage(); // Exits program
+                }
+                for (int i = 0; i < 4; i++)
+                {
+                    resultCacheSteps[i] = atof(argv[++argIndex]);
+                    if (resultCacheSteps[i] < 0.0)
+                    {
+                        printf("ERROR: Result cache precision steps cannot be negative\n");
+                        Usage(); // Exits program
+                    }
+                }
+            }
             else
             {
                 printf("ERROR: %s is an invalid argument\n", argv[argIndex]);
@@ -162,272 +226,339 @@ int main(int argc, char *argv[])
     int tokenCounter = 0;
     int lineCounter = 0;
 
-    while(getline(inputFile, line))
+    RunResultCache resultCache;
+    if (isUsingResultCache)
     {
-        // Reset variables for new loop iteration
-        lineStream.str("");
-        lineStream.clear();
-        token = "";
-        outputLine = "";
-        spreadRateString = "";
-        flameLengthString = "";
-        tokenCounter = 0;
-        runIdentifier = "";
-        badData = false;
-
-        // Parse arguments from a single line
-        lineStream << line;
-        while(std::getline(lineStream, token, ','))
+        resultCache.setQuantization(resultCacheSteps[0], FractionUnits::Percent, resultCacheSteps[1],
+            SpeedUnits::MetersPerSecond, resultCacheSteps[2], SlopeUnits::Degrees, resultCacheSteps[3]);
+        resultCache.setEnabled(true);
+    }
+
+    if (!traceFileName.empty())
+    {
+        Trace::setThreadName("behave-raws-batch");
+        Trace::start();
+    }
+
+    std::vector<std::string> inputLines;
+    std::string outputChunk = "";
+    bool isEndOfInput = false;
+    while (!isEndOfInput)
+    {
+        std::uint64_t chunkStartTime = Trace::now();
+
+        // Read a chunk of lines
+        inputLines.clear();
         {
-            switch (tokenCounter)
+            TraceSpan span("io", "read input chunk");
+            while ((int)inputLines.size() < chunkSize && getline(inputFile, line))
             {
-                case RAWS_ID:
-                {
-                    runIdentifier += token + ",";
-                    break;
-                }
-                case DATE_TIME:
-                {
-                    runIdentifier += token + ",";
-                    break;
-                }
-                case OBSERVED_OR_PREDICTED:
-                {
-                    runIdentifier += token;
-                    break;
-                }
-                case FUEL_MODEL_NUMBER:
-                {
-                    if (!token.compare("NA") == 0)
-                    {
-                        fuelModelNumber = std::stoi(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (!behave.isFuelModelDefined(fuelModelNumber))
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
-                }
-                case ONE_HOUR:
-                {
-                    if (!token.compare("NA") == 0)
-                    {
-                        moistureOneHr = std::stod(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (moistureOneHr < 0 || moistureOneHr > 1000)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
-                }
-                case TEN_HOUR:
-                {
-                    if (!token.compare("NA") == 0)
-                    {
-                        moistureTenHr = std::stod(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (moistureTenHr < 0 || moistureTenHr > 1000)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
-                }
-                case HUNDRED_HOUR:
-                {
-                    if (!token.compare("NA") == 0)
-                    {
-                        moistureHundredHr = std::stod(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (moistureHundredHr < 0 || moistureHundredHr > 1000)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
-                }
-                case LIVE_HERB:
-                {
-                    if (!token.compare("NA") == 0)
-                    {
-                        moistureLiveHerb = std::stod(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (moistureLiveHerb < 0 || moistureLiveHerb > 1000)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
-                }
-                case LIVE_WOODY:
-                {
-                    if (!token.compare("NA") == 0)
-                    {
-                        moistureLiveWoody = std::stod(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (moistureLiveWoody < 0 || moistureLiveWoody > 1000)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
-                }
-                case WIND_SPEED:
-                {
-                    if (!token.compare("NA") == 0)
-                    {
-                        windSpeed = std::stod(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (windSpeed < 0 || windSpeed > 1000)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
-                }
-                case WIND_DIRECTION:
+                inputLines.push_back(line);
+            }
+            isEndOfInput = ((int)inputLines.size() < chunkSize);
+        }
+        if (inputLines.empty())
+        {
+            break;
+        }
+
+        // Calculate every line of the chunk
+        outputChunk.clear();
+        {
+            TraceSpan span("compute", "compute batch");
+            for (std::size_t lineIndex = 0; lineIndex < inputLines.size(); lineIndex++)
+            {
+                line = inputLines[lineIndex];
+                // Reset variables for new loop iteration
+                lineStream.str("");
+                lineStream.clear();
+                token = "";
+                spreadRateString = "";
+                flameLengthString = "";
+                tokenCounter = 0;
+                runIdentifier = "";
+                badData = false;
+
+                // Parse arguments from a single line
+                lineStream << line;
+                while(std::getline(lineStream, token, ','))
                 {
-                    if (!token.compare("NA") == 0)
-                    {
-                        windDirection = std::stod(token);
-                    }
-                    else
+                    switch (tokenCounter)
                     {
-                        // Data is bad
-                        badData = true;
+                        case RAWS_ID:
+                        {
+                            runIdentifier += token + ",";
+                            break;
+                        }
+                        case DATE_TIME:
+                        {
+                            runIdentifier += token + ",";
+                            break;
+                        }
+                        case OBSERVED_OR_PREDICTED:
+                        {
+                            runIdentifier += token;
+                            break;
+                        }
+                        case FUEL_MODEL_NUMBER:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                fuelModelNumber = std::stoi(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (!behave.isFuelModelDefined(fuelModelNumber))
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case ONE_HOUR:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                moistureOneHr = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (moistureOneHr < 0 || moistureOneHr > 1000)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case TEN_HOUR:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                moistureTenHr = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (moistureTenHr < 0 || moistureTenHr > 1000)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case HUNDRED_HOUR:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                moistureHundredHr = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (moistureHundredHr < 0 || moistureHundredHr > 1000)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case LIVE_HERB:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                moistureLiveHerb = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (moistureLiveHerb < 0 || moistureLiveHerb > 1000)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case LIVE_WOODY:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                moistureLiveWoody = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (moistureLiveWoody < 0 || moistureLiveWoody > 1000)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case WIND_SPEED:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                windSpeed = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (windSpeed < 0 || windSpeed > 1000)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case WIND_DIRECTION:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                windDirection = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (windDirection < -360 || windDirection > 360)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case SLOPE:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                slope = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (slope < 0 || slope > 82)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        case ASPECT:
+                        {
+                            if (!token.compare("NA") == 0)
+                            {
+                                aspect = std::stod(token);
+                            }
+                            else
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            if (aspect < -360|| aspect > 360)
+                            {
+                                // Data is bad
+                                badData = true;
+                            }
+                            break;
+                        }
+                        default:
+                        {
+                            break;
+                        }
                     }
-                    if (windDirection < -360 || windDirection > 360)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
+                    tokenCounter++;
                 }
-                case SLOPE:
+
+                lineCounter++;
+                if (lineCounter % 10000 == 0)
                 {
-                    if (!token.compare("NA") == 0)
-                    {
-                        slope = std::stod(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (slope < 0 || slope > 82)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
+                    printf("processed %d behave runs\n", lineCounter);
                 }
-                case ASPECT:
+
+                // If data is not bad, do calculations
+                if (!badData)
                 {
-                    if (!token.compare("NA") == 0)
-                    {
-                        aspect = std::stod(token);
-                    }
-                    else
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    if (aspect < -360|| aspect > 360)
-                    {
-                        // Data is bad
-                        badData = true;
-                    }
-                    break;
+                    // Feed input values to behave
+                    behave.surface.updateSurfaceInputs(fuelModelNumber, moistureOneHr,
+                        moistureTenHr, moistureHundredHr, moistureLiveHerb,
+                        moistureLiveWoody, FractionUnits::Percent, windSpeed,
+                        SpeedUnits::MetersPerSecond,
+                        WindHeightInputMode::DirectMidflame, windDirection,
+                        WindAndSpreadOrientationMode::RelativeToNorth, slope,
+                        SlopeUnits::Degrees, aspect, canopyCover, FractionUnits::Percent,
+                        canopyHeight, LengthUnits::Feet, crownRatio);
+                    // Calculate spread rate and flame length, skipped for rows already in the cache
+                    RunResult result = resultCache.doSurfaceRunInDirectionOfMaxSpread(behave.surface);
+                    spreadRate = SpeedUnits::fromBaseUnits(result.spreadRate, SpeedUnits::MetersPerSecond);
+                    flameLength = LengthUnits::fromBaseUnits(result.flameLength, LengthUnits::Meters);
+                    // Convert data to string for output to file
+                    spreadRateString = std::to_string(spreadRate);
+                    flameLengthString = std::to_string(flameLength);
                 }
-                default:
+                else
                 {
-                    break;
+                    // Data is bad
+                    spreadRateString = "NA";
+                    flameLengthString = "NA";
                 }
+
+                // Add line to output chunk
+                outputChunk += runIdentifier + "," + spreadRateString + "," + flameLengthString + '\n';
             }
-            tokenCounter++;
         }
 
-        lineCounter++;
-        if (lineCounter % 10000 == 0)
+        // Write the chunk
         {
-            printf("processed %d behave runs\n", lineCounter);
+            TraceSpan span("io", "flush output chunk");
+            outputFile << outputChunk;
         }
 
-        // If data is not bad, do calculations
-        if (!badData)
-        {
-            // Feed input values to behave
-            behave.surface.updateSurfaceInputs(fuelModelNumber, moistureOneHr,
-                moistureTenHr, moistureHundredHr, moistureLiveHerb,
-                moistureLiveWoody, MoistureUnits::Percent, windSpeed,
-                SpeedUnits::MetersPerSecond,
-                WindHeightInputMode::DirectMidflame, windDirection,
-                WindAndSpreadOrientationMode::RelativeToNorth, slope,
-                SlopeUnits::Degrees, aspect, canopyCover, CoverUnits::Percent,
-                canopyHeight, LengthUnits::Feet, crownRatio);
-            // Calculate spread rate and flame length
-            behave.surface.doSurfaceRunInDirectionOfMaxSpread();
-            // Get the surface fire spread rate
-            spreadRate = behave.surface.getSpreadRate(SpeedUnits::MetersPerSecond);
-            // Get other required outputs
-            flameLength = behave.surface.getFlameLength(LengthUnits::Meters);
-            // Convert data to string for output to file
-            spreadRateString = std::to_string(spreadRate);
-            flameLengthString = std::to_string(flameLength);
-        }
-        else
+        if (Trace::isRecording())
         {
-            // Data is bad
-            spreadRateString = "NA";
-            flameLengthString = "NA";
+            double chunkSeconds = (Trace::now() - chunkStartTime) * 1e-9;
+            Trace::addCounter("rows per second", (chunkSeconds > 0.0) ? inputLines.size() / chunkSeconds : 0.0);
         }
-
-        // Print line to output file
-        outputLine = runIdentifier + "," + spreadRateString + "," + flameLengthString;
-        outputFile << outputLine << '\n';
     }
 
     // Close input and output files
     inputFile.close();
     outputFile.close();
 
+    if (!traceFileName.empty())
+    {
+        Trace::stop();
+        if (!Trace::writeChromeTrace(traceFileName))
+        {
+            printf("ERROR: could not write trace file %s\n", traceFileName.c_str());
+            return 1;
+        }
+    }
+
+    if (isUsingResultCache)
+    {
+        printf("Result cache: %llu hits, %llu misses, %llu uncached\n", resultCache.getHits(),
+            resultCache.getMisses(), resultCache.getBypasses());
+    }
+
     printf("Done!\n\n");
 
     return 0; // Success
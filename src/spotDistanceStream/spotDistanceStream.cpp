@@ -0,0 +1,520 @@
+/******************************************************************************
+ *
+ * $Id$
+ *
+ * Project:  Spotting distance
+ * Purpose:  Streaming stdin/stdout mode shared by the spotting distance tools
+ * Author:   Natalie Wagenbrenner <nwagenbrenner@gmail.com> 
+ *
+ ******************************************************************************
+ *
+ * THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+ * MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT 
+ * IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105 
+ * OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT 
+ * PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES 
+ * LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER 
+ * PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY, 
+ * RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#include "spotDistanceStream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+// Lines read before results are written when more than one thread is used,
+// a single thread answers every line as soon as it is read
+const int defaultStreamBatchSize = 256;
+// Lines a worker takes from the batch at a time
+const std::size_t streamChunkSize = 16;
+
+struct SpotStreamLine
+{
+    int lineNumber = 0;
+    SpotStreamScenario scenario;
+    std::string error;          // set if the line could not be parsed
+};
+
+std::string trim(const std::string& text)
+{
+    const char* whitespace = " \t\r\n";
+    std::string::size_type begin = text.find_first_not_of(whitespace);
+    if (begin == std::string::npos)
+    {
+        return "";
+    }
+    std::string::size_type end = text.find_last_not_of(whitespace);
+    return text.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> split(const std::string& text, const char* separators)
+{
+    std::vector<std::string> tokens;
+    std::string::size_type begin = 0;
+    while (begin <= text.size())
+    {
+        std::string::size_type end = text.find_first_of(separators, begin);
+        if (end == std::string::npos)
+        {
+            end = text.size();
+        }
+        tokens.push_back(trim(text.substr(begin, end - begin)));
+        begin = end + 1;
+    }
+    return tokens;
+}
+
+bool isStreamField(const std::string& name, const std::vector<std::string>& fieldNames,
+    const std::vector<std::string>& optionalFieldNames)
+{
+    return std::find(fieldNames.begin(), fieldNames.end(), name) != fieldNames.end()
+        || std::find(optionalFieldNames.begin(), optionalFieldNames.end(), name) != optionalFieldNames.end();
+}
+
+bool parseKeyValueLine(const std::string& text, const std::vector<std::string>& fieldNames,
+    const std::vector<std::string>& optionalFieldNames, SpotStreamScenario& scenario, std::string& error)
+{
+    std::vector<std::string> tokens = split(text, ", \t");
+    for (std::size_t i = 0; i < tokens.size(); i++)
+    {
+        if (tokens[i].empty())
+        {
+            continue;
+        }
+        std::string::size_type equals = tokens[i].find('=');
+        if (equals == std::string::npos)
+        {
+            error = "expected key=value, found " + tokens[i];
+            return false;
+        }
+        std::string name = trim(tokens[i].substr(0, equals));
+        if (name.compare(0, 2, "--") == 0)
+        {
+            name = name.substr(2);
+        }
+        if (!isStreamField(name, fieldNames, optionalFieldNames))
+        {
+            error = "unknown field " + name;
+            return false;
+        }
+        scenario.setValue(name, trim(tokens[i].substr(equals + 1)));
+    }
+    for (std::size_t i = 0; i < fieldNames.size(); i++)
+    {
+        if (!scenario.hasValue(fieldNames[i]))
+        {
+            error = "missing " + fieldNames[i];
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseCsvLine(const std::string& text, const std::vector<std::string>& fieldNames,
+    const std::vector<std::string>& optionalFieldNames, SpotStreamScenario& scenario, std::string& error)
+{
+    std::vector<std::string> tokens = split(text, ",");
+    if (tokens.size() < fieldNames.size() || tokens.size() > fieldNames.size() + optionalFieldNames.size())
+    {
+        error = "expected " + std::to_string(fieldNames.size()) + " fields, found " + std::to_string(tokens.size());
+        return false;
+    }
+    for (std::size_t i = 0; i < tokens.size(); i++)
+    {
+        const std::string& name = (i < fieldNames.size()) ? fieldNames[i] : optionalFieldNames[i - fieldNames.size()];
+        scenario.setValue(name, tokens[i]);
+    }
+    return true;
+}
+
+class SpotStreamWorkerPool
+{
+public:
+    SpotStreamWorkerPool(int numberOfThreads, const SpotStreamCalculation& calculate);
+    ~SpotStreamWorkerPool();
+
+    void run(const std::vector<SpotStreamLine>& lines, std::vector<SpotStreamResult>& results);
+
+private:
+    SpotStreamWorkerPool(const SpotStreamWorkerPool&) = delete;
+    SpotStreamWorkerPool& operator=(const SpotStreamWorkerPool&) = delete;
+
+    void workerLoop(int worker);
+    void calculateLines(Spot& spot);
+
+    const SpotStreamCalculation& calculate_;
+    std::vector<Spot> spots_;           // one per worker, the calling thread uses the first
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable workReady_;
+    std::condition_variable workDone_;
+    unsigned long generation_;          // incremented for every batch handed to the workers
+    int busyWorkers_;
+    bool isStopping_;
+    const std::vector<SpotStreamLine>* lines_;
+    std::vector<SpotStreamResult>* results_;
+    std::atomic<std::size_t> nextLine_;
+};
+
+SpotStreamWorkerPool::SpotStreamWorkerPool(int numberOfThreads, const SpotStreamCalculation& calculate)
+    : calculate_(calculate),
+    spots_(std::max(numberOfThreads, 1)),
+    generation_(0),
+    busyWorkers_(0),
+    isStopping_(false),
+    lines_(nullptr),
+    results_(nullptr),
+    nextLine_(0)
+{
+    for (int worker = 1; worker < numberOfThreads; worker++)
+    {
+        threads_.push_back(std::thread(&SpotStreamWorkerPool::workerLoop, this, worker));
+    }
+}
+
+SpotStreamWorkerPool::~SpotStreamWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopping_ = true;
+    }
+    workReady_.notify_all();
+    for (std::size_t i = 0; i < threads_.size(); i++)
+    {
+        threads_[i].join();
+    }
+}
+
+void SpotStreamWorkerPool::run(const std::vector<SpotStreamLine>& lines, std::vector<SpotStreamResult>& results)
+{
+    results.assign(lines.size(), SpotStreamResult());
+    // Batches of a chunk or less are not worth waking the workers for
+    bool isShared = !threads_.empty() && lines.size() > streamChunkSize;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lines_ = &lines;
+        results_ = &results;
+        nextLine_ = 0;
+        if (isShared)
+        {
+            busyWorkers_ = (int)threads_.size();
+            generation_++;
+        }
+    }
+    if (isShared)
+    {
+        workReady_.notify_all();
+    }
+
+    calculateLines(spots_[0]);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    workDone_.wait(lock, [this] { return busyWorkers_ == 0; });
+}
+
+void SpotStreamWorkerPool::workerLoop(int worker)
+{
+    unsigned long finishedGeneration = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            workReady_.wait(lock, [this, finishedGeneration] { return isStopping_ || generation_ != finishedGeneration; });
+            if (isStopping_)
+            {
+                return;
+            }
+            finishedGeneration = generation_;
+        }
+
+        calculateLines(spots_[worker]);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--busyWorkers_ == 0)
+        {
+            workDone_.notify_one();
+        }
+    }
+}
+
+void SpotStreamWorkerPool::calculateLines(Spot& spot)
+{
+    const std::vector<SpotStreamLine>& lines = *lines_;
+    std::vector<SpotStreamResult>& results = *results_;
+    for (;;)
+    {
+        std::size_t begin = nextLine_.fetch_add(streamChunkSize);
+        if (begin >= lines.size())
+        {
+            return;
+        }
+        std::size_t end = std::min(begin + streamChunkSize, lines.size());
+        for (std::size_t i = begin; i < end; i++)
+        {
+            if (lines[i].error.empty())
+            {
+                calculate_(spot, lines[i].scenario, results[i]);
+            }
+            else
+            {
+                results[i].error = lines[i].error;
+            }
+        }
+    }
+}
+
+void writeResult(std::ostream& out, int lineNumber, const SpotStreamResult& result)
+{
+    if (result.isValid)
+    {
+        out << result.mountainSpottingDistance << "," << result.flatSpottingDistance << "\n";
+    }
+    else
+    {
+        out << "error," << lineNumber << "," << result.error << "\n";
+    }
+}
+
+} // namespace
+
+void SpotStreamScenario::setValue(const std::string& name, const std::string& value)
+{
+    values_[name] = value;
+}
+
+bool SpotStreamScenario::hasValue(const std::string& name) const
+{
+    return values_.find(name) != values_.end();
+}
+
+const std::string& SpotStreamScenario::getValue(const std::string& name) const
+{
+    static const std::string empty;
+    std::map<std::string, std::string>::const_iterator value = values_.find(name);
+    return (value != values_.end()) ? value->second : empty;
+}
+
+bool SpotStreamScenario::getNumber(const std::string& name, double& value, std::string& error) const
+{
+    const std::string& text = getValue(name);
+    char* end = nullptr;
+    value = strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || !std::isfinite(value))
+    {
+        error = name + " is not a number: " + text;
+        return false;
+    }
+    return true;
+}
+
+bool isSpotStreamRequested(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--stream") == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseSpotStreamArguments(int argc, char *argv[], SpotStreamOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--stream") == 0)
+        {
+            continue;
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            options.numberOfThreads = atoi(argv[++i]);
+            if (options.numberOfThreads < 0)
+            {
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+        {
+            options.batchSize = atoi(argv[++i]);
+            if (options.batchSize < 0)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int runSpotDistanceStream(const std::vector<std::string>& fieldNames, const std::vector<std::string>& optionalFieldNames,
+    const SpotStreamCalculation& calculate, const SpotStreamOptions& options, std::istream& in, std::ostream& out)
+{
+    int numberOfThreads = options.numberOfThreads;
+    if (numberOfThreads == 0)
+    {
+        numberOfThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+    }
+    int batchSize = options.batchSize;
+    if (batchSize == 0)
+    {
+        batchSize = (numberOfThreads > 1) ? defaultStreamBatchSize : 1;
+    }
+
+    SpotStreamWorkerPool workerPool(numberOfThreads, calculate);
+    std::vector<SpotStreamLine> lines;
+    std::vector<SpotStreamResult> results;
+    std::string text;
+    int lineNumber = 0;
+    bool isEndOfStream = false;
+
+    while (!isEndOfStream)
+    {
+        lines.clear();
+        while ((int)lines.size() < batchSize)
+        {
+            if (!std::getline(in, text))
+            {
+                isEndOfStream = true;
+                break;
+            }
+            lineNumber++;
+            text = trim(text);
+            if (text.empty() || text[0] == '#')
+            {
+                continue;
+            }
+            bool isKeyValueLine = (text.find('=') != std::string::npos);
+            if (!isKeyValueLine && split(text, ",")[0] == fieldNames[0])
+            {
+                // CSV header
+                continue;
+            }
+            lines.push_back(SpotStreamLine());
+            SpotStreamLine& line = lines.back();
+            line.lineNumber = lineNumber;
+            if (isKeyValueLine)
+            {
+                parseKeyValueLine(text, fieldNames, optionalFieldNames, line.scenario, line.error);
+            }
+            else
+            {
+                parseCsvLine(text, fieldNames, optionalFieldNames, line.scenario, line.error);
+            }
+        }
+        if (lines.empty())
+        {
+            continue;
+        }
+
+        workerPool.run(lines, results);
+        for (std::size_t i = 0; i < lines.size(); i++)
+        {
+            writeResult(out, lines[i].lineNumber, results[i]);
+        }
+        out.flush();
+    }
+
+    return out ? 0 : 1;
+}
+
+bool parseSpotFireLocation(const std::string& text, SpotFireLocation::SpotFireLocationEnum& location)
+{
+    if (text == "RIDGE_TOP")
+    {
+        location = SpotFireLocation::RIDGE_TOP;
+    }
+    else if (text == "MIDSLOPE_WINDWARD")
+    {
+        location = SpotFireLocation::MIDSLOPE_WINDWARD;
+    }
+    else if (text == "VALLEY_BOTTOM")
+    {
+        location = SpotFireLocation::VALLEY_BOTTOM;
+    }
+    else if (text == "MIDSLOPE_LEEWARD")
+    {
+        location = SpotFireLocation::MIDSLOPE_LEEWARD;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool parseSpotDownWindCanopyMode(const std::string& text, SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum& downwindCanopyMode)
+{
+    if (text == "CLOSED")
+    {
+        downwindCanopyMode = SpotDownWindCanopyMode::CLOSED;
+    }
+    else if (text == "OPEN")
+    {
+        downwindCanopyMode = SpotDownWindCanopyMode::OPEN;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool parseSpotTreeSpecies(const std::string& text, SpotTreeSpecies::SpotTreeSpeciesEnum& treeSpecies)
+{
+    static const struct
+    {
+        const char* name;
+        SpotTreeSpecies::SpotTreeSpeciesEnum species;
+    } speciesNames[] =
+    {
+        { "ENGELMANN_SPRUCE", SpotTreeSpecies::ENGELMANN_SPRUCE },
+        { "ENGLEMANN_SPRUCE", SpotTreeSpecies::ENGELMANN_SPRUCE }, // spelling the tool has always accepted
+        { "DOUGLAS_FIR", SpotTreeSpecies::DOUGLAS_FIR },
+        { "SUBALPINE_FIR", SpotTreeSpecies::SUBALPINE_FIR },
+        { "WESTERN_HEMLOCK", SpotTreeSpecies::WESTERN_HEMLOCK },
+        { "PONDEROSA_PINE", SpotTreeSpecies::PONDEROSA_PINE },
+        { "LODGEPOLE_PINE", SpotTreeSpecies::LODGEPOLE_PINE },
+        { "WESTERN_WHITE_PINE", SpotTreeSpecies::WESTERN_WHITE_PINE },
+        { "GRAND_FIR", SpotTreeSpecies::GRAND_FIR },
+        { "BALSAM_FIR", SpotTreeSpecies::BALSAM_FIR },
+        { "SLASH_PINE", SpotTreeSpecies::SLASH_PINE },
+        { "LONGLEAF_PINE", SpotTreeSpecies::LONGLEAF_PINE },
+        { "POND_PINE", SpotTreeSpecies::POND_PINE },
+        { "SHORTLEAF_PINE", SpotTreeSpecies::SHORTLEAF_PINE },
+        { "LOBLOLLY_PINE", SpotTreeSpecies::LOBLOLLY_PINE }
+    };
+    for (std::size_t i = 0; i < sizeof(speciesNames) / sizeof(speciesNames[0]); i++)
+    {
+        if (text == speciesNames[i].name)
+        {
+            treeSpecies = speciesNames[i].species;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+ *
+ * $Id$
+ *
+ * Project:  Spotting distance
+ * Purpose:  Streaming stdin/stdout mode shared by the spotting distance tools
+ * Author:   Natalie Wagenbrenner <nwagenbrenner@gmail.com> 
+ *
+ ******************************************************************************
+ *
+ * THIS SOFTWARE WAS DEVELOPED AT THE ROCKY MOUNTAIN RESEARCH STATION (RMRS)
+ * MISSOULA FIRE SCIENCES LABORATORY BY EMPLOYEES OF THE FEDERAL GOVERNMENT 
+ * IN THE COURSE OF THEIR OFFICIAL DUTIES. PURSUANT TO TITLE 17 SECTION 105 
+ * OF THE UNITED STATES CODE, THIS SOFTWARE IS NOT SUBJECT TO COPYRIGHT 
+ * PROTECTION AND IS IN THE PUBLIC DOMAIN. RMRS MISSOULA FIRE SCIENCES 
+ * LABORATORY ASSUMES NO RESPONSIBILITY WHATSOEVER FOR ITS USE BY OTHER 
+ * PARTIES,  AND MAKES NO GUARANTEES, EXPRESSED OR IMPLIED, ABOUT ITS QUALITY, 
+ * RELIABILITY, OR ANY OTHER CHARACTERISTIC.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef SPOTDISTANCESTREAM_H
+#define SPOTDISTANCESTREAM_H
+
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "behaveRun.h"
+
+// One scenario read from a stream line, keyed by the command line option
+// names without the leading "--", e.g. "20ft_wind_speed"
+class SpotStreamScenario
+{
+public:
+    void setValue(const std::string& name, const std::string& value);
+    bool hasValue(const std::string& name) const;
+    const std::string& getValue(const std::string& name) const;
+    bool getNumber(const std::string& name, double& value, std::string& error) const;
+
+private:
+    std::map<std::string, std::string> values_;
+};
+
+struct SpotStreamResult
+{
+    bool isValid = false;
+    double mountainSpottingDistance = 0.0;
+    double flatSpottingDistance = 0.0;
+    std::string error;
+};
+
+// Fills result for one scenario, every worker calls it with its own Spot
+typedef std::function<void(Spot& spot, const SpotStreamScenario& scenario, SpotStreamResult& result)> SpotStreamCalculation;
+
+struct SpotStreamOptions
+{
+    int numberOfThreads = 1;   // 0 for one per hardware thread
+    int batchSize = 0;          // lines read before results are written and flushed, 0 for the default
+};
+
+// True if argv holds --stream
+bool isSpotStreamRequested(int argc, char *argv[]);
+// Reads --stream [--threads n] [--batch n], returns false on anything else
+bool parseSpotStreamArguments(int argc, char *argv[], SpotStreamOptions& options);
+
+// Reads newline-delimited scenarios from in and writes one line
+// "mountainSpottingDistance,flatSpottingDistance" per scenario to out, in input order.
+// A line is either CSV in the order of fieldNames or key=value pairs, for example
+// "location=RIDGE_TOP,20ft_wind_speed=10,...". Blank lines, lines starting with '#'
+// and a CSV header line naming fieldNames[0] are skipped. Fields in optionalFieldNames
+// may be left off the end of a CSV line or out of a key=value line. A scenario that
+// can not be calculated writes "error,<line number>,<message>" instead.
+int runSpotDistanceStream(const std::vector<std::string>& fieldNames, const std::vector<std::string>& optionalFieldNames,
+    const SpotStreamCalculation& calculate, const SpotStreamOptions& options, std::istream& in, std::ostream& out);
+
+bool parseSpotFireLocation(const std::string& text, SpotFireLocation::SpotFireLocationEnum& location);
+bool parseSpotDownWindCanopyMode(const std::string& text, SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum& downwindCanopyMode);
+bool parseSpotTreeSpecies(const std::string& text, SpotTreeSpecies::SpotTreeSpeciesEnum& treeSpecies);
+
+#endif // SPOTDISTANCESTREAM_H
@@ -27,6 +27,7 @@
  *
  *****************************************************************************/
 #include "behaveRun.h"
+#include "spotDistanceStream.h"
 #include <iostream>
 using namespace std;
 
@@ -38,6 +39,8 @@ void Usage()
     printf("compute_spot_distance_surface --location location --ridge_to_valley_distance distance\n");
     printf("      --ridge_to_valley_elevation elevation --downwind_cover_height height\n");
     printf("      --20ft_speed speed --flame_length length [--verbose]\n");
+    printf("      [--downwind_canopy_mode mode]\n");
+    printf("compute_spot_distance_surface --stream [--threads n] [--batch n]\n");
     printf("\n");
     printf("Returns:\n");
     printf("Spotting distance [m]\n");
@@ -55,14 +58,79 @@ void Usage()
     printf("    MIDSLOPE_LEEWARD\n");
     printf("    RIDGE_TOP\n");
     printf("\n");
+    printf("downwind_canopy_mode options (CLOSED if not given):\n");
+    printf("    CLOSED\n");
+    printf("    OPEN\n");
+    printf("\n");
     printf("Example:\n");
     printf("compute_spot_distance_surface --location RIDGE_TOP --ridge_to_valley_distance 1000 ");
     printf("--ridge_to_valley_elevation 2000 --downwind_cover_height 15 --20ft_wind_speed 10 ");
     printf("--flame_length 5\n");
     printf("\n");
+    printf("Stream mode:\n");
+    printf("Reads one scenario per line from stdin, either CSV in the order\n");
+    printf("    location,ridge_to_valley_distance,ridge_to_valley_elevation,\n");
+    printf("    downwind_cover_height,20ft_wind_speed,flame_length[,downwind_canopy_mode]\n");
+    printf("or key=value pairs named after the options above, and writes\n");
+    printf("mountainSpottingDistance,flatSpottingDistance [m] per scenario to stdout.\n");
+    printf("Results are flushed per line, or per --batch lines (256 by default with\n");
+    printf("more than one thread). --threads 0 uses one thread per processor.\n");
+    printf("\n");
     exit(1);
 }
 
+void calculateStreamScenario(Spot& spot, const SpotStreamScenario& scenario, SpotStreamResult& result)
+{
+    SpotFireLocation::SpotFireLocationEnum location;
+    SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum downwindCanopyMode = SpotDownWindCanopyMode::CLOSED;
+    double ridgeToValleyDistance = -1.0;
+    double ridgeToValleyElevation = -1.0;
+    double downwindCoverHeight = -1.0;
+    double windSpeedAtTwentyFeet = -1.0;
+    double flameLength = -1.0;
+
+    if(!parseSpotFireLocation(scenario.getValue("location"), location))
+    {
+        result.error = "location option " + scenario.getValue("location") + " not valid.";
+        return;
+    }
+    if(scenario.hasValue("downwind_canopy_mode")
+        && !parseSpotDownWindCanopyMode(scenario.getValue("downwind_canopy_mode"), downwindCanopyMode))
+    {
+        result.error = "downwind_canopy_mode option " + scenario.getValue("downwind_canopy_mode") + " not valid.";
+        return;
+    }
+    if(!scenario.getNumber("ridge_to_valley_distance", ridgeToValleyDistance, result.error)
+        || !scenario.getNumber("ridge_to_valley_elevation", ridgeToValleyElevation, result.error)
+        || !scenario.getNumber("downwind_cover_height", downwindCoverHeight, result.error)
+        || !scenario.getNumber("20ft_wind_speed", windSpeedAtTwentyFeet, result.error)
+        || !scenario.getNumber("flame_length", flameLength, result.error))
+    {
+        return;
+    }
+
+    spot.updateSpotInputsForSurfaceFire(location, ridgeToValleyDistance,
+            LengthUnits::Meters, ridgeToValleyElevation, LengthUnits::Meters,
+            downwindCoverHeight, LengthUnits::Meters, downwindCanopyMode, windSpeedAtTwentyFeet, SpeedUnits::MetersPerSecond,
+            flameLength, LengthUnits::Meters);
+
+    spot.calculateSpottingDistanceFromSurfaceFire();
+
+    result.mountainSpottingDistance = spot.getMaxMountainousTerrainSpottingDistanceFromSurfaceFire(LengthUnits::Meters);
+    result.flatSpottingDistance = spot.getMaxFlatTerrainSpottingDistanceFromSurfaceFire(LengthUnits::Meters);
+    result.isValid = true;
+}
+
+int runStream(const SpotStreamOptions& streamOptions)
+{
+    const char* fieldNames[] = { "location", "ridge_to_valley_distance", "ridge_to_valley_elevation", "downwind_cover_height", "20ft_wind_speed", "flame_length" };
+    std::vector<std::string> requiredFields(fieldNames, fieldNames + sizeof(fieldNames) / sizeof(fieldNames[0]));
+    std::vector<std::string> optionalFields(1, "downwind_canopy_mode");
+
+    std::ios::sync_with_stdio(false);
+    return runSpotDistanceStream(requiredFields, optionalFields, calculateStreamScenario, streamOptions, cin, cout);
+}
+
 int main(int argc, char *argv[])
 {
     std::string spotLocation = "!set";
@@ -71,9 +139,21 @@ int main(int argc, char *argv[])
     double downwindCoverHeight = -1.0;
     double windSpeedAtTwentyFeet = -1.0;
     double flameLength = -1.0;
+    std::string canopyMode = "CLOSED";
     bool verbose = false;
 
     SpotFireLocation::SpotFireLocationEnum location;
+    SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum downwindCanopyMode = SpotDownWindCanopyMode::CLOSED;
+
+    if(isSpotStreamRequested(argc, argv))
+    {
+        SpotStreamOptions streamOptions;
+        if(!parseSpotStreamArguments(argc, argv, streamOptions))
+        {
+            Usage();
+        }
+        return runStream(streamOptions);
+    }
 
     if(argc < 12){
         Usage();
@@ -85,23 +165,7 @@ int main(int argc, char *argv[])
         if(EQUAL(argv[i], "--location"))
         {
             spotLocation = argv[++i];
-            if(EQUAL(spotLocation.c_str(), "RIDGE_TOP"))
-            {
-                location = SpotFireLocation::RIDGE_TOP;
-            }
-            else if(EQUAL(spotLocation.c_str(), "MIDSLOPE_WINDWARD"))
-            {
-                location = SpotFireLocation::MIDSLOPE_WINDWARD;
-            }
-            else if(EQUAL(spotLocation.c_str(), "VALLEY_BOTTOM"))
-            {
-                location = SpotFireLocation::VALLEY_BOTTOM;
-            }
-            else if(EQUAL(spotLocation.c_str(), "MIDSLOPE_LEEWARD"))
-            {
-                location = SpotFireLocation::MIDSLOPE_LEEWARD;
-            }
-            else
+            if(!parseSpotFireLocation(spotLocation, location))
             {
                 cout<<"location option "<<argv[i]<<" not valid."<<endl;
                 exit(-1);
@@ -127,6 +191,15 @@ int main(int argc, char *argv[])
         {
             flameLength = atof(argv[++i]);
         }
+        else if(EQUAL(argv[i], "--downwind_canopy_mode"))
+        {
+            canopyMode = argv[++i];
+            if(!parseSpotDownWindCanopyMode(canopyMode, downwindCanopyMode))
+            {
+                cout<<"downwind_canopy_mode option "<<argv[i]<<" not valid."<<endl;
+                exit(-1);
+            }
+        }
         else if(EQUAL(argv[i], "--verbose"))
         {
             verbose = true;
@@ -143,6 +216,7 @@ int main(int argc, char *argv[])
         cout<<"ridge_to_valley           = "<<ridgeToValleyDistance<<" m"<<endl;
         cout<<"ridge_to_valley_elevation = "<<ridgeToValleyElevation<<" m"<<endl;
         cout<<"downwind_cover_height     = "<<downwindCoverHeight<<" m"<<endl;
+        cout<<"downwind_canopy_mode      = "<<canopyMode<<endl;
         cout<<"20ft_wind_speed           = "<<windSpeedAtTwentyFeet<<" m/s"<<endl;
         cout<<"flame_length              = "<<flameLength<<" m"<<endl;
     }
@@ -163,7 +237,7 @@ int main(int argc, char *argv[])
     //spotting distance from surface fire
     spot.updateSpotInputsForSurfaceFire(location, ridgeToValleyDistance,
             ridgeToValleyDistanceUnits, ridgeToValleyElevation, elevationUnits,
-            downwindCoverHeight, coverHeightUnits, windSpeedAtTwentyFeet, windSpeedUnits,
+            downwindCoverHeight, coverHeightUnits, downwindCanopyMode, windSpeedAtTwentyFeet, windSpeedUnits,
             flameLength, flameLengthUnits);
 
     spot.calculateSpottingDistanceFromSurfaceFire();
@@ -27,6 +27,7 @@
  *
  *****************************************************************************/
 #include "behaveRun.h"
+#include "spotDistanceStream.h"
 #include <iostream>
 using namespace std;
 
@@ -40,6 +41,8 @@ void Usage()
     printf("      --20ft_speed speed --number_torching_trees number\n");
     printf("      --dbh dbh --tree_height height\n");
     printf("      --tree_species species [--verbose]\n");
+    printf("      [--downwind_canopy_mode mode]\n");
+    printf("compute_spot_distance_trees --stream [--threads n] [--batch n]\n");
     printf("\n");
     printf("Returns:\n");
     printf("Spotting distance [m]\n");
@@ -57,6 +60,10 @@ void Usage()
     printf("    MIDSLOPE_LEEWARD\n");
     printf("    RIDGE_TOP\n");
     printf("\n");
+    printf("downwind_canopy_mode options (CLOSED if not given):\n");
+    printf("    CLOSED\n");
+    printf("    OPEN\n");
+    printf("\n");
     printf("species options:\n");
     printf("    ENGLEMANN_SPRUCE\n");
     printf("    DOUGLAS_FIR\n");
@@ -78,9 +85,81 @@ void Usage()
     printf("--ridge_to_valley_elevation 2000 --downwind_cover_height 15 --20ft_wind_speed 10 ");
     printf("--number_torching_trees 15 --dbh 30 --tree_height 15 --tree_species ENGLEMANN_SPRUCE\n");
     printf("\n");
+    printf("Stream mode:\n");
+    printf("Reads one scenario per line from stdin, either CSV in the order\n");
+    printf("    location,ridge_to_valley_distance,ridge_to_valley_elevation,\n");
+    printf("    downwind_cover_height,20ft_wind_speed,number_torching_trees,\n");
+    printf("    dbh,tree_height,tree_species[,downwind_canopy_mode]\n");
+    printf("or key=value pairs named after the options above, and writes\n");
+    printf("mountainSpottingDistance,flatSpottingDistance [m] per scenario to stdout.\n");
+    printf("Results are flushed per line, or per --batch lines (256 by default with\n");
+    printf("more than one thread). --threads 0 uses one thread per processor.\n");
+    printf("\n");
     exit(1);
 }
 
+void calculateStreamScenario(Spot& spot, const SpotStreamScenario& scenario, SpotStreamResult& result)
+{
+    SpotFireLocation::SpotFireLocationEnum location;
+    SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum downwindCanopyMode = SpotDownWindCanopyMode::CLOSED;
+    double ridgeToValleyDistance = -1.0;
+    double ridgeToValleyElevation = -1.0;
+    double downwindCoverHeight = -1.0;
+    double windSpeedAtTwentyFeet = -1.0;
+    double torchingTrees = -1.0;
+    double DBH = -1.0;
+    double treeHeight = -1.0;
+    SpotTreeSpecies::SpotTreeSpeciesEnum treeSpecies;
+
+    if(!parseSpotFireLocation(scenario.getValue("location"), location))
+    {
+        result.error = "location option " + scenario.getValue("location") + " not valid.";
+        return;
+    }
+    if(scenario.hasValue("downwind_canopy_mode")
+        && !parseSpotDownWindCanopyMode(scenario.getValue("downwind_canopy_mode"), downwindCanopyMode))
+    {
+        result.error = "downwind_canopy_mode option " + scenario.getValue("downwind_canopy_mode") + " not valid.";
+        return;
+    }
+    if(!parseSpotTreeSpecies(scenario.getValue("tree_species"), treeSpecies))
+    {
+        result.error = "tree_species option " + scenario.getValue("tree_species") + " not valid.";
+        return;
+    }
+    if(!scenario.getNumber("ridge_to_valley_distance", ridgeToValleyDistance, result.error)
+        || !scenario.getNumber("ridge_to_valley_elevation", ridgeToValleyElevation, result.error)
+        || !scenario.getNumber("downwind_cover_height", downwindCoverHeight, result.error)
+        || !scenario.getNumber("20ft_wind_speed", windSpeedAtTwentyFeet, result.error)
+        || !scenario.getNumber("number_torching_trees", torchingTrees, result.error)
+        || !scenario.getNumber("dbh", DBH, result.error)
+        || !scenario.getNumber("tree_height", treeHeight, result.error))
+    {
+        return;
+    }
+
+    spot.updateSpotInputsForTorchingTrees(location, ridgeToValleyDistance,
+            LengthUnits::Meters, ridgeToValleyElevation, LengthUnits::Meters,
+            downwindCoverHeight, LengthUnits::Meters, downwindCanopyMode, (int)torchingTrees, DBH, LengthUnits::Centimeters,
+            treeHeight, LengthUnits::Meters, treeSpecies, windSpeedAtTwentyFeet, SpeedUnits::MetersPerSecond);
+
+    spot.calculateSpottingDistanceFromTorchingTrees();
+
+    result.mountainSpottingDistance = spot.getMaxMountainousTerrainSpottingDistanceFromTorchingTrees(LengthUnits::Meters);
+    result.flatSpottingDistance = spot.getMaxFlatTerrainSpottingDistanceFromTorchingTrees(LengthUnits::Meters);
+    result.isValid = true;
+}
+
+int runStream(const SpotStreamOptions& streamOptions)
+{
+    const char* fieldNames[] = { "location", "ridge_to_valley_distance", "ridge_to_valley_elevation", "downwind_cover_height", "20ft_wind_speed", "number_torching_trees", "dbh", "tree_height", "tree_species" };
+    std::vector<std::string> requiredFields(fieldNames, fieldNames + sizeof(fieldNames) / sizeof(fieldNames[0]));
+    std::vector<std::string> optionalFields(1, "downwind_canopy_mode");
+
+    std::ios::sync_with_stdio(false);
+    return runSpotDistanceStream(requiredFields, optionalFields, calculateStreamScenario, streamOptions, cin, cout);
+}
+
 int main(int argc, char *argv[])
 {
     std::string spotLocation = "!set";
@@ -92,11 +171,23 @@ int main(int argc, char *argv[])
     double DBH = -1.0;
     double treeHeight = -1.0;
     std::string species = "!set";
+    std::string canopyMode = "CLOSED";
     bool verbose = false;
 
     SpotFireLocation::SpotFireLocationEnum location;
+    SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum downwindCanopyMode = SpotDownWindCanopyMode::CLOSED;
     SpotTreeSpecies::SpotTreeSpeciesEnum treeSpecies;
 
+    if(isSpotStreamRequested(argc, argv))
+    {
+        SpotStreamOptions streamOptions;
+        if(!parseSpotStreamArguments(argc, argv, streamOptions))
+        {
+            Usage();
+        }
+        return runStream(streamOptions);
+    }
+
     if(argc < 18){
         Usage();
     }
@@ -107,23 +198,7 @@ int main(int argc, char *argv[])
         if(EQUAL(argv[i], "--location"))
         {
             spotLocation = argv[++i];
-            if(EQUAL(spotLocation.c_str(), "RIDGE_TOP"))
-            {
-                location = SpotFireLocation::RIDGE_TOP;
-            }
-            else if(EQUAL(spotLocation.c_str(), "MIDSLOPE_WINDWARD"))
-            {
-                location = SpotFireLocation::MIDSLOPE_WINDWARD;
-            }
-            else if(EQUAL(spotLocation.c_str(), "VALLEY_BOTTOM"))
-            {
-                location = SpotFireLocation::VALLEY_BOTTOM;
-            }
-            else if(EQUAL(spotLocation.c_str(), "MIDSLOPE_LEEWARD"))
-            {
-                location = SpotFireLocation::MIDSLOPE_LEEWARD;
-            }
-            else
+            if(!parseSpotFireLocation(spotLocation, location))
             {
                 cout<<"location option "<<argv[i]<<" not valid."<<endl;
                 exit(-1);
@@ -160,69 +235,18 @@ int main(int argc, char *argv[])
         else if(EQUAL(argv[i], "--tree_species"))
         {
             species = argv[++i];
-            if(EQUAL(species.c_str(), "ENGLEMANN_SPRUCE"))
-            {
-                treeSpecies = SpotTreeSpecies::ENGELMANN_SPRUCE;
-            }
-            else if(EQUAL(species.c_str(), "DOUGLAS_FIR"))
-            {
-                treeSpecies = SpotTreeSpecies::DOUGLAS_FIR;
-            }
-            else if(EQUAL(species.c_str(), "SUBALPINE_FIR"))
-            {
-                treeSpecies = SpotTreeSpecies::SUBALPINE_FIR;
-            }
-            else if(EQUAL(species.c_str(), "WESTERN_HEMLOCK"))
-            {
-                treeSpecies = SpotTreeSpecies::WESTERN_HEMLOCK;
-            }
-            else if(EQUAL(species.c_str(), "PONDEROSA_PINE"))
-            {
-                treeSpecies = SpotTreeSpecies::PONDEROSA_PINE;
-            }
-            else if(EQUAL(species.c_str(), "LODGEPOLE_PINE"))
-            {
-                treeSpecies = SpotTreeSpecies::LODGEPOLE_PINE;
-            }
-            else if(EQUAL(species.c_str(), "WESTERN_WHITE_PINE"))
-            {
-                treeSpecies = SpotTreeSpecies::WESTERN_WHITE_PINE;
-            }
-            else if(EQUAL(species.c_str(), "WESTERN_WHITE_PINE"))
+            if(!parseSpotTreeSpecies(species, treeSpecies))
             {
-                treeSpecies = SpotTreeSpecies::WESTERN_WHITE_PINE;
-            }
-            else if(EQUAL(species.c_str(), "GRAND_FIR"))
-            {
-                treeSpecies = SpotTreeSpecies::GRAND_FIR;
-            }
-            else if(EQUAL(species.c_str(), "BALSAM_FIR"))
-            {
-                treeSpecies = SpotTreeSpecies::BALSAM_FIR;
-            }
-            else if(EQUAL(species.c_str(), "SLASH_PINE"))
-            {
-                treeSpecies = SpotTreeSpecies::SLASH_PINE;
-            }
-            else if(EQUAL(species.c_str(), "LONGLEAF_PINE"))
-            {
-                treeSpecies = SpotTreeSpecies::LONGLEAF_PINE;
-            }
-            else if(EQUAL(species.c_str(), "POND_PINE"))
-            {
-                treeSpecies = SpotTreeSpecies::POND_PINE;
-            }
-            else if(EQUAL(species.c_str(), "SHORTLEAF_PINE"))
-            {
-                treeSpecies = SpotTreeSpecies::SHORTLEAF_PINE;
-            }
-            else if(EQUAL(species.c_str(), "LOBLOLLY_PINE"))
-            {
-                treeSpecies = SpotTreeSpecies::LOBLOLLY_PINE;
+                cout<<"tree_species option "<<argv[i]<<" not valid."<<endl;
+                exit(-1);
             }
-            else
+        }
+        else if(EQUAL(argv[i], "--downwind_canopy_mode"))
+        {
+            canopyMode = argv[++i];
+            if(!parseSpotDownWindCanopyMode(canopyMode, downwindCanopyMode))
             {
-                cout<<"tree_species option "<<argv[i]<<" not valid."<<endl;
+                cout<<"downwind_canopy_mode option "<<argv[i]<<" not valid."<<endl;
                 exit(-1);
             }
         }
@@ -242,6 +266,7 @@ int main(int argc, char *argv[])
         cout<<"ridge_to_valley           = "<<ridgeToValleyDistance<<" m"<<endl;
         cout<<"ridge_to_valley_elevation = "<<ridgeToValleyElevation<<" m"<<endl;
         cout<<"downwind_cover_height     = "<<downwindCoverHeight<<" m"<<endl;
+        cout<<"downwind_canopy_mode      = "<<canopyMode<<endl;
         cout<<"20ft_wind_speed           = "<<windSpeedAtTwentyFeet<<" m/s"<<endl;
         cout<<"number_of_torching_trees  = "<<torchingTrees<<endl;
         cout<<"dbh                       = "<<DBH<<" cm"<<endl;
@@ -266,7 +291,7 @@ int main(int argc, char *argv[])
     //spotting distance from torching trees
     spot.updateSpotInputsForTorchingTrees(location, ridgeToValleyDistance,
             ridgeToValleyDistanceUnits, ridgeToValleyElevation, elevationUnits,
-            downwindCoverHeight, coverHeightUnits, torchingTrees, DBH, DBHUnits, 
+            downwindCoverHeight, coverHeightUnits, downwindCanopyMode, torchingTrees, DBH, DBHUnits, 
             treeHeight, treeHeightUnits, treeSpecies, windSpeedAtTwentyFeet, windSpeedUnits);
 
     spot.calculateSpottingDistanceFromTorchingTrees();
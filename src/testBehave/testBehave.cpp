@@ -1,14 +1,75 @@
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <new>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
+#include "behaveCApi.h"
+#include "behaveInstrumentation.h"
 #include "behaveRun.h"
+#ifdef BEHAVE_SERVER
+#include "behaveServer.h"
+#endif
+#include "behaveTrace.h"
+#include "fireGrowth.h"
+#include "firePerimeterGrowth.h"
 #include "fuelModels.h"
+#include "moistureScenarioFuelbedMatrix.h"
+#include "randfuel.h"
+#include "runResultCache.h"
+#include "spotDistanceStream.h"
+#include "spotLandingDistribution.h"
+#include "twoFuelModelsSpreadRateCache.h"
 
 // Define the error tolerance for double values
 constexpr double error_tolerance = 1e-06;
 
+// Counts heap allocations so a test can check that a calculation makes none
+static std::atomic<unsigned long> numberOfHeapAllocations(0);
+
+void* operator new(std::size_t size)
+{
+    numberOfHeapAllocations++;
+    void* memory = std::malloc((size > 0) ? size : 1);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
 struct TestInfo
 {
     int numTotalTests = 0;
@@ -43,6 +104,7 @@ void testTwoFuelModels(TestInfo& testInfo, BehaveRun& behaveRun);
 void testCrownModuleRothermel(TestInfo& testInfo, BehaveRun& behaveRun);
 void testCrownModuleScottAndReinhardt(TestInfo& testInfo, BehaveRun& behaveRun);
 void testSpotModule(TestInfo& testInfo, BehaveRun& behaveRun);
+void testSpotDistanceStream(TestInfo& testInfo, BehaveRun& behaveRun);
 void testSpeedUnitConversion(TestInfo& testInfo, BehaveRun& behaveRun);
 void testIgniteModule(TestInfo& testInfo, BehaveRun& behaveRun);
 void testSafetyModule(TestInfo& testInfo, BehaveRun& behaveRun);
@@ -50,6 +112,16 @@ void testContainModule(TestInfo& testInfo, BehaveRun& behaveRun);
 void testMortalityModule(TestInfo& testInfo, BehaveRun& behaveRun);
 void testFineDeadFuelMoistureTool(TestInfo& testInfo, BehaveRun& behaveRun);
 void testSlopeTool(TestInfo& testInfo, BehaveRun& behaveRun);
+void testFireGrowth(TestInfo& testInfo, BehaveRun& behaveRun);
+void testFirePerimeterGrowth(TestInfo& testInfo, BehaveRun& behaveRun);
+void testCApi(TestInfo& testInfo, BehaveRun& behaveRun);
+void testInstrumentation(TestInfo& testInfo, BehaveRun& behaveRun);
+void testTrace(TestInfo& testInfo, BehaveRun& behaveRun);
+void testRunResultCache(TestInfo& testInfo, BehaveRun& behaveRun);
+void testResultsSnapshot(TestInfo& testInfo, BehaveRun& behaveRun);
+#ifdef BEHAVE_SERVER
+void testServerRequests(TestInfo& testInfo, BehaveRun& behaveRun);
+#endif
 
 int main()
 {
@@ -75,6 +147,7 @@ int main()
     testCrownModuleRothermel(testInfo, behaveRun);
     testCrownModuleScottAndReinhardt(testInfo, behaveRun);
     testSpotModule(testInfo, behaveRun);
+    testSpotDistanceStream(testInfo, behaveRun);
     testSpeedUnitConversion(testInfo, behaveRun);
     testIgniteModule(testInfo, behaveRun);
     testSafetyModule(testInfo, behaveRun);
@@ -82,6 +155,16 @@ int main()
     testMortalityModule(testInfo, behaveRun);
     testFineDeadFuelMoistureTool(testInfo, behaveRun);
     testSlopeTool(testInfo, behaveRun);
+    testFireGrowth(testInfo, behaveRun);
+    testFirePerimeterGrowth(testInfo, behaveRun);
+    testCApi(testInfo, behaveRun);
+    testInstrumentation(testInfo, behaveRun);
+    testTrace(testInfo, behaveRun);
+    testRunResultCache(testInfo, behaveRun);
+    testResultsSnapshot(testInfo, behaveRun);
+#ifdef BEHAVE_SERVER
+    testServerRequests(testInfo, behaveRun);
+#endif
 
     std::cout << "Total tests performed: " << testInfo.numTotalTests << "\n";
     if(testInfo.numPassed > 0)
@@ -360,6 +443,48 @@ void testSurfaceSingleFuelModel(TestInfo& testInfo, BehaveRun& behaveRun)
     expectedSurfaceFireSpreadRate = 1.978840;
     reportTestResult(testInfo, testName, observedSurfaceFireSpreadRate, expectedSurfaceFireSpreadRate, error_tolerance);
 
+    const MoistureScenarioFuelbedMatrix& moistureScenarioMatrix = MoistureScenarioFuelbedMatrix::getSharedMatrix();
+    int fuelModelNumbersForMatrix[] = { 1, 4, 101, 124, 142, 165, 189 }; // includes dynamic GR and GS fuel models
+    int numberOfMatrixRuns = 0;
+    int numberOfCalculatedRunsLoaded = 0;
+    int numberOfMatrixRunsLoaded = 0;
+    int numberOfMatrixMismatches = 0;
+    for (int scenarioIndex = 0; scenarioIndex < behaveRun.surface.getNumberOfMoistureScenarios(); scenarioIndex++)
+    {
+        behaveRun.surface.setCurrentMoistureScenarioByIndex(scenarioIndex);
+        for (int fuelModelNumber : fuelModelNumbersForMatrix)
+        {
+            behaveRun.surface.setFuelModelNumber(fuelModelNumber);
+            behaveRun.surface.setIsUsingMoistureScenarioMatrix(false);
+            unsigned long long loadsBefore = moistureScenarioMatrix.getNumberOfLoads();
+            behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+            numberOfCalculatedRunsLoaded += (moistureScenarioMatrix.getNumberOfLoads() != loadsBefore) ? 1 : 0;
+            double calculatedSpreadRate = behaveRun.surface.getSpreadRate(SpeedUnits::ChainsPerHour);
+            double calculatedHeatSink = behaveRun.surface.getHeatSink(HeatSinkUnits::BtusPerCubicFoot);
+            behaveRun.surface.setIsUsingMoistureScenarioMatrix(true);
+            loadsBefore = moistureScenarioMatrix.getNumberOfLoads();
+            behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+            numberOfMatrixRunsLoaded += (moistureScenarioMatrix.getNumberOfLoads() != loadsBefore) ? 1 : 0;
+            numberOfMatrixRuns++;
+            if (behaveRun.surface.getSpreadRate(SpeedUnits::ChainsPerHour) != calculatedSpreadRate
+                || behaveRun.surface.getHeatSink(HeatSinkUnits::BtusPerCubicFoot) != calculatedHeatSink)
+            {
+                numberOfMatrixMismatches++;
+            }
+        }
+    }
+    behaveRun.surface.setIsUsingMoistureScenarioMatrix(false);
+    behaveRun.surface.setFuelModelNumber(124);
+
+    testName = "Test moisture scenario matrix is not used when it is turned off";
+    reportTestResult(testInfo, testName, numberOfCalculatedRunsLoaded, 0, error_tolerance);
+
+    testName = "Test moisture scenario matrix loads every run when it is turned on";
+    reportTestResult(testInfo, testName, numberOfMatrixRunsLoaded, numberOfMatrixRuns, error_tolerance);
+
+    testName = "Test moisture scenario matrix matches calculated fuelbed for seven fuel models in every scenario";
+    reportTestResult(testInfo, testName, numberOfMatrixMismatches, 0, error_tolerance);
+
     testName = "Test aggregate live and dead moisture input mode, 5 mph 20 foot uplsope wind";
     behaveRun.surface.setMoistureInputMode(MoistureInputMode::AllAggregate);
     behaveRun.surface.setMoistureDeadAggregate(3.0, moistureUnits);
@@ -507,12 +632,134 @@ void testSurfaceSingleFuelModel(TestInfo& testInfo, BehaveRun& behaveRun)
     expectedSurfaceFireSpreadRate = 46.631688;
     reportTestResult(testInfo, testName, observedSurfaceFireSpreadRate, expectedSurfaceFireSpreadRate, error_tolerance);
 
+    testName = "Test batch runs with precomputed wind adjustment factors per cell match single runs";
+    const int numberOfCells = 24;
+    double cellCanopyCover[numberOfCells];
+    double cellCanopyHeight[numberOfCells];
+    double cellCrownRatio[numberOfCells];
+    int cellFuelModelNumber[numberOfCells];
+    double cellWindSpeed[numberOfCells];
+    for (int i = 0; i < numberOfCells; i++)
+    {
+        cellCanopyCover[i] = 20.0 * (i % 4);
+        cellCanopyHeight[i] = (i % 3 == 0) ? 5.0 : 40.0;
+        cellCrownRatio[i] = 0.3 + 0.1 * (i % 2);
+        cellFuelModelNumber[i] = (i % 5 == 0) ? 124 : 4;
+        cellWindSpeed[i] = 2.0 + i;
+    }
+    behaveRun.surface.setWindAdjustmentFactorCalculationMethod(WindAdjustmentFactorCalculationMethod::UseCrownRatio);
+    double cellWindAdjustmentFactor[numberOfCells];
+    behaveRun.surface.calculateWindAdjustmentFactorsForCells(numberOfCells, cellCanopyCover, FractionUnits::Percent, cellCanopyHeight,
+        LengthUnits::Feet, cellCrownRatio, cellFuelModelNumber, cellWindAdjustmentFactor);
+    SurfaceBatchInputs surfaceBatchInputs;
+    surfaceBatchInputs.numberOfRuns = numberOfCells;
+    surfaceBatchInputs.fuelModelNumber = cellFuelModelNumber;
+    surfaceBatchInputs.windSpeed = cellWindSpeed;
+    surfaceBatchInputs.windAdjustmentFactor = cellWindAdjustmentFactor;
+    double cellSpreadRate[numberOfCells];
+    double cellFlameLength[numberOfCells];
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpreadForBatch(surfaceBatchInputs, cellSpreadRate, SpeedUnits::ChainsPerHour,
+        cellFlameLength, LengthUnits::Feet);
+    double maximumCellDifference = 0.0;
+    for (int i = 0; i < numberOfCells; i++)
+    {
+        behaveRun.surface.setCanopyCover(cellCanopyCover[i], FractionUnits::Percent);
+        behaveRun.surface.setCanopyHeight(cellCanopyHeight[i], LengthUnits::Feet);
+        behaveRun.surface.setCrownRatio(cellCrownRatio[i]);
+        behaveRun.surface.setFuelModelNumber(cellFuelModelNumber[i]);
+        behaveRun.surface.setWindSpeed(cellWindSpeed[i], SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot);
+        behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+        maximumCellDifference = std::max(maximumCellDifference, fabs(cellSpreadRate[i] - behaveRun.surface.getSpreadRate(SpeedUnits::ChainsPerHour)));
+        maximumCellDifference = std::max(maximumCellDifference, fabs(cellFlameLength[i] - behaveRun.surface.getFlameLength(LengthUnits::Feet)));
+    }
+    reportTestResult(testInfo, testName, maximumCellDifference, 0.0, error_tolerance);
+    behaveRun.surface.setCanopyCover(40, FractionUnits::Percent);
+    behaveRun.surface.setCanopyHeight(30, LengthUnits::Feet);
+    behaveRun.surface.setCrownRatio(0.50);
+    behaveRun.surface.setWindSpeed(5, SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot);
+
     testName = "Test Non-Burnable Fuel";
     behaveRun.surface.setFuelModelNumber(91);
     behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
     observedSurfaceFireSpreadRate = roundToSixDecimalPlaces(behaveRun.surface.getSpreadRate(SpeedUnits::ChainsPerHour));
     expectedSurfaceFireSpreadRate = 0.0;
     reportTestResult(testInfo, testName, observedSurfaceFireSpreadRate, expectedSurfaceFireSpreadRate, error_tolerance);
+
+    testName = "Test copied fuel models keep standard fuel model 124 dynamic";
+    FuelModels standardFuelModels;
+    FuelModels copiedFuelModels;
+    copiedFuelModels = standardFuelModels;
+    double observedIsDynamic = copiedFuelModels.getIsDynamic(124) ? 1.0 : 0.0;
+    double expectedIsDynamic = 1.0;
+    reportTestResult(testInfo, testName, observedIsDynamic, expectedIsDynamic, error_tolerance);
+
+    testName = "Test custom fuel model version leaves the original fuel models unchanged";
+    FuelModels customFuelModels = standardFuelModels.withCustomModel(160, "C60", "Custom grass", 1.0, LengthUnits::Feet,
+        15, FractionUnits::Percent, 8000, 8000, HeatOfCombustionUnits::BtusPerPound, 0.1, 0.0, 0.0, 0.5, 0.0,
+        LoadingUnits::TonsPerAcre, 2000, 1800, 1500, SurfaceAreaToVolumeUnits::SquareFeetOverCubicFeet, true);
+    double observedIsDefined = standardFuelModels.isFuelModelDefined(160) ? 1.0 : 0.0;
+    double expectedIsDefined = 0.0;
+    reportTestResult(testInfo, testName, observedIsDefined, expectedIsDefined, error_tolerance);
+
+    testName = "Test custom fuel model version defines the custom fuel model";
+    observedIsDefined = customFuelModels.isFuelModelDefined(160) ? 1.0 : 0.0;
+    expectedIsDefined = 1.0;
+    reportTestResult(testInfo, testName, observedIsDefined, expectedIsDefined, error_tolerance);
+
+    testName = "Test copied fuel models share custom fuel models";
+    FuelModels sharedFuelModels(customFuelModels);
+    double observedIsShared = sharedFuelModels.sharesCustomFuelModelsWith(customFuelModels) ? 1.0 : 0.0;
+    double expectedIsShared = 1.0;
+    reportTestResult(testInfo, testName, observedIsShared, expectedIsShared, error_tolerance);
+
+    testName = "Test copied fuel models stop sharing custom fuel models once one is changed";
+    sharedFuelModels.clearCustomFuelModel(160);
+    observedIsShared = sharedFuelModels.sharesCustomFuelModelsWith(customFuelModels) ? 1.0 : 0.0;
+    expectedIsShared = 0.0;
+    reportTestResult(testInfo, testName, observedIsShared, expectedIsShared, error_tolerance);
+
+    testName = "Test cleared custom fuel model is undefined in the changed copy";
+    observedIsDefined = sharedFuelModels.isFuelModelDefined(160) ? 1.0 : 0.0;
+    expectedIsDefined = 0.0;
+    reportTestResult(testInfo, testName, observedIsDefined, expectedIsDefined, error_tolerance);
+
+    testName = "Test cleared custom fuel model stays defined in the original";
+    observedIsDefined = customFuelModels.isFuelModelDefined(160) ? 1.0 : 0.0;
+    expectedIsDefined = 1.0;
+    reportTestResult(testInfo, testName, observedIsDefined, expectedIsDefined, error_tolerance);
+
+    testName = "Test custom fuel model catalog save and load with fuel model numbers above 256";
+    FuelModels catalogFuelModels;
+    for (int i = 0; i < 1000; i++)
+    {
+        catalogFuelModels.setCustomFuelModel(100000 + i * 7, "L" + std::to_string(i), "Local calibration", 1.0 + i * 0.001,
+            LengthUnits::Feet, 25, FractionUnits::Percent, 8000, 8000, HeatOfCombustionUnits::BtusPerPound,
+            0.1, 0.2, 0.3, 0.4, 0.5, LoadingUnits::PoundsPerSquareFoot, 2000, 1800, 1500,
+            SurfaceAreaToVolumeUnits::SquareFeetOverCubicFeet, (i % 2) == 0);
+    }
+    const string catalogFileName = "testBehaveFuelModelCatalog.bin";
+    FuelModels loadedFuelModels;
+    bool isCatalogRoundTripped = catalogFuelModels.saveCustomFuelModels(catalogFileName)
+        && loadedFuelModels.loadCustomFuelModels(catalogFileName);
+    std::remove(catalogFileName.c_str());
+    double observedFuelbedDepth = isCatalogRoundTripped ? roundToSixDecimalPlaces(loadedFuelModels.getFuelbedDepth(100000 + 999 * 7, LengthUnits::Feet)) : 0.0;
+    double expectedFuelbedDepth = 1.999;
+    reportTestResult(testInfo, testName, observedFuelbedDepth, expectedFuelbedDepth, error_tolerance);
+
+    testName = "Test loaded custom fuel model catalog count";
+    reportTestResult(testInfo, testName, loadedFuelModels.getNumberOfCustomFuelModels(), 1000, error_tolerance);
+
+    testName = "Test loaded custom fuel model catalog code";
+    double observedIsCodeLoaded = (loadedFuelModels.getFuelCode(100000 + 42 * 7) == "L42") ? 1.0 : 0.0;
+    reportTestResult(testInfo, testName, observedIsCodeLoaded, 1.0, error_tolerance);
+
+    testName = "Test loaded custom fuel model catalog dynamic flag";
+    double observedIsDynamicLoaded = loadedFuelModels.getIsDynamic(100000 + 42 * 7) ? 1.0 : 0.0;
+    reportTestResult(testInfo, testName, observedIsDynamicLoaded, 1.0, error_tolerance);
+
+    testName = "Test loaded custom fuel model catalog leaves other fuel model numbers undefined";
+    double observedIsOtherNumberDefined = loadedFuelModels.isFuelModelDefined(100001) ? 1.0 : 0.0;
+    reportTestResult(testInfo, testName, observedIsOtherNumberDefined, 0.0, error_tolerance);
     std::cout << "Finished testing Surface, single fuel model\n\n";
 }
 
@@ -1046,6 +1293,128 @@ void testTwoFuelModels(TestInfo& testInfo, BehaveRun& behaveRun)
     expectedSurfaceFireSpreadRate = 21.971217;
     reportTestResult(testInfo, testName, observedSurfaceFireSpreadRate, expectedSurfaceFireSpreadRate, error_tolerance);
 
+    // Sampled estimate should land within a few standard errors of the exhaustive result
+    testName = "First fuel model coverage 50, two dimensional sampled";
+    behaveRun.surface.setTwoFuelModelsMethod(TwoFuelModelsMethod::TwoDimensionalSampled);
+    behaveRun.surface.setTwoDimensionalSamplingMaxDraws(4096);
+    behaveRun.surface.setTwoDimensionalSamplingThreads(2);
+    behaveRun.surface.setTwoDimensionalSamplingSeed(12345);
+    behaveRun.surface.setTwoFuelModelsFirstFuelModelCoverage(50, coverUnits);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    observedSurfaceFireSpreadRate = roundToSixDecimalPlaces(behaveRun.surface.getSpreadRate(SpeedUnits::ChainsPerHour));
+    expectedSurfaceFireSpreadRate = 17.362382;
+    reportTestResult(testInfo, testName, observedSurfaceFireSpreadRate, expectedSurfaceFireSpreadRate,
+        4.0 * behaveRun.surface.getSpreadRateStandardError(SpeedUnits::ChainsPerHour) + error_tolerance);
+    behaveRun.surface.setTwoFuelModelsMethod(TwoFuelModelsMethod::TwoDimensional);
+
+    TwoFuelModelsSpreadRateCache& spreadRateCache = TwoFuelModelsSpreadRateCache::getSharedCache();
+    testName = "First fuel model coverage 50, repeated run is a cache hit";
+    unsigned long long hitsBefore = spreadRateCache.getHits();
+    behaveRun.surface.setTwoFuelModelsFirstFuelModelCoverage(50, coverUnits);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    reportTestResult(testInfo, testName, (double)(spreadRateCache.getHits() - hitsBefore), 1, error_tolerance);
+
+    testName = "First fuel model coverage 50, quantized prebuilt table";
+    spreadRateCache.setQuantization(0.01, 0.01, 0.1);
+    spreadRateCache.prebuildTable(behaveRun.surface.getFireLengthToWidthRatio(), 2, 2, 0);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    observedSurfaceFireSpreadRate = roundToSixDecimalPlaces(behaveRun.surface.getSpreadRate(SpeedUnits::ChainsPerHour));
+    expectedSurfaceFireSpreadRate = 17.362382;
+    reportTestResult(testInfo, testName, observedSurfaceFireSpreadRate, expectedSurfaceFireSpreadRate, 0.1);
+    // Turned off, the quantization steps no longer apply
+    testName = "First fuel model coverage 50, disabled cache ignores quantization";
+    spreadRateCache.setEnabled(false);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    observedSurfaceFireSpreadRate = roundToSixDecimalPlaces(behaveRun.surface.getSpreadRate(SpeedUnits::ChainsPerHour));
+    reportTestResult(testInfo, testName, observedSurfaceFireSpreadRate, expectedSurfaceFireSpreadRate, error_tolerance);
+    spreadRateCache.setEnabled(true);
+    spreadRateCache.setQuantization(0, 0, 0);
+
+    // RandFuel cannot calculate a block 51 samples wide
+    TwoFuelModelsSpreadRateCache failingCache;
+    TwoFuelModelsSpreadRateKey tooWideKey = failingCache.makeKey(1.0, 0.2, 0.5, 0.5, 2.0, 51, 2, 0);
+    testName = "Two dimensional relative spread rate of a block too wide is an error";
+    reportTestResult(testInfo, testName, failingCache.getRelativeSpreadRate(tooWideKey), -1, error_tolerance);
+    testName = "Two dimensional relative spread rate of a block too wide is not cached";
+    reportTestResult(testInfo, testName, (double)failingCache.getSize(), 0, error_tolerance);
+
+    // The first uncached run grows the RandFuel workspace Surface keeps, the second should reuse it
+    testName = "First fuel model coverage 50, no heap allocations after warm-up";
+    spreadRateCache.setEnabled(false);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    unsigned long allocationsBefore = numberOfHeapAllocations;
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    reportTestResult(testInfo, testName, (double)(numberOfHeapAllocations - allocationsBefore), 0, error_tolerance);
+    spreadRateCache.setEnabled(true);
+
+    const SurfaceInputs& surfaceInputs = behaveRun.surface.getSurfaceInputs();
+    testName = "Two dimensional block size clamps samples to 50";
+    behaveRun.surface.setTwoDimensionalBlockSize(60, 1);
+    reportTestResult(testInfo, testName, surfaceInputs.getTwoDimensionalSamples(), 50, error_tolerance);
+    testName = "Two dimensional block size clamps samples to 1";
+    behaveRun.surface.setTwoDimensionalBlockSize(0, 0);
+    reportTestResult(testInfo, testName, surfaceInputs.getTwoDimensionalSamples(), 1, error_tolerance);
+    testName = "Two dimensional block size clamps depth to 1";
+    reportTestResult(testInfo, testName, surfaceInputs.getTwoDimensionalDepth(), 1, error_tolerance);
+
+    // 2^(3 x 30) sample blocks do not fit in a block count
+    testName = "Two dimensional block size rejects a block count that overflows";
+    behaveRun.surface.setTwoDimensionalBlockSize(2, 2);
+    reportTestResult(testInfo, testName, behaveRun.surface.setTwoDimensionalBlockSize(3, 30), false, error_tolerance);
+    testName = "Two dimensional block size keeps the samples after a rejected size";
+    reportTestResult(testInfo, testName, surfaceInputs.getTwoDimensionalSamples(), 2, error_tolerance);
+    testName = "Two dimensional block size keeps the depth after a rejected size";
+    reportTestResult(testInfo, testName, surfaceInputs.getTwoDimensionalDepth(), 2, error_tolerance);
+
+    // Half of each fuel, the second spreading at 0.2 of the first
+    auto setRandFuelData = [](RandFuel& randFuel)
+    {
+        randFuel.setCellDimensions(10);
+        randFuel.allocFuels(2);
+        randFuel.setFuelData(0, 1.0, 0.5);
+        randFuel.setFuelData(1, 0.2, 0.5);
+    };
+    double maximumRos = 0.0;
+    double harmonicRos = 0.0;
+
+    testName = "Two dimensional 3 x 3 block with 4 threads matches 1 thread";
+    RandFuel singleThreadRandFuel;
+    setRandFuelData(singleThreadRandFuel);
+    double expectedRelativeRos = singleThreadRandFuel.computeSpread2(3, 3, 2.0, 1, &maximumRos, &harmonicRos, 0, 0);
+    RandFuel threadedRandFuel;
+    setRandFuelData(threadedRandFuel);
+    double observedRelativeRos = threadedRandFuel.computeSpread2(3, 3, 2.0, 4, &maximumRos, &harmonicRos, 0, 0);
+    reportTestResult(testInfo, testName, observedRelativeRos, expectedRelativeRos, error_tolerance);
+
+    testName = "Two dimensional 3 x 2 block enumerated on the fly matches materialized blocks";
+    RandFuel materializedRandFuel;
+    setRandFuelData(materializedRandFuel);
+    materializedRandFuel.setEnumerateBlocks(false);
+    expectedRelativeRos = materializedRandFuel.computeSpread2(3, 2, 2.0, 2, &maximumRos, &harmonicRos, 0, 0);
+    double expectedHarmonicRos = harmonicRos;
+    RandFuel enumeratedRandFuel;
+    setRandFuelData(enumeratedRandFuel);
+    observedRelativeRos = enumeratedRandFuel.computeSpread2(3, 2, 2.0, 2, &maximumRos, &harmonicRos, 0, 0);
+    reportTestResult(testInfo, testName, observedRelativeRos, expectedRelativeRos, error_tolerance);
+
+    testName = "Two dimensional 3 x 2 block harmonic spread rate enumerated on the fly matches materialized blocks";
+    reportTestResult(testInfo, testName, harmonicRos, expectedHarmonicRos, error_tolerance);
+
+    // A 1 x 1 block has two arrangements, so two of four pooled threads are
+    // not run and still hold the sums of the 3 x 3 run
+    testName = "Two dimensional 1 x 1 block after a 3 x 3 block matches a fresh RandFuel";
+    RandFuel freshRandFuel;
+    setRandFuelData(freshRandFuel);
+    expectedRelativeRos = freshRandFuel.computeSpread2(1, 1, 2.0, 4, &maximumRos, &harmonicRos, 0, 0);
+    RandFuel pooledRandFuel;
+    setRandFuelData(pooledRandFuel);
+    pooledRandFuel.computeSpread2(3, 3, 2.0, 4, &maximumRos, &harmonicRos, 0, 0);
+    observedRelativeRos = pooledRandFuel.computeSpread2(1, 1, 2.0, 4, &maximumRos, &harmonicRos, 0, 0);
+    reportTestResult(testInfo, testName, observedRelativeRos, expectedRelativeRos, error_tolerance);
+
+    testName = "Two dimensional 1 x 1 block expected relative spread rate";
+    reportTestResult(testInfo, testName, expectedRelativeRos, 0.6, error_tolerance);
+
     std::cout << "Finished testing Two Fuel Models, first fuel model 1, second fuel model 124\n\n";
 }
 
@@ -1409,9 +1778,377 @@ void testSpotModule(TestInfo& testInfo, BehaveRun& behaveRun)
     observedFlatSpottingDistance = roundToSixDecimalPlaces(behaveRun.spot.getMaxFlatTerrainSpottingDistanceFromTorchingTrees(spottingDistanceUnits));
     reportTestResult(testInfo, testName, observedFlatSpottingDistance, expectedFlatSpottingDistance, error_tolerance);
 
+    // Batch versions against one scenario at a time, over more than one block
+    const int numberOfScenarios = 600;
+    std::vector<double> batchWindSpeed(numberOfScenarios);
+    std::vector<double> batchCoverHeight(numberOfScenarios);
+    std::vector<double> batchRidgeToValleyDistance(numberOfScenarios);
+    std::vector<double> batchRidgeToValleyElevation(numberOfScenarios);
+    std::vector<SpotFireLocation::SpotFireLocationEnum> batchLocation(numberOfScenarios);
+    std::vector<SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum> batchCanopyMode(numberOfScenarios);
+    std::vector<double> batchFlameHeight(numberOfScenarios);
+    std::vector<int> batchTorchingTrees(numberOfScenarios);
+    std::vector<double> batchDBH(numberOfScenarios);
+    std::vector<double> batchTreeHeight(numberOfScenarios);
+    std::vector<SpotTreeSpecies::SpotTreeSpeciesEnum> batchTreeSpecies(numberOfScenarios);
+    for (int i = 0; i < numberOfScenarios; i++)
+    {
+        batchWindSpeed[i] = (i % 17) * 1.5;
+        batchCoverHeight[i] = 5.0 + (i % 11) * 8.0;
+        batchRidgeToValleyDistance[i] = 0.25 + (i % 5) * 0.5;
+        batchRidgeToValleyElevation[i] = (i % 7) * 500.0;
+        batchLocation[i] = (SpotFireLocation::SpotFireLocationEnum)(i % 4);
+        batchCanopyMode[i] = ((i % 3) == 0) ? SpotDownWindCanopyMode::OPEN : SpotDownWindCanopyMode::CLOSED;
+        batchFlameHeight[i] = (i % 13) * 2.0;
+        batchTorchingTrees[i] = i % 20;
+        batchDBH[i] = 2.0 + (i % 19) * 2.5;
+        batchTreeHeight[i] = 10.0 + (i % 23) * 5.0;
+        batchTreeSpecies[i] = (SpotTreeSpecies::SpotTreeSpeciesEnum)(i % SpotInputs::SpotArrayConstants::NUM_SPECIES);
+    }
+
+    SpotBatchInputs spotBatchInputs;
+    spotBatchInputs.numberOfScenarios = numberOfScenarios;
+    spotBatchInputs.windSpeedAtTwentyFeet = &batchWindSpeed[0];
+    spotBatchInputs.downwindCoverHeight = &batchCoverHeight[0];
+    spotBatchInputs.ridgeToValleyDistance = &batchRidgeToValleyDistance[0];
+    spotBatchInputs.ridgeToValleyElevation = &batchRidgeToValleyElevation[0];
+    spotBatchInputs.location = &batchLocation[0];
+    spotBatchInputs.downwindCanopyMode = &batchCanopyMode[0];
+    spotBatchInputs.burningPileFlameHeight = &batchFlameHeight[0];
+    spotBatchInputs.flameLength = &batchFlameHeight[0];
+    spotBatchInputs.torchingTrees = &batchTorchingTrees[0];
+    spotBatchInputs.DBH = &batchDBH[0];
+    spotBatchInputs.treeHeight = &batchTreeHeight[0];
+    spotBatchInputs.treeSpecies = &batchTreeSpecies[0];
+
+    std::vector<double> batchFlatDistance(numberOfScenarios);
+    std::vector<double> batchMountainDistance(numberOfScenarios);
+    for (int source = 0; source < 3; source++)
+    {
+        Spot batchSpot;
+        if (source == 0)
+        {
+            testName = "Test batch spotting distances from burning pile match single scenarios";
+            batchSpot.calculateSpottingDistanceFromBurningPileForBatch(spotBatchInputs, &batchFlatDistance[0], &batchMountainDistance[0], spottingDistanceUnits);
+        }
+        else if (source == 1)
+        {
+            testName = "Test batch spotting distances from surface fire match single scenarios";
+            batchSpot.calculateSpottingDistanceFromSurfaceFireForBatch(spotBatchInputs, &batchFlatDistance[0], &batchMountainDistance[0], spottingDistanceUnits);
+        }
+        else
+        {
+            testName = "Test batch spotting distances from torching trees match single scenarios";
+            batchSpot.calculateSpottingDistanceFromTorchingTreesForBatch(spotBatchInputs, &batchFlatDistance[0], &batchMountainDistance[0], spottingDistanceUnits);
+        }
+
+        double maximumDifference = 0.0;
+        for (int i = 0; i < numberOfScenarios; i++)
+        {
+            Spot singleSpot;
+            double singleFlatDistance = 0.0;
+            double singleMountainDistance = 0.0;
+            if (source == 0)
+            {
+                singleSpot.updateSpotInputsForBurningPile(batchLocation[i], batchRidgeToValleyDistance[i], LengthUnits::Miles,
+                    batchRidgeToValleyElevation[i], LengthUnits::Feet, batchCoverHeight[i], LengthUnits::Feet, batchCanopyMode[i],
+                    batchFlameHeight[i], LengthUnits::Feet, batchWindSpeed[i], SpeedUnits::MilesPerHour);
+                singleSpot.calculateSpottingDistanceFromBurningPile();
+                singleFlatDistance = singleSpot.getMaxFlatTerrainSpottingDistanceFromBurningPile(spottingDistanceUnits);
+                singleMountainDistance = singleSpot.getMaxMountainousTerrainSpottingDistanceFromBurningPile(spottingDistanceUnits);
+            }
+            else if (source == 1)
+            {
+                singleSpot.updateSpotInputsForSurfaceFire(batchLocation[i], batchRidgeToValleyDistance[i], LengthUnits::Miles,
+                    batchRidgeToValleyElevation[i], LengthUnits::Feet, batchCoverHeight[i], LengthUnits::Feet, batchCanopyMode[i],
+                    batchWindSpeed[i], SpeedUnits::MilesPerHour, batchFlameHeight[i], LengthUnits::Feet);
+                singleSpot.calculateSpottingDistanceFromSurfaceFire();
+                singleFlatDistance = singleSpot.getMaxFlatTerrainSpottingDistanceFromSurfaceFire(spottingDistanceUnits);
+                singleMountainDistance = singleSpot.getMaxMountainousTerrainSpottingDistanceFromSurfaceFire(spottingDistanceUnits);
+            }
+            else
+            {
+                singleSpot.updateSpotInputsForTorchingTrees(batchLocation[i], batchRidgeToValleyDistance[i], LengthUnits::Miles,
+                    batchRidgeToValleyElevation[i], LengthUnits::Feet, batchCoverHeight[i], LengthUnits::Feet, batchCanopyMode[i],
+                    batchTorchingTrees[i], batchDBH[i], LengthUnits::Inches, batchTreeHeight[i], LengthUnits::Feet,
+                    batchTreeSpecies[i], batchWindSpeed[i], SpeedUnits::MilesPerHour);
+                singleSpot.calculateSpottingDistanceFromTorchingTrees();
+                singleFlatDistance = singleSpot.getMaxFlatTerrainSpottingDistanceFromTorchingTrees(spottingDistanceUnits);
+                singleMountainDistance = singleSpot.getMaxMountainousTerrainSpottingDistanceFromTorchingTrees(spottingDistanceUnits);
+            }
+            maximumDifference = std::max(maximumDifference, fabs(batchFlatDistance[i] - singleFlatDistance));
+            maximumDifference = std::max(maximumDifference, fabs(batchMountainDistance[i] - singleMountainDistance));
+        }
+        reportTestResult(testInfo, testName, roundToSixDecimalPlaces(maximumDifference), 0.0, error_tolerance);
+    }
+
+    // Firebrand landing distribution from torching trees
+    Spot landingSpot;
+    landingSpot.updateSpotInputsForTorchingTrees(location, ridgeToValleyDistance, ridgeToValleyDistanceUnits,
+        ridgeToValleyElevation, elevationUnits, downwindCoverHeight, coverHeightUnits, downWindCanopyMode,
+        torchingTrees, DBH, DBHUnits, treeHeight, treeHeightUnits, treeSpecies, windSpeedAtTwentyFeet, windSpeedUnits);
+    landingSpot.calculateSpottingDistanceFromTorchingTrees();
+    double maxMountainDistance = landingSpot.getMaxMountainousTerrainSpottingDistanceFromTorchingTrees(LengthUnits::Miles);
+
+    SpotLandingGrid landingGrid;
+    landingGrid.downwindMinimum = 0.0;
+    landingGrid.downwindMaximum = 1.0;
+    landingGrid.numberOfDownwindCells = 100;
+    landingGrid.crosswindMinimum = -0.25;
+    landingGrid.crosswindMaximum = 0.25;
+    landingGrid.numberOfCrosswindCells = 51;
+    landingGrid.units = LengthUnits::Miles;
+
+    SpotLandingSamplingParameters samplingParameters;
+    samplingParameters.numberOfFirebrands = 100000;
+    samplingParameters.loftingHeightExponent = 0.0;
+    samplingParameters.gustFactorDeviation = 0.0;
+    samplingParameters.windDirectionDeviation = 0.0;
+    samplingParameters.burnoutHeightDeviation = 0.0;
+
+    SpotLandingDistribution landingDistribution;
+    landingDistribution.setGrid(landingGrid);
+    landingDistribution.setSamplingParameters(samplingParameters);
+    landingDistribution.sampleFromTorchingTrees(landingSpot);
+    testName = "Test firebrands without variation all land at the maximum spotting distance";
+    int maxDistanceCell = (int)(maxMountainDistance / 0.01);
+    reportTestResult(testInfo, testName, landingDistribution.getCount(maxDistanceCell, 25) / 100000.0, 1.0, error_tolerance);
+    testName = "Test mean landing distance without variation is the maximum spotting distance";
+    reportTestResult(testInfo, testName, landingDistribution.getMeanLandingDistance(LengthUnits::Miles), maxMountainDistance, error_tolerance);
+
+    samplingParameters = SpotLandingSamplingParameters();
+    samplingParameters.numberOfFirebrands = 300000;
+    samplingParameters.seed = 20180601;
+    landingDistribution.setGrid(landingGrid);
+    landingDistribution.setSamplingParameters(samplingParameters);
+    landingDistribution.sampleFromTorchingTrees(landingSpot);
+    SpotLandingDistribution threadedLandingDistribution;
+    samplingParameters.numberOfThreads = 4;
+    threadedLandingDistribution.setGrid(landingGrid);
+    threadedLandingDistribution.setSamplingParameters(samplingParameters);
+    threadedLandingDistribution.sampleFromTorchingTrees(landingSpot);
+    int numberOfDifferentCells = 0;
+    for (int downwindCell = 0; downwindCell < landingGrid.numberOfDownwindCells; downwindCell++)
+    {
+        for (int crosswindCell = 0; crosswindCell < landingGrid.numberOfCrosswindCells; crosswindCell++)
+        {
+            if (landingDistribution.getCount(downwindCell, crosswindCell) != threadedLandingDistribution.getCount(downwindCell, crosswindCell))
+            {
+                numberOfDifferentCells++;
+            }
+        }
+    }
+    testName = "Test firebrand landing counts do not depend on the number of threads";
+    reportTestResult(testInfo, testName, numberOfDifferentCells, 0, error_tolerance);
+    testName = "Test mean landing distance does not depend on the number of threads";
+    reportTestResult(testInfo, testName, threadedLandingDistribution.getMeanLandingDistance(LengthUnits::Miles),
+        landingDistribution.getMeanLandingDistance(LengthUnits::Miles), 1e-12);
+    testName = "Test every sampled firebrand either lands or burns out";
+    reportTestResult(testInfo, testName, (double)(landingDistribution.getNumberOfLandedFirebrands() + landingDistribution.getNumberOfBurnedOutFirebrands()),
+        (double)landingDistribution.getNumberOfSampledFirebrands(), error_tolerance);
+
+    SpotLandingGrid emptyGrid = landingGrid;
+    emptyGrid.crosswindMaximum = emptyGrid.crosswindMinimum;
+    landingDistribution.setGrid(emptyGrid);
+    testName = "Test landing grid without crosswind extent is rejected";
+    reportTestResult(testInfo, testName, landingDistribution.getGrid().crosswindMaximum, landingGrid.crosswindMaximum, error_tolerance);
+    testName = "Test rejected landing grid keeps the current counts";
+    reportTestResult(testInfo, testName, (double)landingDistribution.getNumberOfSampledFirebrands(), 300000, error_tolerance);
+
     std::cout << "Finished testing Spot module\n\n";
 }
 
+void testSpotDistanceStream(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    std::cout << "Testing spot distance stream\n";
+    string testName = "";
+
+    // Answers the wind speed as the mountain distance and the location as the
+    // flat distance, so the output shows which line each result came from
+    const std::vector<std::string> fieldNames = { "location", "20ft_wind_speed" };
+    const std::vector<std::string> optionalFieldNames = { "downwind_canopy_mode" };
+    SpotStreamCalculation calculate = [](Spot& spot, const SpotStreamScenario& scenario, SpotStreamResult& result)
+    {
+        SpotFireLocation::SpotFireLocationEnum location = SpotFireLocation::MIDSLOPE_WINDWARD;
+        SpotDownWindCanopyMode::SpotDownWindCanopyModeEnum downwindCanopyMode = SpotDownWindCanopyMode::CLOSED;
+        double windSpeed = 0;
+        if (!parseSpotFireLocation(scenario.getValue("location"), location))
+        {
+            result.error = "unknown location";
+            return;
+        }
+        if (scenario.hasValue("downwind_canopy_mode")
+            && !parseSpotDownWindCanopyMode(scenario.getValue("downwind_canopy_mode"), downwindCanopyMode))
+        {
+            result.error = "unknown downwind canopy mode";
+            return;
+        }
+        if (!scenario.getNumber("20ft_wind_speed", windSpeed, result.error))
+        {
+            return;
+        }
+        result.isValid = true;
+        result.mountainSpottingDistance = windSpeed;
+        result.flatSpottingDistance = location;
+    };
+    auto runStream = [&](const std::string& input, const SpotStreamOptions& options, std::ostream& out)
+    {
+        std::istringstream in(input);
+        return runSpotDistanceStream(fieldNames, optionalFieldNames, calculate, options, in, out);
+    };
+    auto splitLines = [](const std::string& text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    };
+    // The value of the field at index in a comma separated output line
+    auto fieldValue = [](const std::string& line, int index)
+    {
+        std::string::size_type begin = 0;
+        for (int i = 0; i < index && begin != std::string::npos; i++)
+        {
+            begin = line.find(',', begin);
+            begin = (begin == std::string::npos) ? begin : begin + 1;
+        }
+        return (begin == std::string::npos) ? -1.0 : std::atof(line.c_str() + begin);
+    };
+
+    SpotStreamOptions options;
+    std::ostringstream csvOut;
+    int status = runStream("location,20ft_wind_speed\nRIDGE_TOP,10\n# comment\n\nVALLEY_BOTTOM, 5, OPEN\n", options, csvOut);
+    std::vector<std::string> csvLines = splitLines(csvOut.str());
+
+    testName = "Test spot stream CSV status";
+    reportTestResult(testInfo, testName, status, 0, error_tolerance);
+
+    testName = "Test spot stream CSV skips the header, comments and blank lines";
+    reportTestResult(testInfo, testName, (double)csvLines.size(), 2, error_tolerance);
+    csvLines.resize(2);
+
+    testName = "Test spot stream CSV first row wind speed";
+    reportTestResult(testInfo, testName, fieldValue(csvLines[0], 0), 10, error_tolerance);
+
+    testName = "Test spot stream CSV first row location";
+    reportTestResult(testInfo, testName, fieldValue(csvLines[0], 1), SpotFireLocation::RIDGE_TOP, error_tolerance);
+
+    testName = "Test spot stream CSV row with an optional field";
+    reportTestResult(testInfo, testName, fieldValue(csvLines[1], 0), 5, error_tolerance);
+
+    std::ostringstream keyValueOut;
+    runStream("location=RIDGE_TOP, --20ft_wind_speed=12\n20ft_wind_speed=7 location=MIDSLOPE_LEEWARD downwind_canopy_mode=OPEN\n",
+        options, keyValueOut);
+    std::vector<std::string> keyValueLines = splitLines(keyValueOut.str());
+
+    testName = "Test spot stream key=value rows";
+    reportTestResult(testInfo, testName, (double)keyValueLines.size(), 2, error_tolerance);
+    keyValueLines.resize(2);
+
+    testName = "Test spot stream key=value first row wind speed";
+    reportTestResult(testInfo, testName, fieldValue(keyValueLines[0], 0), 12, error_tolerance);
+
+    testName = "Test spot stream key=value second row wind speed";
+    reportTestResult(testInfo, testName, fieldValue(keyValueLines[1], 0), 7, error_tolerance);
+
+    testName = "Test spot stream key=value second row location";
+    reportTestResult(testInfo, testName, fieldValue(keyValueLines[1], 1), SpotFireLocation::MIDSLOPE_LEEWARD, error_tolerance);
+
+    // Each malformed row answers error,<line number>,<message> and the rows after it still run
+    std::ostringstream malformedOut;
+    status = runStream("RIDGE_TOP\nlocation=RIDGE_TOP\nlocation=RIDGE_TOP,20ft_wind_speed=fast\nlocation=RIDGE_TOP,slope=10\n"
+        "RIDGE_TOP,1,2,3\nRIDGE_TOP,4\n", options, malformedOut);
+    std::vector<std::string> malformedLines = splitLines(malformedOut.str());
+    int numberOfErrorLines = 0;
+    int numberOfMisnumberedErrors = 0;
+    for (std::size_t i = 0; i < malformedLines.size(); i++)
+    {
+        if (malformedLines[i].compare(0, 6, "error,") == 0)
+        {
+            numberOfErrorLines++;
+            numberOfMisnumberedErrors += (fieldValue(malformedLines[i], 1) != (double)(i + 1)) ? 1 : 0;
+        }
+    }
+
+    testName = "Test spot stream malformed rows status";
+    reportTestResult(testInfo, testName, status, 0, error_tolerance);
+
+    testName = "Test spot stream answers every malformed row";
+    reportTestResult(testInfo, testName, (double)malformedLines.size(), 6, error_tolerance);
+
+    testName = "Test spot stream malformed rows are errors";
+    reportTestResult(testInfo, testName, numberOfErrorLines, 5, error_tolerance);
+
+    testName = "Test spot stream errors carry their line numbers";
+    reportTestResult(testInfo, testName, numberOfMisnumberedErrors, 0, error_tolerance);
+
+    testName = "Test spot stream row after malformed rows";
+    reportTestResult(testInfo, testName, malformedLines.empty() ? -1.0 : fieldValue(malformedLines.back(), 0), 4, error_tolerance);
+
+    // Results are written and flushed once per batch
+    struct FlushCountingBuffer : public std::stringbuf
+    {
+        int numberOfFlushes = 0;
+        int sync() override
+        {
+            numberOfFlushes++;
+            return std::stringbuf::sync();
+        }
+    };
+    const char* batchArguments[] = { "compute_spot_distance", "--stream", "--batch", "2" };
+    SpotStreamOptions batchOptions;
+    bool isParsed = parseSpotStreamArguments(4, const_cast<char**>(batchArguments), batchOptions);
+    FlushCountingBuffer batchBuffer;
+    std::ostream batchOut(&batchBuffer);
+    runStream("RIDGE_TOP,1\nRIDGE_TOP,2\nRIDGE_TOP,3\nRIDGE_TOP,4\nRIDGE_TOP,5\n", batchOptions, batchOut);
+
+    testName = "Test spot stream --batch argument";
+    reportTestResult(testInfo, testName, isParsed ? batchOptions.batchSize : -1, 2, error_tolerance);
+
+    testName = "Test spot stream flushes once per batch";
+    reportTestResult(testInfo, testName, batchBuffer.numberOfFlushes, 3, error_tolerance);
+
+    testName = "Test spot stream batches answer every row";
+    reportTestResult(testInfo, testName, (double)splitLines(batchBuffer.str()).size(), 5, error_tolerance);
+
+    testName = "Test spot stream rejects a negative --batch";
+    const char* negativeBatchArguments[] = { "compute_spot_distance", "--stream", "--batch", "-1" };
+    SpotStreamOptions negativeBatchOptions;
+    reportTestResult(testInfo, testName, parseSpotStreamArguments(4, const_cast<char**>(negativeBatchArguments),
+        negativeBatchOptions), false, error_tolerance);
+
+    // Workers take rows out of order, the output must still follow the input
+    const int numberOfOrderedRows = 1000;
+    std::string orderedInput;
+    for (int i = 0; i < numberOfOrderedRows; i++)
+    {
+        orderedInput += "RIDGE_TOP," + std::to_string(i) + "\n";
+    }
+    SpotStreamOptions threadedOptions;
+    threadedOptions.numberOfThreads = 4;
+    threadedOptions.batchSize = 300;
+    std::ostringstream orderedOut;
+    runStream(orderedInput, threadedOptions, orderedOut);
+    std::vector<std::string> orderedLines = splitLines(orderedOut.str());
+    int numberOfOutOfOrderRows = 0;
+    for (std::size_t i = 0; i < orderedLines.size(); i++)
+    {
+        numberOfOutOfOrderRows += (fieldValue(orderedLines[i], 0) != (double)i) ? 1 : 0;
+    }
+
+    testName = "Test spot stream on four threads answers every row";
+    reportTestResult(testInfo, testName, (double)orderedLines.size(), numberOfOrderedRows, error_tolerance);
+
+    testName = "Test spot stream on four threads keeps the input order";
+    reportTestResult(testInfo, testName, numberOfOutOfOrderRows, 0, error_tolerance);
+
+    std::cout << "Finished testing spot distance stream\n\n";
+}
+
 void testSpeedUnitConversion(TestInfo& testInfo, BehaveRun& behaveRun)
 {
     std::cout << "Testing speed unit conversion\n";
@@ -1661,8 +2398,82 @@ void testMortalityModule(TestInfo& testInfo, BehaveRun& behaveRun)
 {
     std::cout << "Testing Mortality module\n";
 
-    // TODO: Create tests for Mortality module
-    // Stub for now
+    string testName = "";
+    const double error_tolerance = 1e-12;
+
+    // Tree list of crown scorch trees of three species with one invalid tree
+    Mortality mortality(behaveRun.mortality);
+    mortality.setFlameLengthOrScorchHeightSwitch(FlameLengthOrScorchHeightSwitch::flame_length);
+    mortality.setFlameLengthOrScorchHeightValue(4, LengthUnits::Feet);
+    const int speciesTableIndices[3] =
+    {
+        mortality.getSpeciesTableIndexFromSpeciesCodeAndEquationType("ABAM", EquationType::crown_scorch),
+        mortality.getSpeciesTableIndexFromSpeciesCodeAndEquationType("ABCO", EquationType::crown_scorch),
+        mortality.getSpeciesTableIndexFromSpeciesCodeAndEquationType("ACRU", EquationType::crown_scorch)
+    };
+    const int numberOfTrees = 1500;
+    vector<int> speciesTableIndex(numberOfTrees);
+    vector<double> dbh(numberOfTrees);
+    vector<double> treeHeight(numberOfTrees);
+    vector<double> crownRatio(numberOfTrees);
+    vector<double> expansionFactor(numberOfTrees);
+    for(int i = 0; i < numberOfTrees; i++)
+    {
+        speciesTableIndex[i] = speciesTableIndices[(i / 7) % 3];
+        dbh[i] = 2.0 + (i % 30);
+        treeHeight[i] = 10.0 + (i % 60);
+        crownRatio[i] = 0.2 + 0.1 * (i % 6);
+        expansionFactor[i] = 1.0 + (i % 9);
+    }
+    speciesTableIndex[100] = -1;
+
+    MortalityTreeList treeList;
+    treeList.numberOfTrees = numberOfTrees;
+    treeList.speciesTableIndex = speciesTableIndex.data();
+    treeList.dbh = dbh.data();
+    treeList.treeHeight = treeHeight.data();
+    treeList.crownRatio = crownRatio.data();
+    treeList.expansionFactor = expansionFactor.data();
+
+    vector<double> probabilityOfMortality(numberOfTrees);
+    MortalityStandSummary summary = mortality.calculateMortalityForTreeList(treeList, probabilityOfMortality.data(), FractionUnits::Fraction);
+
+    double largestDifference = 0;
+    double expectedTreesKilled = 0;
+    double expectedBasalAreaKilled = 0;
+    for(int i = 0; i < numberOfTrees; i++)
+    {
+        double expectedProbability = -1;
+        if(speciesTableIndex[i] >= 0)
+        {
+            mortality.setSpeciesCode(mortality.getSpeciesCodeAtSpeciesTableIndex(speciesTableIndex[i]));
+            mortality.setEquationType(EquationType::crown_scorch);
+            mortality.setDBH(dbh[i], LengthUnits::Inches);
+            mortality.setTreeHeight(treeHeight[i], LengthUnits::Feet);
+            mortality.setCrownRatio(crownRatio[i]);
+            mortality.setTreeDensityPerUnitArea(expansionFactor[i], AreaUnits::Acres);
+            expectedProbability = mortality.calculateMortality(FractionUnits::Fraction);
+            expectedTreesKilled += mortality.getKilledTrees();
+            expectedBasalAreaKilled += mortality.getBasalAreaKillled();
+        }
+        largestDifference = std::max(largestDifference, std::fabs(probabilityOfMortality[i] - expectedProbability));
+    }
+
+    testName = "Test tree list probability of mortality matches single tree calculations";
+    reportTestResult(testInfo, testName, largestDifference, 0, error_tolerance);
+
+    testName = "Test tree list invalid tree count";
+    reportTestResult(testInfo, testName, (double)summary.numberOfInvalidTrees, 1, error_tolerance);
+
+    testName = "Test tree list trees killed per acre";
+    reportTestResult(testInfo, testName, summary.treesKilled, expectedTreesKilled, 1e-9);
+
+    testName = "Test tree list basal area killed per acre";
+    reportTestResult(testInfo, testName, summary.basalAreaKilled, expectedBasalAreaKilled, 1e-9);
+
+    testName = "Test tree list postfire canopy cover on four threads";
+    MortalityStandSummary threadedSummary = mortality.calculateMortalityForTreeList(treeList, probabilityOfMortality.data(), FractionUnits::Fraction, 4);
+    reportTestResult(testInfo, testName, threadedSummary.postfireCanopyCover, summary.postfireCanopyCover, error_tolerance);
 
     std::cout << "Finished testing Mortality module\n\n";
 }
@@ -1773,6 +2584,87 @@ void testFineDeadFuelMoistureTool(TestInfo& testInfo, BehaveRun& behaveRun)
     testName = "Test fine dead fuel moisture all indices out of bounds\n";
     reportTestResult(testInfo, testName, observedFineDeadFuelMoisture, expectedFineDeadFuelMoisture, error_tolerance);
 
+    // Hourly weather series for three sites against one lookup at a time
+    const int numberOfSites = 3;
+    const int hoursPerSite = 96;
+    const int numberOfRows = numberOfSites * hoursPerSite;
+    std::vector<double> seriesTemperature(numberOfRows);
+    std::vector<double> seriesRelativeHumidity(numberOfRows);
+    std::vector<int> seriesHour(numberOfRows);
+    std::vector<int> seriesMonth(numberOfRows);
+    std::vector<int> seriesSite(numberOfRows);
+    int siteAspect[numberOfSites] = { FDFMToolAspectIndex::NORTH, FDFMToolAspectIndex::SOUTH, FDFMToolAspectIndex::WEST };
+    int siteElevation[numberOfSites] = { FDFMToolElevationIndex::BELOW_1000_TO_2000_FT, FDFMToolElevationIndex::LEVEL_WITHIN_1000_FT,
+        FDFMToolElevationIndex::ABOVE_1000_TO_2000_FT };
+    int siteShading[numberOfSites] = { FDFMToolShadingIndex::EXPOSED, FDFMToolShadingIndex::SHADED, FDFMToolShadingIndex::EXPOSED };
+    int siteSlope[numberOfSites] = { FDFMToolSlopeIndex::ZERO_TO_THIRTY_PERCENT, FDFMToolSlopeIndex::ZERO_TO_THIRTY_PERCENT,
+        FDFMToolSlopeIndex::GREATER_THAN_OR_EQUAL_TO_THIRTY_ONE_PERCENT };
+    for (int row = 0; row < numberOfRows; row++)
+    {
+        int hour = row % hoursPerSite;
+        seriesSite[row] = row / hoursPerSite;
+        seriesHour[row] = hour % 24;
+        seriesMonth[row] = 1 + (hour / 8 + 3 * seriesSite[row]) % 12;
+        seriesTemperature[row] = -15.0 + 0.23 * row;    // oC
+        seriesRelativeHumidity[row] = fmod(7.3 * row, 101.0);
+    }
+
+    FDFMToolWeatherSeries weatherSeries;
+    weatherSeries.numberOfRows = numberOfRows;
+    weatherSeries.dryBulbTemperature = &seriesTemperature[0];
+    weatherSeries.relativeHumidity = &seriesRelativeHumidity[0];
+    weatherSeries.hourOfDay = &seriesHour[0];
+    weatherSeries.month = &seriesMonth[0];
+    weatherSeries.site = &seriesSite[0];
+    weatherSeries.numberOfSites = numberOfSites;
+    weatherSeries.aspectIndex = siteAspect;
+    weatherSeries.elevationIndex = siteElevation;
+    weatherSeries.shadingIndex = siteShading;
+    weatherSeries.slopeIndex = siteSlope;
+    weatherSeries.temperatureUnits = TemperatureUnits::Celsius;
+
+    std::vector<double> seriesMoistureOneHour(numberOfRows);
+    behaveRun.fineDeadFuelMoistureTool.calculateForWeatherSeries(weatherSeries, &seriesMoistureOneHour[0], FractionUnits::Percent);
+    int numberOfMismatches = 0;
+    for (int row = 0; row < numberOfRows; row++)
+    {
+        // Bin by the table labels
+        double temperatureInFahrenheit = seriesTemperature[row] * 9.0 / 5.0 + 32.0;
+        dryBulbIndex = (temperatureInFahrenheit < 30.0) ? 0 : (temperatureInFahrenheit < 50.0) ? 1 : (temperatureInFahrenheit < 70.0) ? 2
+            : (temperatureInFahrenheit < 90.0) ? 3 : (temperatureInFahrenheit < 110.0) ? 4 : 5;
+        relativeHumidityIndex = std::min((int)(seriesRelativeHumidity[row] / 5.0), 20);
+        int month = seriesMonth[row];
+        monthIndex = (month >= 5 && month <= 7) ? 0 : (month == 11 || month == 12 || month == 1) ? 2 : 1;
+        int hour = seriesHour[row];
+        timeOfDayIndex = (hour < 10) ? 0 : (hour < 12) ? 1 : (hour < 14) ? 2 : (hour < 16) ? 3 : (hour < 18) ? 4 : 5;
+        int site = seriesSite[row];
+        behaveRun.fineDeadFuelMoistureTool.calculateByIndex(siteAspect[site], dryBulbIndex, siteElevation[site], monthIndex,
+            relativeHumidityIndex, siteShading[site], siteSlope[site], timeOfDayIndex);
+        if (seriesMoistureOneHour[row] != behaveRun.fineDeadFuelMoistureTool.getFineDeadFuelMoisture())
+        {
+            numberOfMismatches++;
+        }
+    }
+    testName = "Test weather series fine dead fuel moistures match one lookup at a time";
+    reportTestResult(testInfo, testName, numberOfMismatches, 0, error_tolerance);
+
+    // Hand the series moistures to a surface run
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    std::vector<double> seriesSpreadRate(numberOfRows);
+    std::vector<double> seriesFlameLength(numberOfRows);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpreadForOneHourMoistures(numberOfRows, &seriesMoistureOneHour[0], FractionUnits::Percent,
+        &seriesSpreadRate[0], SpeedUnits::ChainsPerHour, &seriesFlameLength[0], LengthUnits::Feet);
+    double maximumDifference = 0.0;
+    for (int row = 0; row < numberOfRows; row += 7)
+    {
+        behaveRun.surface.setMoistureOneHour(seriesMoistureOneHour[row], FractionUnits::Percent);
+        behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+        maximumDifference = std::max(maximumDifference, fabs(seriesSpreadRate[row] - behaveRun.surface.getSpreadRate(SpeedUnits::ChainsPerHour)));
+        maximumDifference = std::max(maximumDifference, fabs(seriesFlameLength[row] - behaveRun.surface.getFlameLength(LengthUnits::Feet)));
+    }
+    testName = "Test surface runs over weather series moistures match single runs";
+    reportTestResult(testInfo, testName, maximumDifference, 0.0, error_tolerance);
+
     std::cout << "Finished testing Fine Dead Fuel Moisture Tool\n\n";
 }
 
@@ -1890,3 +2782,908 @@ void testSlopeTool(TestInfo& testInfo, BehaveRun& behaveRun)
 
     std::cout << "Finished testing  Slope Tool\n\n";
 }
+
+void testFireGrowth(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    std::cout << "Testing Fire Growth\n";
+    string testName = "";
+
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    Surface surface(behaveRun.surface);
+
+    const int numberOfRows = 21;
+    const int numberOfColumns = 21;
+    const double cellSize = 30.0;
+    std::vector<double> flat(numberOfRows * numberOfColumns, 0.0);
+
+    FireGrowthLandscape landscape;
+    landscape.numberOfRows = numberOfRows;
+    landscape.numberOfColumns = numberOfColumns;
+    landscape.cellSize = cellSize;
+    landscape.cellSizeUnits = LengthUnits::Meters;
+    landscape.slope = &flat[0];
+    landscape.windSpeed = &flat[0];
+
+    FireGrowth fireGrowth;
+    fireGrowth.setLandscape(landscape);
+    fireGrowth.calculateSpreadRates(surface);
+    fireGrowth.addIgnitionPoint(10, 10);
+    fireGrowth.calculateArrivalTimes();
+
+    // Without wind or slope the fire spreads at the same rate in every
+    // direction, and the stencil holds straight and diagonal paths exactly
+    surface.setSlope(0.0, SlopeUnits::Degrees);
+    surface.setWindSpeed(0.0, SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot);
+    surface.doSurfaceRunInDirectionOfMaxSpread();
+    double spreadRate = surface.getSpreadRate(SpeedUnits::MetersPerMinute);
+    double arrivalTimeTolerance = 1e-3; // spread rates are kept in single precision
+
+    testName = "Test fire growth arrival time 10 cells east without wind or slope";
+    reportTestResult(testInfo, testName, fireGrowth.getArrivalTime(10, 20, TimeUnits::Minutes), 10 * cellSize / spreadRate, arrivalTimeTolerance);
+
+    testName = "Test fire growth arrival time 10 cells north west without wind or slope";
+    reportTestResult(testInfo, testName, fireGrowth.getArrivalTime(0, 0, TimeUnits::Minutes), 10 * sqrt(2.0) * cellSize / spreadRate, arrivalTimeTolerance);
+
+    // A 5 mph wind from the north drives the head fire south
+    landscape.windSpeed = nullptr;
+    FireGrowth windDrivenGrowth;
+    windDrivenGrowth.setLandscape(landscape);
+    windDrivenGrowth.calculateSpreadRates(behaveRun.surface);
+    windDrivenGrowth.addIgnitionPoint(10, 10);
+    windDrivenGrowth.calculateArrivalTimes();
+
+    surface.setWindSpeed(5.0, SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot);
+    surface.doSurfaceRunInDirectionOfMaxSpread();
+    spreadRate = surface.getSpreadRate(SpeedUnits::MetersPerMinute);
+
+    testName = "Test fire growth direction of max spread with a north wind";
+    reportTestResult(testInfo, testName, windDrivenGrowth.getDirectionOfMaxSpread(10, 10), surface.getDirectionOfMaxSpread(), error_tolerance);
+
+    testName = "Test fire growth head fire arrival time 10 cells downwind";
+    int downwindRow = 10;
+    int downwindColumn = 10;
+    int rowOffset = 0;
+    int columnOffset = 0;
+    for (int neighbor = 0; neighbor < 8; neighbor++)
+    {
+        FireGrowth::getNeighborOffset(neighbor, rowOffset, columnOffset);
+        double direction = atan2((double)columnOffset, (double)-rowOffset) * 180.0 / 3.14159265358979323846;
+        direction = (direction < 0.0) ? direction + 360.0 : direction;
+        if (fabs(direction - surface.getDirectionOfMaxSpread()) < 1e-6)
+        {
+            downwindRow = 10 + 10 * rowOffset;
+            downwindColumn = 10 + 10 * columnOffset;
+        }
+    }
+    double distance = sqrt((double)(downwindRow - 10) * (downwindRow - 10) + (double)(downwindColumn - 10) * (downwindColumn - 10)) * cellSize;
+    reportTestResult(testInfo, testName, windDrivenGrowth.getArrivalTime(downwindRow, downwindColumn, TimeUnits::Minutes), distance / spreadRate, arrivalTimeTolerance);
+
+    testName = "Test fire growth backing fire arrival time 10 cells upwind";
+    double backingArrivalTime = windDrivenGrowth.getArrivalTime(20 - downwindRow, 20 - downwindColumn, TimeUnits::Minutes);
+    reportTestResult(testInfo, testName, backingArrivalTime, distance / surface.getBackingSpreadRate(SpeedUnits::MetersPerMinute), arrivalTimeTolerance);
+
+    // The arrival times do not depend on the number of threads computing the spread rates
+    std::vector<double> arrivalTimes(numberOfRows * numberOfColumns);
+    windDrivenGrowth.getArrivalTimes(&arrivalTimes[0], TimeUnits::Minutes);
+    FireGrowth threadedGrowth;
+    threadedGrowth.setNumberOfThreads(3);
+    threadedGrowth.setLandscape(landscape);
+    threadedGrowth.calculateSpreadRates(behaveRun.surface);
+    threadedGrowth.addIgnitionPoint(10, 10);
+    threadedGrowth.calculateArrivalTimes();
+    std::vector<double> threadedArrivalTimes(numberOfRows * numberOfColumns);
+    threadedGrowth.getArrivalTimes(&threadedArrivalTimes[0], TimeUnits::Minutes);
+
+    double largestArrivalTimeDifference = 0;
+    for (std::size_t i = 0; i < arrivalTimes.size(); i++)
+    {
+        largestArrivalTimeDifference = std::max(largestArrivalTimeDifference, std::fabs(threadedArrivalTimes[i] - arrivalTimes[i]));
+    }
+
+    testName = "Test fire growth arrival times with 3 threads match 1 thread";
+    reportTestResult(testInfo, testName, largestArrivalTimeDifference, 0, error_tolerance);
+
+    // Crown fire cells spread at the final spread rate of Crown's run
+    setCrownInputsLowMoistureScenario(behaveRun);
+    behaveRun.crown.setWindAndSpreadOrientationMode(WindAndSpreadOrientationMode::RelativeToNorth);
+    behaveRun.crown.doCrownRunRothermel();
+    FireGrowthLandscape crownLandscape;
+    crownLandscape.numberOfRows = 5;
+    crownLandscape.numberOfColumns = 5;
+    FireGrowth crownGrowth;
+    crownGrowth.setLandscape(crownLandscape);
+    crownGrowth.calculateSpreadRates(behaveRun.crown, FireGrowthCrownMethod::Rothermel);
+
+    testName = "Test fire growth crown fire type";
+    reportTestResult(testInfo, testName, crownGrowth.getFireType(2, 2), behaveRun.crown.getFireType(), error_tolerance);
+
+    testName = "Test fire growth crown fire spread rate";
+    reportTestResult(testInfo, testName, crownGrowth.getSpreadRate(2, 2, SpeedUnits::FeetPerMinute),
+        behaveRun.crown.getFinalSpreadRate(SpeedUnits::FeetPerMinute), error_tolerance);
+
+    std::cout << "Finished testing Fire Growth\n\n";
+}
+
+void testFirePerimeterGrowth(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    std::cout << "Testing Fire Perimeter Growth\n";
+    string testName = "";
+
+    // 5 mph wind from the north on flat ground, the head fire runs south
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    behaveRun.surface.setSlope(0.0, SlopeUnits::Degrees);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+
+    FirePerimeterGrowth perimeterGrowth;
+    perimeterGrowth.setUniformFire(behaveRun.surface);
+    perimeterGrowth.setVertexSpacing(1.0, 3.0, LengthUnits::Feet);
+    perimeterGrowth.setIgnitionPoint(0.0, 0.0, LengthUnits::Feet);
+
+    std::vector<double> x(perimeterGrowth.getNumberOfVertices());
+    std::vector<double> y(perimeterGrowth.getNumberOfVertices());
+    perimeterGrowth.getPerimeter(&x[0], &y[0], LengthUnits::Feet);
+    double ignitionRadius = *std::max_element(y.begin(), y.end());
+
+    for (int step = 0; step < 60; step++)
+    {
+        perimeterGrowth.advance(1.0, TimeUnits::Minutes);
+    }
+    x.resize(perimeterGrowth.getNumberOfVertices());
+    y.resize(perimeterGrowth.getNumberOfVertices());
+    perimeterGrowth.getPerimeter(&x[0], &y[0], LengthUnits::Feet);
+
+    // The vertices facing the head and the back of the ellipse move at its
+    // head and backing spread rates
+    testName = "Test fire perimeter growth head fire distance after 60 minutes";
+    double observedDistance = -*std::min_element(y.begin(), y.end()) - ignitionRadius;
+    reportTestResult(testInfo, testName, observedDistance, 60.0 * behaveRun.surface.getSpreadRate(SpeedUnits::FeetPerMinute), 1e-6);
+
+    testName = "Test fire perimeter growth backing fire distance after 60 minutes";
+    observedDistance = *std::max_element(y.begin(), y.end()) - ignitionRadius;
+    reportTestResult(testInfo, testName, observedDistance, 60.0 * behaveRun.surface.getBackingSpreadRate(SpeedUnits::FeetPerMinute), 1e-6);
+
+    // Moving the vertices in parallel does not change the perimeter
+    FirePerimeterGrowth threadedGrowth;
+    threadedGrowth.setUniformFire(behaveRun.surface);
+    threadedGrowth.setNumberOfThreads(4);
+    threadedGrowth.setVertexSpacing(0.1, 0.3, LengthUnits::Feet);
+    threadedGrowth.setPerimeter(x.size(), &x[0], &y[0], LengthUnits::Feet);
+    FirePerimeterGrowth singleThreadGrowth = threadedGrowth;
+    singleThreadGrowth.setNumberOfThreads(1);
+    threadedGrowth.advance(1.0, TimeUnits::Minutes);
+    singleThreadGrowth.advance(1.0, TimeUnits::Minutes);
+    std::vector<double> threadedX(threadedGrowth.getNumberOfVertices());
+    std::vector<double> threadedY(threadedGrowth.getNumberOfVertices());
+    threadedGrowth.getPerimeter(&threadedX[0], &threadedY[0], LengthUnits::Feet);
+    x.resize(singleThreadGrowth.getNumberOfVertices());
+    y.resize(singleThreadGrowth.getNumberOfVertices());
+    singleThreadGrowth.getPerimeter(&x[0], &y[0], LengthUnits::Feet);
+
+    testName = "Test fire perimeter growth number of vertices with 4 threads matches 1 thread";
+    reportTestResult(testInfo, testName, threadedX.size(), x.size(), error_tolerance);
+
+    double largestVertexDifference = 0;
+    for (std::size_t i = 0; i < std::min(x.size(), threadedX.size()); i++)
+    {
+        largestVertexDifference = std::max(largestVertexDifference, std::fabs(threadedX[i] - x[i]));
+        largestVertexDifference = std::max(largestVertexDifference, std::fabs(threadedY[i] - y[i]));
+    }
+
+    testName = "Test fire perimeter growth vertices with 4 threads match 1 thread";
+    reportTestResult(testInfo, testName, largestVertexDifference, 0, error_tolerance);
+
+    std::cout << "Finished testing Fire Perimeter Growth\n\n";
+}
+
+void testCApi(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    std::cout << "Testing C API\n";
+    string testName = "";
+
+    const int numberOfRows = 3;
+    const int fuelModelNumber[numberOfRows] = { 124, 124, 124 };
+    const double moistureOneHour[numberOfRows] = { 6.0, 6.0, 6.0 };
+    const double moistureTenHour[numberOfRows] = { 7.0, 7.0, 7.0 };
+    const double moistureHundredHour[numberOfRows] = { 8.0, 8.0, 8.0 };
+    const double moistureLiveHerbaceous[numberOfRows] = { 60.0, 60.0, 60.0 };
+    const double moistureLiveWoody[numberOfRows] = { 90.0, 90.0, 90.0 };
+    const double windSpeed[numberOfRows] = { 5.0, 10.0, 15.0 };
+    const double slope[numberOfRows] = { 30.0, 30.0, 30.0 };
+    const double canopyHeight[numberOfRows] = { 30.0, 30.0, 30.0 };
+    const double canopyBaseHeight[numberOfRows] = { 6.0, 6.0, 6.0 };
+    const double canopyBulkDensity[numberOfRows] = { 0.03, 0.03, 0.03 };
+    const double moistureFoliar[numberOfRows] = { 120.0, 120.0, 120.0 };
+
+    BehaveSurfaceColumns surfaceColumns = {};
+    surfaceColumns.structSize = sizeof(BehaveSurfaceColumns);
+    surfaceColumns.numberOfRows = numberOfRows;
+    surfaceColumns.fuelModelNumber = fuelModelNumber;
+    surfaceColumns.moistureOneHour = moistureOneHour;
+    surfaceColumns.moistureTenHour = moistureTenHour;
+    surfaceColumns.moistureHundredHour = moistureHundredHour;
+    surfaceColumns.moistureLiveHerbaceous = moistureLiveHerbaceous;
+    surfaceColumns.moistureLiveWoody = moistureLiveWoody;
+    surfaceColumns.windSpeed = windSpeed;
+    surfaceColumns.slope = slope;
+    surfaceColumns.canopyHeight = canopyHeight;
+
+    double spreadRate[numberOfRows];
+    double flameLength[numberOfRows];
+    BehaveSurfaceOutputs surfaceOutputs = {};
+    surfaceOutputs.structSize = sizeof(BehaveSurfaceOutputs);
+    surfaceOutputs.spreadRate = spreadRate;
+    surfaceOutputs.flameLength = flameLength;
+
+    BehaveFuelModels* fuelModels = behave_fuel_models_create();
+    int status = behave_surface_run_batch(fuelModels, &surfaceColumns, &surfaceOutputs);
+
+    behaveRun.surface.updateSurfaceInputs(124, 6.0, 7.0, 8.0, 60.0, 90.0, FractionUnits::Percent, 15.0, SpeedUnits::MilesPerHour,
+        WindHeightInputMode::TwentyFoot, 0.0, WindAndSpreadOrientationMode::RelativeToNorth, 30.0, SlopeUnits::Percent, 0.0,
+        0.0, FractionUnits::Percent, 30.0, LengthUnits::Feet, 0.0);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+
+    testName = "Test C API surface batch status";
+    reportTestResult(testInfo, testName, status, BEHAVE_OK, error_tolerance);
+
+    testName = "Test C API surface batch spread rate matches Surface";
+    reportTestResult(testInfo, testName, spreadRate[2], behaveRun.surface.getSpreadRate(SpeedUnits::FeetPerMinute), error_tolerance);
+
+    testName = "Test C API surface batch flame length matches Surface";
+    reportTestResult(testInfo, testName, flameLength[2], behaveRun.surface.getFlameLength(LengthUnits::Feet), error_tolerance);
+
+    testName = "Test C API surface batch without a wind speed column";
+    surfaceColumns.windSpeed = nullptr;
+    status = behave_surface_run_batch(fuelModels, &surfaceColumns, &surfaceOutputs);
+    reportTestResult(testInfo, testName, status, BEHAVE_ERROR_MISSING_COLUMN, error_tolerance);
+    surfaceColumns.windSpeed = windSpeed;
+
+    // A caller built against older structs passes a smaller structSize, the fields past it read as NULL
+    BehaveSurfaceColumns olderSurfaceColumns = surfaceColumns;
+    olderSurfaceColumns.structSize = offsetof(BehaveSurfaceColumns, slope);
+    BehaveSurfaceOutputs olderSurfaceOutputs = surfaceOutputs;
+    olderSurfaceOutputs.structSize = offsetof(BehaveSurfaceOutputs, flameLength);
+    flameLength[2] = -1.0;
+    status = behave_surface_run_batch(fuelModels, &olderSurfaceColumns, &olderSurfaceOutputs);
+
+    behaveRun.surface.updateSurfaceInputs(124, 6.0, 7.0, 8.0, 60.0, 90.0, FractionUnits::Percent, 15.0, SpeedUnits::MilesPerHour,
+        WindHeightInputMode::TwentyFoot, 0.0, WindAndSpreadOrientationMode::RelativeToNorth, 0.0, SlopeUnits::Percent, 0.0,
+        0.0, FractionUnits::Percent, 0.0, LengthUnits::Feet, 0.0);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+
+    testName = "Test C API surface batch with a smaller structSize status";
+    reportTestResult(testInfo, testName, status, BEHAVE_OK, error_tolerance);
+
+    testName = "Test C API surface batch with a smaller structSize reads no slope";
+    reportTestResult(testInfo, testName, spreadRate[2], behaveRun.surface.getSpreadRate(SpeedUnits::FeetPerMinute), error_tolerance);
+
+    testName = "Test C API surface batch with a smaller structSize writes no flame length";
+    reportTestResult(testInfo, testName, flameLength[2], -1.0, error_tolerance);
+
+    BehaveCrownColumns crownColumns = {};
+    crownColumns.structSize = sizeof(BehaveCrownColumns);
+    crownColumns.surface = &surfaceColumns;
+    crownColumns.canopyBaseHeight = canopyBaseHeight;
+    crownColumns.canopyBulkDensity = canopyBulkDensity;
+    crownColumns.moistureFoliar = moistureFoliar;
+
+    int fireType[numberOfRows];
+    BehaveCrownOutputs crownOutputs = {};
+    crownOutputs.structSize = sizeof(BehaveCrownOutputs);
+    crownOutputs.spreadRate = spreadRate;
+    crownOutputs.fireType = fireType;
+    status = behave_crown_run_batch(fuelModels, BEHAVE_CROWN_ROTHERMEL, &crownColumns, &crownOutputs);
+
+    behaveRun.crown.updateCrownInputs(124, 6.0, 7.0, 8.0, 60.0, 90.0, 120.0, FractionUnits::Percent, 15.0,
+        SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot, 0.0, WindAndSpreadOrientationMode::RelativeToNorth, 30.0,
+        SlopeUnits::Percent, 0.0, 0.0, FractionUnits::Percent, 30.0, 6.0, LengthUnits::Feet, 0.0, 0.03,
+        DensityUnits::PoundsPerCubicFoot);
+    behaveRun.crown.doCrownRunRothermel();
+
+    testName = "Test C API crown batch status";
+    reportTestResult(testInfo, testName, status, BEHAVE_OK, error_tolerance);
+
+    testName = "Test C API crown batch spread rate matches Crown";
+    reportTestResult(testInfo, testName, spreadRate[2], behaveRun.crown.getFinalSpreadRate(SpeedUnits::FeetPerMinute), error_tolerance);
+
+    testName = "Test C API crown batch fire type matches Crown";
+    reportTestResult(testInfo, testName, fireType[2], (int)behaveRun.crown.getFireType(), error_tolerance);
+
+    testName = "Test C API crown batch without surface columns";
+    crownColumns.surface = nullptr;
+    status = behave_crown_run_batch(fuelModels, BEHAVE_CROWN_ROTHERMEL, &crownColumns, &crownOutputs);
+    reportTestResult(testInfo, testName, status, BEHAVE_ERROR_MISSING_COLUMN, error_tolerance);
+
+    behave_fuel_models_destroy(fuelModels);
+
+    // Spotting on flat terrain, with the optional columns left NULL
+    const double coverHeight[numberOfRows] = { 30.0, 30.0, 30.0 };
+    const double burningPileFlameHeight[numberOfRows] = { 5.0, 5.0, 5.0 };
+    const double surfaceFlameLength[numberOfRows] = { 8.0, 8.0, 8.0 };
+    const int torchingTrees[numberOfRows] = { 15, 15, 15 };
+    const double DBH[numberOfRows] = { 20.0, 20.0, 20.0 };
+    const double treeHeight[numberOfRows] = { 30.0, 30.0, 30.0 };
+
+    BehaveSpotColumns spotColumns = {};
+    spotColumns.structSize = sizeof(BehaveSpotColumns);
+    spotColumns.numberOfRows = numberOfRows;
+    spotColumns.windSpeed = windSpeed;
+    spotColumns.downwindCoverHeight = coverHeight;
+    spotColumns.burningPileFlameHeight = burningPileFlameHeight;
+    spotColumns.flameLength = surfaceFlameLength;
+    spotColumns.torchingTrees = torchingTrees;
+    spotColumns.DBH = DBH;
+    spotColumns.treeHeight = treeHeight;
+
+    double flatDistance[numberOfRows];
+    double mountainDistance[numberOfRows];
+    Spot spot;
+
+    status = behave_spot_burning_pile_batch(&spotColumns, flatDistance, mountainDistance);
+    spot.updateSpotInputsForBurningPile(SpotFireLocation::MIDSLOPE_WINDWARD, 0.0, LengthUnits::Miles, 0.0, LengthUnits::Feet,
+        30.0, LengthUnits::Feet, SpotDownWindCanopyMode::CLOSED, 5.0, LengthUnits::Feet, 15.0, SpeedUnits::MilesPerHour);
+    spot.calculateSpottingDistanceFromBurningPile();
+
+    testName = "Test C API burning pile spot batch status";
+    reportTestResult(testInfo, testName, status, BEHAVE_OK, error_tolerance);
+
+    testName = "Test C API burning pile spot batch flat distance matches Spot";
+    reportTestResult(testInfo, testName, flatDistance[2], spot.getMaxFlatTerrainSpottingDistanceFromBurningPile(LengthUnits::Miles),
+        error_tolerance);
+
+    testName = "Test C API burning pile spot batch mountain distance matches Spot";
+    reportTestResult(testInfo, testName, mountainDistance[2],
+        spot.getMaxMountainousTerrainSpottingDistanceFromBurningPile(LengthUnits::Miles), error_tolerance);
+
+    status = behave_spot_surface_fire_batch(&spotColumns, flatDistance, mountainDistance);
+    spot.updateSpotInputsForSurfaceFire(SpotFireLocation::MIDSLOPE_WINDWARD, 0.0, LengthUnits::Miles, 0.0, LengthUnits::Feet,
+        30.0, LengthUnits::Feet, SpotDownWindCanopyMode::CLOSED, 15.0, SpeedUnits::MilesPerHour, 8.0, LengthUnits::Feet);
+    spot.calculateSpottingDistanceFromSurfaceFire();
+
+    testName = "Test C API surface fire spot batch status";
+    reportTestResult(testInfo, testName, status, BEHAVE_OK, error_tolerance);
+
+    testName = "Test C API surface fire spot batch flat distance matches Spot";
+    reportTestResult(testInfo, testName, flatDistance[2], spot.getMaxFlatTerrainSpottingDistanceFromSurfaceFire(LengthUnits::Miles),
+        error_tolerance);
+
+    testName = "Test C API surface fire spot batch mountain distance matches Spot";
+    reportTestResult(testInfo, testName, mountainDistance[2],
+        spot.getMaxMountainousTerrainSpottingDistanceFromSurfaceFire(LengthUnits::Miles), error_tolerance);
+
+    status = behave_spot_torching_trees_batch(&spotColumns, flatDistance, mountainDistance);
+    spot.updateSpotInputsForTorchingTrees(SpotFireLocation::MIDSLOPE_WINDWARD, 0.0, LengthUnits::Miles, 0.0, LengthUnits::Feet,
+        30.0, LengthUnits::Feet, SpotDownWindCanopyMode::CLOSED, 15, 20.0, LengthUnits::Inches, 30.0, LengthUnits::Feet,
+        SpotTreeSpecies::ENGELMANN_SPRUCE, 15.0, SpeedUnits::MilesPerHour);
+    spot.calculateSpottingDistanceFromTorchingTrees();
+
+    testName = "Test C API torching trees spot batch status";
+    reportTestResult(testInfo, testName, status, BEHAVE_OK, error_tolerance);
+
+    testName = "Test C API torching trees spot batch flat distance matches Spot";
+    reportTestResult(testInfo, testName, flatDistance[2], spot.getMaxFlatTerrainSpottingDistanceFromTorchingTrees(LengthUnits::Miles),
+        error_tolerance);
+
+    testName = "Test C API torching trees spot batch mountain distance matches Spot";
+    reportTestResult(testInfo, testName, mountainDistance[2],
+        spot.getMaxMountainousTerrainSpottingDistanceFromTorchingTrees(LengthUnits::Miles), error_tolerance);
+
+    testName = "Test C API torching trees spot batch without a DBH column";
+    spotColumns.DBH = nullptr;
+    status = behave_spot_torching_trees_batch(&spotColumns, flatDistance, mountainDistance);
+    reportTestResult(testInfo, testName, status, BEHAVE_ERROR_MISSING_COLUMN, error_tolerance);
+
+    // Mortality of a crown scorch tree and a tree whose species was not found
+    Mortality mortality(behaveRun.mortality);
+    BehaveSpeciesTable* speciesTable = behave_species_table_create();
+
+    testName = "Test C API species table finds a species code";
+    int speciesTableIndex = behave_species_table_find(speciesTable, "ABAM", BEHAVE_EQUATION_CROWN_SCORCH);
+    reportTestResult(testInfo, testName, speciesTableIndex,
+        mortality.getSpeciesTableIndexFromSpeciesCodeAndEquationType("ABAM", EquationType::crown_scorch), error_tolerance);
+
+    testName = "Test C API species table does not find an unknown species code";
+    int unknownSpeciesTableIndex = behave_species_table_find(speciesTable, "XXXX", BEHAVE_EQUATION_CROWN_SCORCH);
+    reportTestResult(testInfo, testName, unknownSpeciesTableIndex, -1, error_tolerance);
+
+    const int numberOfTrees = 2;
+    const int treeSpeciesTableIndex[numberOfTrees] = { speciesTableIndex, unknownSpeciesTableIndex };
+    const double treeDBH[numberOfTrees] = { 12.0, 12.0 };
+    const double treeTreeHeight[numberOfTrees] = { 40.0, 40.0 };
+    const double treeCrownRatio[numberOfTrees] = { 0.5, 0.5 };
+    const double treeExpansionFactor[numberOfTrees] = { 10.0, 10.0 };
+
+    BehaveMortalityColumns mortalityColumns = {};
+    mortalityColumns.structSize = sizeof(BehaveMortalityColumns);
+    mortalityColumns.numberOfRows = numberOfTrees;
+    mortalityColumns.speciesTableIndex = treeSpeciesTableIndex;
+    mortalityColumns.DBH = treeDBH;
+    mortalityColumns.treeHeight = treeTreeHeight;
+    mortalityColumns.crownRatio = treeCrownRatio;
+    mortalityColumns.expansionFactor = treeExpansionFactor;
+
+    double probabilityOfMortality[numberOfTrees];
+    BehaveMortalitySummary mortalitySummary;
+    status = behave_mortality_batch(speciesTable, &mortalityColumns, 4.0, 0, BEHAVE_FIRE_SEVERITY_NOT_SET, 1,
+        probabilityOfMortality, &mortalitySummary);
+
+    mortality.setFlameLengthOrScorchHeightSwitch(FlameLengthOrScorchHeightSwitch::flame_length);
+    mortality.setFlameLengthOrScorchHeightValue(4, LengthUnits::Feet);
+    mortality.setFireSeverity(FireSeverity::not_set);
+    mortality.setSpeciesCode("ABAM");
+    mortality.setEquationType(EquationType::crown_scorch);
+    mortality.setDBH(12.0, LengthUnits::Inches);
+    mortality.setTreeHeight(40.0, LengthUnits::Feet);
+    mortality.setCrownRatio(0.5);
+    mortality.setTreeDensityPerUnitArea(10.0, AreaUnits::Acres);
+
+    testName = "Test C API mortality batch status";
+    reportTestResult(testInfo, testName, status, BEHAVE_OK, error_tolerance);
+
+    testName = "Test C API mortality batch probability matches Mortality";
+    reportTestResult(testInfo, testName, probabilityOfMortality[0], mortality.calculateMortality(FractionUnits::Fraction),
+        error_tolerance);
+
+    testName = "Test C API mortality batch probability of an unknown species";
+    reportTestResult(testInfo, testName, probabilityOfMortality[1], -1.0, error_tolerance);
+
+    testName = "Test C API mortality batch invalid tree count";
+    reportTestResult(testInfo, testName, (double)mortalitySummary.numberOfInvalidTrees, 1, error_tolerance);
+
+    testName = "Test C API mortality batch with an unknown fire severity";
+    status = behave_mortality_batch(speciesTable, &mortalityColumns, 4.0, 0, BEHAVE_FIRE_SEVERITY_LOW + 1, 1,
+        probabilityOfMortality, &mortalitySummary);
+    reportTestResult(testInfo, testName, status, BEHAVE_ERROR_INVALID_ARGUMENT, error_tolerance);
+
+    // Columns left NULL are not set, as in Mortality
+    mortalityColumns.DBH = nullptr;
+    mortalityColumns.treeHeight = nullptr;
+    mortalityColumns.crownRatio = nullptr;
+    status = behave_mortality_batch(speciesTable, &mortalityColumns, 4.0, 0, BEHAVE_FIRE_SEVERITY_NOT_SET, 1,
+        probabilityOfMortality, &mortalitySummary);
+
+    mortality.setDBH(-1.0, LengthUnits::Inches);
+    mortality.setTreeHeight(-1.0, LengthUnits::Feet);
+    mortality.setCrownRatio(-1.0);
+
+    testName = "Test C API mortality batch status without DBH, tree height and crown ratio";
+    reportTestResult(testInfo, testName, status, BEHAVE_OK, error_tolerance);
+
+    testName = "Test C API mortality batch probability without DBH, tree height and crown ratio matches Mortality";
+    reportTestResult(testInfo, testName, probabilityOfMortality[0], mortality.calculateMortality(FractionUnits::Fraction),
+        error_tolerance);
+
+    behave_species_table_destroy(speciesTable);
+
+    std::cout << "Finished testing C API\n\n";
+}
+
+void testInstrumentation(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    std::cout << "Testing instrumentation\n";
+    string testName = "";
+
+    Instrumentation::reset();
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    InstrumentationSnapshot snapshot = Instrumentation::snapshotCurrentThread();
+
+    // Only counted when the core is built with BEHAVE_INSTRUMENTATION
+    testName = "Test instrumentation counts surface fire stages";
+    std::uint64_t observedCalls = snapshot.stageCalls[InstrumentationStage::SurfaceFlameAndIntensity];
+    reportTestResult(testInfo, testName, observedCalls > 0, Instrumentation::isEnabled(), error_tolerance);
+
+    std::string json = Instrumentation::toJson(Instrumentation::snapshot());
+    auto countOccurrences = [&json](const std::string& text)
+    {
+        int count = 0;
+        for (std::size_t position = json.find(text); position != std::string::npos; position = json.find(text, position + 1))
+        {
+            count++;
+        }
+        return count;
+    };
+
+    testName = "Test instrumentation JSON names the first stage";
+    reportTestResult(testInfo, testName, countOccurrences("\"surfaceFuelbedIntermediates\": {\"calls\": "), 1, error_tolerance);
+    testName = "Test instrumentation JSON names the last counter";
+    reportTestResult(testInfo, testName, countOccurrences("\"containStepHalved\": "), 1, error_tolerance);
+
+    std::cout << "Finished testing instrumentation\n\n";
+}
+
+void testTrace(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    std::cout << "Testing trace\n";
+    string testName = "";
+
+    const char* spanNames[] = { "span 1", "span 2", "span 3", "span 4", "span 5", "span 6" };
+    const char* workerNames[] = { "trace test worker 1", "trace test worker 2", "trace test worker 3" };
+    Trace::start(4);
+    for (int i = 0; i < 3; i++)
+    {
+        std::thread worker([&workerNames, i]
+        {
+            Trace::setThreadName(workerNames[i]);
+            TraceSpan firstSpan("test", "worker span");
+            TraceSpan secondSpan("test", "worker span");
+        });
+        worker.join();
+    }
+    for (int i = 0; i < 6; i++)
+    {
+        TraceSpan span("test", spanNames[i]);
+        behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    }
+    Trace::addCounter("test counter", 42.0);
+    Trace::stop();
+    // Not recorded once stopped
+    Trace::addCounter("test counter", 43.0);
+
+    std::ostringstream trace;
+    Trace::writeChromeTrace(trace);
+    std::string json = trace.str();
+    auto countOccurrences = [&json](const std::string& text)
+    {
+        int count = 0;
+        for (std::size_t position = json.find(text); position != std::string::npos; position = json.find(text, position + 1))
+        {
+            count++;
+        }
+        return count;
+    };
+
+    testName = "Test trace counts events of running and exited threads";
+    reportTestResult(testInfo, testName, (double)Trace::getNumberOfEventsRecorded(), 13, error_tolerance);
+    testName = "Test trace ring buffer keeps the newest span";
+    reportTestResult(testInfo, testName, countOccurrences("\"name\": \"span 6\", \"cat\": \"test\", \"ph\": \"X\""), 1, error_tolerance);
+    testName = "Test trace ring buffer drops the oldest spans";
+    reportTestResult(testInfo, testName, countOccurrences("\"span 2\""), 0, error_tolerance);
+    testName = "Test trace keeps counters recorded while recording";
+    reportTestResult(testInfo, testName, countOccurrences("\"args\": {\"value\": 42}"), 1, error_tolerance);
+    testName = "Test trace ignores counters after stop";
+    reportTestResult(testInfo, testName, countOccurrences("\"args\": {\"value\": 43}"), 0, error_tolerance);
+    testName = "Test trace keeps one ring buffer of exited thread events";
+    reportTestResult(testInfo, testName, countOccurrences("\"worker span\""), 4, error_tolerance);
+    testName = "Test trace drops the oldest exited thread";
+    reportTestResult(testInfo, testName, countOccurrences("\"trace test worker 1\""), 0, error_tolerance);
+    testName = "Test trace keeps the newest exited thread";
+    reportTestResult(testInfo, testName, countOccurrences("\"trace test worker 3\""), 1, error_tolerance);
+
+    std::cout << "Finished testing trace\n\n";
+}
+
+void testRunResultCache(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    std::cout << "Testing run result cache\n";
+    string testName = "";
+
+    RunResultCache resultCache;
+    resultCache.setEnabled(true);
+    resultCache.setQuantization(1.0, FractionUnits::Percent, 0.1, SpeedUnits::MilesPerHour, 1.0, SlopeUnits::Degrees, 5.0);
+
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    double expectedSpreadRate = behaveRun.surface.getSpreadRate(SpeedUnits::FeetPerMinute);
+    resultCache.doSurfaceRunInDirectionOfMaxSpread(behaveRun.surface);
+    RunResult repeated = resultCache.doSurfaceRunInDirectionOfMaxSpread(behaveRun.surface);
+    // Within half a step of the cached moisture
+    behaveRun.surface.setMoistureOneHour(6.3, FractionUnits::Percent);
+    RunResult nearby = resultCache.doSurfaceRunInDirectionOfMaxSpread(behaveRun.surface);
+
+    testName = "Test result cache hits for repeated and nearby inputs";
+    reportTestResult(testInfo, testName, (double)resultCache.getHits(), 2, error_tolerance);
+    testName = "Test result cache misses for the first inputs";
+    reportTestResult(testInfo, testName, (double)resultCache.getMisses(), 1, error_tolerance);
+    testName = "Test result cache spread rate of repeated inputs";
+    reportTestResult(testInfo, testName, repeated.spreadRate, expectedSpreadRate, error_tolerance);
+    testName = "Test result cache spread rate of nearby inputs";
+    reportTestResult(testInfo, testName, nearby.spreadRate, expectedSpreadRate, error_tolerance);
+
+    setSurfaceInputsForTwoFuelModelsLowMoistureScenario(behaveRun);
+    RunResult twoFuelModels = resultCache.doSurfaceRunInDirectionOfMaxSpread(behaveRun.surface);
+    testName = "Test result cache bypasses two fuel models runs";
+    reportTestResult(testInfo, testName, (double)resultCache.getBypasses(), 1, error_tolerance);
+    testName = "Test result cache spread rate of two fuel models run";
+    reportTestResult(testInfo, testName, twoFuelModels.spreadRate, behaveRun.surface.getSpreadRate(SpeedUnits::FeetPerMinute), error_tolerance);
+
+    setCrownInputsLowMoistureScenario(behaveRun);
+    behaveRun.crown.doCrownRunScottAndReinhardt();
+    double expectedCrownSpreadRate = behaveRun.crown.getFinalSpreadRate(SpeedUnits::FeetPerMinute);
+    int expectedFireType = behaveRun.crown.getFireType();
+    resultCache.doCrownRunScottAndReinhardt(behaveRun.crown);
+    RunResult crown = resultCache.doCrownRunScottAndReinhardt(behaveRun.crown);
+    // Same inputs, other crown method, so another key
+    resultCache.doCrownRunRothermel(behaveRun.crown);
+    testName = "Test result cache hits for repeated crown inputs";
+    reportTestResult(testInfo, testName, (double)resultCache.getHits(), 3, error_tolerance);
+    testName = "Test result cache stores each crown method separately";
+    reportTestResult(testInfo, testName, (double)resultCache.getSize(), 3, error_tolerance);
+    testName = "Test result cache crown final spread rate";
+    reportTestResult(testInfo, testName, crown.spreadRate, expectedCrownSpreadRate, error_tolerance);
+    testName = "Test result cache keeps crown fire types";
+    reportTestResult(testInfo, testName, crown.fireType, expectedFireType, error_tolerance);
+
+    // A NaN row, such as "nan" parsed by a batch reader
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    behaveRun.surface.setMoistureOneHour(std::nan(""), FractionUnits::Percent);
+    unsigned long long bypasses = resultCache.getBypasses();
+    std::size_t size = resultCache.getSize();
+    resultCache.doSurfaceRunInDirectionOfMaxSpread(behaveRun.surface);
+    resultCache.doSurfaceRunInDirectionOfMaxSpread(behaveRun.surface);
+    testName = "Test result cache calculates runs with a NaN input";
+    reportTestResult(testInfo, testName, (double)(resultCache.getBypasses() - bypasses), 2, error_tolerance);
+    testName = "Test result cache does not store runs with a NaN input";
+    reportTestResult(testInfo, testName, (double)resultCache.getSize(), (double)size, error_tolerance);
+
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    std::cout << "Finished testing run result cache\n\n";
+}
+
+void testResultsSnapshot(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    std::cout << "Testing results snapshot\n";
+    string testName = "";
+
+    UnitSystem metric = UnitSystem::metric();
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    behaveRun.surface.setElapsedTime(2, TimeUnits::Hours);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    SurfaceResults surfaceResults = behaveRun.surface.getResults(metric);
+
+    testName = "Test surface results snapshot spread rate";
+    reportTestResult(testInfo, testName, surfaceResults.spreadRate, behaveRun.surface.getSpreadRate(SpeedUnits::MetersPerMinute), error_tolerance);
+    testName = "Test surface results snapshot backing spread rate";
+    reportTestResult(testInfo, testName, surfaceResults.backingSpreadRate, behaveRun.surface.getBackingSpreadRate(SpeedUnits::MetersPerMinute), error_tolerance);
+    testName = "Test surface results snapshot flame length";
+    reportTestResult(testInfo, testName, surfaceResults.flameLength, behaveRun.surface.getFlameLength(LengthUnits::Meters), error_tolerance);
+    testName = "Test surface results snapshot fireline intensity";
+    reportTestResult(testInfo, testName, surfaceResults.firelineIntensity, behaveRun.surface.getFirelineIntensity(FirelineIntensityUnits::KilowattsPerMeter), error_tolerance);
+    testName = "Test surface results snapshot midflame wind speed";
+    reportTestResult(testInfo, testName, surfaceResults.midflameWindSpeed, behaveRun.surface.getMidflameWindspeed(SpeedUnits::KilometersPerHour), error_tolerance);
+    testName = "Test surface results snapshot elliptical B";
+    reportTestResult(testInfo, testName, surfaceResults.ellipticalB, behaveRun.surface.getEllipticalB(LengthUnits::Meters, 2, TimeUnits::Hours), error_tolerance);
+    testName = "Test surface results snapshot flanking spread distance";
+    reportTestResult(testInfo, testName, surfaceResults.flankingSpreadDistance, behaveRun.surface.getFlankingSpreadDistance(LengthUnits::Meters, 2, TimeUnits::Hours), error_tolerance);
+    testName = "Test surface results snapshot fire area";
+    reportTestResult(testInfo, testName, surfaceResults.fireArea, behaveRun.surface.getFireArea(AreaUnits::Hectares, 2, TimeUnits::Hours), error_tolerance);
+
+    setCrownInputsLowMoistureScenario(behaveRun);
+    behaveRun.crown.doCrownRunScottAndReinhardt();
+    CrownResults crownResults = behaveRun.crown.getResults(metric);
+    double elapsedTime = behaveRun.crown.getSurfaceInputs().getElapsedTime(TimeUnits::Minutes);
+    testName = "Test crown results snapshot fire type";
+    reportTestResult(testInfo, testName, crownResults.fireType, behaveRun.crown.getFireType(), error_tolerance);
+    testName = "Test crown results snapshot final spread rate";
+    reportTestResult(testInfo, testName, crownResults.finalSpreadRate, behaveRun.crown.getFinalSpreadRate(SpeedUnits::MetersPerMinute), error_tolerance);
+    testName = "Test crown results snapshot final flame length";
+    reportTestResult(testInfo, testName, crownResults.finalFlameLength, behaveRun.crown.getFinalFlameLength(LengthUnits::Meters), error_tolerance);
+    testName = "Test crown results snapshot critical open wind speed";
+    reportTestResult(testInfo, testName, crownResults.criticalOpenWindSpeed, behaveRun.crown.getCriticalOpenWindSpeed(SpeedUnits::KilometersPerHour), error_tolerance);
+    testName = "Test crown results snapshot crown fire area";
+    reportTestResult(testInfo, testName, crownResults.crownFireArea, behaveRun.crown.getCrownFireArea(AreaUnits::Hectares, elapsedTime, TimeUnits::Minutes), error_tolerance);
+
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    behaveRun.surface.setElapsedTime(1, TimeUnits::Hours);
+    std::cout << "Finished testing results snapshot\n\n";
+}
+
+#ifdef BEHAVE_SERVER
+void testServerRequests(TestInfo& testInfo, BehaveRun& behaveRun)
+{
+    using namespace BehaveServerProtocol;
+
+    std::cout << "Testing server requests\n";
+    string testName = "";
+
+    SpeciesMasterTable speciesMasterTable;
+    RequestHeader request;
+    ResponseHeader response;
+    std::vector<char> payload;
+    std::vector<char> responsePayload;
+
+    // Frames parameters and rows the way a client would
+    auto frameRequest = [&](int module, std::uint32_t outputMask, const std::vector<double>& parameters,
+        std::uint32_t numberOfRows, std::uint32_t numberOfColumns, const std::vector<double>& rows)
+    {
+        std::memset(&request, 0, sizeof(request));
+        request.requestId = 7;
+        request.module = (std::uint16_t)module;
+        request.numberOfParameters = (std::uint16_t)parameters.size();
+        request.outputMask = outputMask;
+        request.numberOfRows = numberOfRows;
+        request.numberOfColumns = numberOfColumns;
+        payload.resize((parameters.size() + rows.size()) * sizeof(double));
+        if (!parameters.empty())
+        {
+            std::memcpy(&payload[0], &parameters[0], parameters.size() * sizeof(double));
+        }
+        if (!rows.empty())
+        {
+            std::memcpy(&payload[parameters.size() * sizeof(double)], &rows[0], rows.size() * sizeof(double));
+        }
+    };
+    auto calculate = [&](int module, std::uint32_t outputMask, const std::vector<double>& parameters,
+        std::uint32_t numberOfRows, std::uint32_t numberOfColumns, const std::vector<double>& rows)
+    {
+        frameRequest(module, outputMask, parameters, numberOfRows, numberOfColumns, rows);
+        BehaveServer::calculateRequest(behaveRun, speciesMasterTable, request, payload, response, responsePayload);
+    };
+    auto responseValue = [&](std::size_t index)
+    {
+        double value = 0;
+        std::memcpy(&value, &responsePayload[index * sizeof(double)], sizeof(double));
+        return value;
+    };
+
+    const std::vector<double> surfaceRow = { 124, 6, 7, 8, 60, 90, 15, 0, 30, 0, 0, 30, 0 };
+    behaveRun.surface.updateSurfaceInputs(124, 6.0, 7.0, 8.0, 60.0, 90.0, FractionUnits::Percent, 15.0, SpeedUnits::MilesPerHour,
+        WindHeightInputMode::TwentyFoot, 0.0, WindAndSpreadOrientationMode::RelativeToNorth, 30.0, SlopeUnits::Percent, 0.0,
+        0.0, FractionUnits::Percent, 30.0, LengthUnits::Feet, 0.0);
+    behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+    double expectedSpreadRate = behaveRun.surface.getSpreadRate(SpeedUnits::FeetPerMinute);
+    double expectedFlameLength = behaveRun.surface.getFlameLength(LengthUnits::Feet);
+    double expectedHeatPerUnitArea = behaveRun.surface.getHeatPerUnitArea(HeatPerUnitAreaUnits::BtusPerSquareFoot);
+
+    calculate(Module::Surface, 0, {}, 1, SurfaceInput::NumberOfInputs, surfaceRow);
+
+    testName = "Test server surface request status";
+    reportTestResult(testInfo, testName, response.status, Status::Ok, error_tolerance);
+
+    testName = "Test server surface request echoes the request id";
+    reportTestResult(testInfo, testName, response.requestId, 7, error_tolerance);
+
+    testName = "Test server surface request with every output";
+    reportTestResult(testInfo, testName, response.numberOfColumns, SurfaceOutput::NumberOfOutputs, error_tolerance);
+
+    testName = "Test server surface request spread rate";
+    reportTestResult(testInfo, testName, responseValue(SurfaceOutput::SpreadRate), expectedSpreadRate, error_tolerance);
+
+    testName = "Test server surface request heat per unit area";
+    reportTestResult(testInfo, testName, responseValue(SurfaceOutput::HeatPerUnitArea), expectedHeatPerUnitArea, error_tolerance);
+
+    calculate(Module::Surface, (1u << SurfaceOutput::FlameLength) | (1u << SurfaceOutput::HeatPerUnitArea), {}, 1,
+        SurfaceInput::NumberOfInputs, surfaceRow);
+
+    testName = "Test server surface request with an output mask subset";
+    reportTestResult(testInfo, testName, response.numberOfColumns, 2, error_tolerance);
+
+    testName = "Test server surface request first masked output";
+    reportTestResult(testInfo, testName, responseValue(0), expectedFlameLength, error_tolerance);
+
+    testName = "Test server surface request second masked output";
+    reportTestResult(testInfo, testName, responseValue(1), expectedHeatPerUnitArea, error_tolerance);
+
+    testName = "Test server surface request with an output past the last";
+    calculate(Module::Surface, 1u << SurfaceOutput::NumberOfOutputs, {}, 1, SurfaceInput::NumberOfInputs, surfaceRow);
+    reportTestResult(testInfo, testName, response.status, Status::InvalidRequest, error_tolerance);
+
+    testName = "Test server surface request with the wrong number of columns";
+    calculate(Module::Surface, 0, {}, 1, SurfaceInput::NumberOfInputs - 1, surfaceRow);
+    reportTestResult(testInfo, testName, response.status, Status::InvalidRequest, error_tolerance);
+
+    testName = "Test server surface request with a short payload";
+    std::vector<double> shortSurfaceRow(surfaceRow.begin(), surfaceRow.end() - 1);
+    calculate(Module::Surface, 0, {}, 1, SurfaceInput::NumberOfInputs, shortSurfaceRow);
+    reportTestResult(testInfo, testName, response.status, Status::InvalidRequest, error_tolerance);
+
+    testName = "Test server surface request with an undefined fuel model";
+    std::vector<double> undefinedFuelModelRow = surfaceRow;
+    undefinedFuelModelRow[SurfaceInput::FuelModelNumber] = 14;
+    calculate(Module::Surface, 0, {}, 1, SurfaceInput::NumberOfInputs, undefinedFuelModelRow);
+    reportTestResult(testInfo, testName, response.status, Status::InvalidInput, error_tolerance);
+
+    testName = "Test server request for an unknown module";
+    calculate(99, 0, {}, 1, SurfaceInput::NumberOfInputs, surfaceRow);
+    reportTestResult(testInfo, testName, response.status, Status::InvalidRequest, error_tolerance);
+
+    std::vector<double> crownRow = surfaceRow;
+    crownRow.push_back(6);
+    crownRow.push_back(0.03);
+    crownRow.push_back(120);
+    calculate(Module::Crown, 0, { 0 }, 1, CrownInput::NumberOfInputs, crownRow);
+    behaveRun.crown.updateCrownInputs(124, 6.0, 7.0, 8.0, 60.0, 90.0, 120.0, FractionUnits::Percent, 15.0,
+        SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot, 0.0, WindAndSpreadOrientationMode::RelativeToNorth, 30.0,
+        SlopeUnits::Percent, 0.0, 0.0, FractionUnits::Percent, 30.0, 6.0, LengthUnits::Feet, 0.0, 0.03,
+        DensityUnits::PoundsPerCubicFoot);
+    behaveRun.crown.doCrownRunRothermel();
+
+    testName = "Test server crown request status";
+    reportTestResult(testInfo, testName, response.status, Status::Ok, error_tolerance);
+
+    testName = "Test server crown request spread rate";
+    reportTestResult(testInfo, testName, responseValue(CrownOutput::SpreadRate),
+        behaveRun.crown.getFinalSpreadRate(SpeedUnits::FeetPerMinute), error_tolerance);
+
+    testName = "Test server crown request fire type";
+    reportTestResult(testInfo, testName, responseValue(CrownOutput::FireType), behaveRun.crown.getFireType(), error_tolerance);
+
+    const std::vector<double> spotRow = { 0, 0, 0, 30, 1, 15, 5, 8, 15, 20, 30, 0 };
+    calculate(Module::Spot, 0, { SpotSource::TorchingTrees }, 1, SpotInput::NumberOfInputs, spotRow);
+    Spot spot;
+    spot.updateSpotInputsForTorchingTrees(SpotFireLocation::MIDSLOPE_WINDWARD, 0.0, LengthUnits::Miles, 0.0, LengthUnits::Feet,
+        30.0, LengthUnits::Feet, SpotDownWindCanopyMode::CLOSED, 15, 20.0, LengthUnits::Inches, 30.0, LengthUnits::Feet,
+        SpotTreeSpecies::ENGELMANN_SPRUCE, 15.0, SpeedUnits::MilesPerHour);
+    spot.calculateSpottingDistanceFromTorchingTrees();
+
+    testName = "Test server spot request status";
+    reportTestResult(testInfo, testName, response.status, Status::Ok, error_tolerance);
+
+    testName = "Test server spot request flat distance";
+    reportTestResult(testInfo, testName, responseValue(SpotOutput::FlatDistance),
+        spot.getMaxFlatTerrainSpottingDistanceFromTorchingTrees(LengthUnits::Miles), error_tolerance);
+
+    testName = "Test server spot request mountain distance";
+    reportTestResult(testInfo, testName, responseValue(SpotOutput::MountainDistance),
+        spot.getMaxMountainousTerrainSpottingDistanceFromTorchingTrees(LengthUnits::Miles), error_tolerance);
+
+    const std::vector<double> containRow = { 1, 5, 3, 0, 0, 60, 480, 20 };
+    calculate(Module::Contain, 0, { 1 }, 1, ContainInput::NumberOfInputs + ContainInputsPerResource, containRow);
+    std::int32_t containStatus = response.status;
+    double containmentStatus = responseValue(ContainOutput::ContainmentStatus);
+    double finalFireSize = responseValue(ContainOutput::FinalFireSize);
+    behaveRun.contain.removeAllResources();
+    behaveRun.contain.setReportSize(1, AreaUnits::Acres);
+    behaveRun.contain.setReportRate(5, SpeedUnits::ChainsPerHour);
+    behaveRun.contain.setLwRatio(3);
+    behaveRun.contain.setTactic(ContainTactic::HeadAttack);
+    behaveRun.contain.setAttackDistance(0, LengthUnits::Chains);
+    behaveRun.contain.addResource(60, 480, TimeUnits::Minutes, 20, SpeedUnits::ChainsPerHour);
+    behaveRun.contain.doContainRun();
+
+    testName = "Test server contain request status";
+    reportTestResult(testInfo, testName, containStatus, Status::Ok, error_tolerance);
+
+    testName = "Test server contain request containment status";
+    reportTestResult(testInfo, testName, containmentStatus, behaveRun.contain.getContainmentStatus(),
+        error_tolerance);
+
+    testName = "Test server contain request final fire size";
+    reportTestResult(testInfo, testName, finalFireSize, behaveRun.contain.getFinalFireSize(AreaUnits::Acres),
+        error_tolerance);
+    behaveRun.contain.removeAllResources();
+
+    const std::string speciesCodes = "ABAM\nXXXX\n";
+    frameRequest(Module::SpeciesLookup, 0, { (double)EquationType::crown_scorch }, 2, 0, {});
+    payload.insert(payload.end(), speciesCodes.begin(), speciesCodes.end());
+    BehaveServer::calculateRequest(behaveRun, speciesMasterTable, request, payload, response, responsePayload);
+    int expectedSpeciesTableIndex = speciesMasterTable.getSpeciesTableIndexFromSpeciesCodeAndEquationType("ABAM",
+        EquationType::crown_scorch);
+
+    testName = "Test server species lookup request status";
+    reportTestResult(testInfo, testName, response.status, Status::Ok, error_tolerance);
+
+    testName = "Test server species lookup request finds a species code";
+    reportTestResult(testInfo, testName, responseValue(0), expectedSpeciesTableIndex, error_tolerance);
+
+    testName = "Test server species lookup request does not find an unknown species code";
+    reportTestResult(testInfo, testName, responseValue(1), -1, error_tolerance);
+
+    testName = "Test server species lookup request with more rows than species codes";
+    request.numberOfRows = 3;
+    BehaveServer::calculateRequest(behaveRun, speciesMasterTable, request, payload, response, responsePayload);
+    reportTestResult(testInfo, testName, response.status, Status::InvalidRequest, error_tolerance);
+
+    const std::vector<double> mortalityRow = { (double)expectedSpeciesTableIndex, 12, 40, 0.5, 10, 0, 0, -1, 0 };
+    calculate(Module::Mortality, 0, { 4, 0, -1 }, 1, MortalityInput::NumberOfInputs, mortalityRow);
+    Mortality mortality(behaveRun.mortality);
+    mortality.setFlameLengthOrScorchHeightSwitch(FlameLengthOrScorchHeightSwitch::flame_length);
+    mortality.setFlameLengthOrScorchHeightValue(4, LengthUnits::Feet);
+    mortality.setFireSeverity(FireSeverity::not_set);
+    mortality.setSpeciesCode("ABAM");
+    mortality.setEquationType(EquationType::crown_scorch);
+    mortality.setDBH(12.0, LengthUnits::Inches);
+    mortality.setTreeHeight(40.0, LengthUnits::Feet);
+    mortality.setCrownRatio(0.5);
+    mortality.setTreeDensityPerUnitArea(10.0, AreaUnits::Acres);
+
+    testName = "Test server mortality request status";
+    reportTestResult(testInfo, testName, response.status, Status::Ok, error_tolerance);
+
+    testName = "Test server mortality request probability of mortality";
+    reportTestResult(testInfo, testName, responseValue(MortalityOutput::ProbabilityOfMortality),
+        mortality.calculateMortality(FractionUnits::Fraction), error_tolerance);
+
+    setSurfaceInputsForGS4LowMoistureScenario(behaveRun);
+    std::cout << "Finished testing server requests\n\n";
+}
+#endif
@@ -0,0 +1,33 @@
+#include <iostream>
+
+#include "behaveRun.h"
+#include "fuelModels.h"
+#include "vaporPressureDeficitCalculator.h"
+
+// Runs a surface fire and a vapor pressure deficit through the installed
+// headers and libraries, exiting with 1 if either gives no result
+int main()
+{
+    FuelModels fuelModels;
+    SpeciesMasterTable mortalitySpeciesTable;
+    BehaveRun behave(fuelModels, mortalitySpeciesTable);
+
+    behave.surface.setFuelModelNumber(1);
+    behave.surface.setMoistureOneHour(6, FractionUnits::Percent);
+    behave.surface.setMoistureTenHour(7, FractionUnits::Percent);
+    behave.surface.setMoistureHundredHour(8, FractionUnits::Percent);
+    behave.surface.setMoistureLiveHerbaceous(60, FractionUnits::Percent);
+    behave.surface.setMoistureLiveWoody(90, FractionUnits::Percent);
+    behave.surface.setWindSpeed(5, SpeedUnits::MilesPerHour, WindHeightInputMode::DirectMidflame);
+    behave.surface.doSurfaceRunInDirectionOfMaxSpread();
+    double spreadRate = behave.surface.getSpreadRate(SpeedUnits::ChainsPerHour);
+
+    VaporPressureDeficitCalculator vaporPressureDeficitCalculator;
+    vaporPressureDeficitCalculator.setTemperature(30, TemperatureUnits::Celsius);
+    vaporPressureDeficitCalculator.setRelativeHumidity(20, FractionUnits::Percent);
+    vaporPressureDeficitCalculator.runCalculation();
+    double vaporPressureDeficit = vaporPressureDeficitCalculator.getVaporPressureDeficit(PressureUnits::KiloPascal);
+
+    std::cout << "Spread rate " << spreadRate << " ch/h, vapor pressure deficit " << vaporPressureDeficit << " kPa\n";
+    return (spreadRate > 0.0 && vaporPressureDeficit > 0.0) ? 0 : 1;
+}
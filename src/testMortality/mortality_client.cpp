@@ -1,4 +1,5 @@
 #include "mortality.h"
+#include "behaveTrace.h"
 
 #include <algorithm>
 #include <cmath>
@@ -151,15 +152,22 @@ readFile::readFile(const string& fName) { // Constructor with parameters
 
 int main(int argc, char *argv[])
 {
-    if (argc < 4) {
+    if (argc != 4 && !(argc == 6 && string(argv[4]) == "--trace")) {
       std::cout
         << "Unable to start tests. Please supply .tre and .csv files like so:\n\n"
-        << "testMortality <input.tre> <output.csv> <results.csv>"
+        << "testMortality <input.tre> <output.csv> <results.csv> [--trace <trace.json>]"
         << argc
         << std::endl;
       return 1;
     }
 
+    // Optional Chrome trace event timeline of reading, calculating and writing
+    string traceFilename = (argc == 6) ? argv[5] : "";
+    if (!traceFilename.empty()) {
+        Trace::setThreadName("testMortality");
+        Trace::start();
+    }
+
     std::cout << "Starting tests with:"
               << "\nInput File:" << argv[1]
               << "\nOutput File:" << argv[2]
@@ -209,10 +217,14 @@ int main(int argc, char *argv[])
         "fire_severity"
     };
 
+    std::uint64_t readStartTime = Trace::now();
     readFile myFileInput(argv[1]);
+    Trace::addSpan("io", "read input file", readStartTime, Trace::now());
 
     string outputFilename = argv[2];
+    readStartTime = Trace::now();
     readFile myFileOutput(outputFilename);
+    Trace::addSpan("io", "read output file", readStartTime, Trace::now());
 
     auto resultsFilename = argv[3];
 
@@ -242,8 +254,21 @@ int main(int argc, char *argv[])
     for (const auto &e : myFileInput.vHeader) outFile << e << ",";
     outFile << "BehaveProbability,"  << "FOFEMProbability," << "AbsoluteDifference" << std::endl;
 
-    // Iterate through vector to calculate probabilities of mortality
+    // Iterate through vector to calculate probabilities of mortality, in
+    // batches so the trace shows the rate as the run goes on
+    constexpr int rowsPerBatch = 1000;
+    int rowsInBatch = 0;
+    std::uint64_t batchStartTime = Trace::now();
     for (auto & element : myFileInput.vData) {
+        if (rowsInBatch == rowsPerBatch) {
+            std::uint64_t batchEndTime = Trace::now();
+            Trace::addSpan("compute", "compute batch", batchStartTime, batchEndTime);
+            Trace::addCounter("rows per second", rowsInBatch / ((batchEndTime - batchStartTime + 1) * 1e-9));
+            rowsInBatch = 0;
+            batchStartTime = batchEndTime;
+        }
+        rowsInBatch++;
+
         int idx = myFileInput.getDataTypeIndex("EquationType");
         string plotID = element[myFileInput.getDataTypeIndex("PlotId")];
         
@@ -395,8 +420,20 @@ int main(int argc, char *argv[])
         }
     }
 
-    outFile.close();
+    Trace::addSpan("compute", "compute batch", batchStartTime, Trace::now());
 
+    {
+        TraceSpan span("io", "flush output");
+        outFile.close();
+    }
+
+    if (!traceFilename.empty()) {
+        Trace::stop();
+        if (!Trace::writeChromeTrace(traceFilename)) {
+            std::cout << "Unable to write trace file " << traceFilename << std::endl;
+            return 1;
+        }
+    }
 
     return 0;
 }
@@ -0,0 +1,1123 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "behaveCApi.h"
+#include "behaveRun.h"
+#include "fuelModels.h"
+#include "moistureScenarioFuelbedMatrix.h"
+#include "moistureScenarios.h"
+#include "twoFuelModelsSpreadRateCache.h"
+
+// Golden output and throughput regression harness. A deterministic corpus of
+// surface, crown and two fuel model runs is calculated by the reference path
+// and compared with golden outputs stored as float32 in a compact binary
+// file. Every alternative path over the same inputs (moisture scenario
+// matrix, batch runs with per cell wind adjustment factors, the C interface,
+// the two fuel models spread rate cache) is compared with the reference path
+// within its own declared tolerance. Throughput of each workload can be saved
+// as a baseline and later runs fail when slower than it by more than a
+// threshold.
+
+#define EQUAL(a,b) (strcmp(a,b)==0)
+
+#ifndef REGRESSION_GOLDEN_FILE
+#define REGRESSION_GOLDEN_FILE "regressionGolden.bin"
+#endif
+
+namespace
+{
+
+const char goldenMagic[8] = { 'B', 'H', 'V', 'G', 'O', 'L', 'D', '1' };
+const int goldenSectionNameLength = 32;
+
+// Differences within absolute + relative * max(|reference|, |observed|) pass
+struct Tolerance
+{
+    double relative;
+    double absolute;
+};
+
+// float32 storage rounds to about 6e-8 relative
+const Tolerance goldenTolerance = { 1e-6, 1e-9 };
+// Paths that only rearrange the same arithmetic
+const Tolerance samePathTolerance = { 1e-12, 1e-12 };
+// Quantized two fuel models keys move relative spread rates and coverages by
+// up to half a step of 0.01 and the length-to-breadth ratio by half of 0.1
+const Tolerance quantizedTwoFuelModelsTolerance = { 0.05, 1e-6 };
+
+// Outputs of one corpus, row major
+struct Section
+{
+    std::string name;
+    std::size_t numberOfColumns;
+    std::vector<double> values;
+
+    std::size_t getNumberOfRows() const
+    {
+        return (numberOfColumns > 0) ? values.size() / numberOfColumns : 0;
+    }
+};
+
+struct SurfaceCase
+{
+    int fuelModelNumber;
+    int moistureScenarioIndex;
+    double moistures[5];            // percent, one, ten and hundred hour, live herbaceous and woody
+    double windSpeed;               // mph at twenty feet
+    double windDirection;
+    double slope;                   // percent
+    double aspect;
+    double canopyCover;             // percent
+    double canopyHeight;            // feet
+    double crownRatio;
+};
+
+struct CrownCase
+{
+    SurfaceCase surface;
+    int crownMethod;                // BEHAVE_CROWN_
+    double canopyBaseHeight;        // feet
+    double canopyBulkDensity;       // lb/ft^3
+    double moistureFoliar;          // percent
+};
+
+struct TwoFuelModelsCase
+{
+    SurfaceCase surface;
+    int secondFuelModelNumber;
+    double firstFuelModelCoverage;  // percent
+    TwoFuelModelsMethod::TwoFuelModelsMethodEnum method;
+};
+
+struct CheckResults
+{
+    int numberOfChecks = 0;
+    int numberOfFailures = 0;
+};
+
+void setScenarioMoistures(BehaveRun& behaveRun, int scenarioIndex, double* moistures)
+{
+    moistures[0] = behaveRun.surface.getMoistureScenarioOneHourByIndex(scenarioIndex, FractionUnits::Percent);
+    moistures[1] = behaveRun.surface.getMoistureScenarioTenHourByIndex(scenarioIndex, FractionUnits::Percent);
+    moistures[2] = behaveRun.surface.getMoistureScenarioHundredHourByIndex(scenarioIndex, FractionUnits::Percent);
+    moistures[3] = behaveRun.surface.getMoistureScenarioLiveHerbaceousByIndex(scenarioIndex, FractionUnits::Percent);
+    moistures[4] = behaveRun.surface.getMoistureScenarioLiveWoodyByIndex(scenarioIndex, FractionUnits::Percent);
+}
+
+// Every defined fuel model x every moisture scenario x slope x wind speed x
+// wind direction, fuel model and wind innermost
+std::vector<SurfaceCase> buildSurfaceCorpus(BehaveRun& behaveRun)
+{
+    const double slopes[] = { 0, 60 };
+    const double windSpeeds[] = { 0, 5, 15, 30 };
+    const double windDirections[] = { 0, 135 };
+
+    std::vector<SurfaceCase> corpus;
+    for (int scenarioIndex = 0; scenarioIndex < behaveRun.surface.getNumberOfMoistureScenarios(); scenarioIndex++)
+    {
+        for (double slope : slopes)
+        {
+            for (int fuelModelNumber = 1; fuelModelNumber <= FuelConstants::MaxFuelModels; fuelModelNumber++)
+            {
+                if (!behaveRun.surface.isFuelModelDefined(fuelModelNumber))
+                {
+                    continue;
+                }
+                for (double windSpeed : windSpeeds)
+                {
+                    for (double windDirection : windDirections)
+                    {
+                        SurfaceCase surfaceCase;
+                        surfaceCase.fuelModelNumber = fuelModelNumber;
+                        surfaceCase.moistureScenarioIndex = scenarioIndex;
+                        setScenarioMoistures(behaveRun, scenarioIndex, surfaceCase.moistures);
+                        surfaceCase.windSpeed = windSpeed;
+                        surfaceCase.windDirection = windDirection;
+                        surfaceCase.slope = slope;
+                        surfaceCase.aspect = 200;
+                        surfaceCase.canopyCover = (slope > 0) ? 60 : 10;
+                        surfaceCase.canopyHeight = 40;
+                        surfaceCase.crownRatio = 0.4;
+                        corpus.push_back(surfaceCase);
+                    }
+                }
+            }
+        }
+    }
+    return corpus;
+}
+
+// Both crown methods over timber and shrub fuel models, every moisture
+// scenario and a canopy grid, method outermost
+std::vector<CrownCase> buildCrownCorpus(BehaveRun& behaveRun)
+{
+    const int crownMethods[] = { BEHAVE_CROWN_ROTHERMEL, BEHAVE_CROWN_SCOTT_AND_REINHARDT };
+    const int fuelModelNumbers[] = { 1, 2, 4, 8, 10, 101, 122, 145, 165, 183, 189 };
+    const double windSpeeds[] = { 5, 15, 30 };
+    const double canopyBaseHeights[] = { 2, 8 };
+    const double canopyBulkDensities[] = { 0.006, 0.012 };
+
+    std::vector<CrownCase> corpus;
+    for (int crownMethod : crownMethods)
+    {
+        for (int scenarioIndex = 0; scenarioIndex < behaveRun.surface.getNumberOfMoistureScenarios(); scenarioIndex++)
+        {
+            for (int fuelModelNumber : fuelModelNumbers)
+            {
+                for (double windSpeed : windSpeeds)
+                {
+                    for (double canopyBaseHeight : canopyBaseHeights)
+                    {
+                        for (double canopyBulkDensity : canopyBulkDensities)
+                        {
+                            CrownCase crownCase;
+                            SurfaceCase& surfaceCase = crownCase.surface;
+                            surfaceCase.fuelModelNumber = fuelModelNumber;
+                            surfaceCase.moistureScenarioIndex = scenarioIndex;
+                            setScenarioMoistures(behaveRun, scenarioIndex, surfaceCase.moistures);
+                            surfaceCase.windSpeed = windSpeed;
+                            surfaceCase.windDirection = 0;
+                            surfaceCase.slope = 30;
+                            surfaceCase.aspect = 0;
+                            surfaceCase.canopyCover = 50;
+                            surfaceCase.canopyHeight = 60;
+                            surfaceCase.crownRatio = 0.5;
+                            crownCase.crownMethod = crownMethod;
+                            crownCase.canopyBaseHeight = canopyBaseHeight;
+                            crownCase.canopyBulkDensity = canopyBulkDensity;
+                            crownCase.moistureFoliar = 100;
+                            corpus.push_back(crownCase);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return corpus;
+}
+
+// Fuel model pairs x coverage x wind speed x two fuel models method
+std::vector<TwoFuelModelsCase> buildTwoFuelModelsCorpus(BehaveRun& behaveRun)
+{
+    const int fuelModelPairs[][2] = { { 1, 124 }, { 2, 101 }, { 4, 165 }, { 8, 102 }, { 10, 121 } };
+    const double coverages[] = { 25, 50, 75 };
+    const double windSpeeds[] = { 2, 10 };
+    const TwoFuelModelsMethod::TwoFuelModelsMethodEnum methods[] =
+    {
+        TwoFuelModelsMethod::Arithmetic,
+        TwoFuelModelsMethod::Harmonic,
+        TwoFuelModelsMethod::TwoDimensional
+    };
+    const int scenarioIndex = 0;
+
+    std::vector<TwoFuelModelsCase> corpus;
+    for (TwoFuelModelsMethod::TwoFuelModelsMethodEnum method : methods)
+    {
+        for (const int* fuelModelPair : fuelModelPairs)
+        {
+            for (double coverage : coverages)
+            {
+                for (double windSpeed : windSpeeds)
+                {
+                    TwoFuelModelsCase twoFuelModelsCase;
+                    SurfaceCase& surfaceCase = twoFuelModelsCase.surface;
+                    surfaceCase.fuelModelNumber = fuelModelPair[0];
+                    surfaceCase.moistureScenarioIndex = scenarioIndex;
+                    setScenarioMoistures(behaveRun, scenarioIndex, surfaceCase.moistures);
+                    surfaceCase.windSpeed = windSpeed;
+                    surfaceCase.windDirection = 0;
+                    surfaceCase.slope = 20;
+                    surfaceCase.aspect = 0;
+                    surfaceCase.canopyCover = 0;
+                    surfaceCase.canopyHeight = 0;
+                    surfaceCase.crownRatio = 0;
+                    twoFuelModelsCase.secondFuelModelNumber = fuelModelPair[1];
+                    twoFuelModelsCase.firstFuelModelCoverage = coverage;
+                    twoFuelModelsCase.method = method;
+                    corpus.push_back(twoFuelModelsCase);
+                }
+            }
+        }
+    }
+    return corpus;
+}
+
+void updateSurfaceInputs(Surface& surface, const SurfaceCase& surfaceCase)
+{
+    surface.updateSurfaceInputs(surfaceCase.fuelModelNumber, surfaceCase.moistures[0], surfaceCase.moistures[1],
+        surfaceCase.moistures[2], surfaceCase.moistures[3], surfaceCase.moistures[4], FractionUnits::Percent,
+        surfaceCase.windSpeed, SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot, surfaceCase.windDirection,
+        WindAndSpreadOrientationMode::RelativeToNorth, surfaceCase.slope, SlopeUnits::Percent, surfaceCase.aspect,
+        surfaceCase.canopyCover, FractionUnits::Percent, surfaceCase.canopyHeight, LengthUnits::Feet, surfaceCase.crownRatio);
+}
+
+// Spread rate, flame length, fireline intensity, direction of max spread and
+// heat per unit area
+const std::size_t surfaceColumns = 5;
+
+void appendSurfaceOutputs(const Surface& surface, std::vector<double>& values)
+{
+    values.push_back(surface.getSpreadRate(SpeedUnits::FeetPerMinute));
+    values.push_back(surface.getFlameLength(LengthUnits::Feet));
+    values.push_back(surface.getFirelineIntensity(FirelineIntensityUnits::BtusPerFootPerSecond));
+    values.push_back(surface.getDirectionOfMaxSpread());
+    values.push_back(surface.getHeatPerUnitArea(HeatPerUnitAreaUnits::BtusPerSquareFoot));
+}
+
+Section runSurfaceReference(BehaveRun& behaveRun, const std::vector<SurfaceCase>& corpus)
+{
+    Section section = { "surface", surfaceColumns, std::vector<double>() };
+    section.values.reserve(corpus.size() * surfaceColumns);
+    for (const SurfaceCase& surfaceCase : corpus)
+    {
+        updateSurfaceInputs(behaveRun.surface, surfaceCase);
+        behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+        appendSurfaceOutputs(behaveRun.surface, section.values);
+    }
+    return section;
+}
+
+// The moistures come from the scenario, and standard fuel models take their
+// fuelbed intermediates from the precomputed matrix. Counts the cases that
+// were loaded from the matrix in numberOfCasesLoaded if it is given
+Section runSurfaceMoistureScenarioMatrix(BehaveRun& behaveRun, const std::vector<SurfaceCase>& corpus,
+    std::size_t* numberOfCasesLoaded = nullptr)
+{
+    const MoistureScenarioFuelbedMatrix& matrix = MoistureScenarioFuelbedMatrix::getSharedMatrix();
+    Section section = { "surface", surfaceColumns, std::vector<double>() };
+    section.values.reserve(corpus.size() * surfaceColumns);
+    std::size_t numberLoaded = 0;
+    for (const SurfaceCase& surfaceCase : corpus)
+    {
+        updateSurfaceInputs(behaveRun.surface, surfaceCase);
+        behaveRun.surface.setMoistureInputMode(MoistureInputMode::MoistureScenario);
+        behaveRun.surface.setCurrentMoistureScenarioByIndex(surfaceCase.moistureScenarioIndex);
+        behaveRun.surface.setIsUsingMoistureScenarioMatrix(true);
+        unsigned long long loadsBefore = matrix.getNumberOfLoads();
+        behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+        numberLoaded += (matrix.getNumberOfLoads() != loadsBefore) ? 1 : 0;
+        appendSurfaceOutputs(behaveRun.surface, section.values);
+    }
+    if (numberOfCasesLoaded)
+    {
+        *numberOfCasesLoaded = numberLoaded;
+    }
+    behaveRun.surface.setIsUsingMoistureScenarioMatrix(false);
+    behaveRun.surface.setMoistureInputMode(MoistureInputMode::BySizeClass);
+    return section;
+}
+
+// Spread rate and flame length by batches of one fuelbed environment and
+// canopy, with wind adjustment factors calculated once per batch
+Section runSurfaceBatch(BehaveRun& behaveRun, const std::vector<SurfaceCase>& corpus)
+{
+    const std::size_t batchColumns = 2;
+    Section section = { "surface batch", batchColumns, std::vector<double>(corpus.size() * batchColumns) };
+    std::vector<int> fuelModelNumber;
+    std::vector<double> windSpeed;
+    std::vector<double> windDirection;
+    std::vector<double> windAdjustmentFactor;
+    std::vector<double> spreadRate;
+    std::vector<double> flameLength;
+
+    std::size_t first = 0;
+    while (first < corpus.size())
+    {
+        const SurfaceCase& firstCase = corpus[first];
+        std::size_t last = first;
+        while (last < corpus.size() && corpus[last].moistureScenarioIndex == firstCase.moistureScenarioIndex
+            && corpus[last].slope == firstCase.slope && corpus[last].canopyCover == firstCase.canopyCover)
+        {
+            last++;
+        }
+        std::size_t numberOfRuns = last - first;
+
+        fuelModelNumber.resize(numberOfRuns);
+        windSpeed.resize(numberOfRuns);
+        windDirection.resize(numberOfRuns);
+        windAdjustmentFactor.resize(numberOfRuns);
+        spreadRate.resize(numberOfRuns);
+        flameLength.resize(numberOfRuns);
+        for (std::size_t i = 0; i < numberOfRuns; i++)
+        {
+            fuelModelNumber[i] = corpus[first + i].fuelModelNumber;
+            windSpeed[i] = corpus[first + i].windSpeed;
+            windDirection[i] = corpus[first + i].windDirection;
+        }
+
+        updateSurfaceInputs(behaveRun.surface, firstCase);
+        behaveRun.surface.calculateWindAdjustmentFactorsForCells(numberOfRuns, nullptr, FractionUnits::Percent, nullptr,
+            LengthUnits::Feet, nullptr, &fuelModelNumber[0], &windAdjustmentFactor[0]);
+        SurfaceBatchInputs inputs;
+        inputs.numberOfRuns = numberOfRuns;
+        inputs.fuelModelNumber = &fuelModelNumber[0];
+        inputs.windSpeed = &windSpeed[0];
+        inputs.windDirection = &windDirection[0];
+        inputs.windAdjustmentFactor = &windAdjustmentFactor[0];
+        behaveRun.surface.doSurfaceRunInDirectionOfMaxSpreadForBatch(inputs, &spreadRate[0], SpeedUnits::FeetPerMinute,
+            &flameLength[0], LengthUnits::Feet);
+
+        for (std::size_t i = 0; i < numberOfRuns; i++)
+        {
+            section.values[(first + i) * batchColumns] = spreadRate[i];
+            section.values[(first + i) * batchColumns + 1] = flameLength[i];
+        }
+        first = last;
+    }
+    return section;
+}
+
+// Spread rate, flame length, fireline intensity and direction of max spread
+Section runSurfaceCApi(BehaveFuelModels* fuelModels, const std::vector<SurfaceCase>& corpus)
+{
+    const std::size_t numberOfRows = corpus.size();
+    const std::size_t cApiColumns = 4;
+    std::vector<int> fuelModelNumber(numberOfRows);
+    std::vector<double> inputs[12];
+    for (std::vector<double>& input : inputs)
+    {
+        input.resize(numberOfRows);
+    }
+    for (std::size_t row = 0; row < numberOfRows; row++)
+    {
+        const SurfaceCase& surfaceCase = corpus[row];
+        fuelModelNumber[row] = surfaceCase.fuelModelNumber;
+        for (int i = 0; i < 5; i++)
+        {
+            inputs[i][row] = surfaceCase.moistures[i];
+        }
+        inputs[5][row] = surfaceCase.windSpeed;
+        inputs[6][row] = surfaceCase.windDirection;
+        inputs[7][row] = surfaceCase.slope;
+        inputs[8][row] = surfaceCase.aspect;
+        inputs[9][row] = surfaceCase.canopyCover;
+        inputs[10][row] = surfaceCase.canopyHeight;
+        inputs[11][row] = surfaceCase.crownRatio;
+    }
+
+    BehaveSurfaceColumns columns;
+    std::memset(&columns, 0, sizeof(columns));
+    columns.structSize = sizeof(columns);
+    columns.numberOfRows = numberOfRows;
+    columns.fuelModelNumber = &fuelModelNumber[0];
+    columns.moistureOneHour = &inputs[0][0];
+    columns.moistureTenHour = &inputs[1][0];
+    columns.moistureHundredHour = &inputs[2][0];
+    columns.moistureLiveHerbaceous = &inputs[3][0];
+    columns.moistureLiveWoody = &inputs[4][0];
+    columns.windSpeed = &inputs[5][0];
+    columns.windDirection = &inputs[6][0];
+    columns.slope = &inputs[7][0];
+    columns.aspect = &inputs[8][0];
+    columns.canopyCover = &inputs[9][0];
+    columns.canopyHeight = &inputs[10][0];
+    columns.crownRatio = &inputs[11][0];
+
+    std::vector<double> outputColumns[cApiColumns];
+    for (std::vector<double>& outputColumn : outputColumns)
+    {
+        outputColumn.resize(numberOfRows);
+    }
+    BehaveSurfaceOutputs outputs;
+    outputs.structSize = sizeof(outputs);
+    outputs.spreadRate = &outputColumns[0][0];
+    outputs.flameLength = &outputColumns[1][0];
+    outputs.firelineIntensity = &outputColumns[2][0];
+    outputs.directionOfMaxSpread = &outputColumns[3][0];
+
+    Section section = { "surface C interface", cApiColumns, std::vector<double>() };
+    if (behave_surface_run_batch(fuelModels, &columns, &outputs) != BEHAVE_OK)
+    {
+        return section;
+    }
+    section.values.resize(numberOfRows * cApiColumns);
+    for (std::size_t row = 0; row < numberOfRows; row++)
+    {
+        for (std::size_t column = 0; column < cApiColumns; column++)
+        {
+            section.values[row * cApiColumns + column] = outputColumns[column][row];
+        }
+    }
+    return section;
+}
+
+// Final spread rate, flame length and fireline intensity, fire type and
+// crown fraction burned
+const std::size_t crownColumns = 5;
+
+Section runCrownReference(BehaveRun& behaveRun, const std::vector<CrownCase>& corpus)
+{
+    Section section = { "crown", crownColumns, std::vector<double>() };
+    section.values.reserve(corpus.size() * crownColumns);
+    for (const CrownCase& crownCase : corpus)
+    {
+        const SurfaceCase& surfaceCase = crownCase.surface;
+        behaveRun.crown.updateCrownInputs(surfaceCase.fuelModelNumber, surfaceCase.moistures[0], surfaceCase.moistures[1],
+            surfaceCase.moistures[2], surfaceCase.moistures[3], surfaceCase.moistures[4], crownCase.moistureFoliar,
+            FractionUnits::Percent, surfaceCase.windSpeed, SpeedUnits::MilesPerHour, WindHeightInputMode::TwentyFoot,
+            surfaceCase.windDirection, WindAndSpreadOrientationMode::RelativeToNorth, surfaceCase.slope, SlopeUnits::Percent,
+            surfaceCase.aspect, surfaceCase.canopyCover, FractionUnits::Percent, surfaceCase.canopyHeight,
+            crownCase.canopyBaseHeight, LengthUnits::Feet, surfaceCase.crownRatio, crownCase.canopyBulkDensity,
+            DensityUnits::PoundsPerCubicFoot);
+        if (crownCase.crownMethod == BEHAVE_CROWN_ROTHERMEL)
+        {
+            behaveRun.crown.doCrownRunRothermel();
+        }
+        else
+        {
+            behaveRun.crown.doCrownRunScottAndReinhardt();
+        }
+        section.values.push_back(behaveRun.crown.getFinalSpreadRate(SpeedUnits::FeetPerMinute));
+        section.values.push_back(behaveRun.crown.getFinalFlameLength(LengthUnits::Feet));
+        section.values.push_back(behaveRun.crown.getFinalFirelineIntesity(FirelineIntensityUnits::BtusPerFootPerSecond));
+        section.values.push_back((double)behaveRun.crown.getFireType());
+        section.values.push_back(behaveRun.crown.getCrownFractionBurned());
+    }
+    return section;
+}
+
+// Final spread rate, flame length and fireline intensity and fire type, one
+// batch call per crown method
+Section runCrownCApi(BehaveFuelModels* fuelModels, const std::vector<CrownCase>& corpus)
+{
+    const std::size_t cApiColumns = 4;
+    Section section = { "crown C interface", cApiColumns, std::vector<double>(corpus.size() * cApiColumns) };
+    std::size_t first = 0;
+    while (first < corpus.size())
+    {
+        std::size_t last = first;
+        while (last < corpus.size() && corpus[last].crownMethod == corpus[first].crownMethod)
+        {
+            last++;
+        }
+        std::size_t numberOfRows = last - first;
+
+        std::vector<int> fuelModelNumber(numberOfRows);
+        std::vector<double> inputs[15];
+        for (std::vector<double>& input : inputs)
+        {
+            input.resize(numberOfRows);
+        }
+        for (std::size_t row = 0; row < numberOfRows; row++)
+        {
+            const CrownCase& crownCase = corpus[first + row];
+            const SurfaceCase& surfaceCase = crownCase.surface;
+            fuelModelNumber[row] = surfaceCase.fuelModelNumber;
+            for (int i = 0; i < 5; i++)
+            {
+                inputs[i][row] = surfaceCase.moistures[i];
+            }
+            inputs[5][row] = surfaceCase.windSpeed;
+            inputs[6][row] = surfaceCase.windDirection;
+            inputs[7][row] = surfaceCase.slope;
+            inputs[8][row] = surfaceCase.aspect;
+            inputs[9][row] = surfaceCase.canopyCover;
+            inputs[10][row] = surfaceCase.canopyHeight;
+            inputs[11][row] = surfaceCase.crownRatio;
+            inputs[12][row] = crownCase.canopyBaseHeight;
+            inputs[13][row] = crownCase.canopyBulkDensity;
+            inputs[14][row] = crownCase.moistureFoliar;
+        }
+
+        BehaveSurfaceColumns surfaceColumns;
+        std::memset(&surfaceColumns, 0, sizeof(surfaceColumns));
+        surfaceColumns.structSize = sizeof(surfaceColumns);
+        surfaceColumns.numberOfRows = numberOfRows;
+        surfaceColumns.fuelModelNumber = &fuelModelNumber[0];
+        surfaceColumns.moistureOneHour = &inputs[0][0];
+        surfaceColumns.moistureTenHour = &inputs[1][0];
+        surfaceColumns.moistureHundredHour = &inputs[2][0];
+        surfaceColumns.moistureLiveHerbaceous = &inputs[3][0];
+        surfaceColumns.moistureLiveWoody = &inputs[4][0];
+        surfaceColumns.windSpeed = &inputs[5][0];
+        surfaceColumns.windDirection = &inputs[6][0];
+        surfaceColumns.slope = &inputs[7][0];
+        surfaceColumns.aspect = &inputs[8][0];
+        surfaceColumns.canopyCover = &inputs[9][0];
+        surfaceColumns.canopyHeight = &inputs[10][0];
+        surfaceColumns.crownRatio = &inputs[11][0];
+
+        BehaveCrownColumns columns;
+        std::memset(&columns, 0, sizeof(columns));
+        columns.structSize = sizeof(columns);
+        columns.surface = &surfaceColumns;
+        columns.canopyBaseHeight = &inputs[12][0];
+        columns.canopyBulkDensity = &inputs[13][0];
+        columns.moistureFoliar = &inputs[14][0];
+
+        std::vector<double> spreadRate(numberOfRows);
+        std::vector<double> flameLength(numberOfRows);
+        std::vector<double> firelineIntensity(numberOfRows);
+        std::vector<int> fireType(numberOfRows);
+        BehaveCrownOutputs outputs;
+        outputs.structSize = sizeof(outputs);
+        outputs.spreadRate = &spreadRate[0];
+        outputs.flameLength = &flameLength[0];
+        outputs.firelineIntensity = &firelineIntensity[0];
+        outputs.fireType = &fireType[0];
+        if (behave_crown_run_batch(fuelModels, corpus[first].crownMethod, &columns, &outputs) != BEHAVE_OK)
+        {
+            section.values.clear();
+            return section;
+        }
+        for (std::size_t row = 0; row < numberOfRows; row++)
+        {
+            double* values = &section.values[(first + row) * cApiColumns];
+            values[0] = spreadRate[row];
+            values[1] = flameLength[row];
+            values[2] = firelineIntensity[row];
+            values[3] = (double)fireType[row];
+        }
+        first = last;
+    }
+    return section;
+}
+
+// Spread rate, flame length and fireline intensity
+const std::size_t twoFuelModelsColumns = 3;
+
+Section runTwoFuelModels(BehaveRun& behaveRun, const std::vector<TwoFuelModelsCase>& corpus, bool isOnlyTwoDimensional)
+{
+    Section section = { "two fuel models", twoFuelModelsColumns, std::vector<double>() };
+    for (const TwoFuelModelsCase& twoFuelModelsCase : corpus)
+    {
+        if (isOnlyTwoDimensional && twoFuelModelsCase.method != TwoFuelModelsMethod::TwoDimensional)
+        {
+            continue;
+        }
+        const SurfaceCase& surfaceCase = twoFuelModelsCase.surface;
+        behaveRun.surface.updateSurfaceInputsForTwoFuelModels(surfaceCase.fuelModelNumber, twoFuelModelsCase.secondFuelModelNumber,
+            surfaceCase.moistures[0], surfaceCase.moistures[1], surfaceCase.moistures[2], surfaceCase.moistures[3],
+            surfaceCase.moistures[4], FractionUnits::Percent, surfaceCase.windSpeed, SpeedUnits::MilesPerHour,
+            WindHeightInputMode::TwentyFoot, surfaceCase.windDirection, WindAndSpreadOrientationMode::RelativeToNorth,
+            twoFuelModelsCase.firstFuelModelCoverage, FractionUnits::Percent, twoFuelModelsCase.method, surfaceCase.slope,
+            SlopeUnits::Percent, surfaceCase.aspect, surfaceCase.canopyCover, FractionUnits::Percent, surfaceCase.canopyHeight,
+            LengthUnits::Feet, surfaceCase.crownRatio);
+        behaveRun.surface.doSurfaceRunInDirectionOfMaxSpread();
+        section.values.push_back(behaveRun.surface.getSpreadRate(SpeedUnits::FeetPerMinute));
+        section.values.push_back(behaveRun.surface.getFlameLength(LengthUnits::Feet));
+        section.values.push_back(behaveRun.surface.getFirelineIntensity(FirelineIntensityUnits::BtusPerFootPerSecond));
+    }
+    return section;
+}
+
+// The two dimensional rows only, under one configuration of the shared cache.
+// The cache is left enabled with exact keys and emptied afterwards
+Section runTwoDimensional(BehaveRun& behaveRun, const std::vector<TwoFuelModelsCase>& corpus, bool isCacheEnabled,
+    double quantizationStep, bool isRepeated)
+{
+    TwoFuelModelsSpreadRateCache& spreadRateCache = TwoFuelModelsSpreadRateCache::getSharedCache();
+    spreadRateCache.setQuantization(quantizationStep, quantizationStep, 10 * quantizationStep);
+    spreadRateCache.clear();
+    spreadRateCache.setEnabled(isCacheEnabled);
+    Section section = runTwoFuelModels(behaveRun, corpus, true);
+    if (isRepeated)
+    {
+        // Every row is now a hit
+        section = runTwoFuelModels(behaveRun, corpus, true);
+    }
+    spreadRateCache.setQuantization(0, 0, 0);
+    spreadRateCache.clear();
+    spreadRateCache.setEnabled(true);
+    return section;
+}
+
+bool isWithinTolerance(double reference, double observed, const Tolerance& tolerance)
+{
+    if (std::isnan(reference) || std::isnan(observed))
+    {
+        return std::isnan(reference) && std::isnan(observed);
+    }
+    double scale = std::max(std::fabs(reference), std::fabs(observed));
+    return std::fabs(reference - observed) <= tolerance.absolute + tolerance.relative * scale;
+}
+
+// Compares the first observed.numberOfColumns columns of each reference row
+void compareSections(const std::string& checkName, const Section& reference, const Section& observed,
+    const Tolerance& tolerance, CheckResults& results)
+{
+    results.numberOfChecks++;
+    std::size_t numberOfRows = reference.getNumberOfRows();
+    if (observed.getNumberOfRows() != numberOfRows || observed.numberOfColumns > reference.numberOfColumns)
+    {
+        results.numberOfFailures++;
+        printf("FAILED  %-48s %zu rows expected, %zu observed\n", checkName.c_str(), numberOfRows, observed.getNumberOfRows());
+        return;
+    }
+
+    std::size_t numberOfMismatches = 0;
+    std::size_t firstMismatch = 0;
+    double maxRelativeDifference = 0.0;
+    for (std::size_t row = 0; row < numberOfRows; row++)
+    {
+        for (std::size_t column = 0; column < observed.numberOfColumns; column++)
+        {
+            double referenceValue = reference.values[row * reference.numberOfColumns + column];
+            double observedValue = observed.values[row * observed.numberOfColumns + column];
+            if (!isWithinTolerance(referenceValue, observedValue, tolerance))
+            {
+                if (numberOfMismatches == 0)
+                {
+                    firstMismatch = row * reference.numberOfColumns + column;
+                }
+                numberOfMismatches++;
+            }
+            double scale = std::max(std::fabs(referenceValue), std::fabs(observedValue));
+            if (scale > 0.0)
+            {
+                maxRelativeDifference = std::max(maxRelativeDifference, std::fabs(referenceValue - observedValue) / scale);
+            }
+        }
+    }
+
+    if (numberOfMismatches > 0)
+    {
+        results.numberOfFailures++;
+        std::size_t row = firstMismatch / reference.numberOfColumns;
+        std::size_t column = firstMismatch % reference.numberOfColumns;
+        printf("FAILED  %-48s %zu of %zu values outside tolerance, first at row %zu column %zu: %.9g expected, %.9g observed\n",
+            checkName.c_str(), numberOfMismatches, numberOfRows * observed.numberOfColumns, row, column,
+            reference.values[firstMismatch], observed.values[row * observed.numberOfColumns + column]);
+    }
+    else
+    {
+        printf("passed  %-48s %zu rows, max relative difference %.3g\n", checkName.c_str(), numberOfRows, maxRelativeDifference);
+    }
+}
+
+// Golden file layout, native little endian:
+//     char magic[8], uint32 numberOfSections, then per section
+//     char name[32], uint32 numberOfRows, uint32 numberOfColumns, float values[rows * columns]
+bool writeGoldenFile(const std::string& fileName, const std::vector<Section>& sections)
+{
+    std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    file.write(goldenMagic, sizeof(goldenMagic));
+    std::uint32_t numberOfSections = (std::uint32_t)sections.size();
+    file.write((const char*)&numberOfSections, sizeof(numberOfSections));
+    for (const Section& section : sections)
+    {
+        char name[goldenSectionNameLength] = {};
+        std::strncpy(name, section.name.c_str(), goldenSectionNameLength - 1);
+        std::uint32_t numberOfRows = (std::uint32_t)section.getNumberOfRows();
+        std::uint32_t numberOfColumns = (std::uint32_t)section.numberOfColumns;
+        file.write(name, sizeof(name));
+        file.write((const char*)&numberOfRows, sizeof(numberOfRows));
+        file.write((const char*)&numberOfColumns, sizeof(numberOfColumns));
+        std::vector<float> values(section.values.begin(), section.values.end());
+        if (!values.empty())
+        {
+            file.write((const char*)&values[0], values.size() * sizeof(float));
+        }
+    }
+    file.close();
+    return !file.fail();
+}
+
+bool readGoldenFile(const std::string& fileName, std::map<std::string, Section>& sections)
+{
+    std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+    char magic[sizeof(goldenMagic)];
+    std::uint32_t numberOfSections = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, goldenMagic, sizeof(magic)) != 0
+        || !file.read((char*)&numberOfSections, sizeof(numberOfSections)))
+    {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < numberOfSections; i++)
+    {
+        char name[goldenSectionNameLength];
+        std::uint32_t numberOfRows = 0;
+        std::uint32_t numberOfColumns = 0;
+        if (!file.read(name, sizeof(name)) || !file.read((char*)&numberOfRows, sizeof(numberOfRows))
+            || !file.read((char*)&numberOfColumns, sizeof(numberOfColumns)))
+        {
+            return false;
+        }
+        name[goldenSectionNameLength - 1] = '\0';
+        std::vector<float> values((std::size_t)numberOfRows * numberOfColumns);
+        if (!values.empty() && !file.read((char*)&values[0], values.size() * sizeof(float)))
+        {
+            return false;
+        }
+        Section section = { name, numberOfColumns, std::vector<double>(values.begin(), values.end()) };
+        sections[section.name] = section;
+    }
+    return true;
+}
+
+struct Throughput
+{
+    std::string name;
+    double rowsPerSecond;
+};
+
+struct Workload
+{
+    std::string name;
+    std::size_t numberOfRows;
+    std::function<void()> run;
+};
+
+// Fastest of repeat samples of each workload after one untimed run, the least
+// disturbed by the rest of the machine. Each sample runs its workload until
+// it has used at least minimumSeconds of processor time, which unlike wall
+// time does not count the time other processes hold the processor; all
+// workloads run on one thread. The workloads take turns, so a disturbance
+// lasting several samples slows one sample of each instead of all of one.
+std::vector<Throughput> measureThroughputs(const std::vector<Workload>& workloads, int repeat, double minimumSeconds)
+{
+    std::vector<Throughput> throughputs;
+    for (const Workload& workload : workloads)
+    {
+        workload.run();
+        Throughput throughput = { workload.name, 0.0 };
+        throughputs.push_back(throughput);
+    }
+    for (int i = 0; i < repeat; i++)
+    {
+        for (std::size_t j = 0; j < workloads.size(); j++)
+        {
+            std::clock_t start = std::clock();
+            std::size_t numberOfRuns = 0;
+            double seconds = 0.0;
+            do
+            {
+                workloads[j].run();
+                numberOfRuns++;
+                seconds = (double)(std::clock() - start) / CLOCKS_PER_SEC;
+            } while (seconds < minimumSeconds);
+            double rowsPerSecond = (seconds > 0.0) ? numberOfRuns * workloads[j].numberOfRows / seconds : 0.0;
+            throughputs[j].rowsPerSecond = std::max(throughputs[j].rowsPerSecond, rowsPerSecond);
+        }
+    }
+    return throughputs;
+}
+
+// One "name rowsPerSecond" line per workload, names may contain spaces
+bool writeBaselineFile(const std::string& fileName, const std::vector<Throughput>& throughputs)
+{
+    std::ofstream file(fileName.c_str(), std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    for (const Throughput& throughput : throughputs)
+    {
+        file << throughput.name << " " << throughput.rowsPerSecond << "\n";
+    }
+    file.close();
+    return !file.fail();
+}
+
+bool readBaselineFile(const std::string& fileName, std::map<std::string, double>& rowsPerSecond)
+{
+    std::ifstream file(fileName.c_str(), std::ios::in);
+    if (!file)
+    {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::size_t separator = line.find_last_of(' ');
+        if (separator == std::string::npos)
+        {
+            continue;
+        }
+        rowsPerSecond[line.substr(0, separator)] = std::atof(line.c_str() + separator + 1);
+    }
+    return true;
+}
+
+}
+
+void Usage()
+{
+    printf("Usage:\n");
+    printf("testRegression [--golden file] [--generate-golden] [--baseline file] [--save-baseline]\n");
+    printf("               [--threshold fraction] [--repeat n] [--min-time seconds]\n");
+    printf("\n");
+    printf("Calculates the regression corpus, compares it with the golden outputs and\n");
+    printf("every alternative path with the reference path, and measures throughput.\n");
+    printf("\n");
+    printf("    --golden            golden output file, %s by default\n", REGRESSION_GOLDEN_FILE);
+    printf("    --generate-golden   write the reference outputs to the golden file instead\n");
+    printf("                        of comparing with it\n");
+    printf("    --baseline          throughput baseline file, throughput is only reported\n");
+    printf("                        without one\n");
+    printf("    --save-baseline     write this run's throughput to the baseline file instead\n");
+    printf("                        of comparing with it\n");
+    printf("    --threshold         slowdown below the baseline that fails, 0.25 by default\n");
+    printf("    --repeat            timed samples of each workload, the fastest is kept,\n");
+    printf("                        5 by default\n");
+    printf("    --min-time          processor seconds each sample repeats its workload for,\n");
+    printf("                        0.5 by default\n");
+    printf("\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    std::string goldenFileName = REGRESSION_GOLDEN_FILE;
+    std::string baselineFileName = "";
+    bool isGeneratingGolden = false;
+    bool isSavingBaseline = false;
+    double threshold = 0.25;
+    int repeat = 5;
+    double minimumSeconds = 0.5;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "--generate-golden"))
+        {
+            isGeneratingGolden = true;
+        }
+        else if (EQUAL(argv[i], "--save-baseline"))
+        {
+            isSavingBaseline = true;
+        }
+        else if (i + 1 >= argc)
+        {
+            Usage();
+        }
+        else if (EQUAL(argv[i], "--golden"))
+        {
+            goldenFileName = argv[++i];
+        }
+        else if (EQUAL(argv[i], "--baseline"))
+        {
+            baselineFileName = argv[++i];
+        }
+        else if (EQUAL(argv[i], "--threshold"))
+        {
+            threshold = atof(argv[++i]);
+            if (threshold <= 0.0 || threshold >= 1.0)
+            {
+                Usage();
+            }
+        }
+        else if (EQUAL(argv[i], "--repeat"))
+        {
+            repeat = atoi(argv[++i]);
+            if (repeat < 1)
+            {
+                Usage();
+            }
+        }
+        else if (EQUAL(argv[i], "--min-time"))
+        {
+            minimumSeconds = atof(argv[++i]);
+            if (minimumSeconds < 0.0)
+            {
+                Usage();
+            }
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    if (isSavingBaseline && baselineFileName.empty())
+    {
+        printf("ERROR: --save-baseline needs --baseline\n");
+        Usage();
+    }
+
+    FuelModels fuelModels;
+    SpeciesMasterTable speciesMasterTable;
+    MoistureScenarios moistureScenarios;
+    BehaveRun behaveRun(fuelModels, speciesMasterTable);
+    behaveRun.setMoistureScenarios(moistureScenarios);
+    BehaveFuelModels* cApiFuelModels = behave_fuel_models_create();
+
+    std::vector<SurfaceCase> surfaceCorpus = buildSurfaceCorpus(behaveRun);
+    std::vector<CrownCase> crownCorpus = buildCrownCorpus(behaveRun);
+    std::vector<TwoFuelModelsCase> twoFuelModelsCorpus = buildTwoFuelModelsCorpus(behaveRun);
+    printf("Corpus: %zu surface, %zu crown and %zu two fuel models runs\n\n", surfaceCorpus.size(), crownCorpus.size(),
+        twoFuelModelsCorpus.size());
+
+    // The two dimensional reference is calculated without the cache
+    TwoFuelModelsSpreadRateCache::getSharedCache().setEnabled(false);
+    std::vector<Section> referenceSections;
+    referenceSections.push_back(runSurfaceReference(behaveRun, surfaceCorpus));
+    referenceSections.push_back(runCrownReference(behaveRun, crownCorpus));
+    referenceSections.push_back(runTwoFuelModels(behaveRun, twoFuelModelsCorpus, false));
+    TwoFuelModelsSpreadRateCache::getSharedCache().setEnabled(true);
+    const Section& surfaceReference = referenceSections[0];
+    const Section& crownReference = referenceSections[1];
+
+    CheckResults results;
+    if (isGeneratingGolden)
+    {
+        if (!writeGoldenFile(goldenFileName, referenceSections))
+        {
+            printf("ERROR: could not write %s\n", goldenFileName.c_str());
+            return 1;
+        }
+        printf("Wrote golden outputs to %s\n\n", goldenFileName.c_str());
+    }
+    else
+    {
+        std::map<std::string, Section> goldenSections;
+        if (!readGoldenFile(goldenFileName, goldenSections))
+        {
+            printf("ERROR: could not read golden outputs from %s\n", goldenFileName.c_str());
+            return 1;
+        }
+        for (const Section& reference : referenceSections)
+        {
+            std::map<std::string, Section>::const_iterator golden = goldenSections.find(reference.name);
+            if (golden == goldenSections.end())
+            {
+                results.numberOfChecks++;
+                results.numberOfFailures++;
+                printf("FAILED  golden %-41s missing from %s\n", reference.name.c_str(), goldenFileName.c_str());
+                continue;
+            }
+            compareSections("golden " + reference.name, golden->second, reference, goldenTolerance, results);
+        }
+    }
+
+    // Alternative paths against the reference path
+    Section twoDimensionalReference = runTwoDimensional(behaveRun, twoFuelModelsCorpus, false, 0.0, false);
+    std::size_t numberOfMatrixCasesLoaded = 0;
+    compareSections("moisture scenario matrix", surfaceReference,
+        runSurfaceMoistureScenarioMatrix(behaveRun, surfaceCorpus, &numberOfMatrixCasesLoaded), samePathTolerance, results);
+    // The comparison only shows something if the matrix path was taken, for
+    // every case with a fuelbed to calculate
+    std::size_t numberOfBurnableCases = 0;
+    for (const SurfaceCase& surfaceCase : surfaceCorpus)
+    {
+        numberOfBurnableCases += behaveRun.isAllFuelLoadZero(surfaceCase.fuelModelNumber) ? 0 : 1;
+    }
+    results.numberOfChecks++;
+    if (numberOfMatrixCasesLoaded != numberOfBurnableCases)
+    {
+        results.numberOfFailures++;
+        printf("FAILED  %-48s %zu of %zu burnable rows loaded from the matrix\n", "moisture scenario matrix loads",
+            numberOfMatrixCasesLoaded, numberOfBurnableCases);
+    }
+    else
+    {
+        printf("passed  %-48s %zu rows\n", "moisture scenario matrix loads", numberOfMatrixCasesLoaded);
+    }
+    compareSections("surface batch with cell wind adjustment factors", surfaceReference, runSurfaceBatch(behaveRun, surfaceCorpus),
+        samePathTolerance, results);
+    compareSections("surface C interface batch", surfaceReference, runSurfaceCApi(cApiFuelModels, surfaceCorpus),
+        samePathTolerance, results);
+    compareSections("crown C interface batch", crownReference, runCrownCApi(cApiFuelModels, crownCorpus),
+        samePathTolerance, results);
+    compareSections("two dimensional spread rate cache", twoDimensionalReference,
+        runTwoDimensional(behaveRun, twoFuelModelsCorpus, true, 0.0, true), samePathTolerance, results);
+    compareSections("two dimensional quantized spread rate cache", twoDimensionalReference,
+        runTwoDimensional(behaveRun, twoFuelModelsCorpus, true, 0.01, true), quantizedTwoFuelModelsTolerance, results);
+
+    // Throughput
+    std::vector<Workload> workloads;
+    workloads.push_back({ "surface", surfaceCorpus.size(),
+        [&] { runSurfaceReference(behaveRun, surfaceCorpus); } });
+    workloads.push_back({ "surface moisture scenario matrix", surfaceCorpus.size(),
+        [&] { runSurfaceMoistureScenarioMatrix(behaveRun, surfaceCorpus); } });
+    workloads.push_back({ "surface batch", surfaceCorpus.size(),
+        [&] { runSurfaceBatch(behaveRun, surfaceCorpus); } });
+    workloads.push_back({ "surface C interface", surfaceCorpus.size(),
+        [&] { runSurfaceCApi(cApiFuelModels, surfaceCorpus); } });
+    workloads.push_back({ "crown", crownCorpus.size(),
+        [&] { runCrownReference(behaveRun, crownCorpus); } });
+    workloads.push_back({ "two dimensional", twoDimensionalReference.getNumberOfRows(),
+        [&] { runTwoDimensional(behaveRun, twoFuelModelsCorpus, false, 0.0, false); } });
+    std::vector<Throughput> throughputs = measureThroughputs(workloads, repeat, minimumSeconds);
+
+    std::map<std::string, double> baseline;
+    bool isComparingBaseline = !baselineFileName.empty() && !isSavingBaseline;
+    if (isComparingBaseline && !readBaselineFile(baselineFileName, baseline))
+    {
+        printf("ERROR: could not read throughput baseline from %s\n", baselineFileName.c_str());
+        return 1;
+    }
+    // Rows per second relative to the baseline, -1 without one
+    auto getBaselineRatio = [&](const Throughput& throughput)
+    {
+        std::map<std::string, double>::const_iterator baselineRowsPerSecond = baseline.find(throughput.name);
+        if (!isComparingBaseline || baselineRowsPerSecond == baseline.end() || baselineRowsPerSecond->second <= 0.0)
+        {
+            return -1.0;
+        }
+        return throughput.rowsPerSecond / baselineRowsPerSecond->second;
+    };
+    // A workload slower than the baseline is measured again before it fails,
+    // a regression stays slow while a busy machine rarely does for long
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        std::vector<Workload> slowWorkloads;
+        std::vector<std::size_t> slowIndexes;
+        for (std::size_t i = 0; i < throughputs.size(); i++)
+        {
+            double ratio = getBaselineRatio(throughputs[i]);
+            if (ratio >= 0.0 && ratio < 1.0 - threshold)
+            {
+                slowWorkloads.push_back(workloads[i]);
+                slowIndexes.push_back(i);
+            }
+        }
+        if (slowWorkloads.empty())
+        {
+            break;
+        }
+        std::vector<Throughput> remeasured = measureThroughputs(slowWorkloads, repeat, minimumSeconds);
+        for (std::size_t i = 0; i < slowIndexes.size(); i++)
+        {
+            Throughput& throughput = throughputs[slowIndexes[i]];
+            throughput.rowsPerSecond = std::max(throughput.rowsPerSecond, remeasured[i].rowsPerSecond);
+        }
+    }
+    behave_fuel_models_destroy(cApiFuelModels);
+
+    printf("\n");
+    for (const Throughput& throughput : throughputs)
+    {
+        double ratio = getBaselineRatio(throughput);
+        if (ratio < 0.0)
+        {
+            printf("        %-48s %12.0f rows/s\n", throughput.name.c_str(), throughput.rowsPerSecond);
+            continue;
+        }
+        results.numberOfChecks++;
+        bool isSlower = ratio < 1.0 - threshold;
+        if (isSlower)
+        {
+            results.numberOfFailures++;
+        }
+        printf("%s  %-48s %12.0f rows/s, %.2f x baseline\n", isSlower ? "FAILED" : "passed", throughput.name.c_str(),
+            throughput.rowsPerSecond, ratio);
+    }
+    if (isSavingBaseline)
+    {
+        if (!writeBaselineFile(baselineFileName, throughputs))
+        {
+            printf("ERROR: could not write %s\n", baselineFileName.c_str());
+            return 1;
+        }
+        printf("Wrote throughput baseline to %s\n", baselineFileName.c_str());
+    }
+
+    printf("\nTotal checks performed: %d\n", results.numberOfChecks);
+    printf("Total checks failed: %d\n", results.numberOfFailures);
+    return (results.numberOfFailures > 0) ? 1 : 0;
+}